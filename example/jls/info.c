@@ -101,6 +101,12 @@ int on_info(struct app_s * self, int argc, char * argv[]) {
                 printf("    summary_decimate_factor: %" PRIu32 "\n", signals[i].summary_decimate_factor);
                 printf("    annotation_decimate_factor: %" PRIu32 "\n", signals[i].annotation_decimate_factor);
                 printf("    utc_decimate_factor: %" PRIu32 "\n", signals[i].utc_decimate_factor);
+                printf("    summary_fields: 0x%02" PRIx32 "\n", signals[i].summary_fields);
+                if (signals[i].summary_hist_bins) {
+                    printf("    summary_hist: %" PRIu32 " bins from level %" PRIu32 " over [%g, %g)\n",
+                           signals[i].summary_hist_bins, signals[i].summary_hist_level,
+                           (double) signals[i].summary_hist_min, (double) signals[i].summary_hist_max);
+                }
                 printf("    sample_id_offset: %" PRId64 "\n", signals[i].sample_id_offset);
             }
             printf("    units: %s\n", signals[i].units);
@@ -0,0 +1,567 @@
+/*
+ * Copyright 2026 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file
+ *
+ * @brief Reproducible JLS benchmark suite.
+ *
+ * Each benchmark generates its own synthetic files, so results only
+ * depend on the library version, the build and the machine.
+ * Every measurement reports min, median and p99 over repeated
+ * operations as JSON for tracking regressions between releases.
+ */
+
+#include "jls/copy.h"
+#include "jls/ec.h"
+#include "jls/reader.h"
+#include "jls/threaded_writer.h"
+#include "jls/time.h"
+#include "jls/version.h"
+#include "jls/writer.h"
+
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+
+#define ARRAY_SIZE(x) ( sizeof(x) / sizeof((x)[0]) )
+#define BLOCK_SAMPLES (65536)
+#define READ_SAMPLES (1000)
+#define STATS_LENGTH (100)
+#define ANNOTATION_COUNT (1000)
+#define ANNOTATION_QUERY_COUNT (100)
+#define UTC_INTERVAL (100000)
+#define UTC_QUERY_COUNT (1000)
+#define SIGNAL_ID (1)
+
+
+static const char usage_str[] =
+"Benchmark JLS write, read, statistics, annotation, UTC and copy performance.\n"
+"usage: jls_bench [--<opt1> <value> ...]\n"
+"    --out <path>           The JSON output path.  Default is stdout.\n"
+"    --dir <path>           The directory for the generated files.  Default is '.'.\n"
+"    --samples <count>      The samples per generated file.  Default is 10000000.\n"
+"    --repeat <count>       The operations per measurement.  Default is 31.\n"
+"    --config <name>        Only run the named configuration.\n"
+"    --quick                Use small files and few repeats for a smoke test.\n"
+"\n"
+"Copyright 2026 Jetperch LLC, Apache 2.0 license\n"
+"\n";
+
+#define RPE(x)  do {                        \
+    int32_t rc__ = (x);                     \
+    if (rc__) {                             \
+        printf("error %d: " #x "\n", rc__); \
+        return rc__;                        \
+    }                                       \
+} while (0)
+
+#define GPE(x)  do {                        \
+    rc = (x);                               \
+    if (rc) {                               \
+        printf("error %d: " #x "\n", rc);   \
+        goto exit;                          \
+    }                                       \
+} while (0)
+
+struct config_s {
+    const char * name;
+    uint32_t data_type;
+    uint32_t samples_per_data;
+    uint32_t sample_decimate_factor;
+    uint32_t entries_per_summary;
+    uint32_t summary_decimate_factor;
+};
+
+static const struct config_s CONFIGS[] = {
+    {"f32",      JLS_DATATYPE_F32, 100000, 100, 20000, 100},
+    {"f32_fine", JLS_DATATYPE_F32,  10000,  10,  1000,  10},
+    {"f64",      JLS_DATATYPE_F64, 100000, 100, 20000, 100},
+    {"i16",      JLS_DATATYPE_I16, 100000, 100, 20000, 100},
+    {"u4",       JLS_DATATYPE_U4,  100000, 100, 20000, 100},
+    {"u1",       JLS_DATATYPE_U1,  100000, 104, 20000, 100},
+};
+
+static const struct jls_source_def_s SOURCE_1 = {
+    .source_id = 1,
+    .name = "jls_bench",
+    .vendor = "jls",
+    .model = "",
+    .version = "",
+    .serial_number = "",
+};
+
+struct bench_s {
+    FILE * out;                 // JSON results
+    FILE * log;                 // human-readable table
+    const char * dir;
+    const char * config_filter;
+    int64_t samples;
+    uint32_t repeat;
+    uint32_t result_count;
+    uint64_t rng;
+    double * t;                 // per-operation durations in seconds
+    uint8_t * block;            // BLOCK_SAMPLES of generated sample data
+    void * rd_buf;              // read buffer
+    char path[1024];
+    char path_copy[1024];
+};
+
+static uint64_t rng_next(struct bench_s * self) {  // xorshift64, fixed seed for reproducibility
+    uint64_t x = self->rng;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    self->rng = x;
+    return x;
+}
+
+static int64_t rng_range(struct bench_s * self, int64_t end) {
+    if (end <= 0) {
+        return 0;
+    }
+    return (int64_t) (rng_next(self) % (uint64_t) end);
+}
+
+static inline double time_s(void) {
+    return JLS_TIME_TO_F64(jls_time_rel());
+}
+
+static int cmp_f64(const void * a, const void * b) {
+    double x = *(const double *) a;
+    double y = *(const double *) b;
+    return (x < y) ? -1 : ((x > y) ? 1 : 0);
+}
+
+/**
+ * @brief Emit one measurement.
+ *
+ * @param self The benchmark instance.
+ * @param name The benchmark name.
+ * @param config The configuration name.
+ * @param param The benchmark-specific parameter, such as the statistics increment.
+ * @param n The number of durations in self->t.
+ * @param work The work per operation, used to compute the rate at the median.
+ * @param work_units The units for work, such as "MB" or "samples".
+ */
+static void result(struct bench_s * self, const char * name, const char * config, int64_t param,
+                   uint32_t n, double work, const char * work_units) {
+    if (!n) {
+        return;
+    }
+    qsort(self->t, n, sizeof(double), cmp_f64);
+    double t_min = self->t[0];
+    double t_median = (n & 1) ? self->t[n / 2] : 0.5 * (self->t[n / 2 - 1] + self->t[n / 2]);
+    uint32_t p99_idx = (uint32_t) ceil(0.99 * n) - 1;
+    double t_p99 = self->t[p99_idx];
+    double rate = (t_median > 0.0) ? (work / t_median) : 0.0;
+
+    fprintf(self->log, "%-20s %-9s %12" PRIi64 " %12.3e %12.3e %12.3e %12.4g %s/s\n",
+            name, config, param, t_min, t_median, t_p99, rate, work_units);
+    fflush(self->log);
+    fprintf(self->out, "%s\n    {\"name\": \"%s\", \"config\": \"%s\", \"param\": %" PRIi64
+            ", \"n\": %" PRIu32 ", \"min\": %.9g, \"median\": %.9g, \"p99\": %.9g"
+            ", \"rate\": %.9g, \"rate_units\": \"%s/s\"}",
+            self->result_count ? "," : "",
+            name, config, param, n, t_min, t_median, t_p99, rate, work_units);
+    ++self->result_count;
+}
+
+static double sample_bytes(uint32_t data_type, int64_t samples) {
+    return ((double) samples * jls_datatype_parse_size(data_type)) / 8.0;
+}
+
+static void gen_block(uint8_t * block, uint32_t data_type) {
+    for (uint32_t i = 0; i < BLOCK_SAMPLES; ++i) {
+        int32_t v = (int32_t) (i % 2000);
+        v = (v < 1000) ? v : (2000 - v);  // triangle 0..1000
+        switch (data_type) {
+            case JLS_DATATYPE_F32: ((float *) block)[i] = (float) (v - 500) * 0.002f; break;
+            case JLS_DATATYPE_F64: ((double *) block)[i] = (double) (v - 500) * 0.002; break;
+            case JLS_DATATYPE_I16: ((int16_t *) block)[i] = (int16_t) ((v - 500) * 32); break;
+            case JLS_DATATYPE_U4:
+                if (i & 1) {
+                    block[i / 2] |= (uint8_t) (((v >> 6) & 0x0f) << 4);
+                } else {
+                    block[i / 2] = (uint8_t) ((v >> 6) & 0x0f);
+                }
+                break;
+            case JLS_DATATYPE_U1:
+                if (!(i & 7)) {
+                    block[i / 8] = 0;
+                }
+                if (v > 500) {
+                    block[i / 8] |= (uint8_t) (1 << (i & 7));
+                }
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+static void signal_def_init(struct jls_signal_def_s * def, const struct config_s * config) {
+    memset(def, 0, sizeof(*def));
+    def->signal_id = SIGNAL_ID;
+    def->source_id = 1;
+    def->signal_type = JLS_SIGNAL_TYPE_FSR;
+    def->data_type = config->data_type;
+    def->sample_rate = 1000000;
+    def->samples_per_data = config->samples_per_data;
+    def->sample_decimate_factor = config->sample_decimate_factor;
+    def->entries_per_summary = config->entries_per_summary;
+    def->summary_decimate_factor = config->summary_decimate_factor;
+    def->annotation_decimate_factor = 100;
+    def->utc_decimate_factor = 100;
+    def->name = "signal";
+    def->units = "";
+}
+
+/// Write the synthetic file with sample data, annotations and UTC entries.
+static int32_t write_file(struct bench_s * self, const struct config_s * config) {
+    struct jls_wr_s * wr = NULL;
+    int32_t rc = 0;
+    struct jls_signal_def_s def;
+    signal_def_init(&def, config);
+    int64_t anno_interval = self->samples / ANNOTATION_COUNT;
+    if (anno_interval < 1) {
+        anno_interval = 1;
+    }
+    int64_t anno_next = 0;
+    int64_t utc_next = 0;
+    remove(self->path);
+    RPE(jls_wr_open(&wr, self->path));
+    GPE(jls_wr_source_def(wr, &SOURCE_1));
+    GPE(jls_wr_signal_def(wr, &def));
+    for (int64_t sample_id = 0; sample_id < self->samples; sample_id += BLOCK_SAMPLES) {
+        int64_t n = self->samples - sample_id;
+        n = (n > BLOCK_SAMPLES) ? BLOCK_SAMPLES : n;
+        GPE(jls_wr_fsr(wr, SIGNAL_ID, sample_id, self->block, (uint32_t) n));
+        int64_t sample_id_end = sample_id + n;
+        for (; utc_next < sample_id_end; utc_next += UTC_INTERVAL) {
+            GPE(jls_wr_utc(wr, SIGNAL_ID, utc_next, JLS_TIME_SECOND * (utc_next / def.sample_rate)));
+        }
+        for (; anno_next < sample_id_end; anno_next += anno_interval) {
+            GPE(jls_wr_annotation(wr, SIGNAL_ID, anno_next, NAN, JLS_ANNOTATION_TYPE_TEXT, 0,
+                                  JLS_STORAGE_TYPE_STRING, (const uint8_t *) "bench", 0));
+        }
+    }
+
+exit:
+    if (wr) {
+        int32_t rc_close = jls_wr_close(wr);
+        rc = rc ? rc : rc_close;
+    }
+    return rc;
+}
+
+static int64_t file_size(const char * path) {
+    FILE * f = fopen(path, "rb");
+    if (!f) {
+        return 0;
+    }
+    fseek(f, 0, SEEK_END);
+    int64_t sz = (int64_t) ftell(f);
+    fclose(f);
+    return sz;
+}
+
+/// Evict the file from the OS page cache, when supported, for cold measurements.
+static void cache_evict(const char * path) {
+#if defined(__linux__)
+    int fd = open(path, O_RDONLY);
+    if (fd >= 0) {
+        fdatasync(fd);
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        close(fd);
+    }
+#else
+    (void) path;
+#endif
+}
+
+static int32_t bench_write(struct bench_s * self, const struct config_s * config) {
+    uint32_t repeat = (self->repeat < 5) ? self->repeat : 5;  // whole-file operations
+    for (uint32_t i = 0; i < repeat; ++i) {
+        double t0 = time_s();
+        RPE(write_file(self, config));
+        self->t[i] = time_s() - t0;
+    }
+    result(self, "write", config->name, 0, repeat, sample_bytes(config->data_type, self->samples) / 1e6, "MB");
+    return 0;
+}
+
+static int32_t bench_twr(struct bench_s * self, const struct config_s * config) {
+    uint32_t repeat = (self->repeat < 5) ? self->repeat : 5;
+    struct jls_signal_def_s def;
+    struct jls_twr_s * wr = NULL;
+    int32_t rc = 0;
+    signal_def_init(&def, config);
+    double * t_close = malloc(repeat * sizeof(double));
+    if (!t_close) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    for (uint32_t i = 0; i < repeat; ++i) {
+        remove(self->path_copy);
+        GPE(jls_twr_open(&wr, self->path_copy));
+        GPE(jls_twr_source_def(wr, &SOURCE_1));
+        GPE(jls_twr_signal_def(wr, &def));
+        double t0 = time_s();
+        for (int64_t sample_id = 0; sample_id < self->samples; sample_id += BLOCK_SAMPLES) {
+            int64_t n = self->samples - sample_id;
+            n = (n > BLOCK_SAMPLES) ? BLOCK_SAMPLES : n;
+            do {
+                rc = jls_twr_fsr(wr, SIGNAL_ID, sample_id, self->block, (uint32_t) n);
+            } while (rc == JLS_ERROR_BUSY);
+            GPE(rc);
+        }
+        double t1 = time_s();
+        rc = jls_twr_close(wr);
+        wr = NULL;
+        GPE(rc);
+        self->t[i] = t1 - t0;
+        t_close[i] = time_s() - t1;
+    }
+    result(self, "twr_ingest", config->name, 0, repeat, (double) self->samples, "samples");
+    memcpy(self->t, t_close, repeat * sizeof(double));
+    result(self, "twr_close", config->name, 0, repeat, sample_bytes(config->data_type, self->samples) / 1e6, "MB");
+
+exit:
+    if (wr) {
+        jls_twr_close(wr);
+    }
+    free(t_close);
+    remove(self->path_copy);
+    return rc;
+}
+
+static int32_t bench_open(struct bench_s * self, const struct config_s * config) {
+    struct jls_rd_s * rd = NULL;
+    uint32_t repeat = (self->repeat < 11) ? self->repeat : 11;
+    for (uint32_t i = 0; i < repeat; ++i) {
+        cache_evict(self->path);
+        double t0 = time_s();
+        RPE(jls_rd_open(&rd, self->path));
+        self->t[i] = time_s() - t0;
+        jls_rd_close(rd);
+    }
+    result(self, "open_cold", config->name, 0, repeat, 1.0, "op");
+    for (uint32_t i = 0; i < self->repeat; ++i) {
+        double t0 = time_s();
+        RPE(jls_rd_open(&rd, self->path));
+        self->t[i] = time_s() - t0;
+        jls_rd_close(rd);
+    }
+    result(self, "open_warm", config->name, 0, self->repeat, 1.0, "op");
+    return 0;
+}
+
+static int32_t bench_read(struct bench_s * self, struct jls_rd_s * rd, const struct config_s * config) {
+    uint32_t repeat = (self->repeat < 5) ? self->repeat : 5;
+    for (uint32_t i = 0; i < repeat; ++i) {
+        double t0 = time_s();
+        for (int64_t sample_id = 0; sample_id < self->samples; sample_id += BLOCK_SAMPLES) {
+            int64_t n = self->samples - sample_id;
+            n = (n > BLOCK_SAMPLES) ? BLOCK_SAMPLES : n;
+            RPE(jls_rd_fsr(rd, SIGNAL_ID, sample_id, self->rd_buf, n));
+        }
+        self->t[i] = time_s() - t0;
+    }
+    result(self, "read_sequential", config->name, BLOCK_SAMPLES, repeat,
+           sample_bytes(config->data_type, self->samples) / 1e6, "MB");
+
+    for (uint32_t i = 0; i < self->repeat; ++i) {
+        int64_t sample_id = rng_range(self, self->samples - READ_SAMPLES);
+        double t0 = time_s();
+        RPE(jls_rd_fsr(rd, SIGNAL_ID, sample_id, self->rd_buf, READ_SAMPLES));
+        self->t[i] = time_s() - t0;
+    }
+    result(self, "read_random", config->name, READ_SAMPLES, self->repeat, READ_SAMPLES, "samples");
+    return 0;
+}
+
+static int32_t bench_statistics(struct bench_s * self, struct jls_rd_s * rd, const struct config_s * config) {
+    // one zoom level per summary level, plus the in-between increments
+    int64_t increment = 1;
+    while ((increment * STATS_LENGTH) <= self->samples) {
+        int64_t span = increment * STATS_LENGTH;
+        for (uint32_t i = 0; i < self->repeat; ++i) {
+            int64_t sample_id = rng_range(self, self->samples - span);
+            double t0 = time_s();
+            RPE(jls_rd_fsr_statistics(rd, SIGNAL_ID, sample_id, increment, self->rd_buf, STATS_LENGTH));
+            self->t[i] = time_s() - t0;
+        }
+        result(self, "statistics", config->name, increment, self->repeat, STATS_LENGTH, "windows");
+        increment *= 10;
+    }
+    return 0;
+}
+
+static int32_t on_annotation(void * user_data, const struct jls_annotation_s * annotation) {
+    (void) annotation;
+    uint32_t * count = (uint32_t *) user_data;
+    return (++(*count) >= ANNOTATION_QUERY_COUNT) ? 1 : 0;
+}
+
+static int32_t bench_annotations(struct bench_s * self, struct jls_rd_s * rd, const struct config_s * config) {
+    for (uint32_t i = 0; i < self->repeat; ++i) {
+        int64_t timestamp = rng_range(self, self->samples / 2);
+        uint32_t count = 0;
+        double t0 = time_s();
+        RPE(jls_rd_annotations(rd, SIGNAL_ID, timestamp, on_annotation, &count));
+        self->t[i] = time_s() - t0;
+    }
+    result(self, "annotations", config->name, ANNOTATION_QUERY_COUNT, self->repeat,
+           ANNOTATION_QUERY_COUNT, "annotations");
+    return 0;
+}
+
+static int32_t bench_utc(struct bench_s * self, struct jls_rd_s * rd, const struct config_s * config) {
+    int64_t timestamp = 0;
+    RPE(jls_rd_sample_id_to_timestamp(rd, SIGNAL_ID, 0, &timestamp));  // load the time map
+    for (uint32_t i = 0; i < self->repeat; ++i) {
+        double t0 = time_s();
+        for (uint32_t k = 0; k < UTC_QUERY_COUNT; ++k) {  // batch, single lookups are below timer resolution
+            int64_t sample_id = rng_range(self, self->samples);
+            RPE(jls_rd_sample_id_to_timestamp(rd, SIGNAL_ID, sample_id, &timestamp));
+        }
+        self->t[i] = time_s() - t0;
+    }
+    result(self, "utc", config->name, UTC_QUERY_COUNT, self->repeat, UTC_QUERY_COUNT, "op");
+    return 0;
+}
+
+static int32_t bench_copy(struct bench_s * self, const struct config_s * config) {
+    uint32_t repeat = (self->repeat < 5) ? self->repeat : 5;
+    double mb = (double) file_size(self->path) / 1e6;
+    for (uint32_t i = 0; i < repeat; ++i) {
+        remove(self->path_copy);
+        double t0 = time_s();
+        RPE(jls_copy(self->path, self->path_copy, NULL, NULL, NULL, NULL));
+        self->t[i] = time_s() - t0;
+    }
+    remove(self->path_copy);
+    result(self, "copy", config->name, 0, repeat, mb, "MB");
+    return 0;
+}
+
+static int32_t bench_config(struct bench_s * self, const struct config_s * config) {
+    struct jls_rd_s * rd = NULL;
+    snprintf(self->path, sizeof(self->path), "%s/jls_bench_%s.jls", self->dir, config->name);
+    snprintf(self->path_copy, sizeof(self->path_copy), "%s/jls_bench_%s_copy.jls", self->dir, config->name);
+    self->rng = 0x9E3779B97F4A7C15ULL;
+    gen_block(self->block, config->data_type);
+
+    RPE(bench_write(self, config));
+    RPE(bench_twr(self, config));
+    RPE(bench_open(self, config));
+    RPE(jls_rd_open(&rd, self->path));
+    int32_t rc = bench_read(self, rd, config);
+    if (!rc) {
+        rc = bench_statistics(self, rd, config);
+    }
+    if (!rc) {
+        rc = bench_annotations(self, rd, config);
+    }
+    if (!rc) {
+        rc = bench_utc(self, rd, config);
+    }
+    jls_rd_close(rd);
+    RPE(rc);
+    RPE(bench_copy(self, config));
+    remove(self->path);
+    return 0;
+}
+
+static int usage(void) {
+    printf("%s", usage_str);
+    return 1;
+}
+
+int main(int argc, char * argv[]) {
+    struct bench_s self;
+    memset(&self, 0, sizeof(self));
+    const char * out_path = NULL;
+    self.dir = ".";
+    self.samples = 10000000;
+    self.repeat = 31;
+
+    for (int i = 1; i < argc; ++i) {
+        if (0 == strcmp("--quick", argv[i])) {
+            self.samples = 1000000;
+            self.repeat = 5;
+        } else if ((0 == strcmp("--help", argv[i])) || (0 == strcmp("-h", argv[i]))) {
+            usage();
+            return 0;
+        } else if ((i + 1) >= argc) {
+            return usage();
+        } else if (0 == strcmp("--out", argv[i])) {
+            out_path = argv[++i];
+        } else if (0 == strcmp("--dir", argv[i])) {
+            self.dir = argv[++i];
+        } else if (0 == strcmp("--samples", argv[i])) {
+            self.samples = strtoll(argv[++i], NULL, 0);
+        } else if (0 == strcmp("--repeat", argv[i])) {
+            self.repeat = (uint32_t) strtoul(argv[++i], NULL, 0);
+        } else if (0 == strcmp("--config", argv[i])) {
+            self.config_filter = argv[++i];
+        } else {
+            printf("Unsupported argument: %s\n", argv[i]);
+            return usage();
+        }
+    }
+    if ((self.samples < (10 * READ_SAMPLES)) || (self.repeat < 1)) {
+        return usage();
+    }
+
+    self.out = out_path ? fopen(out_path, "wt") : stdout;
+    self.log = out_path ? stdout : stderr;
+    self.t = malloc(self.repeat * sizeof(double));
+    self.block = calloc(1, BLOCK_SAMPLES * sizeof(double));
+    self.rd_buf = malloc(BLOCK_SAMPLES * sizeof(double));
+    if (!self.out || !self.t || !self.block || !self.rd_buf) {
+        printf("Could not allocate resources\n");
+        return 1;
+    }
+
+    fprintf(self.log, "%-20s %-9s %12s %12s %12s %12s %12s\n", "#name", "config", "param", "min", "median", "p99", "rate");
+    fprintf(self.out, "{\n  \"jls_version\": \"%s\",\n  \"samples\": %" PRIi64 ",\n  \"repeat\": %" PRIu32
+            ",\n  \"time_units\": \"s\",\n  \"results\": [",
+            JLS_VERSION_STR, self.samples, self.repeat);
+    int32_t rc = 0;
+    for (size_t i = 0; !rc && (i < ARRAY_SIZE(CONFIGS)); ++i) {
+        if (self.config_filter && strcmp(self.config_filter, CONFIGS[i].name)) {
+            continue;
+        }
+        rc = bench_config(&self, &CONFIGS[i]);
+    }
+    fprintf(self.out, "\n  ]\n}\n");
+
+    if (self.out != stdout) {
+        fclose(self.out);
+    }
+    free(self.t);
+    free(self.block);
+    free(self.rd_buf);
+    return rc ? 1 : 0;
+}
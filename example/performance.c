@@ -16,7 +16,6 @@
 
 #include "jls/threaded_writer.h"
 #include "jls/ec.h"
-#include "jls/reader.h"
 #include "jls/raw.h"
 #include "jls/time.h"
 #include "jls/backend.h"
@@ -27,9 +26,6 @@
 #include <string.h>
 
 
-#define ARRAY_SIZE(x) ( sizeof(x) / sizeof((x)[0]) )
-
-
 static const char usage_str[] =
 "Utility to test JLS file performance.\n"
 "usage: performance <command>\n"
@@ -48,9 +44,7 @@ static const char usage_str[] =
 "    --entries_per_summary          The entries per summary chunk.\n"
 "    --summary_decimate_factor      The summaries per summary entry.\n"
 "\n"
-"Profile JLS read performance.\n"
-"  profile <filename>\n"
-"    <filename>                     The input file path.\n"
+"For read and write benchmarks, see jls_bench.\n"
 "\n"
 "Print the JLS tag structure.\n"
 "  print <filename> [--<opt1> <value> ...]\n"
@@ -254,169 +248,6 @@ static int32_t generate_jls(const char * filename, const struct jls_signal_def_s
     return 0;
 }
 
-static int32_t json_signal_def(struct jls_rd_s * rd, uint16_t signal_id, FILE * json) {
-    int64_t length = 0;
-    struct jls_signal_def_s signal_def;
-    RPE(jls_rd_signal(rd, signal_id, &signal_def));
-    if (signal_def.signal_type == JLS_SIGNAL_TYPE_FSR) {
-        RPE(jls_rd_fsr_length(rd, signal_id, &length));
-        printf("Length = %" PRIi64 " samples (%.0e)\n", length, (double) length);
-    } else {
-        // todo get VSR length
-    }
-    fprintf(json, "\n  \"info\": {");
-    fprintf(json, "\n    \"signal_id\": %d,", (int) signal_def.signal_id);
-    fprintf(json, "\n    \"source_id\": %d,", (int) signal_def.source_id);
-    fprintf(json, "\n    \"signal_type\": %d,", (int) signal_def.signal_type);
-    fprintf(json, "\n    \"signal_type_str\": \"%s\",", (signal_def.signal_type == JLS_SIGNAL_TYPE_FSR) ? "FSR" : "VSR");
-    fprintf(json, "\n    \"data_type\": %d,", (int) signal_def.data_type);
-    fprintf(json, "\n    \"sample_rate\": %" PRIu32 ",", signal_def.sample_rate);
-    fprintf(json, "\n    \"samples_per_data\": %" PRIu32 ",", signal_def.samples_per_data);
-    fprintf(json, "\n    \"sample_decimate_factor\": %" PRIu32 ",", signal_def.sample_decimate_factor);
-    fprintf(json, "\n    \"entries_per_summary\": %" PRIu32 ",", signal_def.entries_per_summary);
-    fprintf(json, "\n    \"summary_decimate_factor\": %" PRIu32 ",", signal_def.summary_decimate_factor);
-    fprintf(json, "\n    \"annotation_decimate_factor\": %" PRIu32 ",", signal_def.annotation_decimate_factor);
-    fprintf(json, "\n    \"utc_decimate_factor\": %" PRIu32 ",", signal_def.utc_decimate_factor);
-    fprintf(json, "\n    \"name\": \"%s\",", signal_def.name);
-    fprintf(json, "\n    \"units\": \"%s\",", signal_def.units);
-    fprintf(json, "\n    \"length\": %" PRIi64, length);
-    fprintf(json, "\n  }");
-    fflush(json);
-    return 0;
-}
-
-static int32_t profile_fsr_signal(struct jls_rd_s * rd, uint16_t signal_id, FILE * json) {
-    int64_t length = 0;
-    static double data_f64[100000];
-    float * data_f32 = (float *) data_f64;
-    const int64_t read_lengths[] = {1, 100, 1000, 10000, 100000};
-    RPE(jls_rd_fsr_length(rd, signal_id, &length));
-    fprintf(json, "\n{");
-    json_signal_def(rd, signal_id, json);
-
-    fprintf(json, ",\n  \"read_samples\": [");
-    for (size_t read_idx = 0; read_idx < ARRAY_SIZE(read_lengths); ++read_idx) {
-        int64_t sample_count = read_lengths[read_idx];
-        int64_t step_count = 100;
-        int64_t step_sz = (length - 1 - sample_count) / step_count;
-        int64_t t_start = jls_time_rel();
-        for (int64_t sample = 0; sample < length; sample += step_sz) {
-            RPE(jls_rd_fsr(rd, signal_id, sample, data_f32, sample_count));
-        }
-        int64_t t_end = jls_time_rel();
-        double t_duration = JLS_TIME_TO_F64(t_end - t_start);
-        printf("Read %" PRIi64 " samples: %g seconds\n", sample_count, t_duration / step_count);
-        fflush(stdout);
-        if (read_idx) {
-            fprintf(json, ",");
-        }
-        fprintf(json, "\n    [%" PRIi64 ", %g]", sample_count, t_duration / step_count);
-    }
-    fprintf(json, "\n  ]");
-
-    fprintf(json, ",\n  \"read_summary\": [");
-    int summary_counter = 0;
-    const int64_t summary_lengths[] = {1, 11, 479, 1117, 11939};
-    int64_t increment = 1;
-    printf("#signal,increment,length,time\n");
-    double t_total = 0.0;
-    double t_worst = 0.0;
-
-    while (increment < length) {
-        for (size_t summary_idx = 0; summary_idx < ARRAY_SIZE(summary_lengths); ++summary_idx) {
-            int64_t samples = summary_lengths[summary_idx];
-            int64_t count = length / increment - samples;
-            if (count <= 0) {
-                count = 1;
-            }
-            if (count > 100) {
-                count = 100;
-            }
-            int64_t iter_count = 0;
-            int64_t t_start = jls_time_rel();
-            int64_t offset_sz = (length - increment - 1) / count;
-            for (int64_t sample = 0; sample < (length - increment); sample += offset_sz) {
-                int64_t max_len = (length - sample) / increment;
-                int64_t data_length = (max_len < samples) ? max_len : samples;
-                RPE(jls_rd_fsr_statistics(rd, signal_id, sample, increment, data_f64, data_length));
-                ++iter_count;
-            }
-            int64_t t_end = jls_time_rel();
-            double t_duration = JLS_TIME_TO_F64(t_end - t_start);
-            t_duration /= iter_count;
-            if (t_duration > t_worst) {
-                t_worst = t_duration;
-            }
-            t_total += t_duration;
-            printf("%d,%" PRIi64 ",%" PRIi64",%g\n", (int) signal_id, increment,
-                   samples, t_duration);
-            fflush(stdout);
-            if (summary_counter) {
-                fprintf(json, ",");
-            }
-            fprintf(json, "\n    [%d, %" PRIi64 ", %" PRIi64", %g]", (int) signal_id,
-                    increment, samples, t_duration);
-            ++summary_counter;
-        }
-        increment *= 3;
-    }
-    fprintf(json, "\n  ]");
-
-    fprintf(json, "\n}");
-    printf("Total=%.5f, worst=%.5f\n", t_total, t_worst);
-    return 0;
-}
-
-static int32_t profile_vsr_signal(struct jls_rd_s * rd, uint16_t signal_id, FILE * json) {
-    printf("Not yet implemented, skip\n");
-    fprintf(json, "\n{");
-    json_signal_def(rd, signal_id, json);
-    fprintf(json, "\n}");
-    return 0;
-}
-
-static int32_t profile(const char * filename) {
-    struct jls_rd_s * rd = NULL;
-    struct jls_signal_def_s * signals;
-    char json_filename[1024];
-    snprintf(json_filename, sizeof(json_filename), "%s.json", filename);
-    FILE * json = fopen(json_filename, "wt");
-    if (!json) {
-        printf("Could not open JSON output file: %s\n", json_filename);
-        return 1;
-    }
-    uint16_t signals_count = 0;
-    RPE(jls_rd_open(&rd, filename));
-    fprintf(json, "{");
-
-    RPE(jls_rd_signals(rd, &signals, &signals_count));
-    fprintf(json, "\n\"signals\": [");
-    for (uint16_t signal_idx = 0; signal_idx < signals_count; ++signal_idx) {
-        struct jls_signal_def_s * s = signals + signal_idx;
-        if (signal_idx) {
-            fprintf(json, ",");
-        }
-        switch (s->signal_type) {
-            case JLS_SIGNAL_TYPE_FSR:
-                printf("\nProfile FSR signal %d: %d\n", (int) signal_idx, (int) s->signal_id);
-                RPE(profile_fsr_signal(rd, s->signal_id, json));
-                break;
-            case JLS_SIGNAL_TYPE_VSR:
-                printf("\nProfile VSR signal %d: %d\n", (int) signal_idx, (int) s->signal_id);
-                RPE(profile_vsr_signal(rd, s->signal_id, json));
-                break;
-            default:
-                printf("\nProfile signal %d: %d\n", (int) signal_idx, (int) s->signal_id);
-                break;
-        }
-    }
-    fprintf(json, "\n]");
-
-    fprintf(json, "\n}\n");
-    jls_rd_close(rd);
-    return 0;
-}
-
 static int32_t print(const char * filename, uint32_t level) {
     struct jls_raw_s * raw = NULL;
     struct jls_chunk_header_s hdr;
@@ -574,28 +405,6 @@ int main(int argc, char * argv[]) {
         double t_duration = JLS_TIME_TO_F64(t_end - t_start);
         printf("Throughput: %g samples per second\n", length / t_duration);
 
-    } else if (strcmp(argv[0], "profile") == 0) {
-        SKIP_REQUIRED();
-        while (argc) {
-            if (argv[0][0] != '-') {
-                REQUIRE_ARGS(1);
-                if (filename) {
-                    return usage();
-                }
-                filename = argv[0];
-            } else if (0 == strcmp("--filename", argv[0])) {
-                REQUIRE_ARGS(2);
-                filename = argv[1];
-            } else {
-                UNSUPPORTED();
-            }
-            SKIP_REQUIRED();
-        }
-        REQUIRE_FILENAME();
-        if (profile(filename)) {
-            printf("Failed to complete profile\n");
-            return 1;
-        }
     } else if (strcmp(argv[0], "print") == 0) {
         uint32_t level = 0;
         SKIP_REQUIRED();
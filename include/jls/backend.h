@@ -60,7 +60,10 @@ int32_t jls_bk_fread(struct jls_bkf_s * self, void * const buffer, unsigned cons
 int32_t jls_bk_fseek(struct jls_bkf_s * self, int64_t offset, int origin);
 int64_t jls_bk_ftell(struct jls_bkf_s * self);
 int32_t jls_bk_fflush(struct jls_bkf_s * self);
+int32_t jls_bk_fdatasync(struct jls_bkf_s * self);  // like fflush, but skip metadata not needed to read
 int32_t jls_bk_truncate(struct jls_bkf_s * self);
+// Reserve disk space up to length bytes without changing the file size.
+int32_t jls_bk_fallocate(struct jls_bkf_s * self, int64_t length);  // 0, JLS_ERROR_NOT_SUPPORTED or error code
 
 // forward declaration for "threaded_writer.h"
 struct jls_twr_s;
@@ -71,9 +74,18 @@ int jls_bkt_msg_unlock(struct jls_bkt_s * self);        // 0 on success or error
 int jls_bkt_process_lock(struct jls_bkt_s * self);      // 0 on success or error code
 int jls_bkt_process_unlock(struct jls_bkt_s * self);    // 0 on success or error code
 void jls_bkt_msg_wait(struct jls_bkt_s * self);
+void jls_bkt_msg_wait_ms(struct jls_bkt_s * self, uint32_t timeout_ms);  // wait, at most timeout_ms
 void jls_bkt_msg_signal(struct jls_bkt_s * self);
 void jls_bkt_sleep_ms(uint32_t duration_ms);
 
+/// The worker pool task function.
+typedef void (*jls_bkp_fn)(void * user_data);
+struct jls_bkp_s * jls_bkp_initialize(uint32_t thread_count);
+void jls_bkp_finalize(struct jls_bkp_s * self);
+uint32_t jls_bkp_thread_count(struct jls_bkp_s * self);
+// Run fn(user_data[i]) for i < count <= thread_count, one per worker, and wait for all to complete.
+int32_t jls_bkp_run(struct jls_bkp_s * self, jls_bkp_fn fn, void ** user_data, uint32_t count);
+
 
 JLS_API int64_t jls_now(void);
 JLS_API struct jls_time_counter_s jls_time_counter(void);
@@ -75,6 +75,59 @@ JLS_API int32_t jls_copy(const char * src, const char * dst,
                          jls_copy_msg_fn msg_fn, void * msg_user_data,
                          jls_copy_progress_fn progress_fn, void * progress_user_data);
 
+/**
+ * @brief Copy a sample range of selected FSR signals to a new JLS file.
+ *
+ * @param src The source path.
+ * @param dst The destination path.
+ * @param signal_ids The FSR signal ids to copy.  NULL or signal_count 0
+ *      copies all FSR signals.
+ * @param signal_count The number of entries in signal_ids.
+ * @param start_sample_id The API zero-based starting sample id, inclusive.
+ * @param end_sample_id The API zero-based ending sample id, exclusive.
+ *      Use -1 for the end of each signal.
+ * @return 0 or error code.
+ *
+ * The same sample range applies to every selected signal, so select
+ * signals with the same sample rate and start.  The range is clamped to
+ * the length of each signal.  The destination contains all user data,
+ * the sources and definitions of the selected signals, the global
+ * annotations, and the annotations and UTC entries within the range.
+ * UTC entries are also added at the first and last sample when the
+ * signal has a time map.
+ *
+ * When start_sample_id is a multiple of samples_per_data, the stored data
+ * chunks and their level 1 summaries are copied without decoding, so the
+ * time scales with the output size rather than the source size.  Only
+ * the partial chunk at the end and any omitted chunks are decoded.
+ * Other start_sample_id values decode and re-summarize every sample.
+ */
+JLS_API int32_t jls_slice(const char * src, const char * dst,
+                          const uint16_t * signal_ids, uint32_t signal_count,
+                          int64_t start_sample_id, int64_t end_sample_id);
+
+/**
+ * @brief Concatenate JLS files in time order into a new JLS file.
+ *
+ * @param src The array of source paths, in order.
+ * @param src_count The number of entries in src.
+ * @param dst The destination path.
+ * @return 0 or error code.
+ *
+ * Every source must define the same FSR signals with matching data
+ * type, sample rate and summary configuration.  The destination uses
+ * the sources and signal definitions from the first source.  Each
+ * source's samples follow the previous source's samples for the same
+ * signal, and its annotation and UTC sample ids shift to match.  All
+ * user data and global annotations are copied.
+ *
+ * When the samples before a source end on a samples_per_data boundary,
+ * that source's stored data chunks and level 1 summaries are copied
+ * without decoding.  Otherwise its samples are decoded and re-summarized.
+ * Higher summary levels are always recombined from the level 1 summaries.
+ */
+JLS_API int32_t jls_concat(const char * const * src, uint32_t src_count, const char * dst);
+
 JLS_CPP_GUARD_END
 
 /** @} */
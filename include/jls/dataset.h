@@ -0,0 +1,200 @@
+/*
+ * Copyright 2026 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/**
+ * @file
+ *
+ * @brief JLS multi-file dataset reader.
+ */
+
+#ifndef JLS_DATASET_H__
+#define JLS_DATASET_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include "jls/cmacro.h"
+#include "jls/format.h"
+#include "jls/reader.h"
+
+/**
+ * @ingroup jls
+ * @defgroup jls_dataset Dataset
+ *
+ * @brief Read a sequence of JLS segment files as one logical file.
+ *
+ * jls_twr_open_dataset() writes a dataset as numbered segment files
+ * that each hold a contiguous portion of every FSR signal.  The
+ * dataset reader maps sample ids, statistics, annotations and UTC
+ * entries across the segment boundaries.  FSR sample ids are
+ * zero-based from the start of the first segment.
+ *
+ * @{
+ */
+
+JLS_CPP_GUARD_START
+
+/// The opaque JLS dataset reader object.
+struct jls_ds_s;
+
+/**
+ * @brief Construct the file path for a dataset segment.
+ *
+ * @param path The dataset path, such as "capture.jls".
+ * @param index The zero-based segment index.
+ * @param[out] segment_path The segment path, such as "capture_00003.jls".
+ * @param segment_path_size The size of segment_path in bytes.
+ * @return 0 or JLS_ERROR_TOO_BIG.
+ */
+JLS_API int32_t jls_ds_segment_path(const char * path, uint32_t index,
+                                    char * segment_path, size_t segment_path_size);
+
+/**
+ * @brief Open a dataset to read contents.
+ *
+ * @param[out] instance The new dataset read instance.
+ * @param path The dataset path given to jls_twr_open_dataset().
+ * @return 0, JLS_ERROR_NOT_FOUND if the first segment does not
+ *      exist, or error code.
+ *
+ * Opening reads each consecutive segment once to build an in-memory
+ * index of its sample range and whole-segment statistics for each FSR
+ * signal.  Statistics that span entire segments use this index without
+ * reopening them.  At most a few segment readers stay open at once.
+ * The sources and signals come from the first segment.
+ * Call jls_ds_close() when done.
+ *
+ * The index is not persisted, so the open time grows linearly with
+ * the segment count.  Each segment costs one jls_rd_open() and one
+ * whole-segment jls_rd_fsr_statistics() per FSR signal, which reads
+ * the segment's coarsest summaries.  A segment that was not closed,
+ * including one that a writer still holds open, is repaired in place
+ * like jls_rd_open(), which writes to the file and costs time
+ * proportional to the segment size.  Open the dataset after
+ * jls_twr_close() completes.
+ */
+JLS_API int32_t jls_ds_open(struct jls_ds_s ** instance, const char * path);
+
+/**
+ * @brief Close a dataset opened with jls_ds_open().
+ * @param self The dataset read instance.
+ */
+JLS_API void jls_ds_close(struct jls_ds_s * self);
+
+/**
+ * @brief Get the number of segments in the dataset.
+ *
+ * @param self The dataset read instance.
+ * @return The number of segments.
+ */
+JLS_API uint32_t jls_ds_segment_count(struct jls_ds_s * self);
+
+/**
+ * @brief Get the array of sources in the dataset.
+ *
+ * @param self The dataset read instance.
+ * @param[out] sources The array of sources.
+ * @param[out] count The number of items in sources.
+ * @return 0 or error code.
+ */
+JLS_API int32_t jls_ds_sources(struct jls_ds_s * self, struct jls_source_def_s ** sources, uint16_t * count);
+
+/**
+ * @brief Get the array of signals in the dataset.
+ *
+ * @param self The dataset read instance.
+ * @param[out] signals The array of signals.
+ * @param[out] count The number of items in signals.
+ * @return 0 or error code.
+ */
+JLS_API int32_t jls_ds_signals(struct jls_ds_s * self, struct jls_signal_def_s ** signals, uint16_t * count);
+
+/**
+ * @brief Get the number of samples in an FSR signal across all segments.
+ *
+ * @param self The dataset read instance.
+ * @param signal_id The signal id.
+ * @param[out] samples The number of samples in the signal.
+ * @return 0 or error code.
+ */
+JLS_API int32_t jls_ds_fsr_length(struct jls_ds_s * self, uint16_t signal_id, int64_t * samples);
+
+/**
+ * @brief Read FSR data across segments.
+ *
+ * @param self The dataset read instance.
+ * @param signal_id The signal id.
+ * @param start_sample_id The starting sample id to read.
+ * @param[out] data The samples read, packed as in jls_rd_fsr().
+ * @param data_length The number of samples to read.
+ * @return 0, JLS_ERROR_NOT_FOUND if the range includes samples between
+ *      segments, or error code.
+ */
+JLS_API int32_t jls_ds_fsr(struct jls_ds_s * self, uint16_t signal_id, int64_t start_sample_id,
+                           void * data, int64_t data_length);
+
+/**
+ * @brief Read FSR statistics across segments.
+ *
+ * @param self The dataset read instance.
+ * @param signal_id The signal id.
+ * @param start_sample_id The starting sample id to read.
+ * @param increment The number of samples represented by each entry.
+ * @param[out] data The [data_length][JLS_SUMMARY_FSR_COUNT] statistics,
+ *      as in jls_rd_fsr_statistics().
+ * @param data_length The number of entries.
+ * @return 0 or error code.
+ *
+ * Entries within a single segment use that segment's summaries.
+ * Entries that span segments combine the per-segment statistics.
+ */
+JLS_API int32_t jls_ds_fsr_statistics(struct jls_ds_s * self, uint16_t signal_id,
+                                      int64_t start_sample_id, int64_t increment,
+                                      double * data, int64_t data_length);
+
+/**
+ * @brief Iterate over the annotations for a signal across segments.
+ *
+ * @param self The dataset read instance.
+ * @param signal_id The signal id.
+ * @param timestamp The starting timestamp.  Skip all prior annotations.
+ * @param cbk_fn The callback function, see jls_rd_annotations().
+ *      FSR annotation timestamps are dataset sample ids.
+ * @param cbk_user_data The arbitrary data provided to cbk_fn.
+ * @return 0 or error code.
+ */
+JLS_API int32_t jls_ds_annotations(struct jls_ds_s * self, uint16_t signal_id, int64_t timestamp,
+                                   jls_rd_annotation_cbk_fn cbk_fn, void * cbk_user_data);
+
+/**
+ * @brief Iterate over the UTC timestamps for a FSR signal across segments.
+ *
+ * @param self The dataset read instance.
+ * @param signal_id The signal id.
+ * @param sample_id The starting sample_id.  Skip all prior sample ids.
+ * @param cbk_fn The callback function, see jls_rd_utc().
+ *      The entries use dataset sample ids.
+ * @param cbk_user_data The arbitrary data provided to cbk_fn.
+ * @return 0 or error code.
+ */
+JLS_API int32_t jls_ds_utc(struct jls_ds_s * self, uint16_t signal_id, int64_t sample_id,
+                           jls_rd_utc_cbk_fn cbk_fn, void * cbk_user_data);
+
+JLS_CPP_GUARD_END
+
+/** @} */
+
+#endif  /* JLS_DATASET_H__ */
@@ -319,6 +319,8 @@ enum jls_tag_e {
 
     // other tags
     JLS_TAG_USER_DATA                   = 0x40, // own doubly-linked list
+    JLS_TAG_CHECKPOINT_HEAD             = 0x41, // offset of the most recent checkpoint, updated in place
+    JLS_TAG_CHECKPOINT                  = 0x42, // writer track state for recovery, own doubly-linked list
     JLS_TAG_END                         = 0xFF, // present if file closed properly
 };
 
@@ -436,6 +438,13 @@ struct jls_signal_def_s {       // 0 reserved for VSR annotations
      */
     const char * name;
     const char * units;                 ///< The units string, normally as SI with no scale prefix.
+
+    // Added in 0.16.0 after the existing fields to preserve the struct layout.
+    uint32_t summary_fields;            ///< The jls_summary_field_e optional summary fields.  (FSR only)
+    uint32_t summary_hist_bins;         ///< The summary histogram bins, 0 to disable.  (FSR only)
+    uint32_t summary_hist_level;        ///< The first summary level with histograms, 0 for 2.  (FSR only)
+    float summary_hist_min;             ///< The lower edge of the first histogram bin.  (FSR only)
+    float summary_hist_max;             ///< The upper edge of the last histogram bin.  (FSR only)
 };
 
 //  struct jls_track_def_s  // empty, only need chunk_meta for now
@@ -456,6 +465,53 @@ enum jls_summary_fsr_e {
     JLS_SUMMARY_FSR_COUNT = 4,   // must be last
 };
 
+/**
+ * @brief The optional summary fields.
+ *
+ * Set jls_signal_def_s.summary_fields to store these fields in each
+ * FSR summary entry.  The selected fields follow the
+ * JLS_SUMMARY_FSR_COUNT base fields in bit order, so each entry
+ * contains JLS_SUMMARY_FSR_COUNT + popcount(summary_fields) values.
+ * The summary entry_size_bits reflects the total entry size.
+ * All optional fields only consider finite samples.
+ *
+ * JLS_SUMMARY_FIELD_F64 is not a field.  It stores all summary entries
+ * as f64 regardless of the data type, which together with
+ * JLS_SUMMARY_FIELD_SUM keeps long-window sums exact to f64 precision.
+ */
+enum jls_summary_field_e {
+    JLS_SUMMARY_FIELD_SUM = (1 << 0),       ///< The sum.
+    JLS_SUMMARY_FIELD_RMS = (1 << 1),       ///< The root-mean-square value.
+    JLS_SUMMARY_FIELD_FINITE = (1 << 2),    ///< The number of finite samples.
+    JLS_SUMMARY_FIELD_FIRST = (1 << 3),     ///< The first finite sample value.
+    JLS_SUMMARY_FIELD_LAST = (1 << 4),      ///< The last finite sample value.
+    JLS_SUMMARY_FIELD_ALL = 0x1f,           ///< All optional fields.
+    JLS_SUMMARY_FIELD_F64 = (1 << 15),      ///< Store summary entries as f64.
+};
+
+/// The maximum number of values in a summary entry, including optional fields.
+#define JLS_SUMMARY_FSR_ENTRY_MAX (JLS_SUMMARY_FSR_COUNT + 5)
+
+/**
+ * @brief The maximum number of summary histogram bins.
+ *
+ * Set jls_signal_def_s.summary_hist_bins to store a histogram in each
+ * FSR summary entry at summary_hist_level and above.  The bins evenly
+ * divide [summary_hist_min, summary_hist_max), in unscaled integer
+ * units for fixed-point data types.  Finite samples outside
+ * this range count towards the first or last bin.  The bin counts
+ * follow the optional summary fields, so each entry at these levels
+ * contains summary_hist_bins additional values.  Histograms merge by
+ * addition, which allows jls_rd_fsr_quantiles() to compute quantiles
+ * over arbitrary windows from the coarsest covering summaries.
+ *
+ * The bin counts use the summary entry type.  f32 entries represent
+ * counts exactly only up to 2^24 samples per bin, so coarse entries
+ * over longer recordings round their counts.  Set
+ * JLS_SUMMARY_FIELD_F64 in summary_fields for exact counts.
+ */
+#define JLS_SUMMARY_HIST_BINS_MAX (256)
+
 /**
  * @brief Union structure for parsing 32-bit versions.
  */
@@ -634,7 +690,7 @@ struct jls_fsr_index_s {
  */
 struct jls_fsr_f32_summary_s {
     struct jls_payload_header_s header;  ///< The payload
-    float data[][JLS_SUMMARY_FSR_COUNT]; ///< The summary data, each entry is 4 x f32: mean, std, min, max.
+    float data[][JLS_SUMMARY_FSR_COUNT]; ///< The summary data, each entry is 4 x f32: mean, std, min, max.  Optional fields change the stride, see jls_summary_field_e.
 };
 
 /**
@@ -644,7 +700,7 @@ struct jls_fsr_f32_summary_s {
  */
 struct jls_fsr_f64_summary_s {
     struct jls_payload_header_s header;   ///< The payload
-    double data[][JLS_SUMMARY_FSR_COUNT]; ///< The summary data, each entry is 4 x f64: mean, std, min, max.
+    double data[][JLS_SUMMARY_FSR_COUNT]; ///< The summary data, each entry is 4 x f64: mean, std, min, max.  Optional fields change the stride, see jls_summary_field_e.
 };
 
 /**
@@ -27,6 +27,7 @@
 #include <stdint.h>
 #include "jls/cmacro.h"
 #include "jls/format.h"
+#include "jls/stats.h"
 
 /**
  * @ingroup jls
@@ -85,6 +86,15 @@ union jls_version_u jls_raw_version(struct jls_raw_s * self);
  */
 struct jls_bkf_s * jls_raw_backend(struct jls_raw_s * self);
 
+/**
+ * @brief Set the instrumentation counters.
+ *
+ * @param self The JLS raw instance.
+ * @param stats The counters to update, which must remain valid until
+ *      the next call or jls_raw_close().  NULL disables instrumentation.
+ */
+void jls_raw_stats_set(struct jls_raw_s * self, struct jls_stats_s * stats);
+
 /**
  * @brief Write a chunk to the file at the current location and advance on success.
  *
@@ -157,6 +167,18 @@ int32_t jls_raw_rd_payload(struct jls_raw_s * self, uint32_t payload_length_max,
  */
 int32_t jls_raw_chunk_seek(struct jls_raw_s * self, int64_t offset);
 
+/**
+ * @brief Truncate the file at a chunk.
+ *
+ * @param self The JLS raw instance.
+ * @param offset The offset of the first chunk to remove.
+ * @return 0 or error code.
+ *
+ * Removes the chunk at offset and all following chunks.  The next
+ * write occurs at offset.
+ */
+int32_t jls_raw_truncate(struct jls_raw_s * self, int64_t offset);
+
 /**
  * @brief Seek to the file end for writing.
  *
@@ -165,6 +187,14 @@ int32_t jls_raw_chunk_seek(struct jls_raw_s * self, int64_t offset);
  */
 int32_t jls_raw_seek_end(struct jls_raw_s * self);
 
+/**
+ * @brief Update the file end for a file that may still be written.
+ *
+ * @param self The JLS raw instance.
+ * @return 0 or error code.
+ */
+int32_t jls_raw_end_update(struct jls_raw_s * self);
+
 /**
  * @brief Get the current chunk offset.
  *
@@ -193,6 +223,35 @@ int32_t jls_raw_chunk_scan(struct jls_raw_s * self);
  */
 int32_t jls_raw_flush(struct jls_raw_s * self);
 
+/**
+ * @brief Write buffered JLS changes to the file.
+ *
+ * @param self The JLS raw instance.
+ * @param durable When nonzero, also wait for the storage device to
+ *      persist the file data, skipping the metadata that
+ *      jls_raw_flush() also persists, such as the modification time.
+ * @return 0 or error code.
+ */
+int32_t jls_raw_sync(struct jls_raw_s * self, int32_t durable);
+
+/**
+ * @brief Configure the write-behind buffer.
+ *
+ * @param self The JLS raw instance opened with mode "w" or "a".
+ * @param size The buffer size in bytes, or 0 to disable (default).
+ * @return 0 or error code.
+ *
+ * The buffer coalesces chunks appended to the file into large writes
+ * that end at file offsets that are multiples of 4096 bytes.  Header
+ * updates to chunks still in the buffer modify the buffer in place.
+ * Other updates and reads outside the buffer, jls_raw_flush() and
+ * jls_raw_close() first write the buffered data to the file, which
+ * preserves the write order.  While enabled, file space is also
+ * preallocated in large increments when the platform supports it,
+ * without changing the file size.
+ */
+int32_t jls_raw_write_buffer(struct jls_raw_s * self, uint32_t size);
+
 /**
  * @brief Navigate to the next chunk.
  *
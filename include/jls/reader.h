@@ -28,6 +28,7 @@
 #include <stddef.h>
 #include "jls/cmacro.h"
 #include "jls/format.h"
+#include "jls/stats.h"
 
 /**
  * @ingroup jls
@@ -50,10 +51,62 @@ struct jls_rd_s;
  * @param path The JLS file path.
  * @return 0 or error code.
  *
+ * If the file was not properly closed, this function repairs the file
+ * in place.  When the file cannot be opened for writing, such as on
+ * read-only media, it recovers in memory like jls_rd_open_readonly().
  * Call jls_rd_close() when done.
  */
 JLS_API int32_t jls_rd_open(struct jls_rd_s ** instance, const char * path);
 
+/**
+ * @brief Open a JLS file for reading without modifying it.
+ *
+ * @param[out] instance The new JLS read instance.
+ * @param path The JLS file path.
+ * @return 0 or error code.
+ *
+ * Closed files open exactly like jls_rd_open().  For a file that was
+ * not properly closed, the reader uses the chunks linked into the file
+ * like jls_rd_open_follow(), including jls_rd_follow_update().
+ * Opening walks to the end of each summary level, and statistics
+ * compute the missing upper level summaries from lower levels and
+ * sample data when queried.  Use this function for files on read-only
+ * media or files that another process may still be writing.
+ * Call jls_rd_close() when done.
+ */
+JLS_API int32_t jls_rd_open_readonly(struct jls_rd_s ** instance, const char * path);
+
+/**
+ * @brief Open a JLS file that may still be written to follow its contents.
+ *
+ * @param[out] instance The new JLS read instance.
+ * @param path The JLS file path.
+ * @return 0 or error code.
+ *
+ * Unlike jls_rd_open(), this function never repairs the file.  The
+ * reader only uses chunks that the writer has committed by linking
+ * them into the file.  The writer may be in this process or another
+ * process.  Call jls_rd_follow_update() to consume newly appended
+ * definitions, data, and summaries.  Statistics use the completed
+ * summaries and compute the remainder from lower levels and
+ * sample data.  Call jls_rd_close() when done.
+ */
+JLS_API int32_t jls_rd_open_follow(struct jls_rd_s ** instance, const char * path);
+
+/**
+ * @brief Consume chunks appended since the last update.
+ *
+ * @param self The JLS read instance from jls_rd_open_follow().
+ * @return 0, JLS_ERROR_NOT_SUPPORTED if not opened with
+ *      jls_rd_open_follow() or recovered in memory, or error code.
+ *
+ * The update resumes from the most recent chunk at each level, so the
+ * cost is proportional to the newly appended data.  On success,
+ * jls_rd_sources(), jls_rd_signals(), and jls_rd_fsr_length() reflect
+ * the new contents.
+ */
+JLS_API int32_t jls_rd_follow_update(struct jls_rd_s * self);
+
 /**
  * @brief Close a JLS file opened with jls_rd_open().
  * @param self The JLS read instance.
@@ -135,6 +188,126 @@ JLS_API int32_t jls_rd_fsr(struct jls_rd_s * self, uint16_t signal_id, int64_t s
 JLS_API int32_t jls_rd_fsr_f32(struct jls_rd_s * self, uint16_t signal_id, int64_t start_sample_id,
                                float * data, int64_t data_length);
 
+/**
+ * @brief Read fixed sample rate (FSR) data for multiple signals.
+ *
+ * @param self The reader instance.
+ * @param signal_ids The array of FSR signal ids which must all share
+ *      the same sample rate.
+ * @param signal_count The number of entries in signal_ids and data.
+ * @param start_sample_id The starting sample id to read for all signals.
+ * @param data_length The number of samples to read for each signal.
+ * @param[out] data The array of output buffers, one per signal, each
+ *      sized as required by jls_rd_fsr().
+ * @return 0 or error code
+ *
+ * This function produces the same output as calling jls_rd_fsr() once
+ * per signal.  However, it reads the interleaved data chunks in
+ * file offset order, which turns N passes into a single file sweep.
+ */
+JLS_API int32_t jls_rd_fsr_multi(struct jls_rd_s * self, const uint16_t * signal_ids, uint32_t signal_count,
+                                 int64_t start_sample_id, int64_t data_length, void * const * data);
+
+/**
+ * @brief Read fixed sample rate (FSR) data converted to float32.
+ *
+ * @param self The reader instance.
+ * @param signal_id The signal id, which may have any data type.
+ * @param start_sample_id The starting sample id to read.  The first
+ *      recorded sample is always 0.
+ * @param[out] data The samples read.  Integer data types, including
+ *      u1, u4, i4, i24 and u24, are unpacked and scaled by the
+ *      fixed-point factor 2 ** -q.
+ * @param data_length The number of samples to read.  data is
+ *      also at least this many entries (4 * data_length bytes).
+ * @return 0 or error code
+ */
+JLS_API int32_t jls_rd_fsr_as_f32(struct jls_rd_s * self, uint16_t signal_id, int64_t start_sample_id,
+                                  float * data, int64_t data_length);
+
+/**
+ * @brief Read fixed sample rate (FSR) data converted to float64.
+ *
+ * @param self The reader instance.
+ * @param signal_id The signal id, which may have any data type.
+ * @param start_sample_id The starting sample id to read.  The first
+ *      recorded sample is always 0.
+ * @param[out] data The samples read.  Integer data types, including
+ *      u1, u4, i4, i24 and u24, are unpacked and scaled by the
+ *      fixed-point factor 2 ** -q.
+ * @param data_length The number of samples to read.  data is
+ *      also at least this many entries (8 * data_length bytes).
+ * @return 0 or error code
+ */
+JLS_API int32_t jls_rd_fsr_as_f64(struct jls_rd_s * self, uint16_t signal_id, int64_t start_sample_id,
+                                  double * data, int64_t data_length);
+
+/**
+ * @brief Read fixed sample rate (FSR) u1, u4 or u8 data unpacked to u8.
+ *
+ * @param self The reader instance.
+ * @param signal_id The signal id with data type u1, u4 or u8.
+ * @param start_sample_id The starting sample id to read.  The first
+ *      recorded sample is always 0.
+ * @param[out] data The samples read, one sample per byte.
+ * @param data_length The number of samples to read.  data is
+ *      also at least this many bytes.
+ * @return 0, JLS_ERROR_PARAMETER_INVALID for other data types,
+ *      or error code.
+ *
+ * Unlike jls_rd_fsr(), any start_sample_id produces byte-aligned
+ * output that needs no further unpacking.
+ */
+JLS_API int32_t jls_rd_fsr_u8(struct jls_rd_s * self, uint16_t signal_id, int64_t start_sample_id,
+                              uint8_t * data, int64_t data_length);
+
+/// The opaque FSR read iterator instance.
+struct jls_rd_fsr_iter_s;
+
+/**
+ * @brief Open a streaming iterator over fixed sample rate (FSR) data.
+ *
+ * @param self The reader instance.
+ * @param signal_id The FSR signal id.
+ * @param start_sample_id The starting sample id to read.  The first
+ *      recorded sample is always 0.
+ * @param length The total number of samples to iterate.
+ * @param[out] iter The new iterator instance.
+ * @return 0 or error code.
+ *
+ * Unlike repeated calls to jls_rd_fsr(), the iterator validates the
+ * signal once and then follows the data chunks in file order, which
+ * avoids the per-call index traversal for sequential reads.
+ * Call jls_rd_fsr_iter_close() when done.
+ */
+JLS_API int32_t jls_rd_fsr_iter_open(struct jls_rd_s * self, uint16_t signal_id,
+                                     int64_t start_sample_id, int64_t length,
+                                     struct jls_rd_fsr_iter_s ** iter);
+
+/**
+ * @brief Get the next span of samples from the iterator.
+ *
+ * @param iter The iterator instance.
+ * @param[out] data The pointer to the samples, which are packed using
+ *      the signal's data type.  The first sample always starts at
+ *      byte 0, even for u1 and u4 data.  The data remains valid until
+ *      the next call to any jls_rd_* function on the same reader.
+ * @param[out] sample_id The sample id for data[0].  NULL to skip.
+ * @param[out] count The number of samples in data.
+ * @return 0, JLS_ERROR_EMPTY when the iteration is complete, or error code.
+ *
+ * Each span contains at most one data chunk worth of samples.
+ */
+JLS_API int32_t jls_rd_fsr_iter_next(struct jls_rd_fsr_iter_s * iter,
+                                     const void ** data, int64_t * sample_id, int64_t * count);
+
+/**
+ * @brief Close an iterator.
+ *
+ * @param iter The iterator instance from jls_rd_fsr_iter_open().
+ */
+JLS_API void jls_rd_fsr_iter_close(struct jls_rd_fsr_iter_s * iter);
+
 /**
  * @brief Read the statistics data for a fixed sampling rate signal.
  *
@@ -162,11 +335,210 @@ JLS_API int32_t jls_rd_fsr_f32(struct jls_rd_s * self, uint16_t signal_id, int64
  * perfect for waveform display, but perhaps not suitable for other use
  * cases.  If you need sample accurate statistics over multiple
  * increments, call this function repeatedly with data_length 1.
+ *
+ * For fixed-point data types, the statistics are in unscaled integer
+ * units at every level, like the stored summaries.  Multiply by
+ * 2 ** -q to convert them to the units of jls_rd_fsr_as_f64().
  */
 JLS_API int32_t jls_rd_fsr_statistics(struct jls_rd_s * self, uint16_t signal_id,
                                       int64_t start_sample_id, int64_t increment,
                                       double * data, int64_t data_length);
 
+/**
+ * @brief Read the statistics data including optional summary fields.
+ *
+ * @param self The reader instance.
+ * @param signal_id The FSR signal.
+ * @param start_sample_id The starting sample id to read.
+ * @param increment The number of samples that form a single output summary.
+ * @param fields The jls_summary_field_e optional fields to return, which
+ *      must be stored for this signal, see jls_signal_def_s.summary_fields.
+ * @param[out] data The statistics information.  Each entry contains
+ *      the JLS_SUMMARY_FSR_COUNT values from jls_rd_fsr_statistics()
+ *      followed by the selected fields in bit order.
+ * @param data_length The number of statistics points to populate.
+ * @return 0, JLS_ERROR_NOT_SUPPORTED if a field is not stored, or error code.
+ *
+ * Like jls_rd_fsr_statistics(), this function computes from the
+ * summaries and only reads sample data at the boundaries.
+ */
+JLS_API int32_t jls_rd_fsr_statistics_ext(struct jls_rd_s * self, uint16_t signal_id,
+                                          int64_t start_sample_id, int64_t increment, uint32_t fields,
+                                          double * data, int64_t data_length);
+
+/**
+ * @brief Set the number of threads for large statistics requests.
+ *
+ * @param self The reader instance.
+ * @param thread_count The number of worker threads, up to 64.
+ *      0 or 1 (default) computes statistics on the calling thread.
+ * @return 0 or error code.
+ *
+ * Each worker opens its own reader on the same file.  When a
+ * jls_rd_fsr_statistics() or jls_rd_fsr_statistics_ext() request spans
+ * enough summary entries, the reader splits the output into contiguous
+ * parts, one per worker, and blocks until all complete.  The result is
+ * identical to the single-threaded result.
+ */
+JLS_API int32_t jls_rd_threads_set(struct jls_rd_s * self, uint32_t thread_count);
+
+/**
+ * @brief Compute quantiles over a sample window.
+ *
+ * @param self The reader instance.
+ * @param signal_id The FSR signal, which must store summary histograms,
+ *      see jls_signal_def_s.summary_hist_bins.
+ * @param start_sample_id The starting sample id.
+ * @param length The number of samples in the window.
+ * @param q The quantiles to compute, each from 0.0 to 1.0.
+ * @param[out] data The quantile values, one for each q.  NaN when the
+ *      window contains no finite samples.
+ * @param q_count The number of q and data entries.
+ * @return 0, JLS_ERROR_NOT_SUPPORTED if histograms are not stored, or error code.
+ *
+ * This function merges the histograms from the coarsest summaries
+ * that cover the window and only reads sample data at the boundaries.
+ * The result interpolates linearly within the matching histogram bin,
+ * so the accuracy is limited by the bin width.  The window minimum
+ * and maximum bound the result.  f32 summaries round bin counts
+ * above 2^24, see JLS_SUMMARY_HIST_BINS_MAX.  For fixed-point data
+ * types, the histogram range and the quantiles are in unscaled integer
+ * units, like jls_rd_fsr_statistics().
+ */
+JLS_API int32_t jls_rd_fsr_quantiles(struct jls_rd_s * self, uint16_t signal_id,
+                                     int64_t start_sample_id, int64_t length,
+                                     const double * q, double * data, uint32_t q_count);
+
+/// The threshold search predicates for jls_rd_fsr_find().
+enum jls_rd_find_e {
+    JLS_RD_FIND_GT = 0,     ///< A sample greater than the threshold.
+    JLS_RD_FIND_LT = 1,     ///< A sample less than the threshold.
+    /**
+     * @brief A threshold crossing.
+     *
+     * A sample that is on the other side of the threshold than the
+     * previous sample, where the sides are greater than the threshold
+     * and less than or equal to the threshold.
+     */
+    JLS_RD_FIND_CROSS = 2,
+};
+
+/**
+ * @brief Find the first sample that matches a threshold predicate.
+ *
+ * @param self The reader instance.
+ * @param signal_id The FSR signal.
+ * @param start_sample_id The first sample id to search.
+ * @param end_sample_id The sample id just past the search window.
+ * @param predicate The jls_rd_find_e predicate.
+ * @param threshold The threshold value.
+ * @param[out] sample_id The first matching sample id.
+ * @return 0, JLS_ERROR_NOT_FOUND if no sample matches, or error code.
+ *
+ * This function descends the summary levels and skips every summary
+ * entry whose [min, max] range cannot match the predicate, so it only
+ * reads sample data for the matching entry and the window boundaries.
+ * Non-finite samples never match.  For fixed-point data types, the
+ * threshold is in unscaled integer units, like jls_rd_fsr_statistics().
+ */
+JLS_API int32_t jls_rd_fsr_find(struct jls_rd_s * self, uint16_t signal_id,
+                                int64_t start_sample_id, int64_t end_sample_id,
+                                uint8_t predicate, double threshold, int64_t * sample_id);
+
+/// The opaque FSR find iterator instance.
+struct jls_rd_fsr_find_iter_s;
+
+/**
+ * @brief Open an iterator over the intervals that match a threshold predicate.
+ *
+ * @param self The reader instance.
+ * @param signal_id The FSR signal.
+ * @param start_sample_id The first sample id to search.
+ * @param end_sample_id The sample id just past the search window.
+ * @param predicate The jls_rd_find_e predicate.
+ * @param threshold The threshold value, see jls_rd_fsr_find().
+ * @param[out] iter The new iterator instance.
+ * @return 0 or error code.
+ *
+ * For JLS_RD_FIND_GT and JLS_RD_FIND_LT, each interval contains
+ * consecutive matching samples.  For JLS_RD_FIND_CROSS, each interval
+ * starts at a crossing and ends at the next crossing.
+ * Call jls_rd_fsr_find_iter_close() when done.
+ */
+JLS_API int32_t jls_rd_fsr_find_iter_open(struct jls_rd_s * self, uint16_t signal_id,
+                                          int64_t start_sample_id, int64_t end_sample_id,
+                                          uint8_t predicate, double threshold,
+                                          struct jls_rd_fsr_find_iter_s ** iter);
+
+/**
+ * @brief Get the next matching interval.
+ *
+ * @param iter The iterator instance.
+ * @param[out] interval_start The first sample id in the interval.
+ * @param[out] interval_end The sample id just past the interval.
+ * @return 0, JLS_ERROR_EMPTY when the iteration is complete, or error code.
+ */
+JLS_API int32_t jls_rd_fsr_find_iter_next(struct jls_rd_fsr_find_iter_s * iter,
+                                          int64_t * interval_start, int64_t * interval_end);
+
+/**
+ * @brief Close a find iterator.
+ *
+ * @param iter The iterator instance from jls_rd_fsr_find_iter_open().
+ */
+JLS_API void jls_rd_fsr_find_iter_close(struct jls_rd_fsr_find_iter_s * iter);
+
+/**
+ * @brief The virtual signal operations.
+ *
+ * All operations apply y = gain * f(x) + offset.
+ */
+enum jls_rd_virtual_op_e {
+    JLS_RD_VIRTUAL_OP_SCALE = 0,     ///< f(x) = x0
+    JLS_RD_VIRTUAL_OP_SUM = 1,       ///< f(x) = x0 + x1
+    JLS_RD_VIRTUAL_OP_PRODUCT = 2,   ///< f(x) = x0 * x1
+    JLS_RD_VIRTUAL_OP_INTEGRAL = 3,  ///< f(x)[n] = sum(x0[0:n + 1]) / sample_rate
+    JLS_RD_VIRTUAL_OP_DIFF = 4,      ///< f(x) = x0 - x1
+};
+
+/// The virtual signal definition.
+struct jls_rd_virtual_def_s {
+    uint16_t signal_id;         ///< The unused signal id for the virtual signal.
+    uint8_t op;                 ///< The jls_rd_virtual_op_e operation.
+    uint16_t source_ids[2];     ///< The input FSR signal ids, [1] only for SUM, DIFF and PRODUCT.
+    double gain;                ///< The output gain.
+    double offset;              ///< The output offset.
+    const char * name;          ///< The signal name.
+    const char * units;         ///< The signal units.
+};
+
+/**
+ * @brief Define a virtual FSR signal computed from existing FSR signals.
+ *
+ * @param self The reader instance.
+ * @param def The virtual signal definition.  The sources may be
+ *      signals in the file or previously defined virtual signals,
+ *      and they must share the same sample rate.
+ * @return 0 or error code.
+ *
+ * Virtual signals are float64 FSR signals that exist only for this
+ * reader instance.  They are included in jls_rd_signals() and support
+ * jls_rd_signal(), jls_rd_fsr_length(), jls_rd_fsr(), jls_rd_fsr_as_f32(),
+ * jls_rd_fsr_as_f64() and jls_rd_fsr_statistics().
+ *
+ * jls_rd_fsr_statistics() is exact for every operation.  SCALE maps
+ * the source summaries.  SUM, DIFF, PRODUCT and INTEGRAL compute from
+ * the sample data, so their cost grows with the window length.  Use a
+ * writer-side derived signal when you need fast statistics over long
+ * windows.
+ *
+ * INTEGRAL sums the finite samples.  Each read computes the starting
+ * value from the stored sum when the source has the
+ * JLS_SUMMARY_FIELD_SUM and JLS_SUMMARY_FIELD_F64 summary fields.
+ * Otherwise, it reads all source samples before the start.
+ */
+JLS_API int32_t jls_rd_virtual_def(struct jls_rd_s * self, const struct jls_rd_virtual_def_s * def);
+
 /**
  * @brief The function called for each annotation.
  *
@@ -291,6 +663,25 @@ JLS_API int32_t jls_rd_timestamp_to_sample_id(struct jls_rd_s * self, uint16_t s
  */
 JLS_API int32_t jls_rd_tmap_get(struct jls_rd_s * self, uint16_t signal_id, size_t index, struct jls_utc_summary_entry_s * entry);
 
+/**
+ * @brief Enable or disable the reader instrumentation counters.
+ *
+ * @param self The reader instance.
+ * @param enable Nonzero to enable and reset all counters to zero.
+ *      0 to disable and free the counters.
+ * @return 0 or error code.
+ */
+JLS_API int32_t jls_rd_stats_enable(struct jls_rd_s * self, int enable);
+
+/**
+ * @brief Get a snapshot of the reader instrumentation counters.
+ *
+ * @param self The reader instance.
+ * @param[out] stats The counter values.
+ * @return 0, JLS_ERROR_UNAVAILABLE if not enabled, or error code.
+ */
+JLS_API int32_t jls_rd_stats(struct jls_rd_s * self, struct jls_stats_s * stats);
+
 JLS_CPP_GUARD_END
 
 /** @} */
@@ -0,0 +1,77 @@
+/*
+ * Copyright 2026 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/**
+ * @file
+ *
+ * @brief JLS instrumentation counters.
+ */
+
+#ifndef JLS_STATS_H__
+#define JLS_STATS_H__
+
+#include "jls/cmacro.h"
+#include <stdint.h>
+
+/**
+ * @ingroup jls
+ * @defgroup jls_stats Instrumentation counters
+ *
+ * @brief Opt-in hot-path counters for readers and writers.
+ *
+ * Counters are disabled by default and cost nothing until enabled
+ * with jls_rd_stats_enable(), jls_wr_stats_enable() or
+ * jls_twr_stats_enable().  Retrieve a snapshot with the matching
+ * jls_rd_stats(), jls_wr_stats() or jls_twr_stats().
+ *
+ * All durations are in JLS time units, see jls/time.h.
+ *
+ * @{
+ */
+
+JLS_CPP_GUARD_START
+
+/// The number of per-tag chunk counters, indexed by jls_tag_e.
+#define JLS_STATS_TAG_COUNT (256)
+
+/// The number of queue latency histogram bins.
+#define JLS_STATS_LATENCY_BINS (24)
+
+/**
+ * @brief The reader and writer instrumentation counters.
+ */
+struct jls_stats_s {
+    uint64_t chunk_rd[JLS_STATS_TAG_COUNT];  ///< Chunk payloads read, by tag.
+    uint64_t chunk_wr[JLS_STATS_TAG_COUNT];  ///< Chunks written, by tag.
+    uint64_t header_rd;             ///< Chunk headers read from the file.
+    uint64_t bytes_rd;              ///< Total bytes read, headers and payloads.
+    uint64_t bytes_wr;              ///< Total bytes written, headers and payloads.
+    uint64_t seeks;                 ///< File seeks that changed the file position.
+    uint64_t writes;                ///< Writer: write calls issued to the file.
+    int64_t crc_time;               ///< Time spent computing payload CRC32C.
+    int64_t summary_time;           ///< Writer: time spent computing FSR summaries.
+    uint64_t fsr_statistics;        ///< Reader: jls_rd_fsr_statistics() calls.
+    int64_t fsr_statistics_time;    ///< Reader: time spent in jls_rd_fsr_statistics().
+    uint64_t fsr_statistics_level0; ///< Reader: statistics computed from sample data.
+    uint64_t fsr_reconstructed;     ///< Reader: omitted data chunks reconstructed.
+};
+
+JLS_CPP_GUARD_END
+
+/** @} */
+
+#endif  /* JLS_STATS_H__ */
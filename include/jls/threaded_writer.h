@@ -27,6 +27,7 @@
 #include <stdint.h>
 #include "jls/cmacro.h"
 #include "jls/format.h"
+#include "jls/writer.h"
 
 /**
  * @ingroup jls
@@ -52,6 +53,54 @@ enum jls_twr_flag_e {
     JLS_TWR_FLAG_DROP_ON_OVERFLOW = (1 << 0),   ///< Drop on overflow when set, block otherwise.
 };
 
+/**
+ * @brief The threaded writer instrumentation counters.
+ *
+ * latency_histogram counts the time each message waited in the ring
+ * buffer before the writer thread started processing it.  Bin 0 counts
+ * latencies under 1 microsecond, and bin k counts latencies in
+ * [2^(k-1), 2^k) microseconds.  The last bin also counts all
+ * longer latencies.
+ */
+struct jls_twr_stats_s {
+    struct jls_stats_s wr;      ///< The underlying writer counters.
+    uint64_t msg_count;         ///< Messages processed by the writer thread.
+    uint32_t ring_size;         ///< The message ring buffer size in bytes.
+    uint32_t ring_high_water;   ///< The maximum ring buffer usage in bytes.
+    uint64_t dropped_msgs;      ///< Messages dropped due to a full ring buffer.
+    uint64_t dropped_samples;   ///< FSR samples dropped due to a full ring buffer.
+    uint64_t latency_histogram[JLS_STATS_LATENCY_BINS];  ///< The queue latency histogram.
+    int64_t latency_max;        ///< The maximum queue latency in JLS time units.
+    uint64_t syncs;             ///< Durable syncs to the storage device.
+    int64_t sync_time;          ///< Total time spent in durable syncs.
+};
+
+/**
+ * @brief The threaded writer durability modes.
+ *
+ * @see jls_twr_durability()
+ */
+enum jls_twr_durability_e {
+    /// Each flush persists the file to the storage device (default).
+    JLS_TWR_DURABILITY_FLUSH = 0,
+    /// Never persist before close, flushes only write to the OS.
+    JLS_TWR_DURABILITY_NONE = 1,
+    /// Persist periodically from the writer thread, flushes only write to the OS.
+    JLS_TWR_DURABILITY_PERIODIC = 2,
+};
+
+/**
+ * @brief The function called when a flush completes.
+ *
+ * @param user_data The arbitrary user data.
+ * @param flush_id The flush id from jls_twr_flush_async().
+ * @param rc 0 or error code.
+ *
+ * The writer thread calls this function, which must not block and
+ * must not call the threaded writer.
+ */
+typedef void (*jls_twr_flush_cbk_fn)(void * user_data, uint64_t flush_id, int32_t rc);
+
 /**
  * @brief Open a JLS file for writing.
  *
@@ -63,6 +112,40 @@ enum jls_twr_flag_e {
  */
 JLS_API int32_t jls_twr_open(struct jls_twr_s ** instance, const char * path);
 
+/**
+ * @brief Open an existing JLS file to append more data.
+ *
+ * @param[out] instance The JLS writer instance.
+ * @param path The JLS file path.
+ * @return 0 or error code.
+ *
+ * Call jls_twr_close() when done.
+ * @see jls_wr_open_append()
+ */
+JLS_API int32_t jls_twr_open_append(struct jls_twr_s ** instance, const char * path);
+
+/**
+ * @brief Open a multi-file dataset for writing.
+ *
+ * @param[out] instance The JLS writer instance.
+ * @param path The dataset path, such as "capture.jls".  The segments
+ *      are written to jls_ds_segment_path() files, such as
+ *      "capture_00000.jls", "capture_00001.jls", ...
+ * @param segment_size Roll to the next segment once the current segment
+ *      reaches this size in bytes.  0 to disable.
+ * @param segment_duration Roll to the next segment once any FSR signal
+ *      has written this duration, in JLS time units, measured in
+ *      samples at the signal's sample rate.  0 to disable.
+ * @return 0 or error code.
+ *
+ * Each segment is a complete JLS file with the same source and signal
+ * definitions.  Use jls_ds_open() to read the segments as one dataset.
+ * Derived signals are not supported.
+ * Call jls_twr_close() when done.
+ */
+JLS_API int32_t jls_twr_open_dataset(struct jls_twr_s ** instance, const char * path,
+                                     int64_t segment_size, int64_t segment_duration);
+
 /**
  * @brief Close a JLS file.
  *
@@ -97,6 +180,63 @@ JLS_API int32_t jls_twr_flags_set(struct jls_twr_s * self, uint32_t flags);
  */
 JLS_API int32_t jls_twr_flush(struct jls_twr_s * self);
 
+/**
+ * @brief Flush a JLS file without waiting.
+ *
+ * @param self The JLS writer instance from jls_twr_open().
+ * @param cbk_fn The function called when the flush completes, or NULL.
+ * @param cbk_user_data The arbitrary data provided to cbk_fn.
+ * @param[out] flush_id The flush id, which increases with each flush.
+ *      NULL to ignore.
+ * @return 0 or error code.
+ *
+ * The writer thread completes the flush after writing all prior
+ * messages.  Flushes that queue together share a single sync to the
+ * storage device.  The jls_twr_durability() mode determines whether
+ * the flush persists to the storage device.
+ */
+JLS_API int32_t jls_twr_flush_async(struct jls_twr_s * self, jls_twr_flush_cbk_fn cbk_fn, void * cbk_user_data,
+                                    uint64_t * flush_id);
+
+/**
+ * @brief Configure when the writer persists the file to the storage device.
+ *
+ * @param self The JLS writer instance from jls_twr_open().
+ * @param mode The jls_twr_durability_e mode.
+ * @param period For JLS_TWR_DURABILITY_PERIODIC, the maximum duration
+ *      in JLS time units between syncs, or 0 to disable.
+ * @param size For JLS_TWR_DURABILITY_PERIODIC, the maximum bytes
+ *      written between syncs, or 0 to disable.
+ * @return 0 or error code.
+ *
+ * Periodic syncs run on the writer thread and use the lighter data
+ * sync, so the threads adding messages never wait for the storage
+ * device.  Each periodic sync also writes any jls_twr_write_buffer()
+ * data, so readers following the file see it.
+ */
+JLS_API int32_t jls_twr_durability(struct jls_twr_s * self, int32_t mode, int64_t period, int64_t size);
+
+/**
+ * @brief Configure the periodic recovery checkpoints.
+ *
+ * @param self The JLS writer instance from jls_twr_open().
+ * @param interval The minimum number of bytes written between
+ *      checkpoints, or 0 to disable.
+ * @return 0 or error code.
+ * @see jls_wr_checkpoint_interval()
+ */
+JLS_API int32_t jls_twr_checkpoint_interval(struct jls_twr_s * self, int64_t interval);
+
+/**
+ * @brief Configure the write-behind buffer.
+ *
+ * @param self The JLS writer instance from jls_twr_open().
+ * @param size The buffer size in bytes, or 0 to disable.
+ * @return 0 or error code.
+ * @see jls_wr_write_buffer()
+ */
+JLS_API int32_t jls_twr_write_buffer(struct jls_twr_s * self, uint32_t size);
+
 /**
  * @brief Define a new source.
  *
@@ -118,6 +258,18 @@ JLS_API int32_t jls_twr_source_def(struct jls_twr_s * self, const struct jls_sou
  */
 JLS_API int32_t jls_twr_signal_def(struct jls_twr_s * self, const struct jls_signal_def_s * signal);
 
+/**
+ * @brief Define a new signal computed by the writer from other signals.
+ *
+ * @param self The JLS writer instance.
+ * @param signal The signal definition.
+ * @param derived The derived signal definition.
+ * @return 0 or error code.
+ * @see jls_wr_signal_def_derived()
+ */
+JLS_API int32_t jls_twr_signal_def_derived(struct jls_twr_s * self, const struct jls_signal_def_s * signal,
+        const struct jls_wr_derived_def_s * derived);
+
 /**
  * @brief Add arbitrary user data.
  *
@@ -213,6 +365,26 @@ JLS_API int32_t jls_twr_annotation(struct jls_twr_s * self, uint16_t signal_id,
  */
 JLS_API int32_t jls_twr_utc(struct jls_twr_s * self, uint16_t signal_id, int64_t sample_id, int64_t utc);
 
+/**
+ * @brief Enable or disable the threaded writer instrumentation counters.
+ *
+ * @param self The JLS writer instance from jls_twr_open().
+ * @param enable Nonzero to enable and reset all counters to zero,
+ *      including the underlying writer counters.
+ *      0 to disable and free the counters.
+ * @return 0 or error code.
+ */
+JLS_API int32_t jls_twr_stats_enable(struct jls_twr_s * self, int enable);
+
+/**
+ * @brief Get a snapshot of the threaded writer instrumentation counters.
+ *
+ * @param self The JLS writer instance from jls_twr_open().
+ * @param[out] stats The counter values.
+ * @return 0, JLS_ERROR_UNAVAILABLE if not enabled, or error code.
+ */
+JLS_API int32_t jls_twr_stats(struct jls_twr_s * self, struct jls_twr_stats_s * stats);
+
 // todo jls_twr_vsr_f32
 //JLS_API int32_t jls_twr_vsr_f32(struct jls_twr_s * self, uint16_t ts_id, int64_t timestamp, uint32_t data, uint32_t size);
 
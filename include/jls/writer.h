@@ -27,6 +27,7 @@
 #include <stdint.h>
 #include "jls/statistics.h"
 #include "jls/format.h"
+#include "jls/stats.h"
 
 /**
  * @ingroup jls
@@ -53,6 +54,25 @@ struct jls_wr_s;
  */
 JLS_API int32_t jls_wr_open(struct jls_wr_s ** instance, const char * path);
 
+/**
+ * @brief Open an existing JLS file to append more data.
+ *
+ * @param[out] instance The JLS writer instance.
+ * @param path The JLS file path.
+ * @return 0 or error code.
+ *
+ * The existing sources, signals, and user data remain defined.  Sample
+ * data continues from the last sample_id of each FSR signal, and
+ * annotations, UTC entries, and user data append to their existing
+ * lists.  The partial chunks that jls_wr_close() wrote are reloaded
+ * and replaced, so the cost is proportional to the number of summary
+ * levels, not the file size.  Files that were not closed are first
+ * repaired, see jls_rd_open().
+ *
+ * Call jls_wr_close() when done.
+ */
+JLS_API int32_t jls_wr_open_append(struct jls_wr_s ** instance, const char * path);
+
 /**
  * @brief Close a JLS file.
  *
@@ -69,6 +89,45 @@ JLS_API int32_t jls_wr_close(struct jls_wr_s * self);
  */
 JLS_API int32_t jls_wr_flush(struct jls_wr_s * self);
 
+/// The default jls_wr_checkpoint_interval() in bytes.
+#define JLS_WR_CHECKPOINT_INTERVAL_DEFAULT (64LL * 1024 * 1024)
+
+/**
+ * @brief Configure the periodic recovery checkpoints.
+ *
+ * @param self The JLS writer instance from jls_wr_open().
+ * @param interval The minimum number of bytes written between
+ *      checkpoints, or 0 to disable.  The default is
+ *      JLS_WR_CHECKPOINT_INTERVAL_DEFAULT.
+ * @return 0 or error code.
+ *
+ * A checkpoint stores the partial index and summary state of every
+ * track, which otherwise only exists in memory until the chunks fill.
+ * When a file is not closed, jls_rd_open() restores the most recent
+ * checkpoint and only summarizes the data written after it, rather
+ * than repairing from the start of each signal.  Files created by
+ * earlier versions and then opened with jls_wr_open_append()
+ * do not support checkpoints.
+ */
+JLS_API int32_t jls_wr_checkpoint_interval(struct jls_wr_s * self, int64_t interval);
+
+/**
+ * @brief Configure the write-behind buffer.
+ *
+ * @param self The JLS writer instance from jls_wr_open().
+ * @param size The buffer size in bytes, or 0 to disable (default).
+ *      Sizes of several MiB work well.
+ * @return 0 or error code.
+ *
+ * By default, each chunk header, payload and footer is a separate
+ * file write.  The write-behind buffer coalesces consecutive chunks
+ * into large aligned writes, and preallocates file space in large
+ * increments when supported.  Readers following the file, such as
+ * jls_rd_open_follow(), only see the buffered chunks after
+ * jls_wr_flush().  An unclosed file loses the buffered chunks.
+ */
+JLS_API int32_t jls_wr_write_buffer(struct jls_wr_s * self, uint32_t size);
+
 /**
  * @brief Define a new source.
  *
@@ -90,6 +149,56 @@ JLS_API int32_t jls_wr_source_def(struct jls_wr_s * self, const struct jls_sourc
  */
 JLS_API int32_t jls_wr_signal_def(struct jls_wr_s * self, const struct jls_signal_def_s * signal);
 
+/// The maximum number of input signals for a derived signal.
+#define JLS_WR_DERIVED_SOURCE_MAX (4)
+
+/**
+ * @brief The derived signal operations.
+ *
+ * The derived signal output is y = gain * f(x) + offset.
+ */
+enum jls_wr_derived_op_e {
+    JLS_WR_DERIVED_OP_SUM = 0,          ///< f(x) = x0 + x1 + ...
+    JLS_WR_DERIVED_OP_PRODUCT = 1,      ///< f(x) = x0 * x1 * ...
+    JLS_WR_DERIVED_OP_INTEGRAL = 2,     ///< f(x) = running sum(x0) / sample_rate, NaN skipped.
+};
+
+/**
+ * @brief The derived signal definition.
+ */
+struct jls_wr_derived_def_s {
+    uint8_t op;                         ///< The jls_wr_derived_op_e operation.
+    uint8_t source_count;               ///< The number of source_ids: 1 for INTEGRAL, else >= 2.
+    uint16_t source_ids[JLS_WR_DERIVED_SOURCE_MAX];  ///< The input FSR signal ids.
+    double gain;                        ///< The output gain.
+    double offset;                      ///< The output offset.
+};
+
+/**
+ * @brief Define a new signal computed by the writer from other signals.
+ *
+ * @param self The JLS writer instance.
+ * @param signal The signal definition, which must be FSR with
+ *      JLS_DATATYPE_F32 or JLS_DATATYPE_F64.
+ * @param derived The derived signal definition.  NULL is equivalent
+ *      to jls_wr_signal_def().
+ * @return 0 or error code.
+ *
+ * The source signals must already be defined with the same sample_rate.
+ * Sources may be other derived signals.
+ * As aligned sample data arrives for all sources through jls_wr_fsr(),
+ * the writer computes the derived samples and stores them as an ordinary
+ * FSR signal with its own summaries.  Readers then get exact statistics,
+ * such as mean power, at every zoom level.  The caller must not write
+ * the derived signal directly.
+ *
+ * The derived signal starts at the latest first sample_id of its sources.
+ * Source sample skips produce NaN, and source duplicates are ignored.
+ * Any unaligned source data remaining at jls_wr_close() is discarded.
+ */
+JLS_API int32_t jls_wr_signal_def_derived(struct jls_wr_s * self, const struct jls_signal_def_s * signal,
+        const struct jls_wr_derived_def_s * derived);
+
 /**
  * @brief Add arbitrary user data.
  *
@@ -184,6 +293,25 @@ JLS_API int32_t jls_wr_annotation(struct jls_wr_s * self,
  */
 JLS_API int32_t jls_wr_utc(struct jls_wr_s * self, uint16_t signal_id, int64_t sample_id, int64_t utc);
 
+/**
+ * @brief Enable or disable the writer instrumentation counters.
+ *
+ * @param self The writer instance.
+ * @param enable Nonzero to enable and reset all counters to zero.
+ *      0 to disable and free the counters.
+ * @return 0 or error code.
+ */
+JLS_API int32_t jls_wr_stats_enable(struct jls_wr_s * self, int enable);
+
+/**
+ * @brief Get a snapshot of the writer instrumentation counters.
+ *
+ * @param self The writer instance.
+ * @param[out] stats The counter values.
+ * @return 0, JLS_ERROR_UNAVAILABLE if not enabled, or error code.
+ */
+JLS_API int32_t jls_wr_stats(struct jls_wr_s * self, struct jls_stats_s * stats);
+
 // todo jls_wr_vsr_f32
 // JLS_API int32_t jls_wr_vsr_f32(struct jls_wr_s * self, uint16_t ts_id, int64_t timestamp, uint32_t data, uint32_t size);
 
@@ -50,6 +50,46 @@ extern "C" {
  */
 int32_t jls_bit_shift_array_right(uint8_t bits, void * data, size_t size);
 
+/**
+ * @brief Copy a packed bit array to an arbitrary destination bit offset.
+ *
+ * @param[inout] dst The destination array.
+ * @param dst_bit The destination starting bit offset.  Bits in dst before
+ *      dst_bit and after dst_bit + bits are preserved.
+ * @param src The byte-aligned source array.
+ * @param bits The number of bits to copy.
+ */
+void jls_bit_copy(void * dst, size_t dst_bit, const void * src, size_t bits);
+
+/**
+ * @brief Copy a packed bit array between arbitrary bit offsets.
+ *
+ * @param[inout] dst The destination array.
+ * @param dst_bit The destination starting bit offset.  Bits in dst before
+ *      dst_bit and after dst_bit + bits are preserved.
+ * @param src The source array, which must not overlap dst.
+ * @param src_bit The source starting bit offset.
+ * @param bits The number of bits to copy.
+ *
+ * Only reads the source bytes that contain the copied bits.
+ */
+void jls_bit_copy_offset(void * dst, size_t dst_bit, const void * src, size_t src_bit, size_t bits);
+
+/**
+ * @brief Unpack u1 or u4 samples to one u8 per sample.
+ *
+ * @param[out] dst The destination array of count bytes.
+ * @param src The packed source array.
+ * @param src_bit The bit offset of the first sample in src, which must
+ *      be a multiple of entry_size_bits.
+ * @param entry_size_bits The sample size, which is 1, 4 or 8.
+ *      8 copies the samples unmodified.
+ * @param count The number of samples.
+ * @return 0 or JLS_ERROR_PARAMETER_INVALID.
+ */
+int32_t jls_bit_unpack_u8(uint8_t * dst, const void * src, size_t src_bit,
+                          uint8_t entry_size_bits, size_t count);
+
 
 /** @} */
 
@@ -108,6 +108,9 @@ int32_t jls_buf_rd_skip(struct jls_buf_s * self, size_t count);
 int32_t jls_buf_rd_u8(struct jls_buf_s * self, uint8_t * value);
 int32_t jls_buf_rd_u16(struct jls_buf_s * self, uint16_t * value);
 int32_t jls_buf_rd_u32(struct jls_buf_s * self, uint32_t * value);
+int32_t jls_buf_rd_f32(struct jls_buf_s * self, float * value);
+int32_t jls_buf_rd_i64(struct jls_buf_s * self, int64_t * value);
+int32_t jls_buf_rd_bin(struct jls_buf_s * self, void * data, uint32_t data_size);
 int32_t jls_buf_rd_str(struct jls_buf_s * self, const char ** value);
 
 
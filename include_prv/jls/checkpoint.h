@@ -0,0 +1,102 @@
+/*
+ * Copyright 2026 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/**
+ * @file
+ *
+ * @brief JLS writer checkpoints for recovery.
+ */
+
+#ifndef JLS_CHECKPOINT_H__
+#define JLS_CHECKPOINT_H__
+
+#include "jls/cmacro.h"
+#include "jls/core.h"
+#include <stdint.h>
+
+/**
+ * @ingroup jls
+ * @defgroup jls_checkpoint JLS checkpoint.
+ *
+ * @brief Persist the writer track state to speed up recovery.
+ *
+ * The writer keeps the partial index and summary for each level in
+ * memory until they fill.  A file that is not closed loses this state,
+ * and jls_rd_open() must rebuild it from the data chunks.  A checkpoint
+ * chunk stores the state of every track.  A single checkpoint head
+ * chunk near the start of the file holds the most recent checkpoint
+ * offset, which is cleared when the file is closed.
+ *
+ * @{
+ */
+
+JLS_CPP_GUARD_START
+
+/**
+ * @brief Write the checkpoint head chunk.
+ *
+ * @param self The core instance.
+ * @return 0 or error code.
+ *
+ * Call once when creating a file, immediately after the signal 0
+ * definition, so that jls_core_scan_initial() finds it.  Earlier
+ * readers expect the user data, source and signal definitions within
+ * the first three chunks.
+ */
+int32_t jls_core_checkpoint_head_wr(struct jls_core_s * self);
+
+/**
+ * @brief Write a checkpoint with the current writer track state.
+ *
+ * @param self The core instance.
+ * @return 0 or error code.  Files without a checkpoint head, such as
+ *      those created by earlier versions, silently skip checkpoints.
+ */
+int32_t jls_core_checkpoint_wr(struct jls_core_s * self);
+
+/**
+ * @brief Clear the most recent checkpoint offset.
+ *
+ * @param self The core instance.
+ * @return 0 or error code.
+ *
+ * jls_core_wr_end() calls this function.  Closed files do not need
+ * recovery, and a stale checkpoint must not apply to appended data.
+ */
+int32_t jls_core_checkpoint_clear(struct jls_core_s * self);
+
+/**
+ * @brief Recover the summaries of a file that was not closed.
+ *
+ * @param self The core instance, with the file open for append and
+ *      truncated to the last complete chunk.
+ * @return 0, JLS_ERROR_NOT_FOUND if the file has no checkpoint,
+ *      or error code.
+ *
+ * Restores the most recent checkpoint, then summarizes only the FSR,
+ * annotation, and UTC data chunks written after it.  The chunk
+ * sequences are validated before any write.  A validation error
+ * leaves the file unmodified, and the caller should then perform the
+ * full repair.  On success, the caller must write the end chunk.
+ */
+int32_t jls_core_checkpoint_recover(struct jls_core_s * self);
+
+JLS_CPP_GUARD_END
+
+/** @} */
+
+#endif  /* JLS_CHECKPOINT_H__ */
@@ -27,6 +27,7 @@
 #include "jls/format.h"
 #include "jls/raw.h"
 #include "jls/buffer.h"
+#include "jls/statistics.h"
 #include <stdbool.h>
 #include <stdint.h>
 #include <stddef.h>
@@ -70,6 +71,39 @@ struct jls_core_fsr_level_s {
     struct jls_fsr_f32_summary_s * summary;  // either jls_fsr_f32_summary_s or jls_fsr_f64_summary_s
 };
 
+/**
+ * @brief A summary entry accumulator, including the optional fields.
+ *
+ * stats.k counts the finite samples.
+ * @see jls_summary_field_e
+ */
+struct jls_core_fsr_entry_s {
+    struct jls_statistics_s stats;
+    double sum;         // sum of finite samples
+    double sum_c;       // sum compensation term
+    double sum_sq;      // sum of squares of finite samples
+    double sum_sq_c;    // sum_sq compensation term
+    double first;       // first finite sample, NaN if none
+    double last;        // last finite sample, NaN if none
+};
+
+/**
+ * @brief The streaming summary cascade state for one level.
+ *
+ * Each completed level N-1 entry merges into the level N accumulator.
+ * Once summary_decimate_factor entries merge, the level N entry is
+ * stored past the level N summary entry_count as pending and then
+ * merges into level N+1.  jls_core_fsr_summaryN() commits the
+ * pending entries after the level N-1 summary chunk is written.
+ */
+struct jls_core_fsr_cascade_s {
+    struct jls_core_fsr_entry_s accum;  // merged with jls_core_fsr_entry_combine()
+    uint32_t entries;   // level N-1 entries in accum
+    uint32_t fed;       // level N-1 entries merged since the last commit
+    uint32_t pending;   // completed level N entries not yet committed
+    double hist[JLS_SUMMARY_HIST_BINS_MAX];  // histogram counts for accum, level 1 for scratch
+};
+
 struct jls_core_fsr_s {
     struct jls_core_signal_s * parent;
     int64_t signal_length;  // total, including skipped samples
@@ -78,10 +112,9 @@ struct jls_core_fsr_s {
     double * data_f64;             // for level 0 sample data summarization statistics computation
     int64_t sample_id_offset;
     uint8_t write_omit_data;      // omit level 0 sample data. >1=enabled, else disabled
-    uint8_t shift_amount;
-    uint8_t shift_buffer;
     uint64_t buffer_u64[4096];     // for shifting incoming sample data on skips & duplicates
     struct jls_core_fsr_level_s * level[JLS_SUMMARY_LEVEL_COUNT];  // level 0 unused
+    struct jls_core_fsr_cascade_s cascade[JLS_SUMMARY_LEVEL_COUNT];  // levels 0 and 1 unused
 
     struct jls_tmap_s * tmap;     // on read, map UTC to sample_id
 };
@@ -113,6 +146,15 @@ struct jls_core_track_s {
     struct jls_core_chunk_s index_head[JLS_SUMMARY_LEVEL_COUNT];
     struct jls_core_chunk_s data_head;
     struct jls_core_chunk_s summary_head[JLS_SUMMARY_LEVEL_COUNT];
+
+    /**
+     * @brief The reader follow mode file sample_id end at each level.
+     *
+     * For level 0, the end of the most recent data chunk.  For all other
+     * levels, the end of the most recent complete index and summary.
+     * The follow reader uses the fields above for the most recent chunks.
+     */
+    int64_t follow_end[JLS_SUMMARY_LEVEL_COUNT];
 };
 
 struct jls_core_signal_s {
@@ -149,14 +191,38 @@ struct jls_core_s {
 
     struct jls_core_chunk_s user_data_head;  // for most recently added user_data
 
+    struct jls_core_chunk_s checkpoint_head;  // holds the most recent checkpoint offset, 0 if none
+    struct jls_core_chunk_s checkpoint;       // for most recently added checkpoint
+
     struct jls_core_chunk_s chunk_cur;           // most recent read chunk header, payload in buf
     struct jls_core_f64_buf_s * f64_sample_buf;  // for reading samples
     struct jls_core_f64_buf_s * f64_stats_buf;   // for reading statistics
+    struct jls_stats_s * stats;                  // instrumentation counters, NULL when disabled
+    bool follow;                                 // reader follows a file that may still be written
+};
+
+/**
+ * @brief The streaming FSR read iterator state.
+ *
+ * The iterator validates the signal and range once, then follows the
+ * FSR data chunk item_next linked list to avoid per-call index seeks.
+ */
+struct jls_core_fsr_iter_s {
+    struct jls_core_s * core;
+    uint16_t signal_id;
+    uint8_t entry_size_bits;
+    int64_t sample_id;      // next file sample_id to yield
+    int64_t sample_id_end;  // file sample_id end, exclusive
+    int64_t chunk_next;     // offset of next data chunk, 0 if unknown
 };
 
 int32_t jls_core_f64_buf_alloc(size_t length, struct jls_core_f64_buf_s ** buf);
 void jls_core_f64_buf_free(struct jls_core_f64_buf_s * buf);
 
+int32_t jls_core_stats_enable(struct jls_core_s * self, int enable);
+int32_t jls_core_stats(struct jls_core_s * self, struct jls_stats_s * stats);
+void jls_core_stats_free(struct jls_core_s * self);
+
 /**
  * @brief Validate the signal definition.
  *
@@ -221,6 +287,17 @@ int32_t jls_core_wr_index(struct jls_core_s * self, uint16_t signal_id, enum jls
 
 int32_t jls_core_wr_end(struct jls_core_s * self);
 
+uint32_t jls_core_fsr_summary_stride(uint32_t summary_fields);
+uint32_t jls_core_fsr_summary_level_stride(const struct jls_signal_def_s * def, uint8_t level);
+uint32_t jls_core_fsr_hist_bin(const struct jls_signal_def_s * def, double x);
+void jls_core_fsr_entry_reset(struct jls_core_fsr_entry_s * e);
+void jls_core_fsr_entry_add(struct jls_core_fsr_entry_s * e, double x);
+void jls_core_fsr_entry_combine(struct jls_core_fsr_entry_s * tgt,
+                                const struct jls_core_fsr_entry_s * a,
+                                const struct jls_core_fsr_entry_s * b);
+void jls_core_fsr_entry_encode(const struct jls_core_fsr_entry_s * e, uint32_t fields, double * values);
+void jls_core_fsr_entry_decode(struct jls_core_fsr_entry_s * e, uint32_t fields, const double * values, double scale);
+
 int32_t jls_core_fsr_summary_level_alloc(struct jls_core_fsr_s * self, uint8_t level);
 int32_t jls_core_fsr_summary1(struct jls_core_fsr_s * self, int64_t pos);
 int32_t jls_core_fsr_summaryN(struct jls_core_fsr_s * self, uint8_t level, int64_t pos);
@@ -228,12 +305,82 @@ int32_t jls_core_fsr_summaryN(struct jls_core_fsr_s * self, uint8_t level, int64
 int32_t jls_fsr_open(struct jls_core_fsr_s ** instance, struct jls_core_signal_s * parent);
 int32_t jls_fsr_close(struct jls_core_fsr_s * self);
 
+/**
+ * @brief Restore the FSR writer state to append to a closed file.
+ *
+ * @param self The FSR writer instance.
+ * @param truncate[inout] Reduced to the offset of the earliest chunk
+ *      written on close, which the caller must truncate.
+ * @return 0 or error code.
+ *
+ * Partial data, index, and summary chunks written on close are
+ * reloaded and unlinked so that appended samples continue them.
+ */
+int32_t jls_fsr_append(struct jls_core_fsr_s * self, int64_t * truncate);
+
+/**
+ * @brief Serialize the FSR writer state for a checkpoint.
+ *
+ * @param self The FSR writer instance.
+ * @param buf The buffer that receives the state.
+ * @return 0 or error code.
+ *
+ * The state includes the partial index and summary at each level
+ * along with the pending cascade accumulators, which are only on disk
+ * once their chunks fill.  Buffered samples are not included.
+ */
+int32_t jls_fsr_checkpoint(struct jls_core_fsr_s * self, struct jls_buf_s * buf);
+
+/**
+ * @brief Restore the FSR writer state from jls_fsr_checkpoint().
+ *
+ * @param self The FSR writer instance from jls_fsr_open().
+ * @param buf The buffer positioned at the state.
+ * @return 0 or error code.
+ *
+ * Allocates the sample buffer with the next data chunk timestamp.
+ */
+int32_t jls_fsr_restore(struct jls_core_fsr_s * self, struct jls_buf_s * buf);
+
 int32_t jls_core_rd_chunk(struct jls_core_s * self);
 int32_t jls_core_rd_chunk_end(struct jls_core_s * self);
+
+/**
+ * @brief Read a chunk header.
+ *
+ * @param self The core instance.
+ * @param offset The chunk offset, or 0 to clear chunk.
+ * @param chunk[out] The chunk offset and header.
+ * @return 0 or error code.
+ */
+int32_t jls_core_rd_chunk_header(struct jls_core_s * self, int64_t offset, struct jls_core_chunk_s * chunk);
+
+/**
+ * @brief Follow a doubly-linked list to its last item.
+ *
+ * @param self The core instance.
+ * @param chunk[inout] The starting item, which is updated to the last item.
+ *      Only the offset must be valid on input.
+ * @return 0 or error code.
+ */
+int32_t jls_core_list_tail(struct jls_core_s * self, struct jls_core_chunk_s * chunk);
+
+/**
+ * @brief Read the last chunk of a list.
+ *
+ * @param self The core instance.
+ * @param offset The chunk offset, or 0 to read the next chunk.
+ * @param tag The expected chunk tag.
+ * @return 0 or error code.  The chunk is in chunk_cur and buf.
+ *      JLS_ERROR_NOT_SUPPORTED if the tag does not match or the
+ *      chunk has a next item.
+ */
+int32_t jls_core_rd_chunk_tail(struct jls_core_s * self, int64_t offset, uint8_t tag);
 int32_t jls_core_scan_sources(struct jls_core_s * self);
 int32_t jls_core_scan_signals(struct jls_core_s * self);
 int32_t jls_core_scan_fsr_sample_id(struct jls_core_s * self);
 int32_t jls_core_scan_initial(struct jls_core_s * self);
+int32_t jls_core_follow_update(struct jls_core_s * self);
 int32_t jls_core_sources(struct jls_core_s * self, struct jls_source_def_s ** sources, uint16_t * count);
 int32_t jls_core_signals(struct jls_core_s * self, struct jls_signal_def_s ** signals, uint16_t * count);
 int32_t jls_core_signal(struct jls_core_s * self, uint16_t signal_id, struct jls_signal_def_s * signal);
@@ -245,14 +392,34 @@ int32_t jls_core_fsr(struct jls_core_s * self, uint16_t signal_id, int64_t start
                      void * data, int64_t data_length);
 int32_t jls_core_fsr_f32(struct jls_core_s * self, uint16_t signal_id, int64_t start_sample_id,
                          float * data, int64_t data_length);
+int32_t jls_core_fsr_multi(struct jls_core_s * self, const uint16_t * signal_ids, uint32_t signal_count,
+                           int64_t start_sample_id, int64_t data_length, void * const * data);
+int32_t jls_core_fsr_as_f32(struct jls_core_s * self, uint16_t signal_id, int64_t start_sample_id,
+                            float * data, int64_t data_length);
+int32_t jls_core_fsr_as_f64(struct jls_core_s * self, uint16_t signal_id, int64_t start_sample_id,
+                            double * data, int64_t data_length);
+int32_t jls_core_fsr_to_f64(struct jls_core_s * self, uint16_t signal_id, int64_t start_sample_id,
+                            double * data, int64_t data_length);  // unscaled, like the summaries
+int32_t jls_core_fsr_u8(struct jls_core_s * self, uint16_t signal_id, int64_t start_sample_id,
+                        uint8_t * data, int64_t data_length);
 int32_t jls_core_fsr_statistics(struct jls_core_s * self, uint16_t signal_id,
                                 int64_t start_sample_id, int64_t increment,
                                 double * data, int64_t data_length);
+int32_t jls_core_fsr_statistics_ext(struct jls_core_s * self, uint16_t signal_id,
+                                    int64_t start_sample_id, int64_t increment, uint32_t fields,
+                                    double * data, int64_t data_length);
 int32_t jls_core_ts_seek(struct jls_core_s * self, uint16_t signal_id, uint8_t level,
                          enum jls_track_type_e track_type, int64_t timestamp);
 
 int32_t jls_core_rd_fsr_level1(struct jls_core_s * self, uint16_t signal_id, int64_t start_sample_id);
 int32_t jls_core_rd_fsr_data0(struct jls_core_s * self, uint16_t signal_id, int64_t start_sample_id);
+int32_t jls_core_rd_fsr_chunk(struct jls_core_s * self, uint16_t signal_id, int64_t start_sample_id,
+                              const struct jls_fsr_data_s ** data, const void ** summary);
+
+int32_t jls_core_fsr_iter_init(struct jls_core_fsr_iter_s * iter, struct jls_core_s * self, uint16_t signal_id,
+                               int64_t start_sample_id, int64_t length);
+int32_t jls_core_fsr_iter_next(struct jls_core_fsr_iter_s * iter,
+                               const void ** data, int64_t * sample_id, int64_t * count);
 
 int32_t jls_core_repair_fsr(struct jls_core_s * self, uint16_t signal_id);
 
@@ -51,6 +51,50 @@ extern "C" {
  */
 int32_t jls_dt_buffer_to_f64(const void * src, uint32_t src_datatype, double * dst, size_t samples);
 
+/**
+ * @brief Convert a buffer into floats.
+ * @param src The source buffer pointer
+ * @param src_datatype The source buffer datatype, see JLS_DATATYPE_*.
+ * @param[out] dst The output f32 buffer.
+ * @param samples The number of samples to convert.  Both src and dst must
+ *      be able to hold at least this many samples.
+ * @return 0 or error code.
+ */
+int32_t jls_dt_buffer_to_f32(const void * src, uint32_t src_datatype, float * dst, size_t samples);
+
+/**
+ * @brief Convert a buffer into doubles scaled by the fixed-point factor.
+ * @param src The source buffer pointer
+ * @param src_datatype The source buffer datatype, see JLS_DATATYPE_*.
+ * @param[out] dst The output f64 buffer.
+ * @param samples The number of samples to convert.  Both src and dst must
+ *      be able to hold at least this many samples.
+ * @return 0 or error code.
+ *
+ * Unlike jls_dt_buffer_to_f64(), which produces the integer values that
+ * the stored summaries use, this function applies jls_dt_scale().
+ */
+int32_t jls_dt_buffer_as_f64(const void * src, uint32_t src_datatype, double * dst, size_t samples);
+
+/**
+ * @brief Convert a buffer into floats scaled by the fixed-point factor.
+ * @param src The source buffer pointer
+ * @param src_datatype The source buffer datatype, see JLS_DATATYPE_*.
+ * @param[out] dst The output f32 buffer.
+ * @param samples The number of samples to convert.  Both src and dst must
+ *      be able to hold at least this many samples.
+ * @return 0 or error code.
+ */
+int32_t jls_dt_buffer_as_f32(const void * src, uint32_t src_datatype, float * dst, size_t samples);
+
+/**
+ * @brief Get the fixed-point scale factor for a datatype.
+ * @param datatype The datatype, see JLS_DATATYPE_*.
+ * @return The scale factor 2 ** -q, which is 1.0 for floating point
+ *      and integer datatypes with q = 0.
+ */
+double jls_dt_scale(uint32_t datatype);
+
 
 /** @} */
 
@@ -0,0 +1,71 @@
+/*
+ * Copyright 2026 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file
+ *
+ * @brief JLS reader internal functions.
+ */
+
+#ifndef JLS_READER_PRIV_H__
+#define JLS_READER_PRIV_H__
+
+#include <stdint.h>
+#include "jls/format.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @ingroup jls
+ * @defgroup jls_reader_prv Reader internals
+ *
+ * @brief JLS reader internal functions.
+ *
+ * @{
+ */
+
+
+// opaque object
+struct jls_rd_s;
+
+/**
+ * @brief Read a stored FSR data chunk with its level 1 summary entries.
+ *
+ * @param self The reader instance.
+ * @param signal_id The FSR signal.
+ * @param start_sample_id The API zero-based starting sample id, which
+ *      must be a multiple of samples_per_data.
+ * @param[out] data The full data chunk payload.
+ * @param[out] summary The samples_per_data / sample_decimate_factor
+ *      level 1 summary entries for data.
+ * @return 0, JLS_ERROR_NOT_FOUND if the chunk is not stored as a full
+ *      chunk with its level 1 summary, or error code.
+ *
+ * The returned pointers are owned by the reader and remain valid only
+ * until the next reader call.
+ */
+int32_t jls_rd_fsr_chunk(struct jls_rd_s * self, uint16_t signal_id, int64_t start_sample_id,
+                         const struct jls_fsr_data_s ** data, const void ** summary);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* JLS_READER_PRIV_H__ */
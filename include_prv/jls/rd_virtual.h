@@ -0,0 +1,91 @@
+/*
+ * Copyright 2026 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file
+ *
+ * @brief JLS reader virtual signals.
+ */
+
+#ifndef JLS_PRIV_RD_VIRTUAL_H__
+#define JLS_PRIV_RD_VIRTUAL_H__
+
+#include <stdint.h>
+#include "jls/format.h"
+#include "jls/reader.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @ingroup jls
+ * @defgroup jls_rd_virtual Reader virtual signals
+ *
+ * @brief Compute derived FSR signals from other FSR signals on read.
+ *
+ * The virtual signal evaluates its sources through the public jls_rd_*
+ * API, which allows virtual signals to use other virtual signals.
+ *
+ * @{
+ */
+
+/// The opaque virtual signal instance.
+struct jls_rd_virtual_s;
+
+/**
+ * @brief Allocate a new virtual signal.
+ *
+ * @param[out] instance The new virtual signal instance.
+ * @param def The virtual signal definition.
+ * @param source_def The signal definition for def->source_ids[0].
+ * @return 0 or error code.
+ */
+int32_t jls_rd_virtual_alloc(struct jls_rd_virtual_s ** instance,
+                             const struct jls_rd_virtual_def_s * def,
+                             const struct jls_signal_def_s * source_def);
+
+/**
+ * @brief Free a virtual signal instance.
+ *
+ * @param self The virtual signal instance.
+ */
+void jls_rd_virtual_free(struct jls_rd_virtual_s * self);
+
+/**
+ * @brief Get the signal definition.
+ *
+ * @param self The virtual signal instance.
+ * @return The signal definition, which remains valid until jls_rd_virtual_free().
+ */
+const struct jls_signal_def_s * jls_rd_virtual_signal_def(struct jls_rd_virtual_s * self);
+
+int32_t jls_rd_virtual_length(struct jls_rd_virtual_s * self, struct jls_rd_s * rd, int64_t * samples);
+int32_t jls_rd_virtual_f64(struct jls_rd_virtual_s * self, struct jls_rd_s * rd,
+                           int64_t start_sample_id, double * data, int64_t data_length);
+int32_t jls_rd_virtual_f32(struct jls_rd_virtual_s * self, struct jls_rd_s * rd,
+                           int64_t start_sample_id, float * data, int64_t data_length);
+int32_t jls_rd_virtual_statistics(struct jls_rd_virtual_s * self, struct jls_rd_s * rd,
+                                  int64_t start_sample_id, int64_t increment,
+                                  double * data, int64_t data_length);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* JLS_PRIV_RD_VIRTUAL_H__ */
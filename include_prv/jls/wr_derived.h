@@ -0,0 +1,103 @@
+/*
+ * Copyright 2026 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/**
+ * @file
+ *
+ * @brief JLS derived signal writer.
+ */
+
+#ifndef JLS_WRITE_DERIVED_H__
+#define JLS_WRITE_DERIVED_H__
+
+#include <stdint.h>
+#include "jls/format.h"
+#include "jls/writer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @ingroup jls
+ * @defgroup jls_wr_derived Derived signal writer.
+ *
+ * @brief Compute derived FSR signals from other FSR signals on write.
+ *
+ * The instance buffers each source's sample data as f64 until all
+ * sources provide the same sample_ids, then computes the output.
+ *
+ * @{
+ */
+
+/// The opaque derived signal instance.
+struct jls_wr_derived_s;
+
+/**
+ * @brief Allocate a new derived signal.
+ *
+ * @param[out] instance The new derived signal instance.
+ * @param signal_def The derived signal definition.
+ * @param def The derived operation definition.
+ * @return 0 or error code.
+ */
+int32_t jls_wr_derived_alloc(struct jls_wr_derived_s ** instance,
+                             const struct jls_signal_def_s * signal_def,
+                             const struct jls_wr_derived_def_s * def);
+
+/**
+ * @brief Free a derived signal instance.
+ *
+ * @param self The derived signal instance.
+ */
+void jls_wr_derived_free(struct jls_wr_derived_s * self);
+
+/**
+ * @brief Provide source sample data.
+ *
+ * @param self The derived signal instance.
+ * @param signal_id The signal id for data.  Ignored if not a source.
+ * @param data_type The JLS_DATATYPE_* for data.
+ * @param sample_id The sample id for data[0].
+ * @param data The packed sample data.
+ * @param data_length The length of data in samples.
+ * @return 0 or error code.
+ */
+int32_t jls_wr_derived_source(struct jls_wr_derived_s * self, uint16_t signal_id, uint32_t data_type,
+                              int64_t sample_id, const void * data, uint32_t data_length);
+
+/**
+ * @brief Compute the next block of derived samples.
+ *
+ * @param self The derived signal instance.
+ * @param[out] sample_id The sample id for data[0].
+ * @param[out] data The computed samples in the signal's data type,
+ *      valid until the next call.
+ * @param[out] data_length The length of data in samples.
+ * @return 0, JLS_ERROR_EMPTY when all aligned source data is consumed,
+ *      or error code.
+ */
+int32_t jls_wr_derived_next(struct jls_wr_derived_s * self,
+                            int64_t * sample_id, const void ** data, uint32_t * data_length);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* JLS_WRITE_DERIVED_H__ */
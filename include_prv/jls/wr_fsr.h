@@ -53,6 +53,25 @@ extern "C" {
  */
 int32_t jls_wr_fsr_data(struct jls_core_fsr_s * self, int64_t sample_id, const void * data, uint32_t data_length);
 
+/**
+ * @brief Write a complete data chunk with its existing level 1 summary.
+ *
+ * @param self The instance.
+ * @param sample_id The starting sample id for this chunk, which must be
+ *      the next expected sample id.  The data header timestamp is ignored.
+ * @param data The data chunk payload with exactly samples_per_data samples.
+ * @param summary The samples_per_data / sample_decimate_factor level 1
+ *      summary entries for data, in this signal's summary entry format.
+ * @return 0 or error code.
+ *
+ * The samples and level 1 entries are written verbatim without recomputing
+ * the summary from the samples.  Higher summary levels are combined
+ * from the provided level 1 entries.  Any samples pending from
+ * jls_wr_fsr_data() must end on a chunk boundary.
+ */
+int32_t jls_wr_fsr_data_chunk(struct jls_core_fsr_s * self, int64_t sample_id,
+                              const struct jls_fsr_data_s * data, const void * summary);
+
 
 /** @} */
 
@@ -48,6 +48,59 @@ struct jls_twr_s;
 
 int32_t jls_twr_run(struct jls_twr_s * self);
 
+/**
+ * @brief Write a complete FSR data chunk with its existing level 1 summary.
+ *
+ * @param self The writer instance.
+ * @param signal_id The FSR signal.
+ * @param sample_id The starting sample id for this chunk.
+ * @param data The data chunk payload, see jls_wr_fsr_data_chunk().
+ * @param summary The level 1 summary entries for data.
+ * @return 0 or error code.
+ */
+int32_t jls_wr_fsr_chunk(struct jls_wr_s * self, uint16_t signal_id, int64_t sample_id,
+                         const struct jls_fsr_data_s * data, const void * summary);
+
+/**
+ * @brief Write the buffered changes to the file.
+ *
+ * @param self The writer instance.
+ * @param durable When nonzero, also persist the file data to the
+ *      storage device.  See jls_raw_sync().
+ * @return 0 or error code.
+ */
+int32_t jls_wr_sync(struct jls_wr_s * self, int32_t durable);
+
+/**
+ * @brief Get the current file size.
+ *
+ * @param self The writer instance.
+ * @return The current write position in bytes.
+ */
+int64_t jls_wr_tell(struct jls_wr_s * self);
+
+/**
+ * @brief Get a signal definition.
+ *
+ * @param self The writer instance.
+ * @param signal_id The signal id.
+ * @return The signal definition, or NULL if not defined.
+ */
+const struct jls_signal_def_s * jls_wr_signal_def_get(struct jls_wr_s * self, uint16_t signal_id);
+
+/**
+ * @brief Close the writer and continue in a new file.
+ *
+ * @param[inout] instance The writer instance, replaced on success.
+ * @param path The new file path.
+ * @return 0 or error code.  On error, the original writer remains open.
+ *
+ * The new file receives the same source and signal definitions.  FSR
+ * signals continue from the next sample id, which becomes the new file's
+ * sample_id_offset.
+ */
+int32_t jls_wr_roll(struct jls_wr_s ** instance, const char * path);
+
 /** @} */
 
 #ifdef __cplusplus
@@ -64,6 +64,34 @@ int32_t jls_wr_ts_open(
  */
 int32_t jls_wr_ts_close(struct jls_core_ts_s * self);
 
+/**
+ * @brief Restore the timeseries state to append to a closed file.
+ *
+ * @param self The timeseries instance.
+ * @param truncate[inout] Reduced to the offset of the earliest chunk
+ *      committed on close, which the caller must truncate.
+ * @return 0 or error code.
+ */
+int32_t jls_wr_ts_append(struct jls_core_ts_s * self, int64_t * truncate);
+
+/**
+ * @brief Serialize the partial index and summary levels for a checkpoint.
+ *
+ * @param self The timeseries instance.
+ * @param buf The buffer that receives the state.
+ * @return 0 or error code.
+ */
+int32_t jls_wr_ts_checkpoint(struct jls_core_ts_s * self, struct jls_buf_s * buf);
+
+/**
+ * @brief Restore the timeseries state from jls_wr_ts_checkpoint().
+ *
+ * @param self The timeseries instance from jls_wr_ts_open().
+ * @param buf The buffer positioned at the state.
+ * @return 0 or error code.
+ */
+int32_t jls_wr_ts_restore(struct jls_core_ts_s * self, struct jls_buf_s * buf);
+
 /**
  * @brief Add a timeseries annotation entry.
  *
@@ -1,6 +1,44 @@
 #include <napi.h>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <vector>
 extern "C" {
-    #include "jls/writer.h"
+    #include "jls/ec.h"
+    #include "jls/reader.h"
+    #include "jls/threaded_writer.h"
+}
+
+static int64_t ToInt64(const Napi::Value& value) {
+    if (value.IsBigInt()) {
+        bool lossless;
+        return value.As<Napi::BigInt>().Int64Value(&lossless);
+    }
+    return value.As<Napi::Number>().Int64Value();
+}
+
+static std::string ErrorMessage(const char * op, int32_t rc) {
+    return std::string(op) + " failed: " + jls_error_code_name(rc) + " (" + std::to_string(rc) + ")";
+}
+
+/**
+ * Wrap a malloc'd buffer as an ArrayBuffer without copying.
+ *
+ * Runtimes that forbid external buffers, like Electron with the V8
+ * memory cage, get a copy instead.
+ */
+static Napi::ArrayBuffer TakeArrayBuffer(Napi::Env env, void * data, size_t size) {
+#ifdef NODE_API_NO_EXTERNAL_BUFFERS_ALLOWED
+    Napi::ArrayBuffer buffer = Napi::ArrayBuffer::New(env, size);
+    std::memcpy(buffer.Data(), data, size);
+    std::free(data);
+    return buffer;
+#else
+    return Napi::ArrayBuffer::New(env, data, size, [](Napi::Env, void * p) { std::free(p); });
+#endif
 }
 
 class Writer : public Napi::ObjectWrap<Writer> {
@@ -8,6 +46,7 @@ public:
     static Napi::Object Init(Napi::Env env, Napi::Object exports) {
         Napi::Function func = DefineClass(env, "Writer", {
             InstanceMethod("close", &Writer::Close),
+            InstanceMethod("flush", &Writer::Flush),
             InstanceMethod("signalDef", &Writer::SignalDef),
             InstanceMethod("sourceDef", &Writer::SourceDef),
             InstanceMethod("writeF32", &Writer::WriteF32),
@@ -19,22 +58,35 @@ public:
 
     Writer(const Napi::CallbackInfo& info) : Napi::ObjectWrap<Writer>(info) {
         std::string path = info[0].As<Napi::String>();
-        jls_wr_open(&this->writer_, path.c_str());
+        int32_t rc = jls_twr_open(&this->writer_, path.c_str());
+        if (rc) {
+            this->writer_ = nullptr;
+            Napi::Error::New(info.Env(), ErrorMessage("open", rc)).ThrowAsJavaScriptException();
+        }
     }
 
     ~Writer() {
         if (writer_)
-            jls_wr_close(writer_);
+            jls_twr_close(writer_);
     }
 
 private:
 
     Napi::Value Close(const Napi::CallbackInfo& info) {
+        int32_t result = 0;
         if (this->writer_) {
-            jls_wr_close(this->writer_);
+            result = jls_twr_close(this->writer_);
             this->writer_ = nullptr;
         }
-        return info.Env().Undefined();
+        return Napi::Number::New(info.Env(), result);
+    }
+
+    Napi::Value Flush(const Napi::CallbackInfo& info) {
+        int32_t result = JLS_ERROR_CLOSED;
+        if (this->writer_) {
+            result = jls_twr_flush(this->writer_);
+        }
+        return Napi::Number::New(info.Env(), result);
     }
 
     Napi::Value SignalDef(const Napi::CallbackInfo& info) {
@@ -42,6 +94,8 @@ private:
         if (info.Length() < 1 || !info[0].IsObject())
             Napi::TypeError::New(env, "Expected signal definition object").ThrowAsJavaScriptException();
 
+        if (!this->writer_)
+            return Napi::Number::New(env, JLS_ERROR_CLOSED);
         Napi::Object obj = info[0].As<Napi::Object>();
 
         jls_signal_def_s sig = {};
@@ -56,14 +110,26 @@ private:
         sig.summary_decimate_factor = obj.Get("summary_decimate_factor").As<Napi::Number>().Uint32Value();
         sig.annotation_decimate_factor = obj.Get("annotation_decimate_factor").As<Napi::Number>().Uint32Value();
         sig.utc_decimate_factor = obj.Get("utc_decimate_factor").As<Napi::Number>().Uint32Value();
+        if (obj.Has("summary_fields")) {
+            sig.summary_fields = obj.Get("summary_fields").As<Napi::Number>().Uint32Value();
+        }
+        if (obj.Has("summary_hist_bins")) {
+            sig.summary_hist_bins = obj.Get("summary_hist_bins").As<Napi::Number>().Uint32Value();
+            sig.summary_hist_level = obj.Get("summary_hist_level").As<Napi::Number>().Uint32Value();
+            sig.summary_hist_min = obj.Get("summary_hist_min").As<Napi::Number>().FloatValue();
+            sig.summary_hist_max = obj.Get("summary_hist_max").As<Napi::Number>().FloatValue();
+        }
         bool lossless;
-        sig.sample_id_offset = obj.Get("sample_id_offset").As<Napi::BigInt>().Int64Value(&lossless);        
+        sig.sample_id_offset = obj.Get("sample_id_offset").As<Napi::BigInt>().Int64Value(&lossless);
         std::string name = obj.Get("name").As<Napi::String>().Utf8Value();
         std::string units = obj.Get("units").As<Napi::String>().Utf8Value();
         sig.name = name.c_str();
         sig.units = units.c_str();
 
-        int32_t result = jls_wr_signal_def(this->writer_, &sig);
+        int32_t result = jls_twr_signal_def(this->writer_, &sig);
+        if (!result && sig.signal_id < JLS_SIGNAL_COUNT) {
+            this->sample_id_next_[sig.signal_id] = 0;
+        }
         return Napi::Number::New(env, result);
     }
 
@@ -73,6 +139,8 @@ private:
         if (info.Length() < 1 || !info[0].IsObject())
             Napi::TypeError::New(env, "Expected (sourceDef)").ThrowAsJavaScriptException();
 
+        if (!this->writer_)
+            return Napi::Number::New(env, JLS_ERROR_CLOSED);
         Napi::Object obj = info[0].As<Napi::Object>();
         std::string name = obj.Get("name").As<Napi::String>().Utf8Value();
         std::string vendor = obj.Get("vendor").As<Napi::String>().Utf8Value();
@@ -88,33 +156,424 @@ private:
         src.version = version.c_str();
         src.serial_number = serial_number.c_str();
 
-        int32_t result = jls_wr_source_def(this->writer_, &src);
+        int32_t result = jls_twr_source_def(this->writer_, &src);
         return Napi::Number::New(env, result);
     }
 
+    /// writeF32(signal_id, data, sample_id?), where sample_id defaults to the end of the previous write.
     Napi::Value WriteF32(const Napi::CallbackInfo& info) {
         Napi::Env env = info.Env();
 
         if (info.Length() < 2 || !info[0].IsNumber() || !info[1].IsTypedArray())
-            Napi::TypeError::New(env, "Expected (signal_id, Float32Array)").ThrowAsJavaScriptException();
+            Napi::TypeError::New(env, "Expected (signal_id, Float32Array, sample_id?)").ThrowAsJavaScriptException();
 
         uint16_t signal_id = info[0].As<Napi::Number>().Uint32Value();
+        if (signal_id >= JLS_SIGNAL_COUNT)
+            Napi::RangeError::New(env, "Invalid signal_id").ThrowAsJavaScriptException();
+        if (!this->writer_)
+            return Napi::Number::New(env, JLS_ERROR_CLOSED);
         Napi::Float32Array arr = info[1].As<Napi::Float32Array>();
+        int64_t sample_id = this->sample_id_next_[signal_id];
+        if (info.Length() >= 3 && !info[2].IsUndefined())
+            sample_id = ToInt64(info[2]);
 
-        int32_t result = jls_wr_fsr_f32(this->writer_,
-                                        signal_id,
-                                        0,
-                                        arr.Data(),
-                                        arr.ElementLength());
-
+        // copies data into the writer's queue, the file write happens on the writer thread.
+        const float * data = arr.Data();
+        size_t length = arr.ElementLength();
+        int32_t result = 0;
+        while (length && !result) {
+            uint32_t n = static_cast<uint32_t>((length > WRITE_BLOCK_SAMPLES) ? WRITE_BLOCK_SAMPLES : length);
+            result = jls_twr_fsr_f32(this->writer_, signal_id, sample_id, data, n);
+            if (!result) {
+                data += n;
+                length -= n;
+                sample_id += n;
+                this->sample_id_next_[signal_id] = sample_id;
+            }
+        }
         return Napi::Number::New(env, result);
     }
 
-    jls_wr_s* writer_ = nullptr;
+    static constexpr size_t WRITE_BLOCK_SAMPLES = 1 << 20;  // fits the writer queue
+    jls_twr_s* writer_ = nullptr;
+    std::array<int64_t, JLS_SIGNAL_COUNT> sample_id_next_ = {};
+};
+
+class Reader : public Napi::ObjectWrap<Reader> {
+public:
+    static Napi::Object Init(Napi::Env env, Napi::Object exports) {
+        Napi::Function func = DefineClass(env, "Reader", {
+            InstanceMethod("close", &Reader::Close),
+            InstanceMethod("signals", &Reader::Signals),
+            InstanceMethod("fsr", &Reader::Fsr),
+            InstanceMethod("fsrStatistics", &Reader::FsrStatistics),
+            InstanceMethod("annotations", &Reader::Annotations),
+            InstanceMethod("timeMap", &Reader::TimeMap),
+        });
+
+        exports.Set("Reader", func);
+        return exports;
+    }
+
+    Reader(const Napi::CallbackInfo& info) : Napi::ObjectWrap<Reader>(info) {
+        std::string path = info[0].As<Napi::String>();
+        int32_t rc = jls_rd_open(&this->reader_, path.c_str());
+        if (rc) {
+            this->reader_ = nullptr;
+            Napi::Error::New(info.Env(), ErrorMessage("open", rc)).ThrowAsJavaScriptException();
+        }
+    }
+
+    ~Reader() {
+        if (reader_)
+            jls_rd_close(reader_);
+    }
+
+    /// Serializes worker access since jls_rd_s is not thread-safe.
+    std::mutex mutex_;
+    jls_rd_s* reader_ = nullptr;
+
+private:
+
+    Napi::Value Close(const Napi::CallbackInfo& info) {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        if (this->reader_) {
+            jls_rd_close(this->reader_);
+            this->reader_ = nullptr;
+        }
+        return info.Env().Undefined();
+    }
+
+    Napi::Value Signals(const Napi::CallbackInfo& info);
+    Napi::Value Fsr(const Napi::CallbackInfo& info);
+    Napi::Value FsrStatistics(const Napi::CallbackInfo& info);
+    Napi::Value Annotations(const Napi::CallbackInfo& info);
+    Napi::Value TimeMap(const Napi::CallbackInfo& info);
+};
+
+/**
+ * The base class for Reader operations on the libuv worker pool.
+ *
+ * Execute() runs on a worker thread with the reader locked.  OnOK()
+ * runs on the event-loop thread and resolves the Promise.
+ */
+class ReaderWorker : public Napi::AsyncWorker {
+public:
+    ReaderWorker(Napi::Env env, Reader * reader, Napi::Object reader_obj)
+        : Napi::AsyncWorker(env),
+          deferred_(Napi::Promise::Deferred::New(env)),
+          reader_(reader),
+          reader_ref_(Napi::Persistent(reader_obj)) {}
+
+    Napi::Promise Start() {
+        Queue();
+        return deferred_.Promise();
+    }
+
+protected:
+    virtual int32_t Run(jls_rd_s * rd) = 0;
+    virtual Napi::Value Result(Napi::Env env) = 0;
+    virtual const char * Name() const = 0;
+
+    void Execute() override {
+        std::lock_guard<std::mutex> lock(reader_->mutex_);
+        if (!reader_->reader_) {
+            SetError("reader closed");
+            return;
+        }
+        int32_t rc = Run(reader_->reader_);
+        if (rc) {
+            SetError(ErrorMessage(Name(), rc));
+        }
+    }
+
+    void OnOK() override {
+        deferred_.Resolve(Result(Env()));
+    }
+
+    void OnError(const Napi::Error& e) override {
+        deferred_.Reject(e.Value());
+    }
+
+    Napi::Promise::Deferred deferred_;
+
+private:
+    Reader * reader_;
+    Napi::ObjectReference reader_ref_;  // keep the Reader alive while queued
 };
 
+class FsrWorker : public ReaderWorker {
+public:
+    FsrWorker(Napi::Env env, Reader * reader, Napi::Object reader_obj,
+              uint16_t signal_id, int64_t start, int64_t length)
+        : ReaderWorker(env, reader, reader_obj), signal_id_(signal_id), start_(start), length_(length) {}
+
+    ~FsrWorker() {
+        std::free(data_);
+    }
+
+protected:
+    const char * Name() const override { return "fsr"; }
+
+    int32_t Run(jls_rd_s * rd) override {
+        data_ = static_cast<float *>(std::malloc(static_cast<size_t>(length_) * sizeof(float)));
+        if (!data_) {
+            return JLS_ERROR_NOT_ENOUGH_MEMORY;
+        }
+        return jls_rd_fsr_as_f32(rd, signal_id_, start_, data_, length_);
+    }
+
+    Napi::Value Result(Napi::Env env) override {
+        size_t size = static_cast<size_t>(length_) * sizeof(float);
+        Napi::ArrayBuffer buffer = TakeArrayBuffer(env, data_, size);
+        data_ = nullptr;
+        return Napi::Float32Array::New(env, static_cast<size_t>(length_), buffer, 0);
+    }
+
+private:
+    uint16_t signal_id_;
+    int64_t start_;
+    int64_t length_;
+    float * data_ = nullptr;
+};
+
+class FsrStatisticsWorker : public ReaderWorker {
+public:
+    FsrStatisticsWorker(Napi::Env env, Reader * reader, Napi::Object reader_obj,
+                        uint16_t signal_id, int64_t start, int64_t increment, int64_t length)
+        : ReaderWorker(env, reader, reader_obj),
+          signal_id_(signal_id), start_(start), increment_(increment), length_(length) {}
+
+    ~FsrStatisticsWorker() {
+        std::free(data_);
+    }
+
+protected:
+    const char * Name() const override { return "fsrStatistics"; }
+
+    int32_t Run(jls_rd_s * rd) override {
+        data_ = static_cast<double *>(std::malloc(Size()));
+        if (!data_) {
+            return JLS_ERROR_NOT_ENOUGH_MEMORY;
+        }
+        return jls_rd_fsr_statistics(rd, signal_id_, start_, increment_, data_, length_);
+    }
+
+    Napi::Value Result(Napi::Env env) override {
+        Napi::ArrayBuffer buffer = TakeArrayBuffer(env, data_, Size());
+        data_ = nullptr;
+        return Napi::Float64Array::New(env, static_cast<size_t>(length_) * JLS_SUMMARY_FSR_COUNT, buffer, 0);
+    }
+
+private:
+    size_t Size() const {
+        return static_cast<size_t>(length_) * JLS_SUMMARY_FSR_COUNT * sizeof(double);
+    }
+
+    uint16_t signal_id_;
+    int64_t start_;
+    int64_t increment_;
+    int64_t length_;
+    double * data_ = nullptr;
+};
+
+class AnnotationsWorker : public ReaderWorker {
+public:
+    AnnotationsWorker(Napi::Env env, Reader * reader, Napi::Object reader_obj,
+                      uint16_t signal_id, int64_t timestamp)
+        : ReaderWorker(env, reader, reader_obj), signal_id_(signal_id), timestamp_(timestamp) {}
+
+protected:
+    struct Annotation {
+        int64_t timestamp;
+        float y;
+        uint8_t annotation_type;
+        uint8_t storage_type;
+        uint8_t group_id;
+        std::vector<uint8_t> data;
+    };
+
+    const char * Name() const override { return "annotations"; }
+
+    static int32_t OnAnnotation(void * user_data, const struct jls_annotation_s * annotation) {
+        auto self = static_cast<AnnotationsWorker *>(user_data);
+        Annotation a;
+        a.timestamp = annotation->timestamp;
+        a.y = annotation->y;
+        a.annotation_type = annotation->annotation_type;
+        a.storage_type = annotation->storage_type;
+        a.group_id = annotation->group_id;
+        a.data.assign(annotation->data, annotation->data + annotation->data_size);
+        self->annotations_.push_back(std::move(a));
+        return 0;
+    }
+
+    int32_t Run(jls_rd_s * rd) override {
+        return jls_rd_annotations(rd, signal_id_, timestamp_, OnAnnotation, this);
+    }
+
+    Napi::Value Result(Napi::Env env) override {
+        Napi::Array result = Napi::Array::New(env, annotations_.size());
+        for (size_t i = 0; i < annotations_.size(); ++i) {
+            const Annotation& a = annotations_[i];
+            Napi::Object obj = Napi::Object::New(env);
+            obj.Set("timestamp", Napi::BigInt::New(env, a.timestamp));
+            obj.Set("y", Napi::Number::New(env, a.y));
+            obj.Set("annotation_type", Napi::Number::New(env, a.annotation_type));
+            obj.Set("storage_type", Napi::Number::New(env, a.storage_type));
+            obj.Set("group_id", Napi::Number::New(env, a.group_id));
+            if (a.storage_type == JLS_STORAGE_TYPE_BINARY) {
+                obj.Set("data", Napi::Buffer<uint8_t>::Copy(env, a.data.data(), a.data.size()));
+            } else {
+                size_t sz = a.data.size();
+                while (sz && !a.data[sz - 1]) {
+                    --sz;  // strip the terminator
+                }
+                obj.Set("data", Napi::String::New(env, reinterpret_cast<const char *>(a.data.data()), sz));
+            }
+            result.Set(static_cast<uint32_t>(i), obj);
+        }
+        return result;
+    }
+
+private:
+    uint16_t signal_id_;
+    int64_t timestamp_;
+    std::vector<Annotation> annotations_;
+};
+
+class TimeMapWorker : public ReaderWorker {
+public:
+    TimeMapWorker(Napi::Env env, Reader * reader, Napi::Object reader_obj, uint16_t signal_id)
+        : ReaderWorker(env, reader, reader_obj), signal_id_(signal_id) {}
+
+    ~TimeMapWorker() {
+        std::free(data_);
+    }
+
+protected:
+    const char * Name() const override { return "timeMap"; }
+
+    int32_t Run(jls_rd_s * rd) override {
+        length_ = jls_rd_tmap_length(rd, signal_id_);
+        data_ = static_cast<int64_t *>(std::malloc((length_ ? length_ : 1) * 2 * sizeof(int64_t)));
+        if (!data_) {
+            return JLS_ERROR_NOT_ENOUGH_MEMORY;
+        }
+        for (size_t i = 0; i < length_; ++i) {
+            struct jls_utc_summary_entry_s entry;
+            int32_t rc = jls_rd_tmap_get(rd, signal_id_, i, &entry);
+            if (rc) {
+                return rc;
+            }
+            data_[2 * i + 0] = entry.sample_id;
+            data_[2 * i + 1] = entry.timestamp;
+        }
+        return 0;
+    }
+
+    Napi::Value Result(Napi::Env env) override {
+        Napi::ArrayBuffer buffer = TakeArrayBuffer(env, data_, length_ * 2 * sizeof(int64_t));
+        data_ = nullptr;
+        return Napi::BigInt64Array::New(env, length_ * 2, buffer, 0);
+    }
+
+private:
+    uint16_t signal_id_;
+    size_t length_ = 0;
+    int64_t * data_ = nullptr;
+};
+
+Napi::Value Reader::Signals(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    if (!this->reader_)
+        Napi::Error::New(env, "reader closed").ThrowAsJavaScriptException();
+    struct jls_signal_def_s * signals = nullptr;
+    uint16_t count = 0;
+    int32_t rc = jls_rd_signals(this->reader_, &signals, &count);
+    if (rc)
+        Napi::Error::New(env, ErrorMessage("signals", rc)).ThrowAsJavaScriptException();
+    Napi::Array result = Napi::Array::New(env, count);
+    for (uint16_t i = 0; i < count; ++i) {
+        const struct jls_signal_def_s * s = &signals[i];
+        Napi::Object obj = Napi::Object::New(env);
+        obj.Set("signal_id", Napi::Number::New(env, s->signal_id));
+        obj.Set("source_id", Napi::Number::New(env, s->source_id));
+        obj.Set("signal_type", Napi::Number::New(env, s->signal_type));
+        obj.Set("data_type", Napi::Number::New(env, s->data_type));
+        obj.Set("sample_rate", Napi::Number::New(env, s->sample_rate));
+        obj.Set("samples_per_data", Napi::Number::New(env, s->samples_per_data));
+        obj.Set("sample_decimate_factor", Napi::Number::New(env, s->sample_decimate_factor));
+        obj.Set("entries_per_summary", Napi::Number::New(env, s->entries_per_summary));
+        obj.Set("summary_decimate_factor", Napi::Number::New(env, s->summary_decimate_factor));
+        obj.Set("annotation_decimate_factor", Napi::Number::New(env, s->annotation_decimate_factor));
+        obj.Set("utc_decimate_factor", Napi::Number::New(env, s->utc_decimate_factor));
+        obj.Set("summary_fields", Napi::Number::New(env, s->summary_fields));
+        obj.Set("summary_hist_bins", Napi::Number::New(env, s->summary_hist_bins));
+        obj.Set("summary_hist_level", Napi::Number::New(env, s->summary_hist_level));
+        obj.Set("summary_hist_min", Napi::Number::New(env, s->summary_hist_min));
+        obj.Set("summary_hist_max", Napi::Number::New(env, s->summary_hist_max));
+        obj.Set("sample_id_offset", Napi::BigInt::New(env, s->sample_id_offset));
+        obj.Set("name", Napi::String::New(env, s->name ? s->name : ""));
+        obj.Set("units", Napi::String::New(env, s->units ? s->units : ""));
+        result.Set(static_cast<uint32_t>(i), obj);
+    }
+    return result;
+}
+
+Napi::Value Reader::Fsr(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (info.Length() < 3 || !info[0].IsNumber())
+        Napi::TypeError::New(env, "Expected (signal_id, start_sample_id, length)").ThrowAsJavaScriptException();
+    uint16_t signal_id = info[0].As<Napi::Number>().Uint32Value();
+    int64_t start = ToInt64(info[1]);
+    int64_t length = ToInt64(info[2]);
+    if (length <= 0)
+        Napi::RangeError::New(env, "Invalid length").ThrowAsJavaScriptException();
+    auto worker = new FsrWorker(env, this, info.This().As<Napi::Object>(), signal_id, start, length);
+    return worker->Start();
+}
+
+Napi::Value Reader::FsrStatistics(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (info.Length() < 4 || !info[0].IsNumber())
+        Napi::TypeError::New(env, "Expected (signal_id, start_sample_id, increment, length)").ThrowAsJavaScriptException();
+    uint16_t signal_id = info[0].As<Napi::Number>().Uint32Value();
+    int64_t start = ToInt64(info[1]);
+    int64_t increment = ToInt64(info[2]);
+    int64_t length = ToInt64(info[3]);
+    if (length <= 0)
+        Napi::RangeError::New(env, "Invalid length").ThrowAsJavaScriptException();
+    auto worker = new FsrStatisticsWorker(env, this, info.This().As<Napi::Object>(),
+                                          signal_id, start, increment, length);
+    return worker->Start();
+}
+
+Napi::Value Reader::Annotations(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (info.Length() < 1 || !info[0].IsNumber())
+        Napi::TypeError::New(env, "Expected (signal_id, timestamp?)").ThrowAsJavaScriptException();
+    uint16_t signal_id = info[0].As<Napi::Number>().Uint32Value();
+    int64_t timestamp = INT64_MIN;
+    if (info.Length() >= 2 && !info[1].IsUndefined())
+        timestamp = ToInt64(info[1]);
+    auto worker = new AnnotationsWorker(env, this, info.This().As<Napi::Object>(), signal_id, timestamp);
+    return worker->Start();
+}
+
+Napi::Value Reader::TimeMap(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (info.Length() < 1 || !info[0].IsNumber())
+        Napi::TypeError::New(env, "Expected (signal_id)").ThrowAsJavaScriptException();
+    uint16_t signal_id = info[0].As<Napi::Number>().Uint32Value();
+    auto worker = new TimeMapWorker(env, this, info.This().As<Napi::Object>(), signal_id);
+    return worker->Start();
+}
+
 Napi::Object InitAll(Napi::Env env, Napi::Object exports) {
-    return Writer::Init(env, exports);
+    Writer::Init(env, exports);
+    return Reader::Init(env, exports);
 }
 
 NODE_API_MODULE(node_jls, InitAll)
@@ -4,16 +4,25 @@
             "target_name": "node_jls",
             "sources": [
                 "binding.cc",
+                "../src/bit_shift.c",
                 "../src/buffer.c",
+                "../src/checkpoint.c",
+                "../src/copy.c",
                 "../src/core.c",
                 "../src/crc32c_sw.c",
+                "../src/dataset.c",
                 "../src/datatype.c",
                 "../src/ec.c",
                 "../src/log.c",
                 "../src/raw.c",
+                "../src/rd_virtual.c",
+                "../src/reader.c",
+                "../src/statistics.c",
                 "../src/msg_ring_buffer.c",
                 "../src/track.c",
                 "../src/threaded_writer.c",
+                "../src/tmap.c",
+                "../src/wr_derived.c",
                 "../src/wr_fsr.c",
                 "../src/wr_ts.c",
                 "../src/writer.c"
@@ -43,4 +52,4 @@
             ]
         }
     ]
-}
\ No newline at end of file
+}
@@ -1,5 +1,6 @@
 const native = require('node-gyp-build')(__dirname)
 
 module.exports = {
-    Writer: native.JlsWriter
+    Reader: native.Reader,
+    Writer: native.Writer
 }
@@ -19,17 +19,46 @@ declare namespace Jls {
         summary_decimate_factor: number
         annotation_decimate_factor: number
         utc_decimate_factor: number
+        summary_fields?: number
+        summary_hist_bins?: number
+        summary_hist_level?: number
+        summary_hist_min?: number
+        summary_hist_max?: number
         sample_id_offset: bigint
         name: string
         units: string
     }
+    type Annotation = {
+        timestamp: bigint
+        y: number
+        annotation_type: number
+        storage_type: number
+        group_id: number
+        data: string | Buffer
+    }
     class Writer {
         constructor(path: string)
         sourceDef(def: SourceDef): number
         signalDef(def: SignalDef): number
-        writeF32(signal_id: number, data: Float32Array): number
+        /** Queue samples, sample_id defaults to the end of the previous write. */
+        writeF32(signal_id: number, data: Float32Array, sample_id?: number | bigint): number
+        flush(): number
         close(): number
     }
+    /** Reader methods returning a Promise run on the libuv worker pool. */
+    class Reader {
+        constructor(path: string)
+        signals(): SignalDef[]
+        /** Sample data of any data type converted to float32. */
+        fsr(signal_id: number, start_sample_id: number | bigint, length: number | bigint): Promise<Float32Array>
+        /** [mean, std, min, max] for each of length windows of increment samples. */
+        fsrStatistics(signal_id: number, start_sample_id: number | bigint,
+                      increment: number | bigint, length: number | bigint): Promise<Float64Array>
+        annotations(signal_id: number, timestamp?: number | bigint): Promise<Annotation[]>
+        /** Interleaved [sample_id, utc] pairs. */
+        timeMap(signal_id: number): Promise<BigInt64Array>
+        close(): void
+    }
 }
 
 export = Jls
@@ -1,18 +1,34 @@
-const { JlsWriter } = require('./build/Release/node_jls')
+const { Reader, Writer } = require('./build/Release/node_jls')
+const assert = require('assert')
 const fs = require('fs')
 
-const w = new JlsWriter("output3.jls")
+const path = 'output3.jls'
+const SAMPLE_COUNT = 1_000_000
 
-w.sourceDef({
+// Use recorded data when available, otherwise a generated ramp.
+let floats
+if (fs.existsSync('current.f32.bin')) {
+    const fbuf = fs.readFileSync('current.f32.bin')
+    floats = new Float32Array(fbuf.buffer, fbuf.byteOffset, fbuf.length / 4)
+} else {
+    floats = new Float32Array(SAMPLE_COUNT)
+    for (let i = 0; i < floats.length; ++i) {
+        floats[i] = (i % 1000) / 1000
+    }
+}
+
+const w = new Writer(path)
+
+assert.strictEqual(w.sourceDef({
     source_id: 1,
     name: 'probe',
     vendor: 'em',
     model: 'xyz',
     version: '2.3',
     serial_number: '5678'
-})
+}), 0)
 
-const rc = w.signalDef({
+assert.strictEqual(w.signalDef({
     signal_id: 1,           // not 0
     source_id: 1,           // match defined source
     signal_type: 0,
@@ -27,11 +43,54 @@ const rc = w.signalDef({
     sample_id_offset: BigInt(0),
     name: 'current',
     units: 'A'
-})
+}), 0)
 
-const fbuf = fs.readFileSync('current.f32.bin')
-const floats = new Float32Array(fbuf.buffer, fbuf.byteOffset, fbuf.length / 4)
+// Two writes, the second continues at the end of the first.
+const half = Math.floor(floats.length / 2)
+assert.strictEqual(w.writeF32(1, floats.subarray(0, half)), 0)
+assert.strictEqual(w.writeF32(1, floats.subarray(half)), 0)
+assert.strictEqual(w.close(), 0)
+assert.throws(() => w.writeF32(1, [1, 2, 3]), TypeError)
 
-w.writeF32(1, floats)
+async function read() {
+    const r = new Reader(path)
+    const signals = r.signals()
+    assert.deepStrictEqual(signals.map((s) => s.name), ['global_annotation_signal', 'current'])
+    assert.strictEqual(signals[1].sample_id_offset, 0n)
 
-w.close()
+    const length = Math.min(floats.length, 1000)
+    const [data, stats, annotations, tmap] = await Promise.all([
+        r.fsr(1, half - length / 2, length),
+        r.fsrStatistics(1, 0, floats.length, 1),
+        r.annotations(1),
+        r.timeMap(1),
+    ])
+    assert.deepStrictEqual(data, floats.subarray(half - length / 2, half + length / 2))
+
+    let sum = 0
+    let min = Infinity
+    let max = -Infinity
+    for (const x of floats) {
+        sum += x
+        min = Math.min(min, x)
+        max = Math.max(max, x)
+    }
+    assert(Math.abs(stats[0] - sum / floats.length) < 1e-6)
+    assert.strictEqual(stats[2], min)
+    assert.strictEqual(stats[3], max)
+    assert.strictEqual(annotations.length, 0)
+    assert(tmap instanceof BigInt64Array)
+    console.log(`fsr[0] = ${data[0]}, mean = ${stats[0]}, std = ${stats[1]}, min = ${stats[2]}, max = ${stats[3]}`)
+
+    await assert.rejects(r.fsr(9, 0, 10), /fsr failed/)
+    r.close()
+    await assert.rejects(r.fsr(1, 0, 10), /reader closed/)
+}
+
+read().then(() => {
+    fs.unlinkSync(path)
+    console.log('PASS')
+}, (err) => {
+    console.error(err)
+    process.exitCode = 1
+})
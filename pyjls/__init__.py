@@ -13,8 +13,8 @@
 # limitations under the License.
 
 from .binding import DataType, AnnotationType, SignalType, \
-    Writer, Reader, SummaryFSR, TimeMap, \
-    copy, \
+    Writer, Reader, SummaryFSR, SummaryField, FindPredicate, TimeMap, \
+    concat, copy, copy_slice, \
     data_type_as_enum, data_type_as_str, \
     utc_to_jls, jls_to_utc
 from .structs import SourceDef, SignalDef
@@ -22,8 +22,8 @@ from . import time64
 from .version import *
 
 __all__ = ['Writer', 'Reader', 'DataType', 'AnnotationType', 'TimeMap',
-           'SignalType', 'SourceDef', 'SignalDef', 'SummaryFSR',
-           'copy',
+           'SignalType', 'SourceDef', 'SignalDef', 'SummaryFSR', 'SummaryField', 'FindPredicate',
+           'concat', 'copy', 'copy_slice',
            'data_type_as_enum', 'data_type_as_str',
            'utc_to_jls', 'jls_to_utc',
            'time64',
@@ -23,6 +23,7 @@ Python binding for the native JLS implementation.
 from libc.stdint cimport uint8_t, uint16_t, uint32_t, uint64_t, int32_t, int64_t
 from libc.float cimport DBL_MAX
 from libc.math cimport isfinite, NAN
+from cpython.mem cimport PyMem_Malloc, PyMem_Free
 
 from collections.abc import Iterable, Mapping
 import json
@@ -36,7 +37,7 @@ from .structs import SourceDef, SignalDef
 
 __all__ = ['DataType', 'AnnotationType', 'SignalType', 'Writer', 'Reader',
            'TimeMap',
-           'SourceDef', 'SignalDef', 'SummaryFSR', 'jls_inject_log',
+           'SourceDef', 'SignalDef', 'SummaryFSR', 'SummaryField', 'FindPredicate', 'jls_inject_log',
            'copy',
            'data_type_as_enum', 'data_type_as_str']
 
@@ -194,6 +195,39 @@ class SummaryFSR:
     COUNT = c_jls.JLS_SUMMARY_FSR_COUNT
 
 
+class SummaryField:
+    """The optional summary field flags, see SignalDef.summary_fields."""
+    SUM = c_jls.JLS_SUMMARY_FIELD_SUM
+    RMS = c_jls.JLS_SUMMARY_FIELD_RMS
+    FINITE = c_jls.JLS_SUMMARY_FIELD_FINITE
+    FIRST = c_jls.JLS_SUMMARY_FIELD_FIRST
+    LAST = c_jls.JLS_SUMMARY_FIELD_LAST
+    ALL = c_jls.JLS_SUMMARY_FIELD_ALL
+    F64 = c_jls.JLS_SUMMARY_FIELD_F64
+
+
+class FindPredicate:
+    """The threshold search predicates for Reader.fsr_find()."""
+    GT = c_jls.JLS_RD_FIND_GT
+    LT = c_jls.JLS_RD_FIND_LT
+    CROSS = c_jls.JLS_RD_FIND_CROSS
+
+
+_find_predicate_map = {
+    '>': FindPredicate.GT,
+    'gt': FindPredicate.GT,
+    '<': FindPredicate.LT,
+    'lt': FindPredicate.LT,
+    'cross': FindPredicate.CROSS,
+}
+
+
+def _find_predicate(predicate):
+    if isinstance(predicate, str):
+        return _find_predicate_map[predicate.lower()]
+    return int(predicate)
+
+
 cdef void _log_cbk(const char * msg) noexcept nogil:
     with gil:
         m = msg.decode('utf-8').strip()
@@ -270,25 +304,66 @@ def _handle_rc(name, rc):
     raise RuntimeError(f'{name} {rc_name}[{rc}]: {rc_descr}')
 
 
+cdef _stats_to_dict(c_jls.jls_stats_s * s):
+    chunk_rd = {}
+    chunk_wr = {}
+    for tag in range(c_jls.JLS_STATS_TAG_COUNT):
+        name = c_jls.jls_tag_to_name(tag).decode('utf-8')
+        if s.chunk_rd[tag]:
+            chunk_rd[name] = s.chunk_rd[tag]
+        if s.chunk_wr[tag]:
+            chunk_wr[name] = s.chunk_wr[tag]
+    return {
+        'chunk_rd': chunk_rd,
+        'chunk_wr': chunk_wr,
+        'header_rd': s.header_rd,
+        'bytes_rd': s.bytes_rd,
+        'bytes_wr': s.bytes_wr,
+        'seeks': s.seeks,
+        'writes': s.writes,
+        'crc_time': s.crc_time / SECOND,
+        'summary_time': s.summary_time / SECOND,
+        'fsr_statistics': s.fsr_statistics,
+        'fsr_statistics_time': s.fsr_statistics_time / SECOND,
+        'fsr_statistics_level0': s.fsr_statistics_level0,
+        'fsr_reconstructed': s.fsr_reconstructed,
+    }
+
+
 cdef class Writer:
     """Create a new JLS writer.
 
     :param path: The output JLS file path.
+    :param append: When True, open the existing JLS file at path
+        and append to its signals, annotations, UTC, and user data.
     """
     cdef c_jls.jls_twr_s * _wr
     cdef c_jls.jls_signal_def_s _signals[_JLS_SIGNAL_COUNT]
 
     FLAG_DROP_ON_OVERFLOW = c_jls.JLS_TWR_FLAG_DROP_ON_OVERFLOW
+    DURABILITY_FLUSH = c_jls.JLS_TWR_DURABILITY_FLUSH
+    DURABILITY_NONE = c_jls.JLS_TWR_DURABILITY_NONE
+    DURABILITY_PERIODIC = c_jls.JLS_TWR_DURABILITY_PERIODIC
 
-    def __init__(self, path: str):
+    def __init__(self, path: str, append=False):
         cdef c_jls.jls_twr_s ** wr_ptr = &self._wr
         cdef int32_t rc
         cdef const uint8_t[:] path_u8
+        cdef bint is_append = bool(append)
         path_bytes = path.encode('utf-8')
         path_u8 = path_bytes
         self._signals[0].signal_type = c_jls.JLS_SIGNAL_TYPE_VSR
+        if is_append:
+            with Reader(path) as r:
+                for signal_id, signal_def in r.signals.items():
+                    self._signals[signal_id].signal_id = signal_id
+                    self._signals[signal_id].signal_type = signal_def.signal_type
+                    self._signals[signal_id].data_type = signal_def.data_type
         with nogil:
-            rc = c_jls.jls_twr_open(wr_ptr, <char *> &path_u8[0])
+            if is_append:
+                rc = c_jls.jls_twr_open_append(wr_ptr, <char *> &path_u8[0])
+            else:
+                rc = c_jls.jls_twr_open(wr_ptr, <char *> &path_u8[0])
         _handle_rc('open', rc)
 
     def __enter__(self):
@@ -319,6 +394,48 @@ cdef class Writer:
         with nogil:
             c_jls.jls_twr_flush(wr)
 
+    def checkpoint_interval(self, interval):
+        """Configure the periodic recovery checkpoints.
+
+        :param interval: The minimum number of bytes written between
+            checkpoints, or 0 to disable.
+
+        When the file is not closed, the reader recovers from the
+        most recent checkpoint rather than repairing the entire file.
+        """
+        cdef int32_t rc
+        rc = c_jls.jls_twr_checkpoint_interval(self._wr, interval)
+        _handle_rc('checkpoint_interval', rc)
+
+    def durability(self, mode, period=0, size=0):
+        """Configure when the writer persists the file to the storage device.
+
+        :param mode: One of DURABILITY_FLUSH (default), which persists on
+            each flush, DURABILITY_NONE or DURABILITY_PERIODIC.
+        :param period: For DURABILITY_PERIODIC, the maximum duration
+            in seconds between syncs, or 0 to disable.
+        :param size: For DURABILITY_PERIODIC, the maximum bytes
+            written between syncs, or 0 to disable.
+
+        The writer thread performs the periodic syncs, so adding
+        samples never waits for the storage device.
+        """
+        cdef int32_t rc
+        rc = c_jls.jls_twr_durability(self._wr, mode, int(period * SECOND), size)
+        _handle_rc('durability', rc)
+
+    def write_buffer(self, size):
+        """Configure the write-behind buffer.
+
+        :param size: The buffer size in bytes, or 0 to disable.
+
+        The buffer coalesces chunks into large file writes.  Readers
+        following the file only see the buffered data after flush.
+        """
+        cdef int32_t rc
+        rc = c_jls.jls_twr_write_buffer(self._wr, size)
+        _handle_rc('write_buffer', rc)
+
     def source_def(self, source_id, name=None, vendor=None, model=None, version=None, serial_number=None):
         """Define a source."""
         cdef int32_t rc
@@ -349,7 +466,9 @@ cdef class Writer:
     def signal_def(self, signal_id, source_id, signal_type=None, data_type=None, sample_rate=None,
                    samples_per_data=None, sample_decimate_factor=None, entries_per_summary=None,
                    summary_decimate_factor=None, annotation_decimate_factor=None, utc_decimate_factor=None,
-                   name=None, units=None):
+                   name=None, units=None, summary_fields=None,
+                   summary_hist_bins=None, summary_hist_level=None,
+                   summary_hist_min=None, summary_hist_max=None):
         """Define a signal."""
         cdef int32_t rc
         cdef c_jls.jls_signal_def_s * s
@@ -369,6 +488,11 @@ cdef class Writer:
         s.summary_decimate_factor = 0 if summary_decimate_factor is None else int(summary_decimate_factor)
         s.annotation_decimate_factor = 0 if annotation_decimate_factor is None else int(annotation_decimate_factor)
         s.utc_decimate_factor = 0 if utc_decimate_factor is None else int(utc_decimate_factor)
+        s.summary_fields = 0 if summary_fields is None else int(summary_fields)
+        s.summary_hist_bins = 0 if summary_hist_bins is None else int(summary_hist_bins)
+        s.summary_hist_level = 0 if summary_hist_level is None else int(summary_hist_level)
+        s.summary_hist_min = 0.0 if summary_hist_min is None else float(summary_hist_min)
+        s.summary_hist_max = 0.0 if summary_hist_max is None else float(summary_hist_max)
         name_b = _encode_str(name)
         units_b = _encode_str(units)
         s.name = name_b
@@ -390,7 +514,12 @@ cdef class Writer:
                                annotation_decimate_factor=s.annotation_decimate_factor,
                                utc_decimate_factor=s.utc_decimate_factor,
                                name=s.name,
-                               units=s.units)
+                               units=s.units,
+                               summary_fields=s.summary_fields,
+                               summary_hist_bins=s.summary_hist_bins,
+                               summary_hist_level=s.summary_hist_level,
+                               summary_hist_min=s.summary_hist_min,
+                               summary_hist_max=s.summary_hist_max)
 
     def user_data(self, chunk_meta, data):
         """Add user data to the file.
@@ -520,6 +649,48 @@ cdef class Writer:
             rc = c_jls.jls_twr_utc(wr, signal_id_u16, sample_id_i64, utc_i64c)
         _handle_rc('utc', rc)
 
+    def stats_enable(self, enable=True):
+        """Enable or disable the instrumentation counters.
+
+        :param enable: True to enable and reset all counters.
+            False to disable.
+        :raise: On error.
+        """
+        cdef c_jls.jls_twr_s * wr = self._wr
+        cdef int enable_c = 1 if bool(enable) else 0
+        cdef int32_t rc
+        with nogil:
+            rc = c_jls.jls_twr_stats_enable(wr, enable_c)
+        _handle_rc('stats_enable', rc)
+
+    def stats(self):
+        """Get a snapshot of the instrumentation counters.
+
+        :return: The counters dict.  Durations are in seconds.
+            latency_histogram[0] counts queue latencies under 1 µs,
+            and latency_histogram[k] counts [2**(k-1), 2**k) µs.
+        :raise: If not enabled with :meth:`stats_enable`.
+        """
+        cdef c_jls.jls_twr_s * wr = self._wr
+        cdef c_jls.jls_twr_stats_s s
+        cdef int32_t rc
+        with nogil:
+            rc = c_jls.jls_twr_stats(wr, &s)
+        _handle_rc('stats', rc)
+        result = _stats_to_dict(&s.wr)
+        result.update({
+            'msg_count': s.msg_count,
+            'ring_size': s.ring_size,
+            'ring_high_water': s.ring_high_water,
+            'dropped_msgs': s.dropped_msgs,
+            'dropped_samples': s.dropped_samples,
+            'latency_histogram': [s.latency_histogram[i] for i in range(c_jls.JLS_STATS_LATENCY_BINS)],
+            'latency_max': s.latency_max / SECOND,
+            'syncs': s.syncs,
+            'sync_time': s.sync_time / SECOND,
+        })
+        return result
+
 
 cdef class AnnotationCallback:
     cdef uint8_t is_fsr
@@ -540,12 +711,27 @@ cdef class Reader:
     """Open a JLS v2 file for reading.
 
     :param path: The path to the JLS file.
+    :param follow: True to follow a file that may still be written.
+        Call :meth:`follow_update` to consume newly appended contents.
+    :param readonly: True to never modify the file.  A file that was
+        not properly closed is recovered in memory rather than repaired.
     """
     cdef c_jls.jls_rd_s * _rd
     cdef object _sources
     cdef object _signals
 
-    def __init__(self, path: str):
+    def __init__(self, path: str, follow=False, readonly=False):
+        cdef int32_t rc
+        if bool(follow):
+            rc = c_jls.jls_rd_open_follow(&self._rd, path.encode('utf-8'))
+        elif bool(readonly):
+            rc = c_jls.jls_rd_open_readonly(&self._rd, path.encode('utf-8'))
+        else:
+            rc = c_jls.jls_rd_open(&self._rd, path.encode('utf-8'))
+        _handle_rc('open', rc)
+        self._defs_load()
+
+    def _defs_load(self):
         cdef int32_t rc
         cdef c_jls.jls_source_def_s * sources
         cdef c_jls.jls_signal_def_s * signals
@@ -553,9 +739,6 @@ cdef class Reader:
         cdef int64_t samples
         self._sources: Mapping[int, SourceDef] = {}
         self._signals: Mapping[int, SignalDef] = {}
-        rc = c_jls.jls_rd_open(&self._rd, path.encode('utf-8'))
-        _handle_rc('open', rc)
-
         rc = c_jls.jls_rd_sources(self._rd, &sources, &count)
         _handle_rc('rd_sources', rc)
         for i in range(count):
@@ -584,6 +767,11 @@ cdef class Reader:
                 summary_decimate_factor=signals[i].summary_decimate_factor,
                 annotation_decimate_factor=signals[i].annotation_decimate_factor,
                 utc_decimate_factor=signals[i].utc_decimate_factor,
+                summary_fields=signals[i].summary_fields,
+                summary_hist_bins=signals[i].summary_hist_bins,
+                summary_hist_level=signals[i].summary_hist_level,
+                summary_hist_min=signals[i].summary_hist_min,
+                summary_hist_max=signals[i].summary_hist_max,
                 sample_id_offset=signals[i].sample_id_offset,
                 name=signals[i].name.decode('utf-8'),
                 units=signals[i].units.decode('utf-8'))
@@ -603,6 +791,19 @@ cdef class Reader:
         """Close the JLS file and free all resources."""
         c_jls.jls_rd_close(self._rd)
 
+    def follow_update(self):
+        """Consume contents appended since the last update.
+
+        :raise: If not opened with follow=True or on error.
+
+        Updates :attr:`sources`, :attr:`signals` and the signal lengths.
+        """
+        cdef int32_t rc
+        with nogil:
+            rc = c_jls.jls_rd_follow_update(self._rd)
+        _handle_rc('follow_update', rc)
+        self._defs_load()
+
     @property
     def sources(self) -> Mapping[int, SourceDef]:
         """Return the dict mapping source_id to SourceDef."""
@@ -679,15 +880,17 @@ cdef class Reader:
             pass
         raise ValueError(f'signal_lookup failed for {spec}')
 
-    def fsr(self, signal_id, start_sample_id, length):
+    def fsr(self, signal_id, start_sample_id, length, unpack=False):
         """Read the FSR data.
 
         :param signal_id: The signal id.
         :param start_sample_id: The starting sample id to read.
         :param length: The number of samples to read.
+        :param unpack: When True, return u1 and u4 data as one np.uint8
+            per sample, unpacked in the native library.
         :return: The data, which varies depending upon the FSR data type.
 
-            u1 and u4 data will be packed in little endian order.
+            Unless unpack, u1 and u4 data will be packed in little endian order.
 
             For u1, unpack with:
                 np.unpackbits(y, bitorder='little')[:len(x)]
@@ -709,6 +912,15 @@ cdef class Reader:
 
         data_type = self._signals[signal_id].data_type
         entry_size_bits = (data_type >> 8) & 0xff
+        if unpack and entry_size_bits in [1, 4]:
+            data = np.empty(length, dtype=np.uint8)
+            if length <= 0:
+                return data
+            u8 = data
+            with nogil:
+                rc = c_jls.jls_rd_fsr_u8(self._rd, signal_id_u16, start_sample_id_i64, &u8[0], length_i64)
+            _handle_rc('rd_fsr_u8', rc)
+            return data
         np_type = _data_type_map[data_type & 0xffff]
         u8_length = length
         if entry_size_bits == 4:
@@ -726,7 +938,48 @@ cdef class Reader:
         _handle_rc('rd_fsr', rc)
         return data
 
-    def fsr_statistics(self, signal_id, start_sample_id, increment, length):
+    def fsr_as_float(self, signal_id, start_sample_id, length, dtype=None):
+        """Read the FSR data converted to floating point.
+
+        :param signal_id: The signal id.
+        :param start_sample_id: The starting sample id to read.
+        :param length: The number of samples to read.
+        :param dtype: The output data type, either np.float32 (default)
+            or np.float64.
+        :return: The data as a 1-D numpy array of dtype.
+
+        Unlike fsr(), this method unpacks u1, u4, and i4 data
+        and applies any fixed-point scaling in the native library,
+        which avoids the additional numpy conversion passes.
+        """
+        cdef int32_t rc
+        cdef np.float32_t [::1] c_f32
+        cdef np.float64_t [::1] c_f64
+        cdef uint16_t signal_id_u16 = signal_id
+        cdef int64_t start_sample_id_i64 = start_sample_id
+        cdef int64_t length_i64 = length
+
+        dtype = np.float32 if dtype is None else np.dtype(dtype).type
+        if dtype == np.float32:
+            data = np.empty(length, dtype=np.float32)
+            if length <= 0:
+                return data
+            c_f32 = data
+            with nogil:
+                rc = c_jls.jls_rd_fsr_as_f32(self._rd, signal_id_u16, start_sample_id_i64, &c_f32[0], length_i64)
+        elif dtype == np.float64:
+            data = np.empty(length, dtype=np.float64)
+            if length <= 0:
+                return data
+            c_f64 = data
+            with nogil:
+                rc = c_jls.jls_rd_fsr_as_f64(self._rd, signal_id_u16, start_sample_id_i64, &c_f64[0], length_i64)
+        else:
+            raise ValueError(f'unsupported dtype {dtype}')
+        _handle_rc('rd_fsr_as_float', rc)
+        return data
+
+    def fsr_statistics(self, signal_id, start_sample_id, increment, length, fields=None):
         """Read FSR statistics (mean, stdev, min, max).
 
         :param signal_id: The signal id for a fixed sampling rate (FSR) signal.
@@ -734,6 +987,9 @@ cdef class Reader:
             The sample_id of the first recorded sample in a signal is 0.
         :param increment: The number of samples represented per return value.
         :param length: The number of return values to generate.
+        :param fields: The optional SummaryField flags to append as
+            additional columns in flag order.  The signal must store
+            these fields, see SignalDef.summary_fields.
         :return: The 2-D array[summary][stat] of np.float32.
             * Each summary entry represents the statistics computed
               approximately over increment samples starting
@@ -757,15 +1013,116 @@ cdef class Reader:
         cdef int64_t start_sample_id_i64 = start_sample_id
         cdef int64_t increment_i64 = increment
         cdef int64_t length_i64 = length
+        cdef uint32_t fields_u32 = 0 if fields is None else int(fields)
 
-        data = np.empty((length, c_jls.JLS_SUMMARY_FSR_COUNT), dtype=np.float64)
+        columns = c_jls.JLS_SUMMARY_FSR_COUNT + bin(fields_u32).count('1')
+        data = np.empty((length, columns), dtype=np.float64)
         c_data = data
         with nogil:
-            rc = c_jls.jls_rd_fsr_statistics(self._rd, signal_id_u16, start_sample_id_i64,
-                                             increment_i64, &c_data[0, 0], length_i64)
+            rc = c_jls.jls_rd_fsr_statistics_ext(self._rd, signal_id_u16, start_sample_id_i64,
+                                                 increment_i64, fields_u32, &c_data[0, 0], length_i64)
         _handle_rc('rd_fsr_statistics', rc)
         return data
 
+    def fsr_quantiles(self, signal_id, start_sample_id, length, q):
+        """Compute FSR quantiles over a sample window.
+
+        :param signal_id: The signal id for a fixed sampling rate (FSR) signal.
+            The signal must store summary histograms,
+            see SignalDef.summary_hist_bins.
+        :param start_sample_id: The starting sample id.
+            The sample_id of the first recorded sample in a signal is 0.
+        :param length: The number of samples in the window.
+        :param q: The quantile or iterable of quantiles, each from 0.0 to 1.0.
+        :return: The np.float64 array of quantile values, one for each q.
+
+        The quantiles are computed from the summary histograms, so the
+        accuracy is limited by the histogram bin width.  For fixed-point
+        data types, the quantiles are in unscaled integer units, like
+        fsr_statistics().
+        """
+        cdef int32_t rc
+        cdef np.float64_t [:] c_q
+        cdef np.float64_t [:] c_data
+        cdef uint16_t signal_id_u16 = signal_id
+        cdef int64_t start_sample_id_i64 = start_sample_id
+        cdef int64_t length_i64 = length
+        cdef uint32_t q_count
+
+        q_arr = np.array(q, dtype=np.float64, ndmin=1)
+        q_count = len(q_arr)
+        data = np.empty(q_count, dtype=np.float64)
+        if not q_count:
+            return data
+        c_q = q_arr
+        c_data = data
+        with nogil:
+            rc = c_jls.jls_rd_fsr_quantiles(self._rd, signal_id_u16, start_sample_id_i64, length_i64,
+                                            &c_q[0], &c_data[0], q_count)
+        _handle_rc('rd_fsr_quantiles', rc)
+        return data
+
+    def fsr_find(self, signal_id, start_sample_id, end_sample_id, predicate, threshold):
+        """Find the first sample that matches a threshold predicate.
+
+        :param signal_id: The signal id for a fixed sampling rate (FSR) signal.
+        :param start_sample_id: The first sample id to search.
+        :param end_sample_id: The sample id just past the search window.
+        :param predicate: The FindPredicate or one of '>', '<', 'cross'.
+        :param threshold: The threshold value.  For fixed-point data
+            types, use unscaled integer units, like fsr_statistics().
+        :return: The first matching sample id or None.
+
+        The search skips every summary entry whose range cannot match,
+        so it only reads sample data near the match.
+        """
+        cdef int32_t rc
+        cdef uint16_t signal_id_u16 = signal_id
+        cdef int64_t start_i64 = start_sample_id
+        cdef int64_t end_i64 = end_sample_id
+        cdef uint8_t predicate_u8 = _find_predicate(predicate)
+        cdef double threshold_f64 = threshold
+        cdef int64_t sample_id = 0
+        with nogil:
+            rc = c_jls.jls_rd_fsr_find(self._rd, signal_id_u16, start_i64, end_i64,
+                                       predicate_u8, threshold_f64, &sample_id)
+        if rc == c_jls.JLS_ERROR_NOT_FOUND:
+            return None
+        _handle_rc('rd_fsr_find', rc)
+        return sample_id
+
+    def fsr_find_intervals(self, signal_id, start_sample_id, end_sample_id, predicate, threshold):
+        """Find all intervals that match a threshold predicate.
+
+        :param signal_id: The signal id for a fixed sampling rate (FSR) signal.
+        :param start_sample_id: The first sample id to search.
+        :param end_sample_id: The sample id just past the search window.
+        :param predicate: The FindPredicate or one of '>', '<', 'cross'.
+        :param threshold: The threshold value.
+        :return: The list of (start, end) sample id intervals.  For '>'
+            and '<', each interval contains consecutive matching samples.
+            For 'cross', each interval spans from one crossing to the next.
+        """
+        cdef int32_t rc
+        cdef c_jls.jls_rd_fsr_find_iter_s * it = NULL
+        cdef int64_t i0 = 0
+        cdef int64_t i1 = 0
+        rc = c_jls.jls_rd_fsr_find_iter_open(self._rd, signal_id, start_sample_id, end_sample_id,
+                                             _find_predicate(predicate), threshold, &it)
+        _handle_rc('rd_fsr_find_iter_open', rc)
+        result = []
+        try:
+            while True:
+                with nogil:
+                    rc = c_jls.jls_rd_fsr_find_iter_next(it, &i0, &i1)
+                if rc == c_jls.JLS_ERROR_EMPTY:
+                    break
+                _handle_rc('rd_fsr_find_iter_next', rc)
+                result.append((i0, i1))
+        finally:
+            c_jls.jls_rd_fsr_find_iter_close(it)
+        return result
+
     def annotations(self, signal_id, timestamp, cbk_fn):
         """Read annotations from a signal.
 
@@ -896,6 +1253,40 @@ cdef class Reader:
             out[i][1] = time_map.timestamp
         return out
 
+    def threads_set(self, thread_count):
+        """Set the number of threads for large statistics requests.
+
+        :param thread_count: The number of worker threads, up to 64.
+            0 or 1 computes statistics on the calling thread.
+        :raise: On error.
+
+        Large :meth:`fsr_statistics` requests are split across the
+        workers.  The results are identical to the single-threaded results.
+        """
+        rc = c_jls.jls_rd_threads_set(self._rd, <uint32_t> thread_count)
+        _handle_rc('threads_set', rc)
+
+    def stats_enable(self, enable=True):
+        """Enable or disable the instrumentation counters.
+
+        :param enable: True to enable and reset all counters.
+            False to disable.
+        :raise: On error.
+        """
+        rc = c_jls.jls_rd_stats_enable(self._rd, 1 if bool(enable) else 0)
+        _handle_rc('stats_enable', rc)
+
+    def stats(self):
+        """Get a snapshot of the instrumentation counters.
+
+        :return: The counters dict.  Durations are in seconds.
+        :raise: If not enabled with :meth:`stats_enable`.
+        """
+        cdef c_jls.jls_stats_s s
+        rc = c_jls.jls_rd_stats(self._rd, &s)
+        _handle_rc('stats', rc)
+        return _stats_to_dict(&s)
+
 
 class TimeMap:
     """A time map class compatible with pyjoulescope_driver.TimeMap."""
@@ -998,3 +1389,61 @@ def copy(src, dst, msg_fn=None, progress_fn=None):
     rc = c_jls.jls_copy(c_src, c_dst, _copy_msg_fn, <void *> msg_fn, _copy_progress_fn, <void *> progress_fn)
     if rc:
         raise RuntimeError(f'Could not copy: {rc}')
+
+
+def copy_slice(src, dst, signal_ids=None, start_sample_id=0, end_sample_id=-1):
+    """Copy a sample range of selected FSR signals to a new JLS file.
+
+    :param src: The source path.
+    :param dst: The destination path.
+    :param signal_ids: The iterable of FSR signal ids to copy.
+        None (default) copies all FSR signals.
+    :param start_sample_id: The zero-based starting sample id, inclusive.
+    :param end_sample_id: The zero-based ending sample id, exclusive.
+        -1 (default) copies to the end of each signal.
+
+    When start_sample_id is a multiple of samples_per_data, the stored
+    data chunks and their summaries are copied without decoding.
+    """
+    cdef const char * c_src
+    cdef const char * c_dst
+    cdef np.uint16_t [::1] c_ids
+    cdef const uint16_t * c_ids_ptr = NULL
+    src_encode = src.encode('utf-8')
+    dst_encode = dst.encode('utf-8')
+    c_src = src_encode
+    c_dst = dst_encode
+    ids = np.array([] if signal_ids is None else list(signal_ids), dtype=np.uint16)
+    c_ids = ids
+    if len(ids):
+        c_ids_ptr = &c_ids[0]
+    rc = c_jls.jls_slice(c_src, c_dst, c_ids_ptr, <uint32_t> len(ids), start_sample_id, end_sample_id)
+    if rc:
+        raise RuntimeError(f'Could not slice: {rc}')
+
+
+def concat(src, dst):
+    """Concatenate JLS files in time order into a new JLS file.
+
+    :param src: The list of source paths, in order.  All sources must
+        define the same FSR signals.
+    :param dst: The destination path.
+
+    Each source's samples follow the previous source's samples.
+    """
+    cdef const char ** c_src
+    cdef const char * c_dst
+    src_encode = [s.encode('utf-8') for s in src]
+    dst_encode = dst.encode('utf-8')
+    c_dst = dst_encode
+    c_src = <const char **> PyMem_Malloc(len(src_encode) * sizeof(char *))
+    if not c_src:
+        raise MemoryError()
+    try:
+        for idx, s in enumerate(src_encode):
+            c_src[idx] = s
+        rc = c_jls.jls_concat(c_src, <uint32_t> len(src_encode), c_dst)
+    finally:
+        PyMem_Free(c_src)
+    if rc:
+        raise RuntimeError(f'Could not concat: {rc}')
@@ -16,6 +16,9 @@ from libc.stdint cimport uint8_t, uint16_t, uint32_t, uint64_t, int32_t, int64_t
 
 
 cdef extern from "jls/ec.h":
+    enum jls_error_code_e:
+        JLS_ERROR_EMPTY
+        JLS_ERROR_NOT_FOUND
     const char * jls_error_code_name(int ec)
     const char * jls_error_code_description(int ec)
 
@@ -62,6 +65,11 @@ cdef extern from "jls/format.h":
         int64_t sample_id_offset
         const char * name
         const char * units
+        uint32_t summary_fields
+        uint32_t summary_hist_bins
+        uint32_t summary_hist_level
+        float summary_hist_min
+        float summary_hist_max
 
     struct jls_annotation_s:
         int64_t timestamp
@@ -81,6 +89,15 @@ cdef extern from "jls/format.h":
         JLS_SUMMARY_FSR_MAX = 3
         JLS_SUMMARY_FSR_COUNT = 4
 
+    enum jls_summary_field_e:
+        JLS_SUMMARY_FIELD_SUM = (1 << 0)
+        JLS_SUMMARY_FIELD_RMS = (1 << 1)
+        JLS_SUMMARY_FIELD_FINITE = (1 << 2)
+        JLS_SUMMARY_FIELD_FIRST = (1 << 3)
+        JLS_SUMMARY_FIELD_LAST = (1 << 4)
+        JLS_SUMMARY_FIELD_ALL = 0x1f
+        JLS_SUMMARY_FIELD_F64 = (1 << 15)
+
     struct jls_utc_summary_entry_s:
         int64_t sample_id
         int64_t timestamp
@@ -97,15 +114,58 @@ cdef extern from "jls/time.h":
     int64_t jls_now()
 
 
+cdef extern from "jls/raw.h":
+    const char * jls_tag_to_name(uint8_t tag)
+
+
+cdef extern from "jls/stats.h":
+    enum:
+        JLS_STATS_TAG_COUNT
+        JLS_STATS_LATENCY_BINS
+    struct jls_stats_s:
+        uint64_t chunk_rd[JLS_STATS_TAG_COUNT]
+        uint64_t chunk_wr[JLS_STATS_TAG_COUNT]
+        uint64_t header_rd
+        uint64_t bytes_rd
+        uint64_t bytes_wr
+        uint64_t seeks
+        uint64_t writes
+        int64_t crc_time
+        int64_t summary_time
+        uint64_t fsr_statistics
+        int64_t fsr_statistics_time
+        uint64_t fsr_statistics_level0
+        uint64_t fsr_reconstructed
+
+
 cdef extern from "jls/threaded_writer.h":
     struct jls_twr_s
+    struct jls_twr_stats_s:
+        jls_stats_s wr
+        uint64_t msg_count
+        uint32_t ring_size
+        uint32_t ring_high_water
+        uint64_t dropped_msgs
+        uint64_t dropped_samples
+        uint64_t latency_histogram[JLS_STATS_LATENCY_BINS]
+        int64_t latency_max
+        uint64_t syncs
+        int64_t sync_time
     enum jls_twr_flag_e:
         JLS_TWR_FLAG_DROP_ON_OVERFLOW = (1 << 0)
+    enum jls_twr_durability_e:
+        JLS_TWR_DURABILITY_FLUSH = 0
+        JLS_TWR_DURABILITY_NONE = 1
+        JLS_TWR_DURABILITY_PERIODIC = 2
     int32_t jls_twr_open(jls_twr_s ** instance, const char * path) nogil
+    int32_t jls_twr_open_append(jls_twr_s ** instance, const char * path) nogil
     int32_t jls_twr_close(jls_twr_s * self) nogil
     uint32_t jls_twr_flags_get(jls_twr_s * self)
     int32_t jls_twr_flags_set(jls_twr_s * self, uint32_t flags)
     int32_t jls_twr_flush(jls_twr_s * self) nogil
+    int32_t jls_twr_checkpoint_interval(jls_twr_s * self, int64_t interval)
+    int32_t jls_twr_write_buffer(jls_twr_s * self, uint32_t size)
+    int32_t jls_twr_durability(jls_twr_s * self, int32_t mode, int64_t period, int64_t size)
     int32_t jls_twr_source_def(jls_twr_s * self, const jls_source_def_s * source)
     int32_t jls_twr_signal_def(jls_twr_s * self, const jls_signal_def_s * signal)
     int32_t jls_twr_user_data(jls_twr_s * self, uint16_t chunk_meta,
@@ -122,19 +182,45 @@ cdef extern from "jls/threaded_writer.h":
             const uint8_t * data, uint32_t data_size) nogil
     int32_t jls_twr_utc(jls_twr_s * self, uint16_t signal_id, 
                         int64_t sample_id, int64_t utc) nogil
+    int32_t jls_twr_stats_enable(jls_twr_s * self, int enable) nogil
+    int32_t jls_twr_stats(jls_twr_s * self, jls_twr_stats_s * stats) nogil
 
 
 cdef extern from "jls/reader.h":
     struct jls_rd_s
     int32_t jls_rd_open(jls_rd_s ** instance, const char * path)
+    int32_t jls_rd_open_follow(jls_rd_s ** instance, const char * path)
+    int32_t jls_rd_open_readonly(jls_rd_s ** instance, const char * path)
+    int32_t jls_rd_follow_update(jls_rd_s * self) nogil
     void jls_rd_close(jls_rd_s * self) nogil
     int32_t jls_rd_sources(jls_rd_s * self, jls_source_def_s ** sources, uint16_t * count)
     int32_t jls_rd_signals(jls_rd_s * self, jls_signal_def_s ** signals, uint16_t * count)
     int32_t jls_rd_signal(jls_rd_s * self, uint16_t signal_id, jls_signal_def_s * signal)
     int32_t jls_rd_fsr_length(jls_rd_s * self, uint16_t signal_id, int64_t * samples)
     int32_t jls_rd_fsr(jls_rd_s * self, uint16_t signal_id, int64_t start_sample_id, void * data, int64_t data_length) nogil
+    int32_t jls_rd_fsr_as_f32(jls_rd_s * self, uint16_t signal_id, int64_t start_sample_id, float * data, int64_t data_length) nogil
+    int32_t jls_rd_fsr_as_f64(jls_rd_s * self, uint16_t signal_id, int64_t start_sample_id, double * data, int64_t data_length) nogil
+    int32_t jls_rd_fsr_u8(jls_rd_s * self, uint16_t signal_id, int64_t start_sample_id, uint8_t * data, int64_t data_length) nogil
     int32_t jls_rd_fsr_statistics(jls_rd_s * self, uint16_t signal_id,
         int64_t start_sample_id, int64_t increment, double * data, int64_t data_length) nogil
+    int32_t jls_rd_fsr_statistics_ext(jls_rd_s * self, uint16_t signal_id,
+        int64_t start_sample_id, int64_t increment, uint32_t fields, double * data, int64_t data_length) nogil
+    int32_t jls_rd_fsr_quantiles(jls_rd_s * self, uint16_t signal_id,
+        int64_t start_sample_id, int64_t length, const double * q, double * data, uint32_t q_count) nogil
+    enum jls_rd_find_e:
+        JLS_RD_FIND_GT
+        JLS_RD_FIND_LT
+        JLS_RD_FIND_CROSS
+    int32_t jls_rd_fsr_find(jls_rd_s * self, uint16_t signal_id,
+        int64_t start_sample_id, int64_t end_sample_id,
+        uint8_t predicate, double threshold, int64_t * sample_id) nogil
+    struct jls_rd_fsr_find_iter_s
+    int32_t jls_rd_fsr_find_iter_open(jls_rd_s * self, uint16_t signal_id,
+        int64_t start_sample_id, int64_t end_sample_id,
+        uint8_t predicate, double threshold, jls_rd_fsr_find_iter_s ** iter)
+    int32_t jls_rd_fsr_find_iter_next(jls_rd_fsr_find_iter_s * iter,
+        int64_t * interval_start, int64_t * interval_end) nogil
+    void jls_rd_fsr_find_iter_close(jls_rd_fsr_find_iter_s * iter)
     ctypedef int32_t (*jls_rd_annotation_cbk_fn)(void * user_data, const jls_annotation_s * annotation)
     int32_t jls_rd_annotations(jls_rd_s * self, uint16_t signal_id,
         int64_t timestamp, jls_rd_annotation_cbk_fn cbk_fn, void * cbk_user_data) nogil
@@ -151,6 +237,9 @@ cdef extern from "jls/reader.h":
     int32_t jls_rd_timestamp_to_sample_id(jls_rd_s * self, uint16_t signal_id,
                                           int64_t timestamp, int64_t * sample_id)
     int32_t jls_rd_tmap_get(jls_rd_s * self, uint16_t signal_id, size_t index, jls_utc_summary_entry_s * entry)
+    int32_t jls_rd_threads_set(jls_rd_s * self, uint32_t thread_count)
+    int32_t jls_rd_stats_enable(jls_rd_s * self, int enable)
+    int32_t jls_rd_stats(jls_rd_s * self, jls_stats_s * stats)
 
 cdef extern from "jls/copy.h":
     ctypedef int32_t (*jls_copy_msg_fn)(void * user_data, const char * msg)
@@ -158,3 +247,7 @@ cdef extern from "jls/copy.h":
     int32_t jls_copy(const char * src, const char * dst,
                      jls_copy_msg_fn msg_fn, void * msg_user_data,
                      jls_copy_progress_fn progress_fn, void * progress_user_data)
+    int32_t jls_slice(const char * src, const char * dst,
+                      const uint16_t * signal_ids, uint32_t signal_count,
+                      int64_t start_sample_id, int64_t end_sample_id)
+    int32_t jls_concat(const char * const * src, uint32_t src_count, const char * dst)
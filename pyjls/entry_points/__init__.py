@@ -12,9 +12,9 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
-from . import annotate, copy, csv, export, extract, info, plot, timestamp_patch
+from . import annotate, concat, copy, csv, export, extract, info, plot, timestamp_patch
 
-__all__ = [annotate, copy, csv, export, extract, info, plot, timestamp_patch]
+__all__ = [annotate, concat, copy, csv, export, extract, info, plot, timestamp_patch]
 """This list of available command modules.  Each module must contain a 
 parser_config(subparser) function.  The function must return the callable(args)
 that will be executed for the command."""
@@ -0,0 +1,30 @@
+# Copyright 2026 Jetperch LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+from pyjls import concat
+
+
+def parser_config(p):
+    """Concatenate JLS files in time order into a new JLS file."""
+    p.add_argument('src',
+                   nargs='+',
+                   help='The JLS input filenames, in order.')
+    p.add_argument('dst',
+                   help='The JLS output filename.')
+    return on_cmd
+
+
+def on_cmd(args):
+    concat(args.src, args.dst)
+    return 0
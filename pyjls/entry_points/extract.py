@@ -15,7 +15,7 @@
 
 """Extract data from a JLS file into a new JLS file."""
 
-from pyjls import Reader, Writer, time64
+from pyjls import Reader, Writer, copy_slice, time64
 from datetime import datetime
 import sys
 
@@ -135,6 +135,17 @@ def on_cmd(args):
     verbose(f'sources: {sources_used}')
     verbose(f'signals: {signals_used}')
 
+    ranges = set()
+    for signal_id in signals_used:
+        ranges.add((r.timestamp_to_sample_id(signal_id, t64_start), r.timestamp_to_sample_id(signal_id, t64_stop)))
+    if len(ranges) == 1:
+        # same sample range for all signals: copy whole data chunks and their summaries
+        offset, offset_end = ranges.pop()
+        verbose(f'Slice samples {offset} to {offset_end}')
+        copy_slice(args.input, args.output, sorted(signals_used), offset, offset_end + 1)
+        verbose('Export complete')
+        return 0
+
     verbose('Create JLS file')
     w = Writer(args.output)
     for source_id in sources_used:  # Create sources
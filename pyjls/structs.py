@@ -58,6 +58,11 @@ class SignalDef:
     :ivar summary_decimate_factor: The number of summaries per summary, level >= 2.
     :ivar annotation_decimate_factor: The annotation decimate factor for summaries.
     :ivar utc_decimate_factor: The UTC decimate factor for summaries.
+    :ivar summary_fields: The SummaryField optional summary fields.  (FSR only)
+    :ivar summary_hist_bins: The summary histogram bins, 0 to disable.  (FSR only)
+    :ivar summary_hist_level: The first summary level with histograms.  (FSR only)
+    :ivar summary_hist_min: The lower edge of the first histogram bin.  (FSR only)
+    :ivar summary_hist_max: The upper edge of the last histogram bin.  (FSR only)
     :ivar sample_id_offset: The sample id offset for the first sample.  (FSR only)
     :ivar name: The signal name string.
     :ivar units: The signal units string.
@@ -74,6 +79,11 @@ class SignalDef:
     summary_decimate_factor: int = 0
     annotation_decimate_factor: int = 0
     utc_decimate_factor: int = 0
+    summary_fields: int = 0
+    summary_hist_bins: int = 0
+    summary_hist_level: int = 0
+    summary_hist_min: float = 0.0
+    summary_hist_max: float = 0.0
     sample_id_offset: int = 0
     name: str = None
     units: str = None
@@ -89,7 +99,8 @@ class SignalDef:
                           'samples_per_data', 'sample_decimate_factor',
                           'entries_per_summary', 'summary_decimate_factor',
                           'annotation_decimate_factor', 'utc_decimate_factor',
-                          'sample_id_offset',
+                          'summary_fields', 'summary_hist_bins', 'summary_hist_level',
+                          'summary_hist_min', 'summary_hist_max', 'sample_id_offset',
                           'units', 'length']:
                 strs.append(f'    {field}: {getattr(self, field)}')
         return '\n'.join(strs)
@@ -12,7 +12,7 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
-from pyjls.binding import Writer, Reader, SummaryFSR, DataType, jls_inject_log, copy, TimeMap
+from pyjls.binding import Writer, Reader, SummaryFSR, SummaryField, FindPredicate, DataType, jls_inject_log, concat, copy, copy_slice, TimeMap
 from pyjls.time64 import SECOND, YEAR
 import io
 import logging
@@ -131,6 +131,7 @@ class TestBinding(unittest.TestCase):
             dst = r.fsr(3, 0, s.length)
             dst_data = np.unpackbits(dst, count=s.length, bitorder='little')
             np.testing.assert_allclose(data, dst_data)
+            np.testing.assert_equal(data[3:], r.fsr(3, 3, s.length - 3, unpack=True))
 
             stats = r.fsr_statistics(3, 0, s.length, 1)
             np.testing.assert_allclose(np.mean(data), stats[0, SummaryFSR.MEAN])
@@ -308,6 +309,48 @@ class TestBinding(unittest.TestCase):
             os.remove(dst.name)
         self.assertEqual(1.0, progresses[-1])
 
+    def test_copy_slice(self):
+        data = np.arange(110000, dtype=np.float32)
+        with Writer(self._path) as w:
+            w.source_def(source_id=1, name='name', vendor='vendor', model='model',
+                         version='version', serial_number='serial_number')
+            w.signal_def(3, source_id=1, sample_rate=1000000, name='current', units='A')
+            w.fsr(3, 0, data)
+
+        dst = tempfile.NamedTemporaryFile(delete=False, suffix='.jls')
+        dst.close()
+        try:
+            copy_slice(self._path, dst.name, [3], 1000, 101234)
+            with Reader(dst.name) as r:
+                self.assertEqual(100234, r.signals[3].length)
+                np.testing.assert_allclose(data[1000:101234], r.fsr(3, 0, 100234))
+            with self.assertRaises(RuntimeError):
+                copy_slice(self._path, dst.name, [2])
+        finally:
+            os.remove(dst.name)
+
+    def test_concat(self):
+        data = np.arange(110000, dtype=np.float32)
+        paths = []
+        try:
+            for idx in range(3):
+                f = tempfile.NamedTemporaryFile(delete=False, suffix='.jls')
+                f.close()
+                paths.append(f.name)
+            for idx, (start, end) in enumerate([(0, 50000), (50000, 80001), (80001, 110000)]):
+                with Writer(paths[idx]) as w:
+                    w.source_def(source_id=1, name='name', vendor='vendor', model='model',
+                                 version='version', serial_number='serial_number')
+                    w.signal_def(3, source_id=1, sample_rate=1000000, name='current', units='A')
+                    w.fsr(3, 0, data[start:end])
+            concat(paths, self._path)
+            with Reader(self._path) as r:
+                self.assertEqual(len(data), r.signals[3].length)
+                np.testing.assert_allclose(data, r.fsr(3, 0, len(data)))
+        finally:
+            for path in paths:
+                os.remove(path)
+
     def test_signal_lookup(self):
         with Writer(self._path) as w:
             w.source_def(source_id=1, name='src1', vendor='vendor', model='model',
@@ -334,3 +377,126 @@ class TestBinding(unittest.TestCase):
             self.assertEqual(4, r.signal_lookup([2, 'current']).signal_id)
             self.assertEqual(4, r.signal_lookup([2, 4]).signal_id)
             self.assertEqual(5, r.signal_lookup('4').signal_id)
+
+    def test_stats(self):
+        data = np.arange(110000, dtype=np.float32)
+        with Writer(self._path) as w:
+            w.stats_enable()
+            w.source_def(source_id=1, name='name', vendor='vendor', model='model',
+                         version='version', serial_number='serial_number')
+            w.signal_def(3, source_id=1, sample_rate=1000000, name='current', units='A')
+            w.fsr(3, 0, data)
+            w.flush()
+            s = w.stats()
+            self.assertEqual(1, s['chunk_wr']['source_def'])
+            self.assertGreater(s['chunk_wr']['track_fsr_data'], 0)
+            self.assertEqual(0, s['dropped_samples'])
+            self.assertEqual(s['msg_count'], sum(s['latency_histogram']))
+
+        with Reader(self._path) as r:
+            # flush writes the full data chunks, the partial chunk waits for close
+            data_bytes = s['chunk_wr']['track_fsr_data'] * r.signals[3].samples_per_data * data.itemsize
+            self.assertGreater(s['bytes_wr'], data_bytes)
+            with self.assertRaises(RuntimeError):
+                r.stats()
+            r.stats_enable()
+            r.fsr(3, 0, 1000)
+            s = r.stats()
+            self.assertGreater(s['chunk_rd']['track_fsr_data'], 0)
+            self.assertEqual(0, s['fsr_statistics'])
+            r.fsr_statistics(3, 0, 10, 10)
+            self.assertEqual(1, r.stats()['fsr_statistics'])
+
+    def test_summary_fields(self):
+        data = np.linspace(-1.0, 1.0, 100000, dtype=np.float32)
+        data[5000:5100] = np.nan
+        with Writer(self._path) as w:
+            w.source_def(source_id=1, name='name', vendor='vendor', model='model',
+                         version='version', serial_number='serial_number')
+            w.signal_def(3, source_id=1, sample_rate=1000000, name='current', units='A',
+                         summary_fields=SummaryField.ALL)
+            w.fsr(3, 0, data)
+
+        with Reader(self._path) as r:
+            self.assertEqual(SummaryField.ALL, r.signals[3].summary_fields)
+            s = r.fsr_statistics(3, 0, len(data), 1, fields=SummaryField.SUM | SummaryField.FINITE)
+            self.assertEqual((1, SummaryFSR.COUNT + 2), s.shape)
+            x = data[np.isfinite(data)].astype(np.float64)
+            np.testing.assert_allclose(np.sum(x), s[0, SummaryFSR.COUNT], atol=1e-2)
+            self.assertEqual(len(x), s[0, SummaryFSR.COUNT + 1])
+
+    def test_quantiles(self):
+        data = np.linspace(-1.0, 1.0, 1000000, dtype=np.float32)
+        with Writer(self._path) as w:
+            w.source_def(source_id=1, name='name', vendor='vendor', model='model',
+                         version='version', serial_number='serial_number')
+            w.signal_def(3, source_id=1, sample_rate=1000000, name='current', units='A',
+                         summary_hist_bins=100, summary_hist_min=-1.0, summary_hist_max=1.0)
+            w.fsr(3, 0, data)
+
+        with Reader(self._path) as r:
+            self.assertEqual(100, r.signals[3].summary_hist_bins)
+            q = [0.0, 0.1, 0.5, 0.9, 1.0]
+            v = r.fsr_quantiles(3, 1234, 900000, q)
+            np.testing.assert_allclose(np.quantile(data[1234:901234], q), v, atol=0.02)
+
+    def test_find(self):
+        data = np.zeros(1000000, dtype=np.float32)
+        data[123456:123500] = 2.0
+        data[800000:800010] = 2.0
+        with Writer(self._path) as w:
+            w.source_def(source_id=1, name='name', vendor='vendor', model='model',
+                         version='version', serial_number='serial_number')
+            w.signal_def(3, source_id=1, sample_rate=1000000, name='current', units='A')
+            w.fsr(3, 0, data)
+
+        with Reader(self._path) as r:
+            self.assertEqual(123456, r.fsr_find(3, 0, len(data), '>', 1.0))
+            self.assertEqual(123500, r.fsr_find(3, 123457, len(data), FindPredicate.CROSS, 1.0))
+            self.assertIsNone(r.fsr_find(3, 0, len(data), '<', -1.0))
+            self.assertEqual([(123456, 123500), (800000, 800010)],
+                             r.fsr_find_intervals(3, 0, len(data), '>', 1.0))
+
+    def test_threads(self):
+        data = np.sin(np.arange(2000000, dtype=np.float64) * 0.001).astype(np.float32)
+        with Writer(self._path) as w:
+            w.source_def(source_id=1, name='name', vendor='vendor', model='model',
+                         version='version', serial_number='serial_number')
+            w.signal_def(3, source_id=1, sample_rate=1000000, name='current', units='A')
+            w.fsr(3, 0, data)
+
+        with Reader(self._path) as r:
+            expect = r.fsr_statistics(3, 777, 1000, 1900)
+            r.threads_set(4)
+            np.testing.assert_array_equal(expect, r.fsr_statistics(3, 777, 1000, 1900))
+            r.threads_set(0)
+
+    def test_follow(self):
+        data = np.arange(100000, dtype=np.float32)
+        w = Writer(self._path)
+        w.source_def(source_id=1, name='name', vendor='vendor', model='model',
+                     version='version', serial_number='serial_number')
+        w.signal_def(3, source_id=1, sample_rate=1000000, name='current', units='A')
+        w.flush()
+        with Reader(self._path, follow=True) as r:
+            self.assertEqual(0, r.signals[3].length)
+            w.fsr(3, 0, data)
+            w.close()
+            r.follow_update()
+            self.assertEqual(len(data), r.signals[3].length)
+            np.testing.assert_array_equal(data, r.fsr(3, 0, len(data)))
+
+    def test_append(self):
+        data = np.arange(100000, dtype=np.float32)
+        with Writer(self._path) as w:
+            w.source_def(source_id=1, name='name', vendor='vendor', model='model',
+                         version='version', serial_number='serial_number')
+            w.signal_def(3, source_id=1, sample_rate=1000000, name='current', units='A')
+            w.fsr(3, 0, data[:33333])
+        with Writer(self._path, append=True) as w:
+            w.fsr(3, 33333, data[33333:])
+        with Reader(self._path) as r:
+            self.assertEqual(len(data), r.signals[3].length)
+            np.testing.assert_array_equal(data, r.fsr(3, 0, len(data)))
+            s = r.fsr_statistics(3, 0, len(data), 1)
+            np.testing.assert_allclose(np.mean(data, dtype=np.float64), s[0, SummaryFSR.MEAN], rtol=1e-6)
@@ -75,19 +75,23 @@ extensions = [
             'pyjls/binding' + ext,
             'src/bit_shift.c',
             'src/buffer.c',
+            'src/checkpoint.c',
             'src/copy.c',
             'src/core.c',
             'src/crc32c.c',
+            'src/dataset.c',
             'src/datatype.c',
             'src/ec.c',
             'src/log.c',
             'src/msg_ring_buffer.c',
             'src/raw.c',
+            'src/rd_virtual.c',
             'src/reader.c',
             'src/statistics.c',
             'src/threaded_writer.c',
             'src/tmap.c',
             'src/track.c',
+            'src/wr_derived.c',
             'src/wr_fsr.c',
             'src/wr_ts.c',
             'src/writer.c',
@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 
+#ifdef __linux__
+#define _GNU_SOURCE  // fallocate
+#endif
 #include "jls/backend.h"
 #include "jls/wr_prv.h"
 #include "jls/ec.h"
@@ -76,6 +79,25 @@ static void eventflag_wait(struct event_flag* ev) {
     pthread_mutex_unlock(&ev->mutex);
 }
 
+static void eventflag_wait_ms(struct event_flag* ev, uint32_t timeout_ms) {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    ts.tv_sec += timeout_ms / 1000;
+    ts.tv_nsec += ((long) (timeout_ms % 1000)) * 1000000;
+    if (ts.tv_nsec >= 1000000000) {
+        ts.tv_nsec -= 1000000000;
+        ++ts.tv_sec;
+    }
+    pthread_mutex_lock(&ev->mutex);
+    while (!ev->flag) {
+        if (pthread_cond_timedwait(&ev->condition, &ev->mutex, &ts)) {
+            break;  // timed out
+        }
+    }
+    ev->flag = 0;
+    pthread_mutex_unlock(&ev->mutex);
+}
+
 static void eventflag_set(struct event_flag* ev) {
     pthread_mutex_lock(&ev->mutex);
     ev->flag = 1;
@@ -171,6 +193,14 @@ int32_t jls_bk_fflush(struct jls_bkf_s * self) {
     return fsync(self->fd);
 }
 
+int32_t jls_bk_fdatasync(struct jls_bkf_s * self) {
+#ifdef __linux__
+    return fdatasync(self->fd);
+#else
+    return fsync(self->fd);
+#endif
+}
+
 int32_t jls_bk_truncate(struct jls_bkf_s * self) {
     int rc = ftruncate(self->fd, self->fpos);
     if (rc) {
@@ -183,6 +213,24 @@ int32_t jls_bk_truncate(struct jls_bkf_s * self) {
     return 0;
 }
 
+int32_t jls_bk_fallocate(struct jls_bkf_s * self, int64_t length) {
+#ifdef __linux__
+    // posix_fallocate extends the file size, which followers and repair would see.
+    if (fallocate(self->fd, FALLOC_FL_KEEP_SIZE, 0, length)) {
+        if ((errno == EOPNOTSUPP) || (errno == ENOSYS)) {
+            return JLS_ERROR_NOT_SUPPORTED;
+        }
+        JLS_LOGW("fallocate fail %d", errno);
+        return JLS_ERROR_IO;
+    }
+    return 0;
+#else
+    (void) self;
+    (void) length;
+    return JLS_ERROR_NOT_SUPPORTED;
+#endif
+}
+
 static void * task(void * user_data) {
     struct jls_twr_s * self = (struct jls_twr_s *) user_data;
     jls_twr_run(self);
@@ -279,6 +327,10 @@ void jls_bkt_msg_wait(struct jls_bkt_s * self) {
     eventflag_wait(self->msg_event);
 }
 
+void jls_bkt_msg_wait_ms(struct jls_bkt_s * self, uint32_t timeout_ms) {
+    eventflag_wait_ms(self->msg_event, timeout_ms);
+}
+
 void jls_bkt_msg_signal(struct jls_bkt_s * self) {
     eventflag_set(self->msg_event);
 }
@@ -293,6 +345,127 @@ void jls_bkt_sleep_ms(uint32_t duration_ms) {
     } while (rv && errno == EINTR);
 }
 
+struct jls_bkp_worker_s {
+    struct jls_bkp_s * pool;
+    uint32_t index;
+    pthread_t thread;
+};
+
+struct jls_bkp_s {
+    pthread_mutex_t mutex;
+    pthread_cond_t start;
+    pthread_cond_t done;
+    jls_bkp_fn fn;
+    void ** user_data;
+    uint32_t count;
+    uint32_t pending;
+    uint32_t generation;
+    int quit;
+    uint32_t thread_count;
+    struct jls_bkp_worker_s workers[];
+};
+
+static void * pool_task(void * user_data) {
+    struct jls_bkp_worker_s * worker = (struct jls_bkp_worker_s *) user_data;
+    struct jls_bkp_s * self = worker->pool;
+    uint32_t generation = 0;
+    pthread_mutex_lock(&self->mutex);
+    while (1) {
+        while (!self->quit && (generation == self->generation)) {
+            pthread_cond_wait(&self->start, &self->mutex);
+        }
+        if (self->quit) {
+            break;
+        }
+        generation = self->generation;
+        if (worker->index < self->count) {
+            jls_bkp_fn fn = self->fn;
+            void * arg = self->user_data[worker->index];
+            pthread_mutex_unlock(&self->mutex);
+            fn(arg);
+            pthread_mutex_lock(&self->mutex);
+            if (0 == --self->pending) {
+                pthread_cond_signal(&self->done);
+            }
+        }
+    }
+    pthread_mutex_unlock(&self->mutex);
+    return NULL;
+}
+
+struct jls_bkp_s * jls_bkp_initialize(uint32_t thread_count) {
+    if (!thread_count) {
+        return NULL;
+    }
+    struct jls_bkp_s * self = calloc(1, sizeof(struct jls_bkp_s) + thread_count * sizeof(struct jls_bkp_worker_s));
+    if (!self) {
+        return NULL;
+    }
+    pthread_mutex_init(&self->mutex, NULL);
+    pthread_cond_init(&self->start, NULL);
+    pthread_cond_init(&self->done, NULL);
+    for (uint32_t i = 0; i < thread_count; ++i) {
+        struct jls_bkp_worker_s * worker = &self->workers[i];
+        worker->pool = self;
+        worker->index = i;
+        int rc = pthread_create(&worker->thread, NULL, pool_task, worker);
+        if (rc) {
+            JLS_LOGE("jls_bkp_initialize: pthread_create returned %d", rc);
+            jls_bkp_finalize(self);
+            return NULL;
+        }
+        self->thread_count = i + 1;
+    }
+    return self;
+}
+
+void jls_bkp_finalize(struct jls_bkp_s * self) {
+    if (self) {
+        pthread_mutex_lock(&self->mutex);
+        self->quit = 1;
+        pthread_cond_broadcast(&self->start);
+        pthread_mutex_unlock(&self->mutex);
+        for (uint32_t i = 0; i < self->thread_count; ++i) {
+            void * rv = NULL;
+            int rc = pthread_join(self->workers[i].thread, &rv);
+            if (rc) {
+                JLS_LOGE("jls_bkp_finalize join failed with %d", rc);
+            }
+        }
+        pthread_cond_destroy(&self->done);
+        pthread_cond_destroy(&self->start);
+        pthread_mutex_destroy(&self->mutex);
+        free(self);
+    }
+}
+
+uint32_t jls_bkp_thread_count(struct jls_bkp_s * self) {
+    return self ? self->thread_count : 0;
+}
+
+int32_t jls_bkp_run(struct jls_bkp_s * self, jls_bkp_fn fn, void ** user_data, uint32_t count) {
+    if (!self || !fn || (count > self->thread_count)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    } else if (!count) {
+        return 0;
+    }
+    pthread_mutex_lock(&self->mutex);
+    self->fn = fn;
+    self->user_data = user_data;
+    self->count = count;
+    self->pending = count;
+    ++self->generation;
+    pthread_cond_broadcast(&self->start);
+    while (self->pending) {
+        pthread_cond_wait(&self->done, &self->mutex);
+    }
+    self->fn = NULL;
+    self->user_data = NULL;
+    self->count = 0;
+    pthread_mutex_unlock(&self->mutex);
+    return 0;
+}
+
 int64_t jls_now(void) {
     int64_t t;
     struct timespec ts;
@@ -136,6 +136,10 @@ int32_t jls_bk_fflush(struct jls_bkf_s * self) {
     return _commit(self->fd);
 }
 
+int32_t jls_bk_fdatasync(struct jls_bkf_s * self) {
+    return _commit(self->fd);
+}
+
 int32_t jls_bk_truncate(struct jls_bkf_s * self) {
     if (_chsize_s(self->fd, self->fpos) < 0) {
         JLS_LOGE("V failed %d", errno);
@@ -147,6 +151,19 @@ int32_t jls_bk_truncate(struct jls_bkf_s * self) {
     return 0;
 }
 
+int32_t jls_bk_fallocate(struct jls_bkf_s * self, int64_t length) {
+    FILE_ALLOCATION_INFO info;
+    HANDLE h = (HANDLE) _get_osfhandle(self->fd);
+    if (h == INVALID_HANDLE_VALUE) {
+        return JLS_ERROR_IO;
+    }
+    info.AllocationSize.QuadPart = length;
+    if (!SetFileInformationByHandle(h, FileAllocationInfo, &info, sizeof(info))) {
+        return JLS_ERROR_NOT_SUPPORTED;
+    }
+    return 0;
+}
+
 static DWORD WINAPI task(LPVOID lpParam) {
     struct jls_twr_s * self = (struct jls_twr_s *) lpParam;
     return jls_twr_run(self);
@@ -266,6 +283,11 @@ void jls_bkt_msg_wait(struct jls_bkt_s * self) {
     ResetEvent(self->msg_event);
 }
 
+void jls_bkt_msg_wait_ms(struct jls_bkt_s * self, uint32_t timeout_ms) {
+    WaitForSingleObject(self->msg_event, timeout_ms);
+    ResetEvent(self->msg_event);
+}
+
 void jls_bkt_msg_signal(struct jls_bkt_s * self) {
     SetEvent(self->msg_event);
 }
@@ -275,6 +297,125 @@ void jls_bkt_sleep_ms(uint32_t duration_ms) {
 }
 
 
+struct jls_bkp_worker_s {
+    struct jls_bkp_s * pool;
+    uint32_t index;
+    HANDLE thread;
+};
+
+struct jls_bkp_s {
+    CRITICAL_SECTION mutex;
+    CONDITION_VARIABLE start;
+    CONDITION_VARIABLE done;
+    jls_bkp_fn fn;
+    void ** user_data;
+    uint32_t count;
+    uint32_t pending;
+    uint32_t generation;
+    int quit;
+    uint32_t thread_count;
+    struct jls_bkp_worker_s workers[];
+};
+
+static DWORD WINAPI pool_task(LPVOID lpParam) {
+    struct jls_bkp_worker_s * worker = (struct jls_bkp_worker_s *) lpParam;
+    struct jls_bkp_s * self = worker->pool;
+    uint32_t generation = 0;
+    EnterCriticalSection(&self->mutex);
+    while (1) {
+        while (!self->quit && (generation == self->generation)) {
+            SleepConditionVariableCS(&self->start, &self->mutex, INFINITE);
+        }
+        if (self->quit) {
+            break;
+        }
+        generation = self->generation;
+        if (worker->index < self->count) {
+            jls_bkp_fn fn = self->fn;
+            void * arg = self->user_data[worker->index];
+            LeaveCriticalSection(&self->mutex);
+            fn(arg);
+            EnterCriticalSection(&self->mutex);
+            if (0 == --self->pending) {
+                WakeConditionVariable(&self->done);
+            }
+        }
+    }
+    LeaveCriticalSection(&self->mutex);
+    return 0;
+}
+
+struct jls_bkp_s * jls_bkp_initialize(uint32_t thread_count) {
+    if (!thread_count) {
+        return NULL;
+    }
+    struct jls_bkp_s * self = calloc(1, sizeof(struct jls_bkp_s) + thread_count * sizeof(struct jls_bkp_worker_s));
+    if (!self) {
+        return NULL;
+    }
+    InitializeCriticalSection(&self->mutex);
+    InitializeConditionVariable(&self->start);
+    InitializeConditionVariable(&self->done);
+    for (uint32_t i = 0; i < thread_count; ++i) {
+        struct jls_bkp_worker_s * worker = &self->workers[i];
+        worker->pool = self;
+        worker->index = i;
+        worker->thread = CreateThread(NULL, 0, pool_task, worker, 0, NULL);
+        if (!worker->thread) {
+            JLS_LOGE("jls_bkp_initialize: CreateThread failed %d", (int) GetLastError());
+            jls_bkp_finalize(self);
+            return NULL;
+        }
+        self->thread_count = i + 1;
+    }
+    return self;
+}
+
+void jls_bkp_finalize(struct jls_bkp_s * self) {
+    if (self) {
+        EnterCriticalSection(&self->mutex);
+        self->quit = 1;
+        WakeAllConditionVariable(&self->start);
+        LeaveCriticalSection(&self->mutex);
+        for (uint32_t i = 0; i < self->thread_count; ++i) {
+            DWORD rc = WaitForSingleObject(self->workers[i].thread, INFINITE);
+            if (WAIT_OBJECT_0 != rc) {
+                JLS_LOGE("jls_bkp_finalize wait failed %d", (int) rc);
+            }
+            CloseHandle(self->workers[i].thread);
+        }
+        DeleteCriticalSection(&self->mutex);
+        free(self);
+    }
+}
+
+uint32_t jls_bkp_thread_count(struct jls_bkp_s * self) {
+    return self ? self->thread_count : 0;
+}
+
+int32_t jls_bkp_run(struct jls_bkp_s * self, jls_bkp_fn fn, void ** user_data, uint32_t count) {
+    if (!self || !fn || (count > self->thread_count)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    } else if (!count) {
+        return 0;
+    }
+    EnterCriticalSection(&self->mutex);
+    self->fn = fn;
+    self->user_data = user_data;
+    self->count = count;
+    self->pending = count;
+    ++self->generation;
+    WakeAllConditionVariable(&self->start);
+    while (self->pending) {
+        SleepConditionVariableCS(&self->done, &self->mutex, INFINITE);
+    }
+    self->fn = NULL;
+    self->user_data = NULL;
+    self->count = 0;
+    LeaveCriticalSection(&self->mutex);
+    return 0;
+}
+
 int64_t jls_now(void) {
     // Contains a 64-bit value representing the number of 100-nanosecond intervals since January 1, 1601 (UTC).
     // python
@@ -16,6 +16,40 @@
 
 #include "jls/bit_shift.h"
 #include "jls/ec.h"
+#include <string.h>
+
+/*
+ * The kernels process 64-bit words, which compilers further vectorize.
+ * The JLS format is little endian, so a word holds 64 consecutive
+ * samples bits in file order.
+ */
+
+#define U64_BYTES_01  (0x0101010101010101ULL)
+
+static inline uint64_t load_le64(const uint8_t * p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    v = __builtin_bswap64(v);
+#endif
+    return v;
+}
+
+static inline void store_le64(uint8_t * p, uint64_t v) {
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    v = __builtin_bswap64(v);
+#endif
+    memcpy(p, &v, sizeof(v));
+}
+
+// Get up to 8 bits starting at bit offset shift (0 to 7) from s.
+static inline uint8_t bits_get(const uint8_t * s, uint8_t shift, uint8_t bits) {
+    uint32_t v = s[0] >> shift;
+    if ((shift + bits) > 8) {
+        v |= ((uint32_t) s[1]) << (8 - shift);
+    }
+    return (uint8_t) (v & ((1U << bits) - 1));
+}
 
 int32_t jls_bit_shift_array_right(uint8_t bits, void * data, size_t size) {
     if ((bits == 0) || (size == 0)) {
@@ -26,14 +60,132 @@ int32_t jls_bit_shift_array_right(uint8_t bits, void * data, size_t size) {
     }
 
     uint8_t * u8 = (uint8_t *) data;
-    if (size == 1) {
-        u8[0] >>= bits;
+    size_t i = 0;
+    // each word reads the next byte before a later iteration overwrites it
+    for (; (i + 8) < size; i += 8) {
+        uint64_t v = (load_le64(u8 + i) >> bits) | (((uint64_t) u8[i + 8]) << (64 - bits));
+        store_le64(u8 + i, v);
+    }
+    for (; (i + 1) < size; ++i) {
+        u8[i] = (uint8_t) ((u8[i] >> bits) | (u8[i + 1] << (8 - bits)));
+    }
+    u8[size - 1] >>= bits;
+    return 0;
+}
+
+void jls_bit_copy_offset(void * dst, size_t dst_bit, const void * src, size_t src_bit, size_t bits) {
+    if (!bits) {
+        return;
+    }
+    uint8_t * d = ((uint8_t *) dst) + (dst_bit >> 3);
+    const uint8_t * s = ((const uint8_t *) src) + (src_bit >> 3);
+    uint8_t d_shift = (uint8_t) (dst_bit & 7);
+    uint8_t s_shift = (uint8_t) (src_bit & 7);
+
+    if (d_shift) {
+        // partial first destination byte
+        uint8_t n = 8 - d_shift;
+        if (n > bits) {
+            n = (uint8_t) bits;
+        }
+        uint8_t mask = (uint8_t) (((1U << n) - 1) << d_shift);
+        uint8_t v = (uint8_t) (bits_get(s, s_shift, n) << d_shift);
+        *d = (uint8_t) ((*d & ~mask) | v);
+        ++d;
+        s_shift += n;
+        s += s_shift >> 3;
+        s_shift &= 7;
+        bits -= n;
+    }
+
+    size_t d_bytes = bits >> 3;
+    if (!s_shift) {
+        memcpy(d, s, d_bytes);
+    } else {
+        // the source spans at least one byte more than d_bytes
+        size_t i = 0;
+        for (; (i + 8) <= d_bytes; i += 8) {
+            uint64_t v = (load_le64(s + i) >> s_shift) | (((uint64_t) s[i + 8]) << (64 - s_shift));
+            store_le64(d + i, v);
+        }
+        for (; i < d_bytes; ++i) {
+            d[i] = (uint8_t) ((s[i] >> s_shift) | (s[i + 1] << (8 - s_shift)));
+        }
+    }
+    d += d_bytes;
+    s += d_bytes;
+    bits &= 7;
+
+    if (bits) {
+        // partial last destination byte
+        uint8_t mask = (uint8_t) ((1U << bits) - 1);
+        *d = (uint8_t) ((*d & ~mask) | bits_get(s, s_shift, (uint8_t) bits));
+    }
+}
+
+void jls_bit_copy(void * dst, size_t dst_bit, const void * src, size_t bits) {
+    jls_bit_copy_offset(dst, dst_bit, src, 0, bits);
+}
+
+static inline uint64_t unpack_u1x8(uint8_t v) {
+    // byte k of x holds bit k of v, then add to carry each set bit into bit 7
+    uint64_t x = (v * U64_BYTES_01) & 0x8040201008040201ULL;
+    return ((x + 0x00406070787c7e7fULL) >> 7) & U64_BYTES_01;
+}
+
+static inline uint64_t unpack_u4x8(uint32_t v) {
+    // spread the 4 bytes to the even bytes, then the upper nibbles to the odd bytes
+    uint64_t x = v;
+    x = (x | (x << 16)) & 0x0000ffff0000ffffULL;
+    x = (x | (x << 8)) & 0x00ff00ff00ff00ffULL;
+    return (x | (x << 4)) & 0x0f0f0f0f0f0f0f0fULL;
+}
+
+int32_t jls_bit_unpack_u8(uint8_t * dst, const void * src, size_t src_bit,
+                          uint8_t entry_size_bits, size_t count) {
+    const uint8_t * s = ((const uint8_t *) src) + (src_bit >> 3);
+    uint8_t s_shift = (uint8_t) (src_bit & 7);
+    if (entry_size_bits == 8) {
+        memcpy(dst, s, count);
         return 0;
+    } else if ((entry_size_bits != 1) && (entry_size_bits != 4)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    } else if (s_shift % entry_size_bits) {
+        return JLS_ERROR_PARAMETER_INVALID;
     }
-    uint8_t carry = u8[0] >> bits;
-    for (size_t i = 1; i < size; ++i) {
-        u8[i - 1] = (u8[i] << (8 - bits)) | carry;
-        carry = u8[i] >> bits;
+    uint8_t mask = (uint8_t) ((1U << entry_size_bits) - 1);
+
+    // leading samples to the next source byte
+    while (count && s_shift) {
+        *dst++ = (uint8_t) ((*s >> s_shift) & mask);
+        --count;
+        s_shift = (uint8_t) ((s_shift + entry_size_bits) & 7);
+        if (!s_shift) {
+            ++s;
+        }
+    }
+
+    size_t i = 0;
+    if (entry_size_bits == 1) {
+        for (; (i + 8) <= count; i += 8) {
+            store_le64(dst + i, unpack_u1x8(*s++));
+        }
+    } else {
+        for (; (i + 8) <= count; i += 8) {
+            uint32_t v = (uint32_t) s[0] | ((uint32_t) s[1] << 8)
+                    | ((uint32_t) s[2] << 16) | ((uint32_t) s[3] << 24);
+            store_le64(dst + i, unpack_u4x8(v));
+            s += 4;
+        }
+    }
+
+    // trailing samples
+    for (; i < count; ++i) {
+        dst[i] = (uint8_t) ((*s >> s_shift) & mask);
+        s_shift = (uint8_t) ((s_shift + entry_size_bits) & 7);
+        if (!s_shift) {
+            ++s;
+        }
     }
     return 0;
 }
@@ -89,7 +89,7 @@ int32_t jls_buf_realloc(struct jls_buf_s * self, size_t size) {
 
     size_t alloc_size = self->alloc_size;
     while (alloc_size < size) {
-        alloc_size *= alloc_size;
+        alloc_size *= 2;
     }
 
     uint8_t * ptr = realloc(self->start, alloc_size);
@@ -265,6 +265,40 @@ int32_t jls_buf_rd_u32(struct jls_buf_s * self, uint32_t * value) {
     return 0;
 }
 
+int32_t jls_buf_rd_f32(struct jls_buf_s * self, float * value) {
+    if ((self->cur + sizeof(*value)) > self->end) {
+        return JLS_ERROR_EMPTY;
+    }
+    uint8_t * p = (uint8_t *) value;
+    *p++ = *self->cur++;
+    *p++ = *self->cur++;
+    *p++ = *self->cur++;
+    *p++ = *self->cur++;
+    return 0;
+}
+
+int32_t jls_buf_rd_i64(struct jls_buf_s * self, int64_t * value) {
+    if ((self->cur + sizeof(*value)) > self->end) {
+        return JLS_ERROR_EMPTY;
+    }
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; --i) {
+        v = (v << 8) | self->cur[i];
+    }
+    *value = (int64_t) v;
+    self->cur += sizeof(*value);
+    return 0;
+}
+
+int32_t jls_buf_rd_bin(struct jls_buf_s * self, void * data, uint32_t data_size) {
+    if ((self->cur + data_size) > self->end) {
+        return JLS_ERROR_EMPTY;
+    }
+    memcpy(data, self->cur, data_size);
+    self->cur += data_size;
+    return 0;
+}
+
 int32_t jls_buf_rd_str(struct jls_buf_s * self, const char ** value) {
     struct jls_buf_strings_s * s;
     if (NULL == self->strings_tail) {
@@ -0,0 +1,419 @@
+/*
+ * Copyright 2026 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jls/checkpoint.h"
+#include "jls/cdef.h"
+#include "jls/ec.h"
+#include "jls/log.h"
+#include "jls/track.h"
+#include "jls/util.h"
+#include "jls/wr_ts.h"
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+#define CHECKPOINT_VERSION (1)
+
+struct checkpoint_track_s {
+    uint16_t signal_id;
+    uint8_t track_type;
+    int64_t timestamp;  // FSR next data chunk sample_id
+    int64_t head_offsets[JLS_SUMMARY_LEVEL_COUNT];
+    int64_t data_head;
+    int64_t index_head[JLS_SUMMARY_LEVEL_COUNT];
+    int64_t summary_head[JLS_SUMMARY_LEVEL_COUNT];
+};
+
+static int32_t head_update(struct jls_core_s * self, int64_t offset) {
+    int64_t pos = jls_raw_chunk_tell(self->raw);
+    ROE(jls_raw_chunk_seek(self->raw, self->checkpoint_head.offset));
+    ROE(jls_raw_wr_payload(self->raw, sizeof(offset), (uint8_t *) &offset));
+    ROE(jls_raw_chunk_seek(self->raw, pos));
+    return 0;
+}
+
+int32_t jls_core_checkpoint_head_wr(struct jls_core_s * self) {
+    int64_t offset = 0;
+    struct jls_core_chunk_s * chunk = &self->checkpoint_head;
+    chunk->hdr.item_next = 0;
+    chunk->hdr.item_prev = 0;
+    chunk->hdr.tag = JLS_TAG_CHECKPOINT_HEAD;
+    chunk->hdr.rsv0_u8 = 0;
+    chunk->hdr.chunk_meta = 0;
+    chunk->hdr.payload_length = sizeof(offset);
+    chunk->offset = jls_raw_chunk_tell(self->raw);
+    return jls_raw_wr(self->raw, &chunk->hdr, (uint8_t *) &offset);
+}
+
+static int32_t track_wr(struct jls_core_s * self, struct jls_core_track_s * track) {
+    struct jls_buf_s * buf = self->buf;
+    struct jls_core_signal_s * info = track->parent;
+    ROE(jls_buf_wr_u16(buf, info->signal_def.signal_id));
+    ROE(jls_buf_wr_u8(buf, track->track_type));
+    ROE(jls_buf_wr_u8(buf, 0));
+    for (uint8_t level = 0; level < JLS_SUMMARY_LEVEL_COUNT; ++level) {
+        ROE(jls_buf_wr_i64(buf, track->head_offsets[level]));
+    }
+    ROE(jls_buf_wr_i64(buf, track->data_head.offset));
+    for (uint8_t level = 0; level < JLS_SUMMARY_LEVEL_COUNT; ++level) {
+        ROE(jls_buf_wr_i64(buf, track->index_head[level].offset));
+        ROE(jls_buf_wr_i64(buf, track->summary_head[level].offset));
+    }
+    switch (track->track_type) {
+        case JLS_TRACK_TYPE_FSR: return jls_fsr_checkpoint(info->track_fsr, buf);
+        case JLS_TRACK_TYPE_ANNOTATION: return jls_wr_ts_checkpoint(info->track_anno, buf);
+        case JLS_TRACK_TYPE_UTC: return jls_wr_ts_checkpoint(info->track_utc, buf);
+        default: return JLS_ERROR_NOT_SUPPORTED;
+    }
+}
+
+int32_t jls_core_checkpoint_wr(struct jls_core_s * self) {
+    if (!self->checkpoint_head.offset) {
+        return 0;
+    }
+    struct jls_buf_s * buf = self->buf;
+    uint32_t count = 0;
+    for (uint16_t signal_id = 0; signal_id < JLS_SIGNAL_COUNT; ++signal_id) {
+        struct jls_core_signal_s * info = &self->signal_info[signal_id];
+        count += (info->track_fsr ? 1 : 0) + (info->track_anno ? 1 : 0) + (info->track_utc ? 1 : 0);
+    }
+
+    // construct payload
+    jls_buf_reset(buf);
+    ROE(jls_buf_wr_u32(buf, CHECKPOINT_VERSION));
+    ROE(jls_buf_wr_u32(buf, count));
+    for (uint16_t signal_id = 0; signal_id < JLS_SIGNAL_COUNT; ++signal_id) {
+        struct jls_core_signal_s * info = &self->signal_info[signal_id];
+        if (info->track_fsr) {
+            ROE(track_wr(self, &info->tracks[JLS_TRACK_TYPE_FSR]));
+        }
+        if (info->track_anno) {
+            ROE(track_wr(self, &info->tracks[JLS_TRACK_TYPE_ANNOTATION]));
+        }
+        if (info->track_utc) {
+            ROE(track_wr(self, &info->tracks[JLS_TRACK_TYPE_UTC]));
+        }
+    }
+
+    // construct header
+    struct jls_core_chunk_s chunk;
+    chunk.hdr.item_next = 0;  // update later
+    chunk.hdr.item_prev = self->checkpoint.offset;
+    chunk.hdr.tag = JLS_TAG_CHECKPOINT;
+    chunk.hdr.rsv0_u8 = 0;
+    chunk.hdr.chunk_meta = 0;
+    chunk.hdr.payload_length = (uint32_t) jls_buf_length(buf);
+    chunk.offset = jls_raw_chunk_tell(self->raw);
+    JLS_LOGD1("checkpoint %" PRIi64 ": %" PRIu32 " tracks, %" PRIu32 " bytes",
+              chunk.offset, count, chunk.hdr.payload_length);
+
+    // write, then reference from the head
+    ROE(jls_raw_wr(self->raw, &chunk.hdr, buf->start));
+    ROE(jls_core_update_item_head(self, &self->checkpoint, &chunk));
+    return head_update(self, chunk.offset);
+}
+
+int32_t jls_core_checkpoint_clear(struct jls_core_s * self) {
+    if (!self->checkpoint_head.offset) {
+        return 0;
+    }
+    return head_update(self, 0);
+}
+
+static void discard(struct jls_core_s * self) {
+    // Free the restored state without writing, like the append discard.
+    for (uint16_t signal_id = 0; signal_id < JLS_SIGNAL_COUNT; ++signal_id) {
+        struct jls_core_signal_s * info = &self->signal_info[signal_id];
+        struct jls_core_fsr_s * fsr = info->track_fsr;
+        if (fsr) {
+            jls_core_fsr_sample_buffer_free(fsr);
+            for (size_t level = 1; level < JLS_SUMMARY_LEVEL_COUNT; ++level) {
+                if (fsr->level[level]) {
+                    fsr->level[level]->summary->header.entry_count = 0;
+                }
+            }
+            jls_fsr_close(fsr);
+            info->track_fsr = NULL;
+        }
+        struct jls_core_ts_s ** ts_list[] = {&info->track_anno, &info->track_utc};
+        for (size_t k = 0; k < 2; ++k) {
+            struct jls_core_ts_s * ts = *ts_list[k];
+            if (!ts) {
+                continue;
+            }
+            for (size_t level = 1; level < JLS_SUMMARY_LEVEL_COUNT; ++level) {
+                if (ts->index[level]) {
+                    ts->index[level]->header.entry_count = 0;
+                }
+            }
+            jls_wr_ts_close(ts);
+            *ts_list[k] = NULL;
+        }
+    }
+}
+
+static int32_t track_rd(struct jls_core_s * self, struct checkpoint_track_s * t) {
+    struct jls_buf_s * buf = self->buf;
+    uint8_t rsv = 0;
+    ROE(jls_buf_rd_u16(buf, &t->signal_id));
+    ROE(jls_buf_rd_u8(buf, &t->track_type));
+    ROE(jls_buf_rd_u8(buf, &rsv));
+    for (uint8_t level = 0; level < JLS_SUMMARY_LEVEL_COUNT; ++level) {
+        ROE(jls_buf_rd_i64(buf, &t->head_offsets[level]));
+    }
+    ROE(jls_buf_rd_i64(buf, &t->data_head));
+    for (uint8_t level = 0; level < JLS_SUMMARY_LEVEL_COUNT; ++level) {
+        ROE(jls_buf_rd_i64(buf, &t->index_head[level]));
+        ROE(jls_buf_rd_i64(buf, &t->summary_head[level]));
+    }
+
+    if ((t->signal_id >= JLS_SIGNAL_COUNT) || jls_core_signal_validate(self, t->signal_id)) {
+        return JLS_ERROR_UNSUPPORTED_FILE;
+    }
+    struct jls_core_signal_s * info = &self->signal_info[t->signal_id];
+    bool is_fsr = info->signal_def.signal_type == JLS_SIGNAL_TYPE_FSR;
+    switch (t->track_type) {
+        case JLS_TRACK_TYPE_FSR:
+            if (!is_fsr || info->track_fsr) {
+                return JLS_ERROR_UNSUPPORTED_FILE;
+            }
+            ROE(jls_fsr_open(&info->track_fsr, info));
+            ROE(jls_fsr_restore(info->track_fsr, buf));
+            t->timestamp = info->track_fsr->data->header.timestamp;
+            return 0;
+        case JLS_TRACK_TYPE_ANNOTATION:
+            if (info->track_anno) {
+                return JLS_ERROR_UNSUPPORTED_FILE;
+            }
+            ROE(jls_wr_ts_open(&info->track_anno, info, JLS_TRACK_TYPE_ANNOTATION,
+                               info->signal_def.annotation_decimate_factor));
+            return jls_wr_ts_restore(info->track_anno, buf);
+        case JLS_TRACK_TYPE_UTC:
+            if (!is_fsr || info->track_utc) {
+                return JLS_ERROR_UNSUPPORTED_FILE;
+            }
+            ROE(jls_wr_ts_open(&info->track_utc, info, JLS_TRACK_TYPE_UTC,
+                               info->signal_def.utc_decimate_factor));
+            return jls_wr_ts_restore(info->track_utc, buf);
+        default:
+            return JLS_ERROR_UNSUPPORTED_FILE;
+    }
+}
+
+static int32_t coverage_check(struct jls_core_s * self) {
+    // Signals defined after the checkpoint have no restored state.
+    for (uint16_t signal_id = 0; signal_id < JLS_SIGNAL_COUNT; ++signal_id) {
+        struct jls_core_signal_s * info = &self->signal_info[signal_id];
+        if ((info->signal_def.signal_id != signal_id) || !info->chunk_def.offset) {
+            continue;
+        }
+        bool ok = (NULL != info->track_anno);
+        if (info->signal_def.signal_type == JLS_SIGNAL_TYPE_FSR) {
+            ok &= (NULL != info->track_fsr) && (NULL != info->track_utc);
+        } else if (info->tracks[JLS_TRACK_TYPE_VSR].head_offsets[0]) {
+            ok = false;
+        }
+        if (!ok) {
+            JLS_LOGW("checkpoint: signal %d not in checkpoint", (int) signal_id);
+            return JLS_ERROR_NOT_SUPPORTED;
+        }
+    }
+    return 0;
+}
+
+static int32_t replay_track(struct jls_core_s * self, struct checkpoint_track_s * t, bool feed) {
+    // Follow the data chunks written after the checkpoint.
+    struct jls_core_signal_s * info = &self->signal_info[t->signal_id];
+    struct jls_core_track_s * track = &info->tracks[t->track_type];
+    const struct jls_signal_def_s * def = &info->signal_def;
+    uint8_t tag = jls_track_tag_pack(t->track_type, JLS_TRACK_CHUNK_DATA);
+    bool timestamp_valid = (0 != t->data_head);
+    int64_t timestamp = t->timestamp;
+    size_t fsr_size = 0;
+    if (info->track_fsr) {
+        fsr_size = sizeof(struct jls_payload_header_s)
+                + (info->track_fsr->data->header.entry_size_bits * (size_t) def->samples_per_data) / 8;
+    }
+
+    struct jls_core_chunk_s chunk;
+    int64_t offset = track->head_offsets[0];
+    if (t->data_head) {
+        ROE(jls_core_rd_chunk_header(self, t->data_head, &chunk));
+        if (chunk.hdr.tag != tag) {
+            return JLS_ERROR_UNSUPPORTED_FILE;
+        }
+        offset = chunk.hdr.item_next;
+    }
+
+    while (offset) {
+        if (jls_raw_chunk_seek(self->raw, offset) || jls_core_rd_chunk(self)) {
+            break;  // item_next written, but not the chunk
+        }
+        chunk = self->chunk_cur;
+        offset = chunk.hdr.item_next;
+        if ((chunk.hdr.tag != tag) || ((chunk.hdr.chunk_meta & 0x0fff) != t->signal_id)) {
+            JLS_LOGW("checkpoint: unexpected chunk at %" PRIi64, chunk.offset);
+            return JLS_ERROR_UNSUPPORTED_FILE;
+        }
+
+        switch (t->track_type) {
+            case JLS_TRACK_TYPE_FSR: {
+                struct jls_fsr_data_s * r = (struct jls_fsr_data_s *) self->buf->start;
+                if ((chunk.hdr.payload_length < sizeof(r->header)) || (chunk.hdr.payload_length > fsr_size)) {
+                    return JLS_ERROR_UNSUPPORTED_FILE;
+                }
+                if (timestamp_valid && (r->header.timestamp != timestamp)) {
+                    // omitted data chunks have no data to summarize
+                    JLS_LOGW("checkpoint: signal %d gap at %" PRIi64, (int) t->signal_id, timestamp);
+                    return JLS_ERROR_NOT_SUPPORTED;
+                }
+                timestamp_valid = true;
+                timestamp = r->header.timestamp + def->samples_per_data;
+                if (feed) {
+                    struct jls_core_fsr_s * fsr = info->track_fsr;
+                    memcpy(fsr->data, self->buf->start, chunk.hdr.payload_length);
+                    ROE(jls_raw_seek_end(self->raw));
+                    ROE(jls_core_fsr_summary1(fsr, chunk.offset));
+                }
+                break;
+            }
+            case JLS_TRACK_TYPE_ANNOTATION: {
+                struct jls_annotation_s * a = (struct jls_annotation_s *) self->buf->start;
+                if (chunk.hdr.payload_length < sizeof(*a)) {
+                    return JLS_ERROR_UNSUPPORTED_FILE;
+                }
+                if (feed) {
+                    int64_t a_timestamp = a->timestamp;
+                    uint8_t annotation_type = a->annotation_type;
+                    uint8_t group_id = a->group_id;
+                    float y = a->y;
+                    ROE(jls_raw_seek_end(self->raw));
+                    ROE(jls_wr_ts_anno(info->track_anno, a_timestamp, chunk.offset,
+                                       annotation_type, group_id, y));
+                }
+                break;
+            }
+            case JLS_TRACK_TYPE_UTC: {
+                struct jls_utc_data_s * u = (struct jls_utc_data_s *) self->buf->start;
+                if (chunk.hdr.payload_length < sizeof(*u)) {
+                    return JLS_ERROR_UNSUPPORTED_FILE;
+                }
+                if (feed) {
+                    int64_t sample_id = u->header.timestamp;
+                    int64_t utc = u->timestamp;
+                    ROE(jls_raw_seek_end(self->raw));
+                    ROE(jls_wr_ts_utc(info->track_utc, sample_id, chunk.offset, utc));
+                }
+                break;
+            }
+            default:
+                return JLS_ERROR_UNSUPPORTED_FILE;
+        }
+        if (feed) {
+            track->data_head = chunk;
+        }
+    }
+    return 0;
+}
+
+static int32_t track_apply(struct jls_core_s * self, struct checkpoint_track_s * t) {
+    // Discard the level chunks written after the checkpoint, which the replay rewrites.
+    struct jls_core_track_s * track = &self->signal_info[t->signal_id].tracks[t->track_type];
+    for (uint8_t level = 1; level < JLS_SUMMARY_LEVEL_COUNT; ++level) {
+        track->head_offsets[level] = t->head_offsets[level];
+        ROE(jls_core_rd_chunk_header(self, t->index_head[level], &track->index_head[level]));
+        ROE(jls_core_rd_chunk_header(self, t->summary_head[level], &track->summary_head[level]));
+    }
+    if (!track->head_offsets[0]) {
+        track->head_offsets[0] = t->head_offsets[0];
+    }
+    ROE(jls_core_rd_chunk_header(self, t->data_head, &track->data_head));
+    if (track->head.offset) {
+        ROE(jls_track_wr_head(track));
+    }
+    return 0;
+}
+
+static int32_t recover(struct jls_core_s * self, struct checkpoint_track_s * tracks, uint32_t count) {
+    for (uint32_t i = 0; i < count; ++i) {
+        ROE(track_rd(self, &tracks[i]));
+    }
+    ROE(coverage_check(self));
+    for (uint32_t i = 0; i < count; ++i) {
+        ROE(replay_track(self, &tracks[i], false));
+    }
+
+    // Validated, now modify the file.
+    for (uint32_t i = 0; i < count; ++i) {
+        ROE(track_apply(self, &tracks[i]));
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+        ROE(replay_track(self, &tracks[i], true));
+    }
+    ROE(jls_raw_seek_end(self->raw));
+    for (uint16_t signal_id = 0; signal_id < JLS_SIGNAL_COUNT; ++signal_id) {
+        struct jls_core_signal_s * info = &self->signal_info[signal_id];
+        if (info->track_fsr) {
+            jls_core_fsr_sample_buffer_free(info->track_fsr);  // samples already written
+            ROE(jls_fsr_close(info->track_fsr));
+            info->track_fsr = NULL;
+        }
+        ROE(jls_wr_ts_close(info->track_anno));
+        info->track_anno = NULL;
+        ROE(jls_wr_ts_close(info->track_utc));
+        info->track_utc = NULL;
+    }
+    return 0;
+}
+
+int32_t jls_core_checkpoint_recover(struct jls_core_s * self) {
+    int64_t offset = 0;
+    if (!self->checkpoint_head.offset) {
+        return JLS_ERROR_NOT_FOUND;
+    }
+    ROE(jls_raw_chunk_seek(self->raw, self->checkpoint_head.offset));
+    ROE(jls_core_rd_chunk(self));
+    if (jls_buf_rd_i64(self->buf, &offset) || !offset) {
+        return JLS_ERROR_NOT_FOUND;
+    }
+    JLS_LOGI("recover from checkpoint at %" PRIi64, offset);
+    if (jls_raw_chunk_seek(self->raw, offset) || jls_core_rd_chunk(self)
+            || (self->chunk_cur.hdr.tag != JLS_TAG_CHECKPOINT)) {
+        JLS_LOGW("checkpoint at %" PRIi64 " not found", offset);
+        return JLS_ERROR_NOT_FOUND;
+    }
+    uint32_t version = 0;
+    uint32_t count = 0;
+    ROE(jls_buf_rd_u32(self->buf, &version));
+    ROE(jls_buf_rd_u32(self->buf, &count));
+    if ((version != CHECKPOINT_VERSION) || (count > (JLS_SIGNAL_COUNT * JLS_TRACK_TYPE_COUNT))) {
+        JLS_LOGW("checkpoint version %" PRIu32 " not supported", version);
+        return JLS_ERROR_UNSUPPORTED_FILE;
+    }
+    struct checkpoint_track_s * tracks = calloc(count ? count : 1, sizeof(struct checkpoint_track_s));
+    if (!tracks) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    int32_t rc = recover(self, tracks, count);
+    if (rc) {
+        JLS_LOGW("checkpoint recovery failed: %" PRIi32, rc);
+        discard(self);
+    }
+    free(tracks);
+    return rc;
+}
@@ -17,11 +17,19 @@
 #include "jls/copy.h"
 #include "jls/ec.h"
 #include "jls/raw.h"
+#include "jls/reader.h"
 #include "jls/writer.h"
+#include "jls/rd_prv.h"
+#include "jls/wr_prv.h"
+#include "jls/datatype.h"
 #include "jls/buffer.h"
 #include "jls/cdef.h"
+#include "jls/log.h"
 #include <inttypes.h>
+#include <stdbool.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 
 #define PROGRESS_INTERVAL_BYTES (10000000LL)
@@ -132,7 +140,12 @@ int32_t jls_copy(const char * src, const char * dst,
                 ROE(jls_buf_rd_u32(buf, &signal.summary_decimate_factor));
                 ROE(jls_buf_rd_u32(buf, &signal.annotation_decimate_factor));
                 ROE(jls_buf_rd_u32(buf, &signal.utc_decimate_factor));
-                ROE(jls_buf_rd_skip(buf, 92));
+                ROE(jls_buf_rd_u32(buf, &signal.summary_fields));
+                ROE(jls_buf_rd_u32(buf, &signal.summary_hist_bins));
+                ROE(jls_buf_rd_u32(buf, &signal.summary_hist_level));
+                ROE(jls_buf_rd_f32(buf, &signal.summary_hist_min));
+                ROE(jls_buf_rd_f32(buf, &signal.summary_hist_max));
+                ROE(jls_buf_rd_skip(buf, 72));
                 ROE(jls_buf_rd_str(buf, (const char **) &signal.name));
                 ROE(jls_buf_rd_str(buf, (const char **) &signal.units));
                 if (signal.signal_id != 0) {
@@ -211,3 +224,337 @@ int32_t jls_copy(const char * src, const char * dst,
     jls_wr_close(wr);
     return rc;
 }
+
+
+struct slice_s {
+    struct jls_wr_s * wr;
+    uint16_t signal_id;
+    int64_t start;  // absolute sample id, inclusive
+    int64_t end;    // absolute sample id, exclusive
+    int64_t sample_id_offset;  // add to API zero-based source sample ids
+    bool chunk_copy;           // destination on a chunk boundary at start
+    bool utc_ends;             // add UTC entries at start and end - 1
+    int32_t rc;
+};
+
+static int32_t slice_user_data(void * user_data, uint16_t chunk_meta, enum jls_storage_type_e storage_type,
+                               uint8_t * data, uint32_t data_size) {
+    struct slice_s * s = (struct slice_s *) user_data;
+    if (storage_type == JLS_STORAGE_TYPE_INVALID) {
+        return 0;
+    }
+    s->rc = jls_wr_user_data(s->wr, chunk_meta & 0x0fff, storage_type, data, data_size);
+    return s->rc;
+}
+
+static int32_t slice_annotation(void * user_data, const struct jls_annotation_s * a) {
+    struct slice_s * s = (struct slice_s *) user_data;
+    int64_t timestamp = a->timestamp + s->sample_id_offset;
+    if (s->signal_id && (timestamp >= s->end)) {
+        return 1;
+    } else if (s->signal_id && (timestamp < s->start)) {
+        return 0;
+    }
+    s->rc = jls_wr_annotation(s->wr, s->signal_id, timestamp, a->y, a->annotation_type, a->group_id,
+                              a->storage_type, a->data, a->data_size);
+    return s->rc;
+}
+
+static int32_t slice_utc(void * user_data, const struct jls_utc_summary_entry_s * utc, uint32_t size) {
+    struct slice_s * s = (struct slice_s *) user_data;
+    for (uint32_t idx = 0; idx < size; ++idx) {
+        int64_t sample_id = utc[idx].sample_id + s->sample_id_offset;
+        int64_t end = s->utc_ends ? (s->end - 1) : s->end;
+        if (sample_id >= end) {
+            return 1;
+        } else if ((sample_id > s->start) || ((sample_id == s->start) && !s->utc_ends)) {
+            s->rc = jls_wr_utc(s->wr, s->signal_id, sample_id, utc[idx].timestamp);
+            if (s->rc) {
+                return s->rc;
+            }
+        }
+    }
+    return 0;
+}
+
+static int32_t slice_utc_at(struct jls_rd_s * rd, struct slice_s * s, int64_t sample_id) {
+    int64_t timestamp = 0;
+    if (0 == jls_rd_sample_id_to_timestamp(rd, s->signal_id, sample_id - s->sample_id_offset, &timestamp)) {
+        return jls_wr_utc(s->wr, s->signal_id, sample_id, timestamp);
+    }
+    return 0;
+}
+
+static int32_t slice_fsr(struct jls_rd_s * rd, struct slice_s * s, const struct jls_signal_def_s * def,
+                         uint8_t * buf) {
+    const int64_t samples_per_data = def->samples_per_data;
+    const uint16_t signal_id = s->signal_id;
+    int64_t start = s->start - s->sample_id_offset;  // API zero-based
+    int64_t end = s->end - s->sample_id_offset;
+    bool aligned = s->chunk_copy && (0 == (start % samples_per_data));
+    int64_t pos = start;
+    while (pos < end) {
+        if (aligned && ((pos + samples_per_data) <= end)) {
+            const struct jls_fsr_data_s * data = NULL;
+            const void * summary = NULL;
+            int32_t rc = jls_rd_fsr_chunk(rd, signal_id, pos, &data, &summary);
+            if (0 == rc) {
+                rc = jls_wr_fsr_chunk(s->wr, signal_id, pos + s->sample_id_offset, data, summary);
+            }
+            if (0 == rc) {
+                pos += samples_per_data;
+                continue;
+            } else if ((rc != JLS_ERROR_NOT_FOUND) && (rc != JLS_ERROR_NOT_SUPPORTED)) {
+                return rc;
+            }
+        }
+        // decode up to the next chunk boundary: boundaries, omitted chunks and unaligned ranges
+        int64_t length = ((pos / samples_per_data) + 1) * samples_per_data - pos;
+        if (length > (end - pos)) {
+            length = end - pos;
+        }
+        ROE(jls_rd_fsr(rd, signal_id, pos, buf, length));
+        ROE(jls_wr_fsr(s->wr, signal_id, pos + s->sample_id_offset, buf, (uint32_t) length));
+        pos += length;
+    }
+    return 0;
+}
+
+static int32_t slice_signal(struct jls_rd_s * rd, struct slice_s * s, const struct jls_signal_def_s * def) {
+    int64_t start = s->start - s->sample_id_offset;  // API zero-based
+    uint8_t * buf = malloc((def->samples_per_data * jls_datatype_parse_size(def->data_type) + 7) / 8 + 8);
+    if (NULL == buf) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    int32_t rc = slice_fsr(rd, s, def, buf);
+    free(buf);
+    ROE(rc);
+
+    ROE(jls_rd_annotations(rd, s->signal_id, start, slice_annotation, s));
+    ROE(s->rc);
+    if (s->utc_ends) {
+        ROE(slice_utc_at(rd, s, s->start));
+    }
+    ROE(jls_rd_utc(rd, s->signal_id, start, slice_utc, s));
+    ROE(s->rc);
+    if (s->utc_ends && ((s->end - 1) > s->start)) {
+        ROE(slice_utc_at(rd, s, s->end - 1));
+    }
+    return 0;
+}
+
+static int32_t slice(struct jls_rd_s * rd, struct jls_wr_s * wr,
+                     const uint16_t * signal_ids, uint32_t signal_count,
+                     int64_t start_sample_id, int64_t end_sample_id) {
+    struct jls_source_def_s * sources = NULL;
+    struct jls_signal_def_s * signals = NULL;
+    uint16_t sources_count = 0;
+    uint16_t signals_count = 0;
+    uint8_t selected[JLS_SIGNAL_COUNT];
+    uint8_t sources_used[JLS_SOURCE_COUNT];
+    struct slice_s s = {.wr = wr, .chunk_copy = true, .utc_ends = true, .rc = 0};
+    memset(selected, 0, sizeof(selected));
+    memset(sources_used, 0, sizeof(sources_used));
+
+    ROE(jls_rd_sources(rd, &sources, &sources_count));
+    ROE(jls_rd_signals(rd, &signals, &signals_count));
+    for (uint16_t idx = 0; idx < signals_count; ++idx) {
+        struct jls_signal_def_s * def = &signals[idx];
+        if ((def->signal_id == 0) || (def->signal_type != JLS_SIGNAL_TYPE_FSR)) {
+            continue;
+        }
+        bool match = (NULL == signal_ids) || (0 == signal_count);
+        for (uint32_t k = 0; !match && (k < signal_count); ++k) {
+            match = (signal_ids[k] == def->signal_id);
+        }
+        if (match) {
+            selected[def->signal_id] = 1;
+            sources_used[def->source_id] = 1;
+        }
+    }
+    for (uint32_t k = 0; (NULL != signal_ids) && (k < signal_count); ++k) {
+        if ((signal_ids[k] >= JLS_SIGNAL_COUNT) || !selected[signal_ids[k]]) {
+            return JLS_ERROR_PARAMETER_INVALID;  // not a FSR signal
+        }
+    }
+
+    ROE(jls_rd_user_data(rd, slice_user_data, &s));
+    ROE(s.rc);
+    for (uint16_t idx = 0; idx < sources_count; ++idx) {
+        if (sources[idx].source_id && sources_used[sources[idx].source_id]) {
+            ROE(jls_wr_source_def(wr, &sources[idx]));
+        }
+    }
+    s.signal_id = 0;
+    ROE(jls_rd_annotations(rd, 0, 0, slice_annotation, &s));
+    ROE(s.rc);
+
+    for (uint16_t idx = 0; idx < signals_count; ++idx) {
+        struct jls_signal_def_s * def = &signals[idx];
+        if (!selected[def->signal_id]) {
+            continue;
+        }
+        ROE(jls_wr_signal_def(wr, def));
+        int64_t length = 0;
+        ROE(jls_rd_fsr_length(rd, def->signal_id, &length));
+        int64_t start = (start_sample_id < 0) ? 0 : start_sample_id;
+        int64_t end = ((end_sample_id < 0) || (end_sample_id > length)) ? length : end_sample_id;
+        if (start > end) {
+            start = end;
+        }
+        s.signal_id = def->signal_id;
+        s.sample_id_offset = def->sample_id_offset;
+        s.start = start + def->sample_id_offset;
+        s.end = end + def->sample_id_offset;
+        if (start == end) {
+            continue;
+        }
+        ROE(slice_signal(rd, &s, def));
+    }
+    return 0;
+}
+
+int32_t jls_slice(const char * src, const char * dst,
+                  const uint16_t * signal_ids, uint32_t signal_count,
+                  int64_t start_sample_id, int64_t end_sample_id) {
+    struct jls_rd_s * rd = NULL;
+    struct jls_wr_s * wr = NULL;
+    ROE(jls_rd_open(&rd, src));
+    int32_t rc = jls_wr_open(&wr, dst);
+    if (rc) {
+        jls_rd_close(rd);
+        return rc;
+    }
+    rc = slice(rd, wr, signal_ids, signal_count, start_sample_id, end_sample_id);
+    int32_t rc_close = jls_wr_close(wr);
+    jls_rd_close(rd);
+    return rc ? rc : rc_close;
+}
+
+static bool concat_signal_match(const struct jls_signal_def_s * a, const struct jls_signal_def_s * b) {
+    return (a->signal_type == b->signal_type)
+        && (a->data_type == b->data_type)
+        && (a->sample_rate == b->sample_rate)
+        && (a->samples_per_data == b->samples_per_data)
+        && (a->sample_decimate_factor == b->sample_decimate_factor)
+        && (a->entries_per_summary == b->entries_per_summary)
+        && (a->summary_decimate_factor == b->summary_decimate_factor)
+        && (a->summary_fields == b->summary_fields)
+        && (a->summary_hist_bins == b->summary_hist_bins)
+        && (a->summary_hist_level == b->summary_hist_level)
+        && (a->summary_hist_min == b->summary_hist_min)
+        && (a->summary_hist_max == b->summary_hist_max);
+}
+
+struct concat_s {
+    struct jls_wr_s * wr;
+    bool defined;                               // first source defined the signals
+    uint8_t fsr[JLS_SIGNAL_COUNT];              // the FSR signals
+    struct jls_signal_def_s def[JLS_SIGNAL_COUNT];  // the definitions, without names
+    int64_t sample_id_start[JLS_SIGNAL_COUNT];  // the destination first sample id
+    int64_t sample_id_next[JLS_SIGNAL_COUNT];   // the destination next sample id
+};
+
+static int32_t concat_signals(struct jls_rd_s * rd, struct concat_s * c) {
+    struct jls_source_def_s * sources = NULL;
+    struct jls_signal_def_s * signals = NULL;
+    uint16_t sources_count = 0;
+    uint16_t signals_count = 0;
+    uint8_t fsr[JLS_SIGNAL_COUNT];
+    memset(fsr, 0, sizeof(fsr));
+    ROE(jls_rd_sources(rd, &sources, &sources_count));
+    ROE(jls_rd_signals(rd, &signals, &signals_count));
+
+    for (uint16_t idx = 0; idx < signals_count; ++idx) {
+        struct jls_signal_def_s * def = &signals[idx];
+        if ((def->signal_id == 0) || (def->signal_type != JLS_SIGNAL_TYPE_FSR)) {
+            continue;
+        }
+        fsr[def->signal_id] = 1;
+        if (!c->defined) {
+            c->fsr[def->signal_id] = 1;
+            c->def[def->signal_id] = *def;
+            c->def[def->signal_id].name = NULL;
+            c->def[def->signal_id].units = NULL;
+            c->sample_id_start[def->signal_id] = def->sample_id_offset;
+            c->sample_id_next[def->signal_id] = def->sample_id_offset;
+        } else if (!c->fsr[def->signal_id] || !concat_signal_match(&c->def[def->signal_id], def)) {
+            JLS_LOGW("concat: signal %d does not match", (int) def->signal_id);
+            return JLS_ERROR_PARAMETER_INVALID;
+        }
+    }
+    if (c->defined) {
+        if (memcmp(fsr, c->fsr, sizeof(fsr))) {
+            JLS_LOGW("concat: missing signals");
+            return JLS_ERROR_PARAMETER_INVALID;
+        }
+        return 0;
+    }
+
+    for (uint16_t idx = 0; idx < sources_count; ++idx) {
+        if (sources[idx].source_id) {
+            ROE(jls_wr_source_def(c->wr, &sources[idx]));
+        }
+    }
+    for (uint16_t idx = 0; idx < signals_count; ++idx) {
+        if (fsr[signals[idx].signal_id]) {
+            ROE(jls_wr_signal_def(c->wr, &signals[idx]));
+        }
+    }
+    c->defined = true;
+    return 0;
+}
+
+static int32_t concat_one(struct jls_rd_s * rd, struct concat_s * c) {
+    struct slice_s s = {.wr = c->wr, .chunk_copy = true, .utc_ends = false, .rc = 0};
+    ROE(concat_signals(rd, c));
+    ROE(jls_rd_user_data(rd, slice_user_data, &s));
+    ROE(s.rc);
+    ROE(jls_rd_annotations(rd, 0, 0, slice_annotation, &s));
+    ROE(s.rc);
+
+    for (uint32_t signal_id = 1; signal_id < JLS_SIGNAL_COUNT; ++signal_id) {
+        if (!c->fsr[signal_id]) {
+            continue;
+        }
+        struct jls_signal_def_s * def = &c->def[signal_id];
+        int64_t length = 0;
+        ROE(jls_rd_fsr_length(rd, (uint16_t) signal_id, &length));
+        s.signal_id = (uint16_t) signal_id;
+        s.sample_id_offset = c->sample_id_next[signal_id];
+        s.start = c->sample_id_next[signal_id];
+        s.end = s.start + length;
+        s.chunk_copy = (0 == ((s.start - c->sample_id_start[signal_id]) % def->samples_per_data));
+        if (length) {
+            ROE(slice_signal(rd, &s, def));
+        }
+        c->sample_id_next[signal_id] = s.end;
+    }
+    return 0;
+}
+
+int32_t jls_concat(const char * const * src, uint32_t src_count, const char * dst) {
+    struct jls_rd_s * rd = NULL;
+    int32_t rc = 0;
+    if ((NULL == src) || !src_count) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    struct concat_s * c = calloc(1, sizeof(struct concat_s));
+    if (NULL == c) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    rc = jls_wr_open(&c->wr, dst);
+    for (uint32_t idx = 0; !rc && (idx < src_count); ++idx) {
+        rc = jls_rd_open(&rd, src[idx]);
+        if (!rc) {
+            rc = concat_one(rd, c);
+            jls_rd_close(rd);
+        }
+    }
+    if (c->wr) {
+        int32_t rc_close = jls_wr_close(c->wr);
+        rc = rc ? rc : rc_close;
+    }
+    free(c);
+    return rc;
+}
@@ -17,9 +17,11 @@
 #include "jls/core.h"
 #include "jls/backend.h"
 #include "jls/crc32c.h"
+#include "jls/datatype.h"
 #include "jls/format.h"
 #include "jls/bit_shift.h"
 #include "jls/cdef.h"
+#include "jls/checkpoint.h"
 #include "jls/ec.h"
 #include "jls/log.h"
 #include "jls/track.h"
@@ -122,6 +124,183 @@ void jls_core_f64_buf_free(struct jls_core_f64_buf_s * buf) {
     }
 }
 
+int32_t jls_core_stats_enable(struct jls_core_s * self, int enable) {
+    if (!enable) {
+        jls_core_stats_free(self);
+        return 0;
+    }
+    if (!self->stats) {
+        self->stats = malloc(sizeof(struct jls_stats_s));
+        if (!self->stats) {
+            return JLS_ERROR_NOT_ENOUGH_MEMORY;
+        }
+    }
+    memset(self->stats, 0, sizeof(*self->stats));
+    jls_raw_stats_set(self->raw, self->stats);
+    return 0;
+}
+
+int32_t jls_core_stats(struct jls_core_s * self, struct jls_stats_s * stats) {
+    if (!stats) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    if (!self->stats) {
+        memset(stats, 0, sizeof(*stats));
+        return JLS_ERROR_UNAVAILABLE;
+    }
+    *stats = *self->stats;
+    return 0;
+}
+
+void jls_core_stats_free(struct jls_core_s * self) {
+    jls_raw_stats_set(self->raw, NULL);
+    free(self->stats);
+    self->stats = NULL;
+}
+
+uint32_t jls_core_fsr_summary_stride(uint32_t summary_fields) {
+    uint32_t stride = JLS_SUMMARY_FSR_COUNT;
+    for (uint32_t f = summary_fields & JLS_SUMMARY_FIELD_ALL; f; f &= f - 1) {
+        ++stride;
+    }
+    return stride;
+}
+
+uint32_t jls_core_fsr_summary_level_stride(const struct jls_signal_def_s * def, uint8_t level) {
+    uint32_t stride = jls_core_fsr_summary_stride(def->summary_fields);
+    if (def->summary_hist_bins && (level >= def->summary_hist_level)) {
+        stride += def->summary_hist_bins;
+    }
+    return stride;
+}
+
+uint32_t jls_core_fsr_hist_bin(const struct jls_signal_def_s * def, double x) {
+    double v_min = def->summary_hist_min;
+    double v_max = def->summary_hist_max;
+    double idx = floor((x - v_min) * def->summary_hist_bins / (v_max - v_min));
+    if (idx <= 0.0) {
+        return 0;
+    } else if (idx >= def->summary_hist_bins) {
+        return def->summary_hist_bins - 1;
+    }
+    return (uint32_t) idx;
+}
+
+static inline void sum_add(double * sum, double * c, double x) {
+    // Neumaier compensated summation
+    double t = *sum + x;
+    if (fabs(*sum) >= fabs(x)) {
+        *c += (*sum - t) + x;
+    } else {
+        *c += (x - t) + *sum;
+    }
+    *sum = t;
+}
+
+void jls_core_fsr_entry_reset(struct jls_core_fsr_entry_s * e) {
+    jls_statistics_reset(&e->stats);
+    e->sum = 0.0;
+    e->sum_c = 0.0;
+    e->sum_sq = 0.0;
+    e->sum_sq_c = 0.0;
+    e->first = NAN;
+    e->last = NAN;
+}
+
+void jls_core_fsr_entry_add(struct jls_core_fsr_entry_s * e, double x) {
+    // only updates k and the optional fields, not mean, s, min or max
+    if (!isfinite(x)) {
+        return;
+    }
+    if (!e->stats.k) {
+        e->first = x;
+    }
+    e->last = x;
+    ++e->stats.k;
+    sum_add(&e->sum, &e->sum_c, x);
+    sum_add(&e->sum_sq, &e->sum_sq_c, x * x);
+}
+
+void jls_core_fsr_entry_combine(struct jls_core_fsr_entry_s * tgt,
+                                const struct jls_core_fsr_entry_s * a,
+                                const struct jls_core_fsr_entry_s * b) {
+    double first = a->stats.k ? a->first : b->first;
+    double last = b->stats.k ? b->last : a->last;
+    double sum = a->sum;
+    double sum_c = a->sum_c + b->sum_c;
+    double sum_sq = a->sum_sq;
+    double sum_sq_c = a->sum_sq_c + b->sum_sq_c;
+    sum_add(&sum, &sum_c, b->sum);
+    sum_add(&sum_sq, &sum_sq_c, b->sum_sq);
+    jls_statistics_combine(&tgt->stats, &a->stats, &b->stats);
+    tgt->sum = sum;
+    tgt->sum_c = sum_c;
+    tgt->sum_sq = sum_sq;
+    tgt->sum_sq_c = sum_sq_c;
+    tgt->first = first;
+    tgt->last = last;
+}
+
+void jls_core_fsr_entry_encode(const struct jls_core_fsr_entry_s * e, uint32_t fields, double * values) {
+    double k = (double) e->stats.k;
+    if (fields & JLS_SUMMARY_FIELD_SUM) {
+        *values++ = e->sum + e->sum_c;
+    }
+    if (fields & JLS_SUMMARY_FIELD_RMS) {
+        *values++ = e->stats.k ? sqrt((e->sum_sq + e->sum_sq_c) / k) : NAN;
+    }
+    if (fields & JLS_SUMMARY_FIELD_FINITE) {
+        *values++ = k;
+    }
+    if (fields & JLS_SUMMARY_FIELD_FIRST) {
+        *values++ = e->first;
+    }
+    if (fields & JLS_SUMMARY_FIELD_LAST) {
+        *values++ = e->last;
+    }
+}
+
+void jls_core_fsr_entry_decode(struct jls_core_fsr_entry_s * e, uint32_t fields, const double * values, double scale) {
+    // e->stats already holds the base fields for the nominal sample count scaled by scale.
+    double sum = NAN;
+    double rms = NAN;
+    e->first = NAN;
+    e->last = NAN;
+    if (fields & JLS_SUMMARY_FIELD_SUM) {
+        sum = *values++ * scale;
+    }
+    if (fields & JLS_SUMMARY_FIELD_RMS) {
+        rms = *values++;
+    }
+    if (fields & JLS_SUMMARY_FIELD_FINITE) {
+        uint64_t k = (uint64_t) llround(*values++ * scale);
+        if (!k) {
+            jls_statistics_reset(&e->stats);
+        } else if (k != e->stats.k) {
+            e->stats.s *= k / (double) e->stats.k;
+            e->stats.k = k;
+        }
+    }
+    if (fields & JLS_SUMMARY_FIELD_FIRST) {
+        e->first = *values++;
+    }
+    if (fields & JLS_SUMMARY_FIELD_LAST) {
+        e->last = *values++;
+    }
+    double k = (double) e->stats.k;
+    e->sum_c = 0.0;
+    e->sum_sq_c = 0.0;
+    if (!e->stats.k) {
+        e->sum = 0.0;
+        e->sum_sq = 0.0;
+        e->first = NAN;
+        e->last = NAN;
+        return;
+    }
+    e->sum = isnan(sum) ? (e->stats.mean * k) : sum;
+    e->sum_sq = isnan(rms) ? (e->stats.s + e->stats.mean * e->stats.mean * k) : (rms * rms * k);
+}
+
 int32_t jls_core_signal_def_validate(struct jls_signal_def_s const * def) {
     // externally verify signal_id
     // externally verify source_id
@@ -176,6 +355,27 @@ int32_t jls_core_signal_def_validate(struct jls_signal_def_s const * def) {
                 return JLS_ERROR_PARAMETER_INVALID;
         }
     }
+
+    if (def->summary_fields & ~((uint32_t) (JLS_SUMMARY_FIELD_ALL | JLS_SUMMARY_FIELD_F64))) {
+        JLS_LOGW("Invalid summary fields: 0x%08x", def->summary_fields);
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    if (def->summary_hist_bins) {
+        if (def->summary_hist_bins > JLS_SUMMARY_HIST_BINS_MAX) {
+            JLS_LOGW("Invalid summary histogram bins: %" PRIu32, def->summary_hist_bins);
+            return JLS_ERROR_PARAMETER_INVALID;
+        }
+        if (def->summary_hist_level >= JLS_SUMMARY_LEVEL_COUNT) {
+            JLS_LOGW("Invalid summary histogram level: %" PRIu32, def->summary_hist_level);
+            return JLS_ERROR_PARAMETER_INVALID;
+        }
+        if (!isfinite(def->summary_hist_min) || !isfinite(def->summary_hist_max)
+                || (def->summary_hist_min >= def->summary_hist_max)) {
+            JLS_LOGW("Invalid summary histogram range: %f to %f",
+                     (double) def->summary_hist_min, (double) def->summary_hist_max);
+            return JLS_ERROR_PARAMETER_INVALID;
+        }
+    }
     return 0;
 }
 
@@ -248,6 +448,9 @@ int32_t jls_core_signal_def_align(struct jls_signal_def_s * def) {
     def->samples_per_data = samples_per_data;
     def->entries_per_summary = entries_per_summary;
     def->summary_decimate_factor = summary_decimate_factor;
+    if (def->summary_hist_bins && !def->summary_hist_level) {
+        def->summary_hist_level = 2;
+    }
     return 0;
 }
 
@@ -281,7 +484,7 @@ int32_t jls_core_signal_validate(struct jls_core_s * self, uint16_t signal_id) {
     struct jls_core_signal_s * signal_info = &self->signal_info[signal_id];
     if (signal_info->signal_def.signal_id != signal_id) {
         JLS_LOGW("signal_id %d not defined", (int) signal_id);
-        return false;
+        return JLS_ERROR_NOT_FOUND;
     }
     if (!signal_info->chunk_def.offset) {
         JLS_LOGW("attempted to annotated an undefined signal %d", (int) signal_id);
@@ -426,6 +629,8 @@ int32_t jls_core_wr_index(struct jls_core_s * self, uint16_t signal_id, enum jls
 }
 
 int32_t jls_core_wr_end(struct jls_core_s * self) {
+    ROE(jls_core_checkpoint_clear(self));  // closed files do not need recovery
+
     // construct header
     struct jls_core_chunk_s chunk;
     chunk.hdr.item_next = 0;
@@ -500,33 +705,73 @@ int32_t jls_core_rd_chunk_end(struct jls_core_s * self) {
     return JLS_ERROR_NOT_FOUND;
 }
 
+int32_t jls_core_rd_chunk_header(struct jls_core_s * self, int64_t offset, struct jls_core_chunk_s * chunk) {
+    memset(chunk, 0, sizeof(*chunk));
+    if (offset) {
+        ROE(jls_raw_chunk_seek(self->raw, offset));
+        ROE(jls_raw_rd_header(self->raw, &chunk->hdr));
+        chunk->offset = offset;
+    }
+    return 0;
+}
+
+int32_t jls_core_list_tail(struct jls_core_s * self, struct jls_core_chunk_s * chunk) {
+    ROE(jls_core_rd_chunk_header(self, chunk->offset, chunk));
+    while (chunk->hdr.item_next) {
+        ROE(jls_core_rd_chunk_header(self, chunk->hdr.item_next, chunk));
+    }
+    return 0;
+}
+
+int32_t jls_core_rd_chunk_tail(struct jls_core_s * self, int64_t offset, uint8_t tag) {
+    if (offset) {
+        ROE(jls_raw_chunk_seek(self->raw, offset));
+    }
+    ROE(jls_core_rd_chunk(self));
+    if (self->chunk_cur.hdr.tag != tag) {
+        JLS_LOGE("chunk at %" PRIi64 ": tag %d, expected %d",
+                 self->chunk_cur.offset, (int) self->chunk_cur.hdr.tag, (int) tag);
+        return JLS_ERROR_NOT_SUPPORTED;
+    } else if (self->chunk_cur.hdr.item_next) {
+        JLS_LOGE("chunk at %" PRIi64 " is not the list tail", self->chunk_cur.offset);
+        return JLS_ERROR_NOT_SUPPORTED;
+    }
+    return 0;
+}
+
+
+static int32_t handle_source_def(struct jls_core_s * self) {
+    uint16_t source_id = self->chunk_cur.hdr.chunk_meta;
+    if (source_id >= JLS_SOURCE_COUNT) {
+        JLS_LOGW("source_id %d too big - skip", (int) source_id);
+        return 0;
+    }
+    struct jls_core_source_s * source_info = &self->source_info[source_id];
+    source_info->chunk_def = self->chunk_cur;
+    struct jls_source_def_s *src = &source_info->source_def;
+    ROE(jls_buf_rd_skip(self->buf, 64));
+    ROE(jls_buf_rd_str(self->buf, (const char **) &src->name));
+    ROE(jls_buf_rd_str(self->buf, (const char **) &src->vendor));
+    ROE(jls_buf_rd_str(self->buf, (const char **) &src->model));
+    ROE(jls_buf_rd_str(self->buf, (const char **) &src->version));
+    ROE(jls_buf_rd_str(self->buf, (const char **) &src->serial_number));
+    src->source_id = source_id;  // indicate that this source is valid!
+    JLS_LOGD1("Found source %d : %s", (int) source_id, src->name);
+    return 0;
+}
 
 int32_t jls_core_scan_sources(struct jls_core_s * self) {
     JLS_LOGD1("jls_core_scan_sources");
     ROE(jls_raw_chunk_seek(self->raw, self->source_head.offset));
     while (1) {
         ROE(jls_core_rd_chunk(self));
-        uint16_t source_id = self->chunk_cur.hdr.chunk_meta;
-        if (source_id >= JLS_SOURCE_COUNT) {
-            JLS_LOGW("source_id %d too big - skip", (int) source_id);
-        } else {
-            struct jls_core_source_s * source_info = &self->source_info[source_id];
-            source_info->chunk_def = self->chunk_cur;
-            struct jls_source_def_s *src = &source_info->source_def;
-            ROE(jls_buf_rd_skip(self->buf, 64));
-            ROE(jls_buf_rd_str(self->buf, (const char **) &src->name));
-            ROE(jls_buf_rd_str(self->buf, (const char **) &src->vendor));
-            ROE(jls_buf_rd_str(self->buf, (const char **) &src->model));
-            ROE(jls_buf_rd_str(self->buf, (const char **) &src->version));
-            ROE(jls_buf_rd_str(self->buf, (const char **) &src->serial_number));
-            src->source_id = source_id;  // indicate that this source is valid!
-            JLS_LOGD1("Found source %d : %s", (int) source_id, src->name);
-        }
+        ROE(handle_source_def(self));
         if (!self->chunk_cur.hdr.item_next) {
             break;
         }
         ROE(jls_raw_chunk_seek(self->raw, self->chunk_cur.hdr.item_next));
     }
+    self->source_head = self->chunk_cur;  // continue from here on append and jls_core_follow_update()
     return 0;
 }
 
@@ -551,7 +796,12 @@ static int32_t handle_signal_def(struct jls_core_s * self) {
     ROE(jls_buf_rd_u32(self->buf, &s->summary_decimate_factor));
     ROE(jls_buf_rd_u32(self->buf, &s->annotation_decimate_factor));
     ROE(jls_buf_rd_u32(self->buf, &s->utc_decimate_factor));
-    ROE(jls_buf_rd_skip(self->buf, 92));
+    ROE(jls_buf_rd_u32(self->buf, &s->summary_fields));
+    ROE(jls_buf_rd_u32(self->buf, &s->summary_hist_bins));
+    ROE(jls_buf_rd_u32(self->buf, &s->summary_hist_level));
+    ROE(jls_buf_rd_f32(self->buf, &s->summary_hist_min));
+    ROE(jls_buf_rd_f32(self->buf, &s->summary_hist_max));
+    ROE(jls_buf_rd_skip(self->buf, 72));
     ROE(jls_buf_rd_str(self->buf, (const char **) &s->name));
     ROE(jls_buf_rd_str(self->buf, (const char **) &s->units));
     if (0 == jls_core_signal_def_validate(s)) {  // validate passed
@@ -591,25 +841,31 @@ static int32_t handle_track_head(struct jls_core_s * self, int64_t pos) {
     return 0;
 }
 
+static int32_t handle_signal_list(struct jls_core_s * self) {
+    if (self->chunk_cur.hdr.tag == JLS_TAG_SIGNAL_DEF) {
+        handle_signal_def(self);
+    } else if ((self->chunk_cur.hdr.tag & 7) == JLS_TRACK_CHUNK_DEF) {
+        handle_track_def(self, self->chunk_cur.offset);
+    } else if ((self->chunk_cur.hdr.tag & 7) == JLS_TRACK_CHUNK_HEAD) {
+        handle_track_head(self, self->chunk_cur.offset);
+    } else {
+        JLS_LOGW("unknown tag %d in signal list", (int) self->chunk_cur.hdr.tag);
+    }
+    return 0;
+}
+
 int32_t jls_core_scan_signals(struct jls_core_s * self) {
     JLS_LOGD1("jls_core_scan_signals");
     ROE(jls_raw_chunk_seek(self->raw, self->signal_head.offset));
     while (1) {
         ROE(jls_core_rd_chunk(self));
-        if (self->chunk_cur.hdr.tag == JLS_TAG_SIGNAL_DEF) {
-            handle_signal_def(self);
-        } else if ((self->chunk_cur.hdr.tag & 7) == JLS_TRACK_CHUNK_DEF) {
-            handle_track_def(self, self->chunk_cur.offset);
-        } else if ((self->chunk_cur.hdr.tag & 7) == JLS_TRACK_CHUNK_HEAD) {
-            handle_track_head(self, self->chunk_cur.offset);
-        } else {
-            JLS_LOGW("unknown tag %d in signal list", (int) self->chunk_cur.hdr.tag);
-        }
+        handle_signal_list(self);
         if (!self->chunk_cur.hdr.item_next) {
             break;
         }
         ROE(jls_raw_chunk_seek(self->raw, self->chunk_cur.hdr.item_next));
     }
+    self->signal_head = self->chunk_cur;  // continue from here on append and jls_core_follow_update()
     return 0;
 }
 
@@ -676,11 +932,228 @@ int32_t jls_core_scan_initial(struct jls_core_s * self) {
                     self->signal_head.hdr = self->chunk_cur.hdr;
                 }
                 break;
+            case JLS_TAG_CHECKPOINT_HEAD:  // also accept it before the first source_def
+                if (!self->checkpoint_head.offset) {
+                    self->checkpoint_head.offset = pos;
+                    self->checkpoint_head.hdr = self->chunk_cur.hdr;
+                }
+                break;
             default:
                 break;  // skip
         }
     }
     JLS_LOGD1("found initial tags");
+
+    // The checkpoint head follows the signal 0 track definitions and heads.
+    while (!self->checkpoint_head.offset) {
+        int64_t pos = jls_raw_chunk_tell(self->raw);
+        rc = jls_core_rd_chunk(self);
+        if (rc == JLS_ERROR_EMPTY) {
+            return 0;
+        } else if (rc) {
+            return rc;
+        }
+        uint8_t tag = self->chunk_cur.hdr.tag;
+        if (tag == JLS_TAG_CHECKPOINT_HEAD) {
+            self->checkpoint_head.offset = pos;
+            self->checkpoint_head.hdr = self->chunk_cur.hdr;
+        } else if (!(tag & JLS_TRACK_TAG_FLAG) || ((tag & 7) > JLS_TRACK_CHUNK_HEAD)) {
+            break;  // no checkpoint head, such as files from earlier versions
+        }
+    }
+    return 0;
+}
+
+static int64_t fsr_index_step(const struct jls_signal_def_s * signal_def, int level) {
+    // compute the step size in samples between each index entry.
+    int64_t step_size = signal_def->samples_per_data;  // each data chunk
+    if (level > 1) {
+        step_size *= signal_def->entries_per_summary /
+                (signal_def->samples_per_data / signal_def->sample_decimate_factor);
+    }
+    for (int k = 3; k <= level; ++k) {
+        step_size *= signal_def->summary_decimate_factor;
+    }
+    return step_size;
+}
+
+static int32_t follow_list(struct jls_core_s * self, struct jls_core_chunk_s * last,
+                           int32_t (*handle)(struct jls_core_s * self)) {
+    if (!last->offset) {
+        return 0;
+    }
+    ROE(jls_raw_chunk_seek(self->raw, last->offset));
+    ROE(jls_raw_rd_header(self->raw, &last->hdr));  // item_next updated when the writer appends
+    while (last->hdr.item_next) {
+        ROE(jls_raw_chunk_seek(self->raw, last->hdr.item_next));
+        ROE(jls_core_rd_chunk(self));
+        ROE(handle(self));
+        *last = self->chunk_cur;
+    }
+    return 0;
+}
+
+static int32_t follow_track_heads(struct jls_core_s * self) {
+    // The writer updates the track head payload in place as levels are added.
+    for (uint16_t signal_id = 0; signal_id < JLS_SIGNAL_COUNT; ++signal_id) {
+        struct jls_core_signal_s * info = &self->signal_info[signal_id];
+        if (info->signal_def.signal_id != signal_id) {
+            continue;
+        }
+        for (int track_type = 0; track_type < JLS_TRACK_TYPE_COUNT; ++track_type) {
+            int64_t offset = info->tracks[track_type].head.offset;
+            if (offset) {
+                ROE(jls_raw_chunk_seek(self->raw, offset));
+                ROE(jls_core_rd_chunk(self));
+                ROE(handle_track_head(self, offset));
+            }
+        }
+    }
+    return 0;
+}
+
+static int32_t follow_fsr_level(struct jls_core_s * self, struct jls_core_track_s * track, uint8_t level,
+                                int64_t start, bool * updated) {
+    struct jls_signal_def_s * signal_def = &track->parent->signal_def;
+    int64_t step_size = fsr_index_step(signal_def, level);
+    struct jls_payload_header_s * h;
+
+    if (!track->summary_head[level].offset) {
+        // the summary immediately follows the index
+        ROE(jls_raw_chunk_seek(self->raw, start));
+        ROE(jls_core_rd_chunk(self));
+        struct jls_core_chunk_s index = self->chunk_cur;
+        h = (struct jls_payload_header_s *) self->buf->start;
+        int64_t index_end = h->timestamp + h->entry_count * step_size;
+        if (jls_core_rd_chunk(self) || (self->chunk_cur.hdr.tag != JLS_TAG_TRACK_FSR_SUMMARY)) {
+            return 0;  // summary not yet written
+        }
+        track->index_head[level] = index;
+        track->summary_head[level] = self->chunk_cur;
+        track->follow_end[level] = index_end;
+        *updated = true;
+    }
+
+    // The writer links each summary after writing the next index and summary.
+    while (1) {
+        ROE(jls_raw_chunk_seek(self->raw, track->summary_head[level].offset));
+        ROE(jls_raw_rd_header(self->raw, &track->summary_head[level].hdr));
+        int64_t summary_next = track->summary_head[level].hdr.item_next;
+        if (!summary_next) {
+            return 0;
+        }
+        ROE(jls_raw_chunk_seek(self->raw, track->index_head[level].offset));
+        ROE(jls_raw_rd_header(self->raw, &track->index_head[level].hdr));
+        int64_t index_next = track->index_head[level].hdr.item_next;
+        if (!index_next) {
+            JLS_LOGW("follow: summary linked without index");
+            return 0;
+        }
+        ROE(jls_raw_chunk_seek(self->raw, index_next));
+        ROE(jls_core_rd_chunk(self));
+        h = (struct jls_payload_header_s *) self->buf->start;
+        track->index_head[level] = self->chunk_cur;
+        track->summary_head[level].offset = summary_next;
+        track->follow_end[level] = h->timestamp + h->entry_count * step_size;
+        *updated = true;
+    }
+}
+
+static int32_t follow_fsr_data(struct jls_core_s * self, struct jls_core_track_s * track, int64_t offset) {
+    ROE(jls_raw_chunk_seek(self->raw, offset));
+    ROE(jls_core_rd_chunk(self));
+    struct jls_payload_header_s * h = (struct jls_payload_header_s *) self->buf->start;
+    track->data_head = self->chunk_cur;
+    track->follow_end[0] = h->timestamp + h->entry_count;
+    return 0;
+}
+
+static int32_t follow_fsr(struct jls_core_s * self, uint16_t signal_id) {
+    struct jls_core_signal_s * info = &self->signal_info[signal_id];
+    struct jls_signal_def_s * signal_def = &info->signal_def;
+    struct jls_core_track_s * track = &info->tracks[JLS_TRACK_TYPE_FSR];
+    if (!info->track_fsr) {
+        info->parent = self;
+        ROE(jls_fsr_open(&info->track_fsr, info));
+    }
+    if (!track->head_offsets[0]) {
+        info->track_fsr->signal_length = 0;  // no data yet
+        return 0;
+    }
+    if (!track->data_head.offset) {
+        ROE(follow_fsr_data(self, track, track->head_offsets[0]));
+        struct jls_fsr_data_s * r = (struct jls_fsr_data_s *) self->buf->start;
+        signal_def->sample_id_offset = r->header.timestamp;
+    }
+
+    // Follow from the top level down.  A level not yet followed starts from the
+    // last entry of the level above, so opening costs one walk to the end of each
+    // level rather than a scan of the entire file.
+    bool updated = false;
+    uint8_t level_top = 0;
+    while (((level_top + 1) < JLS_SUMMARY_LEVEL_COUNT) && track->head_offsets[level_top + 1]) {
+        ++level_top;
+    }
+    for (uint8_t level = level_top; level > 0; --level) {
+        bool level_updated = false;
+        int64_t start = track->head_offsets[level];
+        if (!track->summary_head[level].offset && (level < level_top) && track->index_head[level + 1].offset) {
+            ROE(jls_raw_chunk_seek(self->raw, track->index_head[level + 1].offset));
+            ROE(jls_core_rd_chunk(self));
+            struct jls_fsr_index_s * r = (struct jls_fsr_index_s *) self->buf->start;
+            if (r->header.entry_count && r->offsets[r->header.entry_count - 1]) {
+                start = r->offsets[r->header.entry_count - 1];
+            }
+        }
+        ROE(follow_fsr_level(self, track, level, start, &level_updated));
+        if (level == 1) {
+            updated = level_updated;
+        }
+    }
+
+    if (updated) {  // skip to the last indexed data chunk
+        ROE(jls_raw_chunk_seek(self->raw, track->index_head[1].offset));
+        ROE(jls_core_rd_chunk(self));
+        struct jls_fsr_index_s * r = (struct jls_fsr_index_s *) self->buf->start;
+        if (r->header.entry_count) {
+            int64_t offset = r->offsets[r->header.entry_count - 1];
+            if (offset > track->data_head.offset) {  // 0 when omitted
+                ROE(follow_fsr_data(self, track, offset));
+            }
+        }
+    }
+    while (1) {  // follow the unindexed data chunks
+        ROE(jls_raw_chunk_seek(self->raw, track->data_head.offset));
+        ROE(jls_raw_rd_header(self->raw, &track->data_head.hdr));
+        if (!track->data_head.hdr.item_next) {
+            break;
+        }
+        int64_t offset = track->data_head.hdr.item_next;
+        if (follow_fsr_data(self, track, offset)) {
+            JLS_LOGW("follow: incomplete data chunk at %" PRIi64, offset);
+            track->data_head.hdr.item_next = 0;  // linked, but not completely written
+            break;
+        }
+    }
+
+    info->track_fsr->signal_length = track->follow_end[0] - signal_def->sample_id_offset;
+    return 0;
+}
+
+int32_t jls_core_follow_update(struct jls_core_s * self) {
+    if (!self->follow) {
+        return 0;
+    }
+    ROE(jls_raw_end_update(self->raw));
+    ROE(follow_list(self, &self->source_head, handle_source_def));
+    ROE(follow_list(self, &self->signal_head, handle_signal_list));
+    ROE(follow_track_heads(self));
+    for (uint16_t signal_id = 0; signal_id < JLS_SIGNAL_COUNT; ++signal_id) {
+        struct jls_signal_def_s * signal_def = &self->signal_info[signal_id].signal_def;
+        if ((signal_def->signal_id == signal_id) && (signal_def->signal_type == JLS_SIGNAL_TYPE_FSR)) {
+            ROE(follow_fsr(self, signal_id));
+        }
+    }
     return 0;
 }
 
@@ -724,6 +1197,32 @@ int32_t jls_core_signal(struct jls_core_s * self, uint16_t signal_id, struct jls
     return 0;
 }
 
+/**
+ * @brief Read the chunk at offset and follow item_next to the chunk containing sample_id.
+ *
+ * @param self The instance.
+ * @param step_size The samples for each payload entry.
+ * @param end The file sample_id end of the chunks available to follow.
+ * @param sample_id The target file sample_id.
+ * @param[inout] offset The starting chunk offset, updated to the chunk read.
+ * @return 0 or error code.
+ *
+ * Only for follow mode, where newer chunks may not yet be indexed.
+ */
+static int32_t follow_walk(struct jls_core_s * self, int64_t step_size, int64_t end,
+                           int64_t sample_id, int64_t * offset) {
+    while (1) {
+        ROE(jls_raw_chunk_seek(self->raw, *offset));
+        ROE(jls_core_rd_chunk(self));
+        struct jls_payload_header_s * h = (struct jls_payload_header_s *) self->buf->start;
+        int64_t chunk_end = h->timestamp + h->entry_count * step_size;
+        if ((sample_id < chunk_end) || (chunk_end >= end) || !self->chunk_cur.hdr.item_next) {
+            return 0;
+        }
+        *offset = self->chunk_cur.hdr.item_next;
+    }
+}
+
 int32_t jls_core_fsr_seek(struct jls_core_s * self, uint16_t signal_id, uint8_t level, int64_t sample_id) {
     // timestamp in JLS units with possible non-zero offset
     ROE(jls_core_signal_validate(self, signal_id));
@@ -733,10 +1232,12 @@ int32_t jls_core_fsr_seek(struct jls_core_s * self, uint16_t signal_id, uint8_t
         return JLS_ERROR_NOT_SUPPORTED;
     }
     int64_t offset = 0;
-    int64_t * offsets = self->signal_info[signal_id].tracks[JLS_TRACK_TYPE_FSR].head_offsets;
+    struct jls_core_track_s * track = &self->signal_info[signal_id].tracks[JLS_TRACK_TYPE_FSR];
+    int64_t * offsets = track->head_offsets;
     int initial_level = JLS_SUMMARY_LEVEL_COUNT - 1;
     for (; initial_level >= 0; --initial_level) {
-        if (offsets[initial_level]) {
+        // follow mode skips levels without a complete index and summary
+        if (offsets[initial_level] && (!self->follow || track->follow_end[initial_level])) {
             offset = offsets[initial_level];
             break;
         }
@@ -746,19 +1247,15 @@ int32_t jls_core_fsr_seek(struct jls_core_s * self, uint16_t signal_id, uint8_t
     }
 
     for (int lvl = initial_level; lvl > level; --lvl) {
-        // compute the step size in samples between each index entry.
-        int64_t step_size = signal_def->samples_per_data;  // each data chunk
-        if (lvl > 1) {
-            step_size *= signal_def->entries_per_summary /
-                    (signal_def->samples_per_data / signal_def->sample_decimate_factor);
-        }
-        for (int k = 3; k <= lvl; ++k) {
-            step_size *= signal_def->summary_decimate_factor;
-        }
+        int64_t step_size = fsr_index_step(signal_def, lvl);
         JLS_LOGD3("signal %d, level %d, offset=%" PRIi64 ", step_size=%" PRIi64,
                  (int) signal_id, lvl, offset, step_size);
-        ROE(jls_raw_chunk_seek(self->raw, offset));
-        ROE(jls_core_rd_chunk(self));
+        if (self->follow) {
+            ROE(follow_walk(self, step_size, track->follow_end[lvl], sample_id, &offset));
+        } else {
+            ROE(jls_raw_chunk_seek(self->raw, offset));
+            ROE(jls_core_rd_chunk(self));
+        }
         if (self->chunk_cur.hdr.tag != JLS_TAG_TRACK_FSR_INDEX) {
             JLS_LOGW("seek tag mismatch: %d", (int) self->chunk_cur.hdr.tag);
         }
@@ -775,7 +1272,9 @@ int32_t jls_core_fsr_seek(struct jls_core_s * self, uint16_t signal_id, uint8_t
         }
 
         int64_t idx = (sample_id - chunk_timestamp) / step_size;
-        if ((idx < 0) || (idx >= chunk_entries)) {
+        if (self->follow && (idx >= chunk_entries) && (chunk_entries > 0)) {
+            idx = chunk_entries - 1;  // newer chunks are not yet indexed, continue from the last
+        } else if ((idx < 0) || (idx >= chunk_entries)) {
             JLS_LOGE("invalid index signal %d, level %d, sample_id=%"
                      PRIi64 " offset=%" PRIi64 ": %" PRIi64 " >= %" PRIi64,
                      (int) signal_id, lvl, sample_id,
@@ -785,6 +1284,9 @@ int32_t jls_core_fsr_seek(struct jls_core_s * self, uint16_t signal_id, uint8_t
         offset = r->offsets[idx];
     }
 
+    if (self->follow && level && (initial_level >= level) && offset) {
+        ROE(follow_walk(self, fsr_index_step(signal_def, level), track->follow_end[level], sample_id, &offset));
+    }
     ROE(jls_raw_chunk_seek(self->raw, offset));
     return 0;
 }
@@ -892,6 +1394,9 @@ static void construct_f64(int64_t sample_id, double * y, int64_t count, double m
 }
 
 static int32_t reconstruct_omitted_chunk(struct jls_core_s * self, uint16_t signal_id, int64_t start_sample_id) {
+    if (self->stats) {
+        ++self->stats->fsr_reconstructed;
+    }
     struct jls_signal_def_s * signal_def = &self->signal_info[signal_id].signal_def;
     uint8_t sample_size_bits = jls_datatype_parse_size(signal_def->data_type);
 
@@ -902,10 +1407,13 @@ static int32_t reconstruct_omitted_chunk(struct jls_core_s * self, uint16_t sign
     struct jls_fsr_f32_summary_s * s32 = (struct jls_fsr_f32_summary_s *) self->rd_summary->start;
     struct jls_fsr_f64_summary_s * s64 = (struct jls_fsr_f64_summary_s *) self->rd_summary->start;
     int64_t s_index = (sample_id - s32->header.timestamp) / signal_def->sample_decimate_factor;
+    uint32_t stride = jls_core_fsr_summary_level_stride(signal_def, 1);
+    const float * d32 = s32->data[0];
+    const double * d64 = s64->data[0];
     bool is_summary_64 = false;
-    if (s32->header.entry_size_bits == (4 * sizeof(float) * 8)) {
+    if (s32->header.entry_size_bits == (stride * sizeof(float) * 8)) {
         //
-    } else if (s32->header.entry_size_bits == (4 * sizeof(double) * 8)) {
+    } else if (s32->header.entry_size_bits == (stride * sizeof(double) * 8)) {
         is_summary_64 = true;
     } else {
         JLS_LOGE("unsupported summary element size");
@@ -934,16 +1442,17 @@ static int32_t reconstruct_omitted_chunk(struct jls_core_s * self, uint16_t sign
         if (s_index >= s32->header.entry_count) {
             break;
         }
+        int64_t s_offset = s_index * stride;
         if (is_summary_64) {
-            mu32 = (float) s64->data[s_index][JLS_SUMMARY_FSR_MEAN];
-            std32 = (float) s64->data[s_index][JLS_SUMMARY_FSR_STD];
-            mu64 = s64->data[s_index][JLS_SUMMARY_FSR_MEAN];
-            std64 = s64->data[s_index][JLS_SUMMARY_FSR_STD];
+            mu32 = (float) d64[s_offset + JLS_SUMMARY_FSR_MEAN];
+            std32 = (float) d64[s_offset + JLS_SUMMARY_FSR_STD];
+            mu64 = d64[s_offset + JLS_SUMMARY_FSR_MEAN];
+            std64 = d64[s_offset + JLS_SUMMARY_FSR_STD];
         } else {
-            mu32 = s32->data[s_index][JLS_SUMMARY_FSR_MEAN];
-            std32 = s32->data[s_index][JLS_SUMMARY_FSR_STD];
-            mu64 = s32->data[s_index][JLS_SUMMARY_FSR_MEAN];
-            std64 = s32->data[s_index][JLS_SUMMARY_FSR_STD];
+            mu32 = d32[s_offset + JLS_SUMMARY_FSR_MEAN];
+            std32 = d32[s_offset + JLS_SUMMARY_FSR_STD];
+            mu64 = d32[s_offset + JLS_SUMMARY_FSR_MEAN];
+            std64 = d32[s_offset + JLS_SUMMARY_FSR_STD];
         }
 
         if (signal_def->data_type == JLS_DATATYPE_F32) {
@@ -964,8 +1473,7 @@ static int32_t reconstruct_omitted_chunk(struct jls_core_s * self, uint16_t sign
             }
             memset(d, value, sz_bytes);
         } else {
-            memset(d, 0, sz_bytes);  // for now, set to zero
-            break;
+            memset(d, 0, sz_bytes);  // for now, set to zero, which matches the writer skip fill
         }
         d += sz_bytes;
         ++s_index;
@@ -1009,19 +1517,32 @@ int32_t jls_core_rd_fsr_level1(struct jls_core_s * self, uint16_t signal_id, int
     return 0;
 }
 
-int32_t jls_core_rd_fsr_data0(struct jls_core_s * self, uint16_t signal_id, int64_t start_sample_id) {
+static int32_t rd_fsr_data0(struct jls_core_s * self, uint16_t signal_id, int64_t start_sample_id,
+                            int64_t * offset_next) {
     int64_t offset = 0;
     int64_t chunk_sample_id;
     struct jls_signal_def_s * signal_def = &self->signal_info[signal_id].signal_def;
+    bool follow = false;
     ROE(jls_core_rd_fsr_level1(self, signal_id, start_sample_id));
     if ((self->rd_index_chunk.offset == 0) && (self->chunk_cur.hdr.tag == JLS_TAG_TRACK_FSR_DATA)) {
         offset = self->chunk_cur.offset;
+        follow = self->follow;
     } else {
         struct jls_fsr_index_s * idx = (struct jls_fsr_index_s *) self->rd_index->start;
         int64_t idx_entry = (start_sample_id - idx->header.timestamp) / signal_def->samples_per_data;
+        if (self->follow && (idx_entry >= idx->header.entry_count) && (idx->header.entry_count > 0)) {
+            idx_entry = idx->header.entry_count - 1;  // data chunks not yet indexed
+            follow = true;
+        }
         offset = idx->offsets[idx_entry];
     }
+    if (follow && offset) {
+        ROE(follow_walk(self, 1, INT64_MAX, start_sample_id, &offset));
+    }
     struct jls_fsr_data_s * r;
+    if (offset_next) {
+        *offset_next = 0;
+    }
 
     if (0 == offset) {
         // omitted, assume full chunk
@@ -1044,9 +1565,15 @@ int32_t jls_core_rd_fsr_data0(struct jls_core_s * self, uint16_t signal_id, int6
         if (self->chunk_cur.hdr.chunk_meta != signal_id) {
             JLS_LOGW("unexpected chunk meta: %d (expected %d)", (int) self->chunk_cur.hdr.chunk_meta, signal_id);
         }
+        if (offset_next) {
+            *offset_next = self->chunk_cur.hdr.item_next;
+        }
     }
 
     if (start_sample_id < chunk_sample_id) {  // omitted chunk
+        if (offset_next && offset) {
+            *offset_next = offset;  // the chunk just read follows the omitted chunk
+        }
         ROE(reconstruct_omitted_chunk(self, signal_id, start_sample_id));
     }
 
@@ -1058,6 +1585,44 @@ int32_t jls_core_rd_fsr_data0(struct jls_core_s * self, uint16_t signal_id, int6
     return 0;
 }
 
+int32_t jls_core_rd_fsr_data0(struct jls_core_s * self, uint16_t signal_id, int64_t start_sample_id) {
+    return rd_fsr_data0(self, signal_id, start_sample_id, NULL);
+}
+
+int32_t jls_core_rd_fsr_chunk(struct jls_core_s * self, uint16_t signal_id, int64_t start_sample_id,
+                              const struct jls_fsr_data_s ** data, const void ** summary) {
+    ROE(jls_core_signal_validate_typed(self, signal_id, JLS_SIGNAL_TYPE_FSR));
+    struct jls_signal_def_s * signal_def = &self->signal_info[signal_id].signal_def;
+    int64_t sample_id = start_sample_id + signal_def->sample_id_offset;
+    ROE(jls_core_rd_fsr_level1(self, signal_id, sample_id));
+    if (!self->rd_index_chunk.offset || !self->rd_summary_chunk.offset) {
+        return JLS_ERROR_NOT_FOUND;  // no level 1 summary
+    }
+    struct jls_fsr_index_s * idx = (struct jls_fsr_index_s *) self->rd_index->start;
+    struct jls_fsr_f32_summary_s * s = (struct jls_fsr_f32_summary_s *) self->rd_summary->start;
+    int64_t chunk_offset = sample_id - idx->header.timestamp;
+    if ((chunk_offset < 0) || (chunk_offset % signal_def->samples_per_data)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    int64_t entry = chunk_offset / signal_def->samples_per_data;
+    uint32_t entries = signal_def->samples_per_data / signal_def->sample_decimate_factor;
+    if ((entry >= idx->header.entry_count) || (0 == idx->offsets[entry])
+            || (((entry + 1) * entries) > s->header.entry_count)) {
+        return JLS_ERROR_NOT_FOUND;  // omitted or not summarized
+    }
+    ROE(jls_raw_chunk_seek(self->raw, idx->offsets[entry]));
+    ROE(jls_core_rd_chunk(self));
+    struct jls_fsr_data_s * d = (struct jls_fsr_data_s *) self->buf->start;
+    if ((self->chunk_cur.hdr.tag != JLS_TAG_TRACK_FSR_DATA)
+            || (d->header.timestamp != sample_id)
+            || (d->header.entry_count != signal_def->samples_per_data)) {
+        return JLS_ERROR_NOT_FOUND;
+    }
+    *data = d;
+    *summary = ((const uint8_t *) s->data) + (entry * entries * s->header.entry_size_bits) / 8;
+    return 0;
+}
+
 int32_t jls_core_fsr(struct jls_core_s * self, uint16_t signal_id, int64_t start_sample_id,
                      void * data, int64_t data_length) {
     // start_sample_id is API zero-based
@@ -1089,71 +1654,33 @@ int32_t jls_core_fsr(struct jls_core_s * self, uint16_t signal_id, int64_t start
     //JLS_LOGD3("jls_rd_fsr_f32(%d, %" PRIi64 ")", (int) signal_id, start_sample_id);
     start_sample_id += sample_id_offset;  // file sample_id
 
-    int64_t chunk_sample_id;
-    int64_t chunk_sample_count;
-    uint8_t * u8;
-    uint8_t * u8_end;
-    uint8_t shift_bits = 0;
-    uint8_t shift_carry = 0;
-
+    size_t dst_bit = 0;
     while (data_length > 0) {
         ROE(jls_core_rd_fsr_data0(self, signal_id, start_sample_id));
 
         struct jls_fsr_data_s * r = (struct jls_fsr_data_s *) self->buf->start;
-        chunk_sample_id = r->header.timestamp;
-        chunk_sample_count = r->header.entry_count;
-        u8 = (uint8_t *) &r->data[0];
-        u8_end = u8 + (chunk_sample_count * entry_size_bits) / 8;
         if (r->header.entry_size_bits != entry_size_bits) {
             JLS_LOGE("fsr entry size mismatch");
             return JLS_ERROR_UNSPECIFIED;
         }
-
-        int64_t sz_samples = chunk_sample_count;
-        if (start_sample_id > chunk_sample_id) {
-            // should only happen on first chunk
-            int64_t idx_start = start_sample_id - chunk_sample_id;
-            sz_samples = chunk_sample_count - idx_start;
-            u8 += ((idx_start * entry_size_bits) / 8);
-            switch (entry_size_bits) {
-                case 1: shift_bits = (uint8_t) (start_sample_id & 0x07); break;
-                case 4: shift_bits = (uint8_t) ((start_sample_id & 0x01) * 4); break;
-                default: break;
-            }
-            if (shift_bits) {
-                shift_carry = (*u8++) >> shift_bits;
-                uint8_t rem_bits = (uint8_t) ((start_sample_id + data_length - 1) & 0x07) + 1;
-                if ((1 == entry_size_bits) && ((8 - shift_bits + rem_bits) > 8)) {
-                    // write out carry on buffer wrap when carry + end bits exceed a byte
-                    if (data_length > sz_samples) {
-                        data_length += 8;
-                    }
-                } else if ((4 == entry_size_bits) && (sz_samples == 1)) {
-                    data_length -= sz_samples;
-                    start_sample_id += sz_samples;
-                    continue;
-                }
-            }
+        int64_t idx_start = start_sample_id - r->header.timestamp;  // nonzero on first chunk only
+        int64_t sz_samples = r->header.entry_count - idx_start;
+        if ((idx_start < 0) || (sz_samples <= 0)) {
+            JLS_LOGE("rd_fsr: sample_id %" PRIi64 " not in chunk", start_sample_id);
+            return JLS_ERROR_NOT_FOUND;
         }
-
         if (sz_samples > data_length) {
             sz_samples = data_length;
         }
 
-        size_t sz_bytes = (size_t) (sz_samples * entry_size_bits + 7) / 8;
-        if ((u8 + sz_bytes) > u8_end) {
-            sz_bytes = (size_t) (u8_end - u8);
-        }
-        if (shift_bits) {
-            for (size_t i = 0; i < sz_bytes; ++i) {
-                data_u8[i] = (u8[i] << (8 - shift_bits)) | shift_carry;
-                shift_carry = u8[i] >> shift_bits;
-            }
-            sz_bytes = (sz_samples * entry_size_bits) / 8;
+        size_t src_bit = (size_t) (idx_start * entry_size_bits);
+        size_t bits = (size_t) (sz_samples * entry_size_bits);
+        if ((src_bit | dst_bit) & 7) {
+            jls_bit_copy_offset(data_u8, dst_bit, &r->data[0], src_bit, bits);
         } else {
-            memcpy(data_u8, u8, sz_bytes);
+            memcpy(data_u8 + dst_bit / 8, (uint8_t *) &r->data[0] + src_bit / 8, (bits + 7) / 8);
         }
-        data_u8 += sz_bytes;
+        dst_bit += bits;
         data_length -= sz_samples;
         start_sample_id += sz_samples;
     }
@@ -1169,6 +1696,239 @@ int32_t jls_core_fsr_f32(struct jls_core_s * self, uint16_t signal_id, int64_t s
     return jls_core_fsr(self, signal_id, start_sample_id, data, data_length);
 }
 
+int32_t jls_core_fsr_iter_init(struct jls_core_fsr_iter_s * iter, struct jls_core_s * self, uint16_t signal_id,
+                               int64_t start_sample_id, int64_t length) {
+    if (!iter) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    memset(iter, 0, sizeof(*iter));
+    ROE(jls_core_signal_validate_typed(self, signal_id, JLS_SIGNAL_TYPE_FSR));
+    int64_t samples = 0;
+    ROE(jls_core_fsr_length(self, signal_id, &samples));
+    struct jls_signal_def_s * signal_def = &self->signal_info[signal_id].signal_def;
+    if ((start_sample_id < 0) || (length < 0) || ((start_sample_id + length) > samples)) {
+        JLS_LOGW("fsr_iter %d %s: start=%" PRIi64 " length=%" PRIi64 " invalid for %" PRIi64,
+                 (int) signal_id, signal_def->name, start_sample_id, length, samples);
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    iter->core = self;
+    iter->signal_id = signal_id;
+    iter->entry_size_bits = jls_datatype_parse_size(signal_def->data_type);
+    iter->sample_id = start_sample_id + signal_def->sample_id_offset;  // file sample_id
+    iter->sample_id_end = iter->sample_id + length;
+    iter->chunk_next = 0;
+    return 0;
+}
+
+static int32_t fsr_iter_load(struct jls_core_fsr_iter_s * iter) {
+    struct jls_core_s * self = iter->core;
+    int64_t offset = iter->chunk_next;
+    if (offset) {
+        // follow the data chunk linked list, no index traversal required
+        ROE(jls_raw_chunk_seek(self->raw, offset));
+        ROE(jls_core_rd_chunk(self));
+        if ((self->chunk_cur.hdr.tag != JLS_TAG_TRACK_FSR_DATA)
+                || (self->chunk_cur.hdr.chunk_meta != iter->signal_id)) {
+            JLS_LOGW("fsr_iter: unexpected chunk tag=%d, meta=%d",
+                     (int) self->chunk_cur.hdr.tag, (int) self->chunk_cur.hdr.chunk_meta);
+            offset = 0;
+        } else {
+            struct jls_fsr_data_s * r = (struct jls_fsr_data_s *) self->buf->start;
+            if (iter->sample_id < r->header.timestamp) {
+                // omitted chunk(s) precede this chunk, reconstruct from summary
+                ROE(rd_fsr_data0(self, iter->signal_id, iter->sample_id, &iter->chunk_next));
+                if (!iter->chunk_next) {
+                    iter->chunk_next = offset;
+                }
+                return 0;
+            } else if (iter->sample_id >= (r->header.timestamp + r->header.entry_count)) {
+                JLS_LOGW("fsr_iter: data chunk linked list discontinuity");
+                offset = 0;
+            } else {
+                iter->chunk_next = self->chunk_cur.hdr.item_next;
+                return 0;
+            }
+        }
+    }
+    // initial chunk or recovery: seek using the index
+    return rd_fsr_data0(self, iter->signal_id, iter->sample_id, &iter->chunk_next);
+}
+
+static int32_t fsr_iter_next(struct jls_core_fsr_iter_s * iter, const void ** data, uint8_t * src_bit,
+                             int64_t * sample_id, int64_t * count) {
+    // Yield the span starting at bit src_bit of data, which is only non-zero on the first chunk.
+    if (!iter || !iter->core || !data || !count) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    *data = NULL;
+    *src_bit = 0;
+    *count = 0;
+    if (iter->sample_id >= iter->sample_id_end) {
+        return JLS_ERROR_EMPTY;
+    }
+    struct jls_core_s * self = iter->core;
+    struct jls_signal_def_s * signal_def = &self->signal_info[iter->signal_id].signal_def;
+    ROE(fsr_iter_load(iter));
+
+    struct jls_fsr_data_s * r = (struct jls_fsr_data_s *) self->buf->start;
+    if (r->header.entry_size_bits != iter->entry_size_bits) {
+        JLS_LOGE("fsr entry size mismatch");
+        return JLS_ERROR_UNSPECIFIED;
+    }
+    int64_t chunk_sample_id = r->header.timestamp;
+    int64_t chunk_sample_count = r->header.entry_count;
+    int64_t idx_start = iter->sample_id - chunk_sample_id;
+    int64_t sz_samples = chunk_sample_count - idx_start;
+    if (sz_samples <= 0) {
+        JLS_LOGE("fsr_iter: sample_id %" PRIi64 " not in chunk", iter->sample_id);
+        return JLS_ERROR_NOT_FOUND;
+    }
+    if (sz_samples > (iter->sample_id_end - iter->sample_id)) {
+        sz_samples = iter->sample_id_end - iter->sample_id;
+    }
+
+    int64_t bit_start = idx_start * iter->entry_size_bits;
+    *data = (uint8_t *) &r->data[0] + bit_start / 8;
+    *src_bit = (uint8_t) (bit_start & 7);
+    if (sample_id) {
+        *sample_id = iter->sample_id - signal_def->sample_id_offset;
+    }
+    *count = sz_samples;
+    iter->sample_id += sz_samples;
+    return 0;
+}
+
+int32_t jls_core_fsr_iter_next(struct jls_core_fsr_iter_s * iter,
+                               const void ** data, int64_t * sample_id, int64_t * count) {
+    uint8_t src_bit = 0;
+    ROE(fsr_iter_next(iter, data, &src_bit, sample_id, count));
+    if (src_bit) {
+        // only on the first chunk, align in place to the start of the span
+        uint8_t * u8 = (uint8_t *) *data;
+        size_t size = ((size_t) *count * iter->entry_size_bits + src_bit + 7) / 8;
+        ROE(jls_bit_shift_array_right(src_bit, u8, size));
+    }
+    return 0;
+}
+
+int32_t jls_core_fsr_multi(struct jls_core_s * self, const uint16_t * signal_ids, uint32_t signal_count,
+                           int64_t start_sample_id, int64_t data_length, void * const * data) {
+    int32_t rc = 0;
+    if (!signal_ids || !data || !signal_count || (signal_count > JLS_SIGNAL_COUNT)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    if (data_length < 0) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    struct jls_core_fsr_iter_s * iters = calloc(signal_count, sizeof(struct jls_core_fsr_iter_s));
+    if (!iters) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    for (uint32_t k = 0; k < signal_count; ++k) {
+        rc = jls_core_fsr_iter_init(&iters[k], self, signal_ids[k], start_sample_id, data_length);
+        if (rc) {
+            goto exit;
+        }
+        if (!data[k]) {
+            rc = JLS_ERROR_PARAMETER_INVALID;
+            goto exit;
+        }
+        if (self->signal_info[signal_ids[k]].signal_def.sample_rate
+                != self->signal_info[signal_ids[0]].signal_def.sample_rate) {
+            JLS_LOGW("fsr_multi: signal %d sample_rate mismatch", (int) signal_ids[k]);
+            rc = JLS_ERROR_PARAMETER_INVALID;
+            goto exit;
+        }
+    }
+
+    while (1) {
+        // Signals are interleaved on disk as written, so read the chunk with the
+        // lowest file offset next.  Unknown offsets (0) need an index seek first.
+        int32_t sel = -1;
+        int64_t sel_offset = INT64_MAX;
+        for (uint32_t k = 0; k < signal_count; ++k) {
+            if ((iters[k].sample_id < iters[k].sample_id_end) && (iters[k].chunk_next < sel_offset)) {
+                sel = (int32_t) k;
+                sel_offset = iters[k].chunk_next;
+            }
+        }
+        if (sel < 0) {
+            break;
+        }
+        const void * src = NULL;
+        int64_t sample_id = 0;
+        int64_t count = 0;
+        rc = jls_core_fsr_iter_next(&iters[sel], &src, &sample_id, &count);
+        if (rc) {
+            break;
+        }
+        uint8_t entry_size_bits = iters[sel].entry_size_bits;
+        uint8_t * dst = (uint8_t *) data[sel];
+        size_t bit_offset = (size_t) ((sample_id - start_sample_id) * entry_size_bits);
+        if (entry_size_bits < 8) {
+            jls_bit_copy(dst, bit_offset, src, (size_t) (count * entry_size_bits));
+        } else {
+            memcpy(dst + bit_offset / 8, src, (size_t) (count * entry_size_bits) / 8);
+        }
+    }
+
+exit:
+    free(iters);
+    return rc;
+}
+
+#define FSR_AS_FLOAT(dt_fn_) {                                                      \
+    struct jls_core_fsr_iter_s iter;                                                \
+    const void * src = NULL;                                                        \
+    int64_t count = 0;                                                              \
+    int32_t rc;                                                                     \
+    ROE(jls_core_fsr_iter_init(&iter, self, signal_id, start_sample_id,             \
+                               (data_length > 0) ? data_length : 0));               \
+    uint32_t data_type = self->signal_info[signal_id].signal_def.data_type;         \
+    while (0 == (rc = jls_core_fsr_iter_next(&iter, &src, NULL, &count))) {         \
+        ROE(dt_fn_(src, data_type, data, (size_t) count));                          \
+        data += count;                                                              \
+    }                                                                               \
+    return (rc == JLS_ERROR_EMPTY) ? 0 : rc;                                        \
+}
+
+int32_t jls_core_fsr_as_f32(struct jls_core_s * self, uint16_t signal_id, int64_t start_sample_id,
+                            float * data, int64_t data_length) {
+    FSR_AS_FLOAT(jls_dt_buffer_as_f32);
+}
+
+int32_t jls_core_fsr_as_f64(struct jls_core_s * self, uint16_t signal_id, int64_t start_sample_id,
+                            double * data, int64_t data_length) {
+    FSR_AS_FLOAT(jls_dt_buffer_as_f64);
+}
+
+int32_t jls_core_fsr_to_f64(struct jls_core_s * self, uint16_t signal_id, int64_t start_sample_id,
+                            double * data, int64_t data_length) {
+    FSR_AS_FLOAT(jls_dt_buffer_to_f64);
+}
+
+int32_t jls_core_fsr_u8(struct jls_core_s * self, uint16_t signal_id, int64_t start_sample_id,
+                        uint8_t * data, int64_t data_length) {
+    struct jls_core_fsr_iter_s iter;
+    const void * src = NULL;
+    uint8_t src_bit = 0;
+    int64_t count = 0;
+    int32_t rc;
+    ROE(jls_core_signal_validate_typed(self, signal_id, JLS_SIGNAL_TYPE_FSR));
+    uint32_t data_type = self->signal_info[signal_id].signal_def.data_type;
+    uint8_t entry_size_bits = jls_datatype_parse_size(data_type);
+    if ((jls_datatype_parse_basetype(data_type) != JLS_DATATYPE_BASETYPE_UINT) || (entry_size_bits > 8)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    ROE(jls_core_fsr_iter_init(&iter, self, signal_id, start_sample_id,
+                               (data_length > 0) ? data_length : 0));
+    while (0 == (rc = fsr_iter_next(&iter, &src, &src_bit, NULL, &count))) {
+        ROE(jls_bit_unpack_u8(data, src, src_bit, entry_size_bits, (size_t) count));
+        data += count;
+    }
+    return (rc == JLS_ERROR_EMPTY) ? 0 : rc;
+}
+
 int32_t jls_core_ts_seek(struct jls_core_s * self, uint16_t signal_id, uint8_t level,
                          enum jls_track_type_e track_type, int64_t timestamp) {
     // timestamp in JLS units with possible non-zero offset
@@ -1309,6 +2069,10 @@ int32_t jls_core_repair_fsr(struct jls_core_s * self, uint16_t signal_id) {
                 offset = r->offsets[r->header.entry_count - 1];
                 lvl->index->header.entry_count = 0;
                 lvl->summary->header.entry_count = 0;
+                if (level > 0) {  // continue with the lower level chunks
+                    ROE(jls_core_fsr_summary_level_alloc(signal_info->track_fsr, (uint8_t) level));
+                    lvl = signal_info->track_fsr->level[level];
+                }
                 if (0 != jls_raw_chunk_seek(self->raw, offset)) {
                     JLS_LOGE("Could not seek to lower-level index.  Cannot repair.");
                     break;
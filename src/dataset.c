@@ -0,0 +1,467 @@
+/*
+ * Copyright 2026 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jls/dataset.h"
+#include "jls/bit_shift.h"
+#include "jls/statistics.h"
+#include "jls/ec.h"
+#include "jls/log.h"
+#include "jls/cdef.h"
+#include <inttypes.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+#define READERS_MAX (4)         // segment readers open at once, excluding the first segment
+#define SEGMENT_PATH_EXTRA (32) // segment path characters added to the dataset path
+
+struct ds_entry_s {
+    int64_t start;                  // the dataset sample id of the segment's first sample
+    int64_t length;                 // the number of samples in the segment
+    struct jls_statistics_s stats;  // the whole-segment statistics
+};
+
+struct ds_segment_s {
+    char * path;
+    struct jls_rd_s * rd;           // NULL when closed
+    uint64_t used;                  // for least recently used eviction
+    struct ds_entry_s * entries;    // indexed by fsr_index
+};
+
+struct jls_ds_s {
+    struct ds_segment_s * segments;
+    uint32_t segment_count;
+    uint32_t open_count;            // open readers, excluding the first segment
+    uint64_t used;
+    uint16_t fsr_count;
+    uint8_t fsr_index[JLS_SIGNAL_COUNT];  // index + 1 into entries, 0 if not a FSR signal
+    uint8_t sample_size_bits[JLS_SIGNAL_COUNT];
+    int64_t sample_id_offset[JLS_SIGNAL_COUNT];  // from the first segment
+};
+
+struct ds_cbk_s {
+    jls_rd_annotation_cbk_fn annotation_fn;
+    jls_rd_utc_cbk_fn utc_fn;
+    void * user_data;
+    int64_t offset;                 // add to segment sample ids
+    int32_t stop;
+};
+
+int32_t jls_ds_segment_path(const char * path, uint32_t index, char * segment_path, size_t segment_path_size) {
+    size_t length = strlen(path);
+    if ((length >= 4) && (0 == strcmp(path + length - 4, ".jls"))) {
+        length -= 4;
+    }
+    int n = snprintf(segment_path, segment_path_size, "%.*s_%05" PRIu32 ".jls", (int) length, path, index);
+    if ((n < 0) || ((size_t) n >= segment_path_size)) {
+        return JLS_ERROR_TOO_BIG;
+    }
+    return 0;
+}
+
+static int32_t segment_rd(struct jls_ds_s * self, uint32_t index, struct jls_rd_s ** rd) {
+    struct ds_segment_s * segment = &self->segments[index];
+    segment->used = ++self->used;
+    if (!segment->rd) {
+        if (index && (self->open_count >= READERS_MAX)) {
+            uint32_t lru = 0;
+            for (uint32_t i = 1; i < self->segment_count; ++i) {
+                if (self->segments[i].rd && (!lru || (self->segments[i].used < self->segments[lru].used))) {
+                    lru = i;
+                }
+            }
+            if (lru) {
+                jls_rd_close(self->segments[lru].rd);
+                self->segments[lru].rd = NULL;
+                --self->open_count;
+            }
+        }
+        ROE(jls_rd_open(&segment->rd, segment->path));
+        if (index) {
+            ++self->open_count;
+        }
+    }
+    *rd = segment->rd;
+    return 0;
+}
+
+static inline struct ds_entry_s * entry_get(struct jls_ds_s * self, uint32_t index, uint16_t signal_id) {
+    return &self->segments[index].entries[self->fsr_index[signal_id] - 1];
+}
+
+static int32_t fsr_validate(struct jls_ds_s * self, uint16_t signal_id) {
+    if ((signal_id >= JLS_SIGNAL_COUNT) || !self->fsr_index[signal_id]) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    return 0;
+}
+
+static void stats_from_summary(struct jls_statistics_s * stats, const double * v, int64_t length) {
+    jls_statistics_reset(stats);
+    if (isfinite(v[JLS_SUMMARY_FSR_MEAN])) {
+        stats->k = (uint64_t) length;
+        stats->mean = v[JLS_SUMMARY_FSR_MEAN];
+        stats->s = (length > 1) ? v[JLS_SUMMARY_FSR_STD] * v[JLS_SUMMARY_FSR_STD] * (double) (length - 1) : 0.0;
+        stats->min = v[JLS_SUMMARY_FSR_MIN];
+        stats->max = v[JLS_SUMMARY_FSR_MAX];
+    }
+}
+
+static void stats_to_summary(struct jls_statistics_s * stats, double * v) {
+    if (!stats->k) {
+        v[JLS_SUMMARY_FSR_MEAN] = NAN;
+        v[JLS_SUMMARY_FSR_STD] = NAN;
+        v[JLS_SUMMARY_FSR_MIN] = NAN;
+        v[JLS_SUMMARY_FSR_MAX] = NAN;
+    } else {
+        v[JLS_SUMMARY_FSR_MEAN] = stats->mean;
+        v[JLS_SUMMARY_FSR_STD] = sqrt(jls_statistics_var(stats));
+        v[JLS_SUMMARY_FSR_MIN] = stats->min;
+        v[JLS_SUMMARY_FSR_MAX] = stats->max;
+    }
+}
+
+static int32_t segment_index(struct jls_ds_s * self, uint32_t index) {
+    struct jls_rd_s * rd = NULL;
+    struct jls_signal_def_s * signals = NULL;
+    uint16_t count = 0;
+    ROE(segment_rd(self, index, &rd));
+    ROE(jls_rd_signals(rd, &signals, &count));
+    for (uint16_t idx = 0; idx < count; ++idx) {
+        uint16_t signal_id = signals[idx].signal_id;
+        if (!self->fsr_index[signal_id] || (signals[idx].signal_type != JLS_SIGNAL_TYPE_FSR)) {
+            continue;
+        }
+        struct ds_entry_s * e = entry_get(self, index, signal_id);
+        ROE(jls_rd_fsr_length(rd, signal_id, &e->length));
+        if (e->length) {
+            e->start = signals[idx].sample_id_offset - self->sample_id_offset[signal_id];
+            double v[JLS_SUMMARY_FSR_COUNT];
+            ROE(jls_rd_fsr_statistics(rd, signal_id, 0, e->length, v, 1));
+            stats_from_summary(&e->stats, v, e->length);
+        }
+    }
+    return 0;
+}
+
+void jls_ds_close(struct jls_ds_s * self) {
+    if (self) {
+        for (uint32_t idx = 0; idx < self->segment_count; ++idx) {
+            struct ds_segment_s * segment = &self->segments[idx];
+            if (segment->rd) {
+                jls_rd_close(segment->rd);
+            }
+            free(segment->path);
+            free(segment->entries);
+        }
+        free(self->segments);
+        free(self);
+    }
+}
+
+static int32_t ds_open(struct jls_ds_s * self, const char * path) {
+    size_t path_size = strlen(path) + SEGMENT_PATH_EXTRA;
+    char * segment_path = malloc(path_size);
+    if (!segment_path) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    while (1) {
+        int32_t rc = jls_ds_segment_path(path, self->segment_count, segment_path, path_size);
+        FILE * f = rc ? NULL : fopen(segment_path, "rb");
+        if (!f) {
+            break;
+        }
+        fclose(f);
+        struct ds_segment_s * segments = realloc(self->segments, (self->segment_count + 1) * sizeof(*segments));
+        if (!segments) {
+            free(segment_path);
+            return JLS_ERROR_NOT_ENOUGH_MEMORY;
+        }
+        self->segments = segments;
+        struct ds_segment_s * segment = &segments[self->segment_count++];
+        memset(segment, 0, sizeof(*segment));
+        segment->path = segment_path;
+        segment_path = malloc(path_size);
+        if (!segment_path) {
+            return JLS_ERROR_NOT_ENOUGH_MEMORY;
+        }
+    }
+    free(segment_path);
+    if (!self->segment_count) {
+        return JLS_ERROR_NOT_FOUND;
+    }
+
+    // The first segment defines the FSR signals.
+    struct jls_rd_s * rd = NULL;
+    struct jls_signal_def_s * signals = NULL;
+    uint16_t count = 0;
+    ROE(segment_rd(self, 0, &rd));
+    ROE(jls_rd_signals(rd, &signals, &count));
+    for (uint16_t idx = 0; idx < count; ++idx) {
+        if ((signals[idx].signal_id != 0) && (signals[idx].signal_type == JLS_SIGNAL_TYPE_FSR)) {
+            self->fsr_index[signals[idx].signal_id] = (uint8_t) (++self->fsr_count);
+            self->sample_size_bits[signals[idx].signal_id] = jls_datatype_parse_size(signals[idx].data_type);
+            self->sample_id_offset[signals[idx].signal_id] = signals[idx].sample_id_offset;
+        }
+    }
+    for (uint32_t index = 0; index < self->segment_count; ++index) {
+        struct ds_segment_s * segment = &self->segments[index];
+        segment->entries = calloc(self->fsr_count ? self->fsr_count : 1, sizeof(struct ds_entry_s));
+        if (!segment->entries) {
+            return JLS_ERROR_NOT_ENOUGH_MEMORY;
+        }
+    }
+    for (uint32_t index = 0; index < self->segment_count; ++index) {
+        ROE(segment_index(self, index));
+        for (uint16_t signal_id = 1; signal_id < JLS_SIGNAL_COUNT; ++signal_id) {
+            if (!self->fsr_index[signal_id]) {
+                continue;
+            }
+            struct ds_entry_s * e = entry_get(self, index, signal_id);
+            if (index && !e->length) {
+                struct ds_entry_s * prev = entry_get(self, index - 1, signal_id);
+                e->start = prev->start + prev->length;
+            }
+        }
+    }
+    return 0;
+}
+
+int32_t jls_ds_open(struct jls_ds_s ** instance, const char * path) {
+    if (!instance || !path) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    struct jls_ds_s * self = calloc(1, sizeof(struct jls_ds_s));
+    if (!self) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    int32_t rc = ds_open(self, path);
+    if (rc) {
+        jls_ds_close(self);
+        return rc;
+    }
+    *instance = self;
+    return 0;
+}
+
+uint32_t jls_ds_segment_count(struct jls_ds_s * self) {
+    return self->segment_count;
+}
+
+int32_t jls_ds_sources(struct jls_ds_s * self, struct jls_source_def_s ** sources, uint16_t * count) {
+    return jls_rd_sources(self->segments[0].rd, sources, count);
+}
+
+int32_t jls_ds_signals(struct jls_ds_s * self, struct jls_signal_def_s ** signals, uint16_t * count) {
+    return jls_rd_signals(self->segments[0].rd, signals, count);
+}
+
+int32_t jls_ds_fsr_length(struct jls_ds_s * self, uint16_t signal_id, int64_t * samples) {
+    ROE(fsr_validate(self, signal_id));
+    struct ds_entry_s * e = entry_get(self, self->segment_count - 1, signal_id);
+    *samples = e->start + e->length;
+    return 0;
+}
+
+static uint32_t segment_find(struct jls_ds_s * self, uint16_t signal_id, int64_t sample_id) {
+    // The segment containing sample_id, or the next segment after sample_id.
+    uint32_t lo = 0;
+    uint32_t hi = self->segment_count;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        struct ds_entry_s * e = entry_get(self, mid, signal_id);
+        if ((e->start + e->length) <= sample_id) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+int32_t jls_ds_fsr(struct jls_ds_s * self, uint16_t signal_id, int64_t start_sample_id,
+                   void * data, int64_t data_length) {
+    ROE(fsr_validate(self, signal_id));
+    if ((start_sample_id < 0) || (data_length < 0)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    uint8_t bits = self->sample_size_bits[signal_id];
+    uint8_t * dst = (uint8_t *) data;
+    int64_t done = 0;
+    uint32_t index = segment_find(self, signal_id, start_sample_id);
+    while (done < data_length) {
+        if (index >= self->segment_count) {
+            return JLS_ERROR_NOT_FOUND;
+        }
+        struct ds_entry_s * e = entry_get(self, index, signal_id);
+        int64_t sample_id = start_sample_id + done;
+        if (sample_id < e->start) {
+            return JLS_ERROR_NOT_FOUND;  // between segments
+        }
+        int64_t length = e->start + e->length - sample_id;
+        if (length > (data_length - done)) {
+            length = data_length - done;
+        }
+        if (length > 0) {
+            struct jls_rd_s * rd = NULL;
+            ROE(segment_rd(self, index, &rd));
+            size_t dst_bit = (size_t) done * bits;
+            if (0 == (dst_bit % 8)) {
+                ROE(jls_rd_fsr(rd, signal_id, sample_id - e->start, dst + dst_bit / 8, length));
+            } else {
+                size_t bit_count = (size_t) length * bits;
+                uint8_t * buf = malloc((bit_count + 7) / 8);
+                if (!buf) {
+                    return JLS_ERROR_NOT_ENOUGH_MEMORY;
+                }
+                int32_t rc = jls_rd_fsr(rd, signal_id, sample_id - e->start, buf, length);
+                if (!rc) {
+                    jls_bit_copy(dst, dst_bit, buf, bit_count);
+                }
+                free(buf);
+                ROE(rc);
+            }
+            done += length;
+        }
+        ++index;
+    }
+    return 0;
+}
+
+static int32_t statistics_span(struct jls_ds_s * self, uint16_t signal_id,
+                               int64_t start_sample_id, int64_t end_sample_id, double * data) {
+    struct jls_statistics_s total;
+    jls_statistics_reset(&total);
+    for (uint32_t index = segment_find(self, signal_id, start_sample_id); index < self->segment_count; ++index) {
+        struct ds_entry_s * e = entry_get(self, index, signal_id);
+        if (e->start >= end_sample_id) {
+            break;
+        }
+        int64_t a = (start_sample_id > e->start) ? start_sample_id : e->start;
+        int64_t b = e->start + e->length;
+        b = (end_sample_id < b) ? end_sample_id : b;
+        if (a >= b) {
+            continue;
+        }
+        struct jls_statistics_s stats;
+        if ((a == e->start) && (b == (e->start + e->length))) {
+            stats = e->stats;  // whole segment from the index
+        } else {
+            struct jls_rd_s * rd = NULL;
+            double v[JLS_SUMMARY_FSR_COUNT];
+            ROE(segment_rd(self, index, &rd));
+            ROE(jls_rd_fsr_statistics(rd, signal_id, a - e->start, b - a, v, 1));
+            stats_from_summary(&stats, v, b - a);
+        }
+        jls_statistics_combine(&total, &total, &stats);
+    }
+    stats_to_summary(&total, data);
+    return 0;
+}
+
+int32_t jls_ds_fsr_statistics(struct jls_ds_s * self, uint16_t signal_id,
+                              int64_t start_sample_id, int64_t increment,
+                              double * data, int64_t data_length) {
+    ROE(fsr_validate(self, signal_id));
+    if ((start_sample_id < 0) || (increment <= 0) || (data_length < 0)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    int64_t idx = 0;
+    while (idx < data_length) {
+        int64_t sample_id = start_sample_id + idx * increment;
+        uint32_t index = segment_find(self, signal_id, sample_id);
+        if (index < self->segment_count) {
+            // consecutive entries within one segment use its summaries directly
+            struct ds_entry_s * e = entry_get(self, index, signal_id);
+            int64_t count = (sample_id >= e->start) ? ((e->start + e->length - sample_id) / increment) : 0;
+            if (count > (data_length - idx)) {
+                count = data_length - idx;
+            }
+            if (count > 0) {
+                struct jls_rd_s * rd = NULL;
+                ROE(segment_rd(self, index, &rd));
+                ROE(jls_rd_fsr_statistics(rd, signal_id, sample_id - e->start, increment,
+                                          data + idx * JLS_SUMMARY_FSR_COUNT, count));
+                idx += count;
+                continue;
+            }
+        }
+        ROE(statistics_span(self, signal_id, sample_id, sample_id + increment, data + idx * JLS_SUMMARY_FSR_COUNT));
+        ++idx;
+    }
+    return 0;
+}
+
+static int32_t ds_annotation(void * user_data, const struct jls_annotation_s * annotation) {
+    struct ds_cbk_s * c = (struct ds_cbk_s *) user_data;
+    // The annotation lives in the segment reader's buffer, so adjust in place.
+    ((struct jls_annotation_s *) annotation)->timestamp += c->offset;
+    c->stop = c->annotation_fn(c->user_data, annotation);
+    return c->stop;
+}
+
+int32_t jls_ds_annotations(struct jls_ds_s * self, uint16_t signal_id, int64_t timestamp,
+                           jls_rd_annotation_cbk_fn cbk_fn, void * cbk_user_data) {
+    struct ds_cbk_s c = {.annotation_fn = cbk_fn, .user_data = cbk_user_data, .offset = 0, .stop = 0};
+    if (!cbk_fn || (signal_id >= JLS_SIGNAL_COUNT)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    bool is_fsr = self->fsr_index[signal_id] != 0;
+    uint32_t index = is_fsr ? segment_find(self, signal_id, timestamp) : 0;
+    for (; !c.stop && (index < self->segment_count); ++index) {
+        struct jls_rd_s * rd = NULL;
+        ROE(segment_rd(self, index, &rd));
+        c.offset = is_fsr ? entry_get(self, index, signal_id)->start : 0;
+        int32_t rc = jls_rd_annotations(rd, signal_id, timestamp - c.offset, ds_annotation, &c);
+        if (rc && (rc != JLS_ERROR_NOT_FOUND)) {
+            return rc;  // signal may be missing from later segments
+        }
+    }
+    return 0;
+}
+
+static int32_t ds_utc(void * user_data, const struct jls_utc_summary_entry_s * utc, uint32_t size) {
+    struct ds_cbk_s * c = (struct ds_cbk_s *) user_data;
+    // The entries live in the segment reader's buffer, so adjust in place.
+    struct jls_utc_summary_entry_s * entries = (struct jls_utc_summary_entry_s *) utc;
+    for (uint32_t idx = 0; idx < size; ++idx) {
+        entries[idx].sample_id += c->offset;
+    }
+    c->stop = c->utc_fn(c->user_data, utc, size);
+    return c->stop;
+}
+
+int32_t jls_ds_utc(struct jls_ds_s * self, uint16_t signal_id, int64_t sample_id,
+                   jls_rd_utc_cbk_fn cbk_fn, void * cbk_user_data) {
+    struct ds_cbk_s c = {.utc_fn = cbk_fn, .user_data = cbk_user_data, .offset = 0, .stop = 0};
+    if (!cbk_fn) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    ROE(fsr_validate(self, signal_id));
+    for (uint32_t index = segment_find(self, signal_id, sample_id); !c.stop && (index < self->segment_count); ++index) {
+        struct jls_rd_s * rd = NULL;
+        ROE(segment_rd(self, index, &rd));
+        c.offset = entry_get(self, index, signal_id)->start;
+        int32_t rc = jls_rd_utc(rd, signal_id, sample_id - c.offset, ds_utc, &c);
+        if (rc && (rc != JLS_ERROR_NOT_FOUND)) {
+            return rc;
+        }
+    }
+    return 0;
+}
@@ -29,76 +29,99 @@ static inline int8_t uint4_to_int8(uint8_t k) {
     return (int8_t) k;
 }
 
-#define TO_DOUBLE(type_) { \
-    const type_ * s = (const type_ *) src; \
-    for (uint32_t i = 0; i < samples; ++i) { \
-        *dst++ = (double) *s++; \
-    } \
-    break; \
+static inline uint32_t u24_parse(const uint8_t * s) {
+    return ((uint32_t) s[0]) | (((uint32_t) s[1]) << 8) | (((uint32_t) s[2]) << 16);
 }
 
-int32_t jls_dt_buffer_to_f64(const void * src, uint32_t src_datatype, double * dst, size_t samples) {
-    switch (src_datatype & 0xffff) {
-        case JLS_DATATYPE_I4: {
-            const uint8_t *s = (const uint8_t *) src;
-            for (uint32_t i = 0; i < samples; i += 2) {
-                uint8_t k = s[i >> 1];
-                dst[i + 0] = (double) uint4_to_int8(k);
-                dst[i + 1] = (double) uint4_to_int8(k >> 4);
-            }
-            break;
-        }
-        case JLS_DATATYPE_I8: TO_DOUBLE(int8_t);
-        case JLS_DATATYPE_I16: TO_DOUBLE(int16_t);
-        // case JLS_DATATYPE_I24: break; todo
-        case JLS_DATATYPE_I32: TO_DOUBLE(int32_t);
-        case JLS_DATATYPE_I64: TO_DOUBLE(int64_t);
-        case JLS_DATATYPE_U1: {
-            const uint8_t *s = (const uint8_t *) src;
-            for (uint32_t i = 0; i < (samples / 8); ++i) {
-                uint8_t k = s[i];
-                *dst++ = (double) ((k >> 0) & 1);
-                *dst++ = (double) ((k >> 1) & 1);
-                *dst++ = (double) ((k >> 2) & 1);
-                *dst++ = (double) ((k >> 3) & 1);
-                *dst++ = (double) ((k >> 4) & 1);
-                *dst++ = (double) ((k >> 5) & 1);
-                *dst++ = (double) ((k >> 6) & 1);
-                *dst++ = (double) ((k >> 7) & 1);
-            }
-            break;
-        }
-        case JLS_DATATYPE_U4:  {
-            const uint8_t *s = (const uint8_t *) src;
-            for (uint32_t i = 0; i < samples; i += 2) {
-                uint8_t k = s[i >> 1];
-                dst[i + 0] = (double) (k & 0x0f);
-                dst[i + 1] = (double) ((k >> 4) & 0x0f);
-            }
-            break;
-        }
-        case JLS_DATATYPE_U8: TO_DOUBLE(uint8_t);
-        case JLS_DATATYPE_U16: TO_DOUBLE(uint16_t);
-        // case JLS_DATATYPE_U24: break;  todo
-        case JLS_DATATYPE_U32: TO_DOUBLE(uint32_t);
-        case JLS_DATATYPE_U64: TO_DOUBLE(uint64_t);
-
-        case JLS_DATATYPE_F32: TO_DOUBLE(float);
-        case JLS_DATATYPE_F64: TO_DOUBLE(double);
-        default:
-            JLS_LOGW("Invalid data type: 0x%08x", src_datatype);
-            return JLS_ERROR_PARAMETER_INVALID;
+static inline int32_t i24_parse(const uint8_t * s) {
+    uint32_t k = u24_parse(s);
+    if (k & 0x00800000) {
+        k |= 0xff000000;
     }
+    return (int32_t) k;
+}
 
-    // fixed point support
-    int8_t fp = (int8_t) ((src_datatype & 0xff) >> 16);
-    if ((src_datatype & JLS_DATATYPE_BASETYPE_UINT) && fp) {
-        double scale = pow(2.0, fp);
-        for (uint32_t i = 0; i < samples; ++i) {
-            dst[i] *= scale;
-        }
+double jls_dt_scale(uint32_t datatype) {
+    // fixed point: scale by 2 ** -q
+    int8_t q = (int8_t) jls_datatype_parse_q(datatype);
+    if (jls_datatype_parse_basetype(datatype) == JLS_DATATYPE_BASETYPE_FLOAT) {
+        return 1.0;
     }
+    return ldexp(1.0, -q);
+}
+
+// Keep the inner loops simple with no cross-iteration dependencies so that
+// the compiler can vectorize them.  Any fixed-point scale is fused.
+#define DT_CONVERT(dst_type_, src_type_) { \
+    const src_type_ * s = (const src_type_ *) src; \
+    for (size_t i = 0; i < samples; ++i) { \
+        dst[i] = (dst_type_) (s[i] * scale); \
+    } \
+    break; \
+}
+
+#define DT_BUFFER_CONVERT_BODY(dst_type_)                                           \
+    const uint8_t * s8 = (const uint8_t *) src;                                     \
+    switch (src_datatype & 0xffff) {                                                \
+        case JLS_DATATYPE_I4:                                                       \
+            for (size_t i = 0; i < samples; ++i) {                                  \
+                dst[i] = (dst_type_) (uint4_to_int8(s8[i >> 1] >> (4 * (i & 1))) * scale); \
+            }                                                                       \
+            break;                                                                  \
+        case JLS_DATATYPE_I8: DT_CONVERT(dst_type_, int8_t);                        \
+        case JLS_DATATYPE_I16: DT_CONVERT(dst_type_, int16_t);                      \
+        case JLS_DATATYPE_I24:                                                      \
+            for (size_t i = 0; i < samples; ++i) {                                  \
+                dst[i] = (dst_type_) (i24_parse(s8 + 3 * i) * scale);               \
+            }                                                                       \
+            break;                                                                  \
+        case JLS_DATATYPE_I32: DT_CONVERT(dst_type_, int32_t);                      \
+        case JLS_DATATYPE_I64: DT_CONVERT(dst_type_, int64_t);                      \
+        case JLS_DATATYPE_U1:                                                       \
+            for (size_t i = 0; i < samples; ++i) {                                  \
+                dst[i] = (dst_type_) (((s8[i >> 3] >> (i & 7)) & 1) * scale);       \
+            }                                                                       \
+            break;                                                                  \
+        case JLS_DATATYPE_U4:                                                       \
+            for (size_t i = 0; i < samples; ++i) {                                  \
+                dst[i] = (dst_type_) (((s8[i >> 1] >> (4 * (i & 1))) & 0x0f) * scale); \
+            }                                                                       \
+            break;                                                                  \
+        case JLS_DATATYPE_U8: DT_CONVERT(dst_type_, uint8_t);                       \
+        case JLS_DATATYPE_U16: DT_CONVERT(dst_type_, uint16_t);                     \
+        case JLS_DATATYPE_U24:                                                      \
+            for (size_t i = 0; i < samples; ++i) {                                  \
+                dst[i] = (dst_type_) (u24_parse(s8 + 3 * i) * scale);               \
+            }                                                                       \
+            break;                                                                  \
+        case JLS_DATATYPE_U32: DT_CONVERT(dst_type_, uint32_t);                     \
+        case JLS_DATATYPE_U64: DT_CONVERT(dst_type_, uint64_t);                     \
+        case JLS_DATATYPE_F32: DT_CONVERT(dst_type_, float);                        \
+        case JLS_DATATYPE_F64: DT_CONVERT(dst_type_, double);                       \
+        default:                                                                    \
+            JLS_LOGW("Invalid data type: 0x%08x", src_datatype);                    \
+            return JLS_ERROR_PARAMETER_INVALID;                                     \
+    }                                                                               \
     return 0;
+
+int32_t jls_dt_buffer_to_f64(const void * src, uint32_t src_datatype, double * dst, size_t samples) {
+    const double scale = 1.0;
+    DT_BUFFER_CONVERT_BODY(double)
+}
+
+int32_t jls_dt_buffer_to_f32(const void * src, uint32_t src_datatype, float * dst, size_t samples) {
+    const float scale = 1.0f;
+    DT_BUFFER_CONVERT_BODY(float)
+}
+
+int32_t jls_dt_buffer_as_f64(const void * src, uint32_t src_datatype, double * dst, size_t samples) {
+    const double scale = jls_dt_scale(src_datatype);
+    DT_BUFFER_CONVERT_BODY(double)
+}
+
+int32_t jls_dt_buffer_as_f32(const void * src, uint32_t src_datatype, float * dst, size_t samples) {
+    const float scale = (float) jls_dt_scale(src_datatype);
+    DT_BUFFER_CONVERT_BODY(float)
 }
 
 const char * jls_dt_str(uint32_t datatype) {
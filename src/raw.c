@@ -32,6 +32,8 @@
 #define HEADER_ALIGN (8)            // must be power of 2 and greater than CRC_SIZE
 #define SCAN_SIZE (4096)
 #define CHUNK_BUFFER_SIZE  (1 << 24)
+#define WRITE_ALIGN (4096)          // write buffer flush alignment, must be power of 2
+#define PREALLOCATE_SIZE (64LL * 1024 * 1024)
 static const uint8_t FILE_HDR[] = JLS_HEADER_IDENTIFICATION;
 
 #define ROE(x)  do {                        \
@@ -56,12 +58,181 @@ struct jls_raw_s {
     uint32_t last_payload_length;   // the payload length for the last chunk in the file.
     uint8_t write_en;
     union jls_version_u version;
+    struct jls_stats_s * stats;     // optional instrumentation, NULL when disabled.
+    uint8_t * wbuf;                 // the write-behind buffer, NULL when disabled.
+    uint32_t wbuf_size;             // the wbuf allocated size in bytes.
+    uint32_t wbuf_length;           // the valid bytes in wbuf.
+    uint32_t wbuf_dirty;            // the wbuf index for the first byte not yet written.
+    int64_t wbuf_offset;            // the file offset for wbuf[0].
+    int64_t falloc_end;             // the preallocated file end, -1 when not supported.
 };
 
 static inline void invalidate_current_chunk(struct jls_raw_s * self) {
     self->hdr.tag = JLS_TAG_INVALID;
 }
 
+static int32_t bk_write(struct jls_raw_s * self, const void * buffer, uint32_t count) {
+    if (self->stats) {
+        ++self->stats->writes;
+    }
+    return jls_bk_fwrite(&self->backend, buffer, count);
+}
+
+static void preallocate(struct jls_raw_s * self, int64_t end) {
+    if ((self->falloc_end < 0) || (end <= self->falloc_end)) {
+        return;
+    }
+    end = (end + PREALLOCATE_SIZE - 1) & ~(PREALLOCATE_SIZE - 1);
+    int32_t rc = jls_bk_fallocate(&self->backend, end);
+    if (rc == JLS_ERROR_NOT_SUPPORTED) {
+        self->falloc_end = -1;
+    } else if (!rc) {
+        self->falloc_end = end;
+    }  // else retry on the next write
+}
+
+/*
+ * The write-behind buffer holds the most recent file contents from
+ * wbuf_offset.  The bytes from wbuf_dirty to wbuf_length are not yet
+ * in the file.  When the buffer is enabled, backend.fpos is the
+ * logical file position, and the file operations below explicitly
+ * seek since the OS file position is not tracked.
+ */
+
+static int32_t bk_pwrite(struct jls_raw_s * self, int64_t offset, const void * buffer, uint32_t count) {
+    int64_t fpos = self->backend.fpos;
+    int64_t fend = self->backend.fend;
+    preallocate(self, offset + count);
+    RLE(jls_bk_fseek(&self->backend, offset, SEEK_SET));
+    RLE(bk_write(self, buffer, count));
+    self->backend.fpos = fpos;
+    self->backend.fend = (fend > self->backend.fend) ? fend : self->backend.fend;
+    return 0;
+}
+
+static int32_t wbuf_flush(struct jls_raw_s * self) {
+    if (self->wbuf_dirty < self->wbuf_length) {
+        RLE(bk_pwrite(self, self->wbuf_offset + self->wbuf_dirty, self->wbuf + self->wbuf_dirty,
+                      self->wbuf_length - self->wbuf_dirty));
+        self->wbuf_dirty = self->wbuf_length;
+    }
+    return 0;
+}
+
+static int32_t wbuf_drain(struct jls_raw_s * self) {
+    // write up to an aligned boundary, keep the most recent quarter for header updates
+    int64_t keep = (self->wbuf_offset + self->wbuf_length - self->wbuf_size / 4) & ~((int64_t) WRITE_ALIGN - 1);
+    uint32_t shift = (keep > self->wbuf_offset) ? (uint32_t) (keep - self->wbuf_offset) : 0;
+    if (!shift) {
+        RLE(wbuf_flush(self));
+        self->wbuf_length = 0;
+        self->wbuf_dirty = 0;
+        return 0;
+    }
+    if (self->wbuf_dirty < shift) {
+        RLE(bk_pwrite(self, self->wbuf_offset + self->wbuf_dirty, self->wbuf + self->wbuf_dirty,
+                      shift - self->wbuf_dirty));
+        self->wbuf_dirty = shift;
+    }
+    memmove(self->wbuf, self->wbuf + shift, self->wbuf_length - shift);
+    self->wbuf_offset += shift;
+    self->wbuf_length -= shift;
+    self->wbuf_dirty -= shift;
+    return 0;
+}
+
+static int32_t wbuf_discard(struct jls_raw_s * self) {
+    RLE(wbuf_flush(self));
+    self->wbuf_length = 0;
+    self->wbuf_dirty = 0;
+    if (self->wbuf) {
+        // restore the OS file position
+        RLE(jls_bk_fseek(&self->backend, self->backend.fpos, SEEK_SET));
+    }
+    return 0;
+}
+
+static inline int wbuf_contains(struct jls_raw_s * self, int64_t pos, uint32_t count) {
+    return (pos >= self->wbuf_offset) && ((pos + count) <= (self->wbuf_offset + self->wbuf_length));
+}
+
+static int32_t raw_write(struct jls_raw_s * self, const void * buffer, uint32_t count) {
+    int64_t fpos = self->backend.fpos;
+    if (!self->wbuf) {
+        return bk_write(self, buffer, count);
+    }
+    int64_t wbuf_end = self->wbuf_offset + self->wbuf_length;
+    if (self->wbuf_length && (fpos >= self->wbuf_offset) && (fpos <= wbuf_end)
+            && ((fpos + count) > (self->wbuf_offset + self->wbuf_size))) {
+        RLE(wbuf_drain(self));  // full
+    }
+    wbuf_end = self->wbuf_offset + self->wbuf_length;
+    int in_buf = (fpos >= self->wbuf_offset) && (fpos <= wbuf_end)
+            && ((fpos + count) <= (self->wbuf_offset + self->wbuf_size));
+    if (!in_buf && (fpos == self->backend.fend) && (count <= (self->wbuf_size / 2))) {
+        RLE(wbuf_flush(self));  // restart at the file end
+        self->wbuf_offset = fpos;
+        self->wbuf_length = 0;
+        self->wbuf_dirty = 0;
+        in_buf = 1;
+    }
+    if (!in_buf) {
+        // header update before the buffer or large payload: write directly, in order
+        RLE(wbuf_flush(self));
+        RLE(bk_pwrite(self, fpos, buffer, count));
+    } else {
+        uint32_t idx = (uint32_t) (fpos - self->wbuf_offset);
+        memcpy(self->wbuf + idx, buffer, count);
+        if ((idx + count) > self->wbuf_length) {
+            self->wbuf_length = idx + count;
+        }
+        if (idx < self->wbuf_dirty) {
+            self->wbuf_dirty = idx;
+        }
+    }
+    self->backend.fpos = fpos + count;
+    if (self->backend.fpos > self->backend.fend) {
+        self->backend.fend = self->backend.fpos;
+    }
+    return 0;
+}
+
+static int32_t raw_read(struct jls_raw_s * self, void * const buffer, unsigned const buffer_size) {
+    if (!self->wbuf) {
+        return jls_bk_fread(&self->backend, buffer, buffer_size);
+    }
+    int64_t fpos = self->backend.fpos;
+    if (self->wbuf_length && wbuf_contains(self, fpos, buffer_size)) {
+        memcpy(buffer, self->wbuf + (fpos - self->wbuf_offset), buffer_size);
+        self->backend.fpos += buffer_size;
+        return 0;
+    }
+    RLE(wbuf_flush(self));
+    RLE(jls_bk_fseek(&self->backend, fpos, SEEK_SET));
+    return jls_bk_fread(&self->backend, buffer, buffer_size);
+}
+
+static inline int32_t raw_seek(struct jls_raw_s * self, int64_t pos) {
+    if (self->stats && (pos != self->backend.fpos)) {
+        ++self->stats->seeks;
+    }
+    if (self->wbuf) {
+        self->backend.fpos = pos;  // deferred to the next file operation
+        return 0;
+    }
+    return jls_bk_fseek(&self->backend, pos, SEEK_SET);
+}
+
+static uint32_t raw_crc32c(struct jls_raw_s * self, const uint8_t * data, uint32_t length) {
+    if (!self->stats) {
+        return jls_crc32c(data, length);
+    }
+    int64_t t_start = jls_time_rel();
+    uint32_t crc32 = jls_crc32c(data, length);
+    self->stats->crc_time += jls_time_rel() - t_start;
+    return crc32;
+}
+
 static inline uint32_t payload_size_on_disk(uint32_t payload_size) {
     if (!payload_size) {
         return 0;
@@ -73,11 +244,13 @@ static inline uint32_t payload_size_on_disk(uint32_t payload_size) {
     return payload_size + pad + CRC_SIZE;
 }
 
-static int32_t wr_file_header(struct jls_raw_s * self) {
+static int32_t wr_file_header(struct jls_raw_s * self, int closed) {
+    // length 0 indicates that the file is open for writing.
     int32_t rc = 0;
+    RLE(wbuf_discard(self));
     int64_t pos = jls_bk_ftell(&self->backend);
     jls_bk_fseek(&self->backend, 0L, SEEK_END);
-    int64_t file_sz = jls_bk_ftell(&self->backend);
+    int64_t file_sz = closed ? jls_bk_ftell(&self->backend) : 0;
     jls_bk_fseek(&self->backend, 0L, SEEK_SET);
 
     struct jls_file_header_s hdr = {
@@ -87,7 +260,7 @@ static int32_t wr_file_header(struct jls_raw_s * self) {
             .crc32 = 0,
     };
     hdr.crc32 = jls_crc32c((uint8_t *) &hdr, sizeof(hdr) - 4);
-    RLE(jls_bk_fwrite(&self->backend, &hdr, sizeof(hdr)));
+    RLE(bk_write(self, &hdr, sizeof(hdr)));
     if (pos != 0) {
         jls_bk_fseek(&self->backend, pos, SEEK_SET);
     } else {
@@ -97,7 +270,7 @@ static int32_t wr_file_header(struct jls_raw_s * self) {
 }
 
 static int32_t rd_file_header(struct jls_raw_s * self, struct jls_file_header_s * hdr) {
-    if (jls_bk_fread(&self->backend, hdr, sizeof(*hdr))) {
+    if (raw_read(self, hdr, sizeof(*hdr))) {
         JLS_LOGE("could not read file header");
         return JLS_ERROR_UNSUPPORTED_FILE;
     }
@@ -124,6 +297,9 @@ static int32_t rd_file_header(struct jls_raw_s * self, struct jls_file_header_s
 }
 
 static void fend_get(struct jls_raw_s * self) {
+    if (self->wbuf) {
+        return;  // fend is current while writing
+    }
     int64_t pos = jls_bk_ftell(&self->backend);
     if (jls_bk_fseek(&self->backend, 0, SEEK_END)) {
         JLS_LOGE("seek to end failed");
@@ -163,12 +339,16 @@ int32_t jls_raw_open(struct jls_raw_s ** instance, const char * path, const char
         return JLS_ERROR_NOT_ENOUGH_MEMORY;
     }
     self->backend.fd = -1;
-    ROE(jls_bk_fopen(&self->backend, path, mode));
+    rc = jls_bk_fopen(&self->backend, path, mode);
+    if (rc) {
+        free(self);
+        return rc;
+    }
 
     switch (mode[0]) {
         case 'w':
             self->write_en = 1;
-            rc = wr_file_header(self);
+            rc = wr_file_header(self, 0);
             self->offset = self->backend.fpos;
             self->version.u32 = JLS_FORMAT_VERSION_U32;
             break;
@@ -186,6 +366,9 @@ int32_t jls_raw_open(struct jls_raw_s ** instance, const char * path, const char
                 if (self->version.u32 != JLS_FORMAT_VERSION_U32) {
                     JLS_LOGE("cannot append, different format versions");
                     rc = JLS_ERROR_UNSUPPORTED_FILE;
+                } else {
+                    int32_t rc_hdr = wr_file_header(self, 0);
+                    rc = rc_hdr ? rc_hdr : rc;
                 }
             }
             break;
@@ -205,9 +388,16 @@ int32_t jls_raw_open(struct jls_raw_s ** instance, const char * path, const char
 int32_t jls_raw_close(struct jls_raw_s * self) {
     if (self) {
         if ((self->backend.fd != -1) && (self->write_en)) {
-            wr_file_header(self);
+            wr_file_header(self, 1);
+            if (self->falloc_end > self->backend.fend) {
+                // release the unused preallocation
+                if (!jls_bk_fseek(&self->backend, self->backend.fend, SEEK_SET)) {
+                    jls_bk_truncate(&self->backend);
+                }
+            }
         }
         jls_bk_fclose(&self->backend);
+        free(self->wbuf);
         free(self);
     }
     return 0;
@@ -217,10 +407,19 @@ union jls_version_u jls_raw_version(struct jls_raw_s * self) {
     return self->version;
 }
 
+void jls_raw_stats_set(struct jls_raw_s * self, struct jls_stats_s * stats) {
+    if (self) {
+        self->stats = stats;
+    }
+}
+
 struct jls_bkf_s * jls_raw_backend(struct jls_raw_s * self) {
     if (self->backend.fd == -1) {
         return NULL;
     }
+    if (wbuf_discard(self)) {
+        return NULL;
+    }
     return &self->backend;
 }
 
@@ -228,6 +427,9 @@ int32_t jls_raw_wr(struct jls_raw_s * self, struct jls_chunk_header_s * hdr, con
     JLS_LOGD3("wr @ %" PRId64 " : %d %s", jls_raw_chunk_tell(self), (int) hdr->tag, jls_tag_to_name(hdr->tag));
     RLE(jls_raw_wr_header(self, hdr));
     RLE(jls_raw_wr_payload(self, hdr->payload_length, payload));
+    if (self->stats) {
+        ++self->stats->chunk_wr[hdr->tag];
+    }
     invalidate_current_chunk(self);
     self->offset = self->backend.fpos;
     return 0;
@@ -240,11 +442,14 @@ int32_t jls_raw_wr_header(struct jls_raw_s * self, struct jls_chunk_header_s * h
     hdr->crc32 = jls_crc32c_hdr(hdr);
     if (self->offset != self->backend.fpos) {
         invalidate_current_chunk(self);
-        RLE(jls_bk_fseek(&self->backend, self->offset, SEEK_SET));
+        RLE(raw_seek(self, self->offset));
     }
-    if (jls_bk_fwrite(&self->backend, hdr, sizeof(*hdr))) {
+    if (raw_write(self, hdr, sizeof(*hdr))) {
         return JLS_ERROR_IO;
     }
+    if (self->stats) {
+        self->stats->bytes_wr += sizeof(*hdr);
+    }
     self->hdr = *hdr;
     return 0;
 }
@@ -270,14 +475,17 @@ int32_t jls_raw_wr_payload(struct jls_raw_s * self, uint32_t payload_length, con
     if (pad != 0) {
         pad = HEADER_ALIGN - pad;
     }
-    uint32_t crc32 = jls_crc32c(payload, hdr->payload_length);
+    uint32_t crc32 = raw_crc32c(self, payload, hdr->payload_length);
     footer[pad + 0] = crc32 & 0xff;
     footer[pad + 1] = (crc32 >> 8) & 0xff;
     footer[pad + 2] = (crc32 >> 16) & 0xff;
     footer[pad + 3] = (crc32 >> 24) & 0xff;
 
-    RLE(jls_bk_fwrite(&self->backend, payload, hdr->payload_length));
-    RLE(jls_bk_fwrite(&self->backend, footer, pad + CRC_SIZE));
+    RLE(raw_write(self, payload, hdr->payload_length));
+    RLE(raw_write(self, footer, pad + CRC_SIZE));
+    if (self->stats) {
+        self->stats->bytes_wr += hdr->payload_length + pad + CRC_SIZE;
+    }
     if (self->backend.fpos >= self->backend.fend) {
         self->last_payload_length = payload_length;
     }
@@ -303,17 +511,21 @@ int32_t jls_raw_rd_header(struct jls_raw_s * self, struct jls_chunk_header_s * h
             return JLS_ERROR_EMPTY;
         }
         if (self->offset != self->backend.fpos) {
-            if (jls_bk_fseek(&self->backend, self->offset, SEEK_SET)) {
+            if (raw_seek(self, self->offset)) {
                 JLS_LOGE("seek failed");
                 invalidate_current_chunk(self);
                 return JLS_ERROR_IO;
             }
         }
         self->offset = self->backend.fpos;
-        if (jls_bk_fread(&self->backend, (uint8_t *) h, sizeof(*h))) {
+        if (raw_read(self, (uint8_t *) h, sizeof(*h))) {
             invalidate_current_chunk(self);
             return JLS_ERROR_EMPTY;
         }
+        if (self->stats) {
+            ++self->stats->header_rd;
+            self->stats->bytes_rd += sizeof(*h);
+        }
         uint32_t crc32 = jls_crc32c_hdr(h);
         if (crc32 != h->crc32) {
             JLS_LOGW("chunk header fpos=%" PRIi64 " crc error: %u != %u",
@@ -349,12 +561,16 @@ int32_t jls_raw_rd_payload(struct jls_raw_s * self, uint32_t payload_length_max,
 
     int64_t pos = self->offset + sizeof(struct jls_chunk_header_s);
     if (pos != self->backend.fpos) {
-        jls_bk_fseek(&self->backend, pos, SEEK_SET);
+        raw_seek(self, pos);
         self->backend.fpos = pos;
     }
 
-    RLE(jls_bk_fread(&self->backend, (uint8_t *) payload, rd_size));
-    crc32_calc = jls_crc32c(payload, hdr->payload_length);
+    RLE(raw_read(self, (uint8_t *) payload, rd_size));
+    if (self->stats) {
+        ++self->stats->chunk_rd[hdr->tag];
+        self->stats->bytes_rd += rd_size;
+    }
+    crc32_calc = raw_crc32c(self, payload, hdr->payload_length);
     crc32_file = ((uint32_t)payload[rd_size - 4])
         | (((uint32_t)payload[rd_size - 3]) << 8)
         | (((uint32_t)payload[rd_size - 2]) << 16)
@@ -374,7 +590,7 @@ int32_t jls_raw_chunk_seek(struct jls_raw_s * self, int64_t offset) {
         JLS_LOGW("seek to 0");
         return JLS_ERROR_IO;
     }
-    if (jls_bk_fseek(&self->backend, offset, SEEK_SET)) {
+    if (raw_seek(self, offset)) {
         return JLS_ERROR_IO;
     }
     self->offset = self->backend.fpos;
@@ -386,6 +602,7 @@ int32_t jls_raw_chunk_scan(struct jls_raw_s * self) {
     uint8_t * b;
     invalidate_current_chunk(self);
     int64_t offset = jls_raw_chunk_tell(self);
+    RLE(wbuf_discard(self));
     RLE(jls_bk_fseek(&self->backend, 0L, SEEK_END));
     int64_t offset_end = jls_bk_ftell(&self->backend);
     if (offset & (HEADER_ALIGN - 1)) {
@@ -394,7 +611,7 @@ int32_t jls_raw_chunk_scan(struct jls_raw_s * self) {
     }
 
     while (offset < offset_end) {
-        if (jls_bk_fseek(&self->backend, offset, SEEK_SET)) {
+        if (raw_seek(self, offset)) {
             return JLS_ERROR_IO;
         }
         b = buffer;
@@ -403,7 +620,7 @@ int32_t jls_raw_chunk_scan(struct jls_raw_s * self) {
             sz = offset_end - offset;
         }
         size_t sz_block = sz;
-        jls_bk_fread(&self->backend, buffer, (unsigned const) sz);
+        raw_read(self, buffer, (unsigned const) sz);
         while (sz >= sizeof(struct jls_chunk_header_s)) {
             struct jls_chunk_header_s * hdr = (struct jls_chunk_header_s *) b;
             uint32_t crc32 = jls_crc32c_hdr(hdr);
@@ -419,9 +636,28 @@ int32_t jls_raw_chunk_scan(struct jls_raw_s * self) {
     return JLS_ERROR_NOT_FOUND;
 }
 
+int32_t jls_raw_end_update(struct jls_raw_s * self) {
+    invalidate_current_chunk(self);
+    fend_get(self);
+    return 0;
+}
+
+int32_t jls_raw_truncate(struct jls_raw_s * self, int64_t offset) {
+    struct jls_chunk_header_s hdr;
+    RLE(jls_raw_chunk_seek(self, offset));
+    RLE(jls_raw_rd_header(self, &hdr));
+    RLE(jls_raw_chunk_seek(self, offset));
+    RLE(wbuf_discard(self));
+    RLE(jls_bk_truncate(&self->backend));
+    self->last_payload_length = hdr.payload_prev_length;
+    return 0;
+}
+
 int32_t jls_raw_seek_end(struct jls_raw_s * self) {
     invalidate_current_chunk(self);
-    if (jls_bk_fseek(&self->backend, 0, SEEK_END)) {
+    if (self->wbuf) {
+        self->backend.fpos = self->backend.fend;
+    } else if (jls_bk_fseek(&self->backend, 0, SEEK_END)) {
         return JLS_ERROR_IO;
     }
     self->offset = self->backend.fpos;
@@ -433,9 +669,42 @@ int64_t jls_raw_chunk_tell(struct jls_raw_s * self) {
 }
 
 int32_t jls_raw_flush(struct jls_raw_s * self) {
+    RLE(wbuf_flush(self));
     return jls_bk_fflush(&self->backend);
 }
 
+int32_t jls_raw_sync(struct jls_raw_s * self, int32_t durable) {
+    RLE(wbuf_flush(self));
+    if (durable && jls_bk_fdatasync(&self->backend)) {
+        return JLS_ERROR_IO;
+    }
+    return 0;
+}
+
+int32_t jls_raw_write_buffer(struct jls_raw_s * self, uint32_t size) {
+    if (!self) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    if (!self->write_en) {
+        return JLS_ERROR_NOT_SUPPORTED;
+    }
+    RLE(wbuf_discard(self));
+    if (size == self->wbuf_size) {
+        return 0;
+    }
+    free(self->wbuf);
+    self->wbuf = NULL;
+    self->wbuf_size = 0;
+    if (size) {
+        self->wbuf = malloc(size);
+        if (!self->wbuf) {
+            return JLS_ERROR_NOT_ENOUGH_MEMORY;
+        }
+        self->wbuf_size = size;
+    }
+    return 0;
+}
+
 int32_t jls_raw_chunk_next(struct jls_raw_s * self) {
     RLE(jls_raw_rd_header(self, NULL));  // ensure that we have the header
     invalidate_current_chunk(self);
@@ -447,7 +716,7 @@ int32_t jls_raw_chunk_next(struct jls_raw_s * self) {
     }
     if (pos != self->backend.fpos) {
         // sequential access
-        if (jls_bk_fseek(&self->backend, pos, SEEK_SET)) {
+        if (raw_seek(self, pos)) {
             return JLS_ERROR_EMPTY;
         }
     }
@@ -470,7 +739,7 @@ int32_t jls_raw_chunk_prev(struct jls_raw_s * self) {
     }
     if (pos != self->backend.fpos) {
         // sequential access
-        jls_bk_fseek(&self->backend, pos, SEEK_SET);
+        raw_seek(self, pos);
     }
     self->offset = self->backend.fpos;
     return 0;
@@ -485,7 +754,7 @@ int32_t jls_raw_item_next(struct jls_raw_s * self) {
     }
 
     invalidate_current_chunk(self);
-    if (jls_bk_fseek(&self->backend, pos, SEEK_SET)) {
+    if (raw_seek(self, pos)) {
         return JLS_ERROR_EMPTY;
     }
     self->offset = self->backend.fpos;
@@ -503,7 +772,7 @@ int32_t jls_raw_item_prev(struct jls_raw_s * self) {
         return JLS_ERROR_EMPTY;
     }
     invalidate_current_chunk(self);
-    RLE(jls_bk_fseek(&self->backend, pos, SEEK_SET));
+    RLE(raw_seek(self, pos));
     self->offset = self->backend.fpos;
     return 0;
 }
@@ -555,6 +824,8 @@ const char * jls_tag_to_name(uint8_t tag) {
         case JLS_TAG_TRACK_UTC_INDEX:           return "track_utc_index";
         case JLS_TAG_TRACK_UTC_SUMMARY:         return "track_utc_summary";
         case JLS_TAG_USER_DATA:                 return "user_data";
+        case JLS_TAG_CHECKPOINT_HEAD:           return "checkpoint_head";
+        case JLS_TAG_CHECKPOINT:                return "checkpoint";
         case JLS_TAG_END:                       return "end";
         default:                                return "unknown";
     }
@@ -0,0 +1,332 @@
+/*
+ * Copyright 2026 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jls/rd_virtual.h"
+#include "jls/cdef.h"
+#include "jls/datatype.h"
+#include "jls/ec.h"
+#include "jls/log.h"
+#include "jls/statistics.h"
+#include <inttypes.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+#define BLOCK_SIZE (4096)
+
+
+struct jls_rd_virtual_s {
+    struct jls_rd_virtual_def_s def;
+    struct jls_signal_def_s signal_def;
+    char * name;
+    char * units;
+    double x0[BLOCK_SIZE];
+    double x1[BLOCK_SIZE];
+    double y[BLOCK_SIZE];
+};
+
+static char * str_copy(const char * s) {
+    if (!s) {
+        s = "";
+    }
+    size_t sz = strlen(s) + 1;
+    char * rv = malloc(sz);
+    if (rv) {
+        memcpy(rv, s, sz);
+    }
+    return rv;
+}
+
+static inline bool is_binary(uint8_t op) {
+    return (op == JLS_RD_VIRTUAL_OP_SUM) || (op == JLS_RD_VIRTUAL_OP_DIFF)
+        || (op == JLS_RD_VIRTUAL_OP_PRODUCT);
+}
+
+int32_t jls_rd_virtual_alloc(struct jls_rd_virtual_s ** instance,
+                             const struct jls_rd_virtual_def_s * def,
+                             const struct jls_signal_def_s * source_def) {
+    if (!instance || !def || !source_def) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    switch (def->op) {
+        case JLS_RD_VIRTUAL_OP_SCALE: break;
+        case JLS_RD_VIRTUAL_OP_SUM: break;
+        case JLS_RD_VIRTUAL_OP_DIFF: break;
+        case JLS_RD_VIRTUAL_OP_PRODUCT: break;
+        case JLS_RD_VIRTUAL_OP_INTEGRAL: break;
+        default:
+            JLS_LOGW("virtual signal %d: invalid op %d", (int) def->signal_id, (int) def->op);
+            return JLS_ERROR_PARAMETER_INVALID;
+    }
+    struct jls_rd_virtual_s * self = calloc(1, sizeof(struct jls_rd_virtual_s));
+    if (!self) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    self->def = *def;
+    self->name = str_copy(def->name);
+    self->units = str_copy(def->units);
+    if (!self->name || !self->units) {
+        jls_rd_virtual_free(self);
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    self->def.name = self->name;
+    self->def.units = self->units;
+
+    self->signal_def = *source_def;
+    self->signal_def.signal_id = def->signal_id;
+    self->signal_def.data_type = JLS_DATATYPE_F64;
+    self->signal_def.sample_id_offset = 0;
+    self->signal_def.summary_fields = 0;    // computed, no stored summaries
+    self->signal_def.summary_hist_bins = 0;
+    self->signal_def.name = self->name;
+    self->signal_def.units = self->units;
+    *instance = self;
+    return 0;
+}
+
+void jls_rd_virtual_free(struct jls_rd_virtual_s * self) {
+    if (self) {
+        free(self->name);
+        free(self->units);
+        free(self);
+    }
+}
+
+const struct jls_signal_def_s * jls_rd_virtual_signal_def(struct jls_rd_virtual_s * self) {
+    return &self->signal_def;
+}
+
+int32_t jls_rd_virtual_length(struct jls_rd_virtual_s * self, struct jls_rd_s * rd, int64_t * samples) {
+    int64_t length = 0;
+    ROE(jls_rd_fsr_length(rd, self->def.source_ids[0], samples));
+    if (is_binary(self->def.op)) {
+        ROE(jls_rd_fsr_length(rd, self->def.source_ids[1], &length));
+        if (length < *samples) {
+            *samples = length;
+        }
+    }
+    return 0;
+}
+
+static int32_t range_validate(struct jls_rd_virtual_s * self, struct jls_rd_s * rd,
+                              int64_t start_sample_id, int64_t length) {
+    int64_t samples = 0;
+    ROE(jls_rd_virtual_length(self, rd, &samples));
+    if ((start_sample_id < 0) || (length < 0) || ((start_sample_id + length) > samples)) {
+        JLS_LOGW("virtual signal %d: start=%" PRIi64 " length=%" PRIi64 " invalid for %" PRIi64,
+                 (int) self->def.signal_id, start_sample_id, length, samples);
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    return 0;
+}
+
+/**
+ * @brief Get the factor that converts source statistics to sample units.
+ */
+static int32_t source_scale(struct jls_rd_s * rd, uint16_t signal_id, double * scale) {
+    struct jls_signal_def_s def;
+    ROE(jls_rd_signal(rd, signal_id, &def));
+    *scale = jls_dt_scale(def.data_type);  // summaries are unscaled fixed point
+    return 0;
+}
+
+/**
+ * @brief Get the integral accumulator value for all samples before sample_id.
+ *
+ * Like eval(), the accumulator is the sum of the finite samples.
+ */
+static int32_t integral_start(struct jls_rd_virtual_s * self, struct jls_rd_s * rd,
+                              int64_t sample_id, double * accum) {
+    const uint16_t source_id = self->def.source_ids[0];
+    const uint32_t sum_fields = JLS_SUMMARY_FIELD_SUM | JLS_SUMMARY_FIELD_F64;
+    struct jls_signal_def_s def;
+    *accum = 0.0;
+    if (sample_id <= 0) {
+        return 0;
+    }
+    ROE(jls_rd_signal(rd, source_id, &def));
+    if ((def.summary_fields & sum_fields) == sum_fields) {
+        // the stored f64 sum is exact and only reads samples at the boundary
+        double v[JLS_SUMMARY_FSR_COUNT + 1];
+        ROE(jls_rd_fsr_statistics_ext(rd, source_id, 0, sample_id, JLS_SUMMARY_FIELD_SUM, v, 1));
+        if (isfinite(v[JLS_SUMMARY_FSR_COUNT])) {
+            *accum = v[JLS_SUMMARY_FSR_COUNT] * jls_dt_scale(def.data_type);
+        }
+        return 0;
+    }
+
+    double a = 0.0;
+    for (int64_t k = 0; k < sample_id; k += BLOCK_SIZE) {
+        int64_t length = ((sample_id - k) > BLOCK_SIZE) ? BLOCK_SIZE : (sample_id - k);
+        ROE(jls_rd_fsr_as_f64(rd, source_id, k, self->x0, length));
+        for (int64_t i = 0; i < length; ++i) {
+            if (isfinite(self->x0[i])) {
+                a += self->x0[i];
+            }
+        }
+    }
+    *accum = a;
+    return 0;
+}
+
+/**
+ * @brief Evaluate one block of at most BLOCK_SIZE samples into self->y.
+ */
+static int32_t eval(struct jls_rd_virtual_s * self, struct jls_rd_s * rd,
+                    int64_t start_sample_id, int64_t length, double * accum) {
+    const double gain = self->def.gain;
+    const double offset = self->def.offset;
+    double * x0 = self->x0;
+    double * x1 = self->x1;
+    double * y = self->y;
+    ROE(jls_rd_fsr_as_f64(rd, self->def.source_ids[0], start_sample_id, x0, length));
+    if (is_binary(self->def.op)) {
+        ROE(jls_rd_fsr_as_f64(rd, self->def.source_ids[1], start_sample_id, x1, length));
+    }
+
+    switch (self->def.op) {
+        case JLS_RD_VIRTUAL_OP_SCALE:
+            for (int64_t i = 0; i < length; ++i) {
+                y[i] = gain * x0[i] + offset;
+            }
+            break;
+        case JLS_RD_VIRTUAL_OP_SUM:
+            for (int64_t i = 0; i < length; ++i) {
+                y[i] = gain * (x0[i] + x1[i]) + offset;
+            }
+            break;
+        case JLS_RD_VIRTUAL_OP_DIFF:
+            for (int64_t i = 0; i < length; ++i) {
+                y[i] = gain * (x0[i] - x1[i]) + offset;
+            }
+            break;
+        case JLS_RD_VIRTUAL_OP_PRODUCT:
+            for (int64_t i = 0; i < length; ++i) {
+                y[i] = gain * (x0[i] * x1[i]) + offset;
+            }
+            break;
+        case JLS_RD_VIRTUAL_OP_INTEGRAL: {
+            const double scale = gain / (double) self->signal_def.sample_rate;
+            double a = *accum;
+            for (int64_t i = 0; i < length; ++i) {
+                if (isfinite(x0[i])) {
+                    a += x0[i];
+                }
+                y[i] = a * scale + offset;
+            }
+            *accum = a;
+            break;
+        }
+        default:
+            return JLS_ERROR_PARAMETER_INVALID;
+    }
+    return 0;
+}
+
+#define VIRTUAL_READ(dst_type_) {                                                   \
+    double accum = 0.0;                                                             \
+    ROE(range_validate(self, rd, start_sample_id, data_length));                    \
+    if (self->def.op == JLS_RD_VIRTUAL_OP_INTEGRAL) {                               \
+        ROE(integral_start(self, rd, start_sample_id, &accum));                     \
+    }                                                                               \
+    while (data_length > 0) {                                                       \
+        int64_t length = (data_length > BLOCK_SIZE) ? BLOCK_SIZE : data_length;     \
+        ROE(eval(self, rd, start_sample_id, length, &accum));                       \
+        for (int64_t i = 0; i < length; ++i) {                                      \
+            data[i] = (dst_type_) self->y[i];                                       \
+        }                                                                           \
+        data += length;                                                             \
+        start_sample_id += length;                                                  \
+        data_length -= length;                                                      \
+    }                                                                               \
+    return 0;                                                                       \
+}
+
+int32_t jls_rd_virtual_f64(struct jls_rd_virtual_s * self, struct jls_rd_s * rd,
+                           int64_t start_sample_id, double * data, int64_t data_length) {
+    VIRTUAL_READ(double);
+}
+
+int32_t jls_rd_virtual_f32(struct jls_rd_virtual_s * self, struct jls_rd_s * rd,
+                           int64_t start_sample_id, float * data, int64_t data_length) {
+    VIRTUAL_READ(float);
+}
+
+static int32_t statistics_scale(struct jls_rd_virtual_s * self, struct jls_rd_s * rd,
+                                int64_t start_sample_id, int64_t increment,
+                                double * data, int64_t data_length) {
+    // y = gain * x + offset maps each summary statistic exactly
+    double scale = 1.0;
+    ROE(source_scale(rd, self->def.source_ids[0], &scale));
+    const double gain = self->def.gain * scale;
+    const double offset = self->def.offset;
+    ROE(jls_rd_fsr_statistics(rd, self->def.source_ids[0], start_sample_id, increment, data, data_length));
+    for (int64_t i = 0; i < data_length; ++i) {
+        double v_min = gain * data[JLS_SUMMARY_FSR_MIN] + offset;
+        double v_max = gain * data[JLS_SUMMARY_FSR_MAX] + offset;
+        data[JLS_SUMMARY_FSR_MEAN] = gain * data[JLS_SUMMARY_FSR_MEAN] + offset;
+        data[JLS_SUMMARY_FSR_STD] = fabs(gain) * data[JLS_SUMMARY_FSR_STD];
+        data[JLS_SUMMARY_FSR_MIN] = (gain < 0) ? v_max : v_min;
+        data[JLS_SUMMARY_FSR_MAX] = (gain < 0) ? v_min : v_max;
+        data += JLS_SUMMARY_FSR_COUNT;
+    }
+    return 0;
+}
+
+int32_t jls_rd_virtual_statistics(struct jls_rd_virtual_s * self, struct jls_rd_s * rd,
+                                  int64_t start_sample_id, int64_t increment,
+                                  double * data, int64_t data_length) {
+    if (increment <= 0) {
+        JLS_LOGW("invalid increment: %" PRIi64, increment);
+        return JLS_ERROR_PARAMETER_INVALID;
+    } else if (data_length <= 0) {
+        JLS_LOGW("invalid length: %" PRIi64, data_length);
+        return 0;
+    }
+    ROE(range_validate(self, rd, start_sample_id, increment * data_length));
+    if (self->def.op == JLS_RD_VIRTUAL_OP_SCALE) {
+        return statistics_scale(self, rd, start_sample_id, increment, data, data_length);
+    }
+
+    // The other operations have no exact summary mapping, so compute from the samples.
+    double accum = 0.0;
+    struct jls_statistics_s stats_accum;
+    struct jls_statistics_s stats_block;
+    if (self->def.op == JLS_RD_VIRTUAL_OP_INTEGRAL) {
+        ROE(integral_start(self, rd, start_sample_id, &accum));
+    }
+    while (data_length > 0) {
+        jls_statistics_reset(&stats_accum);
+        int64_t remaining = increment;
+        while (remaining > 0) {
+            int64_t length = (remaining > BLOCK_SIZE) ? BLOCK_SIZE : remaining;
+            ROE(eval(self, rd, start_sample_id, length, &accum));
+            jls_statistics_compute_f64(&stats_block, self->y, (uint64_t) length);
+            jls_statistics_combine(&stats_accum, &stats_accum, &stats_block);
+            start_sample_id += length;
+            remaining -= length;
+        }
+        data[JLS_SUMMARY_FSR_MEAN] = stats_accum.mean;
+        data[JLS_SUMMARY_FSR_STD] = sqrt(jls_statistics_var(&stats_accum));
+        data[JLS_SUMMARY_FSR_MIN] = stats_accum.min;
+        data[JLS_SUMMARY_FSR_MAX] = stats_accum.max;
+        data += JLS_SUMMARY_FSR_COUNT;
+        --data_length;
+    }
+    return 0;
+}
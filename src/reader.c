@@ -15,18 +15,22 @@
  */
 
 #include "jls/reader.h"
+#include "jls/rd_prv.h"
 #include "jls/core.h"
+#include "jls/checkpoint.h"
 #include "jls/backend.h"
 #include "jls/raw.h"
 #include "jls/track.h"
 #include "jls/format.h"
 #include "jls/datatype.h"
+#include "jls/rd_virtual.h"
 #include "jls/ec.h"
 #include "jls/log.h"
 #include "jls/cdef.h"
 #include "jls/tmap.h"
 #include "jls/buffer.h"
 #include "jls/statistics.h"
+#include "jls/time.h"
 #include "jls/util.h"
 #include <inttypes.h>
 #include <math.h>
@@ -38,10 +42,54 @@
 
 #define SIGNAL_MASK  (0x0fff)
 #define DECIMATE_PER_DURATION (25)
+#define THREADS_MAX (64)
+#define THREADS_ENTRIES_MIN (4096)   // minimum summary entries to split a statistics request
 
+enum stats_flags_e {
+    STATS_HEAD_SCALED = (1 << 0),   // scale the summary entry straddling the start
+    STATS_TAIL_SCALED = (1 << 1),   // scale the summary entry straddling the end
+};
+
+struct stats_part_s {
+    struct jls_rd_s * rd;           // the worker reader
+    uint16_t signal_id;
+    uint8_t level;
+    uint8_t flags;                  // stats_flags_e
+    uint32_t fields;
+    int64_t start_sample_id;        // API zero-based sample id
+    int64_t increment;
+    double * data;
+    int64_t data_length;
+    int32_t rc;
+};
 
 struct jls_rd_s {
     struct jls_core_s core;
+    struct jls_rd_virtual_s * virtual_signals[JLS_SIGNAL_COUNT];
+    char * path;
+    struct jls_bkp_s * pool;        // statistics worker pool, NULL when disabled
+    struct jls_rd_s * workers[THREADS_MAX];
+};
+
+struct jls_rd_fsr_iter_s {
+    struct jls_core_fsr_iter_s core;
+};
+
+enum find_op_e {
+    FIND_OP_GT,
+    FIND_OP_GE,
+    FIND_OP_LT,
+    FIND_OP_LE,
+};
+
+struct jls_rd_fsr_find_iter_s {
+    struct jls_rd_s * rd;
+    uint16_t signal_id;
+    uint8_t op;             // find_op_e for the interval start
+    bool cross;             // pos is the next crossing
+    double threshold;
+    int64_t pos;
+    int64_t end;
 };
 
 
@@ -53,7 +101,42 @@ struct jls_rd_s {
 } while (0)
 
 
-int32_t jls_rd_open(struct jls_rd_s ** instance, const char * path) {
+static int32_t repair(struct jls_core_s * core) {
+    // Rebuild the summaries from the start of each signal.
+    for (uint16_t signal_idx = 0; signal_idx < JLS_SIGNAL_COUNT; ++signal_idx) {
+        struct jls_core_signal_s * signal_info = &core->signal_info[signal_idx];
+        if (signal_info->signal_def.signal_id != signal_idx) {
+            continue;
+        }
+        JLS_LOGI("repair signal %d", (int) signal_info->signal_def.signal_id);
+        for (int track_idx = 0; track_idx < JLS_TRACK_TYPE_COUNT; ++track_idx) {
+            if (NULL != signal_info->tracks[track_idx].parent) {
+                jls_track_repair_pointers(&signal_info->tracks[track_idx]);
+            }
+        }
+    }
+
+    ROE(jls_core_scan_fsr_sample_id(core));
+
+    for (uint16_t signal_idx = 0; signal_idx < JLS_SIGNAL_COUNT; ++signal_idx) {
+        struct jls_core_signal_s * signal_info = &core->signal_info[signal_idx];
+        if (signal_info->signal_def.signal_id != signal_idx) {
+            continue;
+        }
+
+        if (signal_info->signal_def.signal_type == JLS_SIGNAL_TYPE_FSR) {
+            ROE(jls_core_repair_fsr(core, signal_idx));
+            // todo repair annotation
+            // todo repair UTC
+        } else {
+            // todo repair VSR
+            // todo repair annotation
+        }
+    }
+    return 0;
+}
+
+static int32_t rd_open(struct jls_rd_s ** instance, const char * path, bool follow, bool readonly) {
     int32_t rc = 0;
     if (!instance) {
         return JLS_ERROR_PARAMETER_INVALID;
@@ -64,7 +147,16 @@ int32_t jls_rd_open(struct jls_rd_s ** instance, const char * path) {
         return JLS_ERROR_NOT_ENOUGH_MEMORY;
     }
 
+    size_t path_sz = strlen(path) + 1;
+    self->path = malloc(path_sz);
+    if (!self->path) {
+        free(self);
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    memcpy(self->path, path, path_sz);
+
     struct jls_core_s * core = &self->core;
+    core->follow = true;  // record the list tails in case the file is not closed
     core->buf = jls_buf_alloc();
     if (!core->buf) {
         GOE(JLS_ERROR_NOT_ENOUGH_MEMORY);
@@ -91,6 +183,14 @@ int32_t jls_rd_open(struct jls_rd_s ** instance, const char * path) {
     GOE(jls_core_scan_sources(core));
     GOE(jls_core_scan_signals(core));
 
+    if (follow) {
+        // never repair, the writer may still be appending
+        GOE(jls_core_follow_update(core));
+        *instance = self;
+        return 0;
+    }
+    core->follow = false;
+
     if (jls_core_rd_chunk_end(core)) {
         return JLS_ERROR_EMPTY;  // no chunk found!
     }
@@ -98,10 +198,15 @@ int32_t jls_rd_open(struct jls_rd_s ** instance, const char * path) {
 
     if (self->core.chunk_cur.hdr.tag != JLS_TAG_END) {
         JLS_LOGW("not properly closed");  // indices & summaries may be incomplete
+        if (readonly) {
+            goto recover_readonly;
+        }
         GOE(jls_raw_close(core->raw));
         rc = jls_raw_open(&core->raw, path, "a");
         if (rc && (rc != JLS_ERROR_TRUNCATED)) {
-            goto exit;
+            JLS_LOGW("cannot repair, open read-only: %" PRIi32, rc);
+            GOE(jls_raw_open(&core->raw, path, "r"));
+            goto recover_readonly;
         }
 
         // find last full chunk and truncate remainder
@@ -113,37 +218,10 @@ int32_t jls_rd_open(struct jls_rd_s ** instance, const char * path) {
         GOE(jls_raw_chunk_seek(core->raw, pos));
         GOE(jls_raw_wr(core->raw, &core->chunk_cur.hdr, core->buf->cur));
 
-        for (uint16_t signal_idx = 0; signal_idx < JLS_SIGNAL_COUNT; ++signal_idx) {
-            struct jls_core_signal_s * signal_info = &core->signal_info[signal_idx];
-            if (signal_info->signal_def.signal_id != signal_idx) {
-                continue;
-            }
-            JLS_LOGI("repair signal %d", (int) signal_info->signal_def.signal_id);
-            for (int track_idx = 0; track_idx < JLS_TRACK_TYPE_COUNT; ++track_idx) {
-                if (NULL != signal_info->tracks[track_idx].parent) {
-                    jls_track_repair_pointers(&signal_info->tracks[track_idx]);
-                }
-            }
+        rc = jls_core_checkpoint_recover(core);
+        if (rc) {
+            GOE(repair(core));
         }
-
-        GOE(jls_core_scan_fsr_sample_id(core));
-
-        for (uint16_t signal_idx = 0; signal_idx < JLS_SIGNAL_COUNT; ++signal_idx) {
-            struct jls_core_signal_s * signal_info = &core->signal_info[signal_idx];
-            if (signal_info->signal_def.signal_id != signal_idx) {
-                continue;
-            }
-
-            if (signal_info->signal_def.signal_type == JLS_SIGNAL_TYPE_FSR) {
-                GOE(jls_core_repair_fsr(core, signal_idx));
-                // todo repair annotation
-                // todo repair UTC
-            } else {
-                // todo repair VSR
-                // todo repair annotation
-            }
-        }
-
         GOE(jls_core_wr_end(core));
         GOE(jls_raw_close(core->raw));
         GOE(jls_raw_open(&core->raw, path, "r"));
@@ -160,13 +238,57 @@ int32_t jls_rd_open(struct jls_rd_s ** instance, const char * path) {
     *instance = self;
     return 0;
 
+recover_readonly:
+    // Serve the linked chunks like jls_rd_open_follow(), without writing.
+    core->follow = true;
+    GOE(jls_core_follow_update(core));
+    *instance = self;
+    return 0;
+
 exit:
     jls_rd_close(self);
     return rc;
 }
 
+static void threads_free(struct jls_rd_s * self) {
+    jls_bkp_finalize(self->pool);
+    self->pool = NULL;
+    for (size_t i = 0; i < THREADS_MAX; ++i) {
+        jls_rd_close(self->workers[i]);
+        self->workers[i] = NULL;
+    }
+}
+
+int32_t jls_rd_open(struct jls_rd_s ** instance, const char * path) {
+    return rd_open(instance, path, false, false);
+}
+
+int32_t jls_rd_open_follow(struct jls_rd_s ** instance, const char * path) {
+    return rd_open(instance, path, true, false);
+}
+
+int32_t jls_rd_open_readonly(struct jls_rd_s ** instance, const char * path) {
+    return rd_open(instance, path, false, true);
+}
+
+int32_t jls_rd_follow_update(struct jls_rd_s * self) {
+    if (!self) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    } else if (!self->core.follow) {
+        return JLS_ERROR_NOT_SUPPORTED;
+    }
+    ROE(jls_core_follow_update(&self->core));
+    for (size_t i = 0; i < THREADS_MAX; ++i) {
+        if (self->workers[i]) {
+            ROE(jls_core_follow_update(&self->workers[i]->core));
+        }
+    }
+    return 0;
+}
+
 void jls_rd_close(struct jls_rd_s * self) {
     if (self) {
+        threads_free(self);
         struct jls_core_s * core = &self->core;
         if (NULL != core->raw) {
             for (size_t i = 0; i < JLS_SIGNAL_COUNT; ++i) {
@@ -183,45 +305,205 @@ void jls_rd_close(struct jls_rd_s * self) {
         core->f64_stats_buf = NULL;
         jls_core_f64_buf_free(core->f64_sample_buf);
         core->f64_sample_buf = NULL;
+        jls_core_stats_free(core);
+        for (size_t i = 0; i < JLS_SIGNAL_COUNT; ++i) {
+            jls_rd_virtual_free(self->virtual_signals[i]);
+            self->virtual_signals[i] = NULL;
+        }
+        free(self->path);
         free(self);
     }
 }
 
+int32_t jls_rd_threads_set(struct jls_rd_s * self, uint32_t thread_count) {
+    if (!self) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    } else if (thread_count > THREADS_MAX) {
+        JLS_LOGW("thread_count %" PRIu32 " > %d", thread_count, THREADS_MAX);
+        return JLS_ERROR_PARAMETER_INVALID;
+    } else if (thread_count <= 1) {
+        thread_count = 0;
+    }
+    if (thread_count == jls_bkp_thread_count(self->pool)) {
+        return 0;
+    }
+    threads_free(self);
+    if (!thread_count) {
+        return 0;
+    }
+    int32_t rc = 0;
+    for (uint32_t i = 0; i < thread_count; ++i) {
+        GOE(rd_open(&self->workers[i], self->path, self->core.follow, true));  // independent I/O cursor
+    }
+    self->pool = jls_bkp_initialize(thread_count);
+    if (!self->pool) {
+        GOE(JLS_ERROR_NOT_ENOUGH_MEMORY);
+    }
+    return 0;
+
+exit:
+    threads_free(self);
+    return rc;
+}
+
 int32_t jls_rd_sources(struct jls_rd_s * self, struct jls_source_def_s ** sources, uint16_t * count) {
     return jls_core_sources(&self->core, sources, count);
 }
 
+static inline struct jls_rd_virtual_s * rd_virtual(struct jls_rd_s * self, uint16_t signal_id) {
+    return (signal_id < JLS_SIGNAL_COUNT) ? self->virtual_signals[signal_id] : NULL;
+}
+
 int32_t jls_rd_signals(struct jls_rd_s * self, struct jls_signal_def_s ** signals, uint16_t * count) {
-    return jls_core_signals(&self->core, signals, count);
+    ROE(jls_core_signals(&self->core, signals, count));
+    for (uint16_t i = 0; i < JLS_SIGNAL_COUNT; ++i) {
+        if (self->virtual_signals[i]) {
+            (*signals)[(*count)++] = *jls_rd_virtual_signal_def(self->virtual_signals[i]);
+        }
+    }
+    return 0;
 }
 
 int32_t jls_rd_signal(struct jls_rd_s * self, uint16_t signal_id, struct jls_signal_def_s * signal) {
+    struct jls_rd_virtual_s * v = rd_virtual(self, signal_id);
+    if (v) {
+        if (signal) {
+            *signal = *jls_rd_virtual_signal_def(v);
+        }
+        return 0;
+    }
     return jls_core_signal(&self->core, signal_id, signal);
 }
 
+int32_t jls_rd_virtual_def(struct jls_rd_s * self, const struct jls_rd_virtual_def_s * def) {
+    struct jls_signal_def_s source_def;
+    struct jls_signal_def_s source_def1;
+    if (!self || !def || (def->signal_id >= JLS_SIGNAL_COUNT)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    uint16_t signal_id = def->signal_id;
+    if ((self->core.signal_info[signal_id].signal_def.signal_id == signal_id) || self->virtual_signals[signal_id]) {
+        JLS_LOGW("virtual signal %d already exists", (int) signal_id);
+        return JLS_ERROR_ALREADY_EXISTS;
+    }
+    ROE(jls_rd_signal(self, def->source_ids[0], &source_def));
+    if (source_def.signal_type != JLS_SIGNAL_TYPE_FSR) {
+        return JLS_ERROR_NOT_SUPPORTED;
+    }
+    if ((def->op == JLS_RD_VIRTUAL_OP_SUM) || (def->op == JLS_RD_VIRTUAL_OP_DIFF)
+            || (def->op == JLS_RD_VIRTUAL_OP_PRODUCT)) {
+        ROE(jls_rd_signal(self, def->source_ids[1], &source_def1));
+        if ((source_def1.signal_type != JLS_SIGNAL_TYPE_FSR) || (source_def1.sample_rate != source_def.sample_rate)) {
+            JLS_LOGW("virtual signal %d: source %d incompatible", (int) signal_id, (int) def->source_ids[1]);
+            return JLS_ERROR_PARAMETER_INVALID;
+        }
+    }
+    return jls_rd_virtual_alloc(&self->virtual_signals[signal_id], def, &source_def);
+}
+
 JLS_API int32_t jls_rd_fsr_length(struct jls_rd_s * self, uint16_t signal_id, int64_t * samples) {
+    struct jls_rd_virtual_s * v = rd_virtual(self, signal_id);
+    if (v) {
+        return jls_rd_virtual_length(v, self, samples);
+    }
     return jls_core_fsr_length(&self->core, signal_id, samples);
 }
 
 int32_t jls_rd_fsr(struct jls_rd_s * self, uint16_t signal_id, int64_t start_sample_id,
                    void * data, int64_t data_length) {
+    struct jls_rd_virtual_s * v = rd_virtual(self, signal_id);
+    if (v) {
+        return jls_rd_virtual_f64(v, self, start_sample_id, (double *) data, data_length);
+    }
     return jls_core_fsr(&self->core, signal_id, start_sample_id, data, data_length);
 }
 
+int32_t jls_rd_fsr_chunk(struct jls_rd_s * self, uint16_t signal_id, int64_t start_sample_id,
+                         const struct jls_fsr_data_s ** data, const void ** summary) {
+    if (rd_virtual(self, signal_id)) {
+        return JLS_ERROR_NOT_FOUND;  // computed on read, no stored chunks
+    }
+    return jls_core_rd_fsr_chunk(&self->core, signal_id, start_sample_id, data, summary);
+}
+
 JLS_API int32_t jls_rd_fsr_f32(struct jls_rd_s * self, uint16_t signal_id, int64_t start_sample_id,
                                float * data, int64_t data_length) {
+    if (rd_virtual(self, signal_id)) {
+        return JLS_ERROR_PARAMETER_INVALID;  // float64
+    }
     return jls_core_fsr_f32(&self->core, signal_id, start_sample_id, data, data_length);
 }
 
-static inline void f32_to_stats(struct jls_statistics_s * stats, const float * data, int64_t count) {
-    stats->k = count;
-    stats->mean = data[JLS_SUMMARY_FSR_MEAN];
-    stats->min = data[JLS_SUMMARY_FSR_MIN];
-    stats->max = data[JLS_SUMMARY_FSR_MAX];
-    if (count > 1) {
-        stats->s = ((double) data[JLS_SUMMARY_FSR_STD]) * data[JLS_SUMMARY_FSR_STD] * (count - 1);
-    } else {
-        stats->s = 0.0;
+int32_t jls_rd_fsr_multi(struct jls_rd_s * self, const uint16_t * signal_ids, uint32_t signal_count,
+                         int64_t start_sample_id, int64_t data_length, void * const * data) {
+    for (uint32_t k = 0; signal_ids && (k < signal_count); ++k) {
+        if (rd_virtual(self, signal_ids[k])) {
+            return JLS_ERROR_NOT_SUPPORTED;
+        }
+    }
+    return jls_core_fsr_multi(&self->core, signal_ids, signal_count, start_sample_id, data_length, data);
+}
+
+int32_t jls_rd_fsr_as_f32(struct jls_rd_s * self, uint16_t signal_id, int64_t start_sample_id,
+                          float * data, int64_t data_length) {
+    struct jls_rd_virtual_s * v = rd_virtual(self, signal_id);
+    if (v) {
+        return jls_rd_virtual_f32(v, self, start_sample_id, data, data_length);
+    }
+    return jls_core_fsr_as_f32(&self->core, signal_id, start_sample_id, data, data_length);
+}
+
+int32_t jls_rd_fsr_as_f64(struct jls_rd_s * self, uint16_t signal_id, int64_t start_sample_id,
+                          double * data, int64_t data_length) {
+    struct jls_rd_virtual_s * v = rd_virtual(self, signal_id);
+    if (v) {
+        return jls_rd_virtual_f64(v, self, start_sample_id, data, data_length);
+    }
+    return jls_core_fsr_as_f64(&self->core, signal_id, start_sample_id, data, data_length);
+}
+
+int32_t jls_rd_fsr_u8(struct jls_rd_s * self, uint16_t signal_id, int64_t start_sample_id,
+                      uint8_t * data, int64_t data_length) {
+    if (rd_virtual(self, signal_id)) {
+        return JLS_ERROR_PARAMETER_INVALID;  // float64
+    }
+    return jls_core_fsr_u8(&self->core, signal_id, start_sample_id, data, data_length);
+}
+
+int32_t jls_rd_fsr_iter_open(struct jls_rd_s * self, uint16_t signal_id,
+                             int64_t start_sample_id, int64_t length,
+                             struct jls_rd_fsr_iter_s ** iter) {
+    if (!self || !iter) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    if (rd_virtual(self, signal_id)) {
+        return JLS_ERROR_NOT_SUPPORTED;
+    }
+    *iter = NULL;
+    struct jls_rd_fsr_iter_s * it = calloc(1, sizeof(struct jls_rd_fsr_iter_s));
+    if (!it) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    int32_t rc = jls_core_fsr_iter_init(&it->core, &self->core, signal_id, start_sample_id, length);
+    if (rc) {
+        free(it);
+        return rc;
+    }
+    *iter = it;
+    return 0;
+}
+
+int32_t jls_rd_fsr_iter_next(struct jls_rd_fsr_iter_s * iter,
+                             const void ** data, int64_t * sample_id, int64_t * count) {
+    if (!iter) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    return jls_core_fsr_iter_next(&iter->core, data, sample_id, count);
+}
+
+void jls_rd_fsr_iter_close(struct jls_rd_fsr_iter_s * iter) {
+    if (iter) {
+        free(iter);
     }
 }
 
@@ -232,6 +514,18 @@ static inline void stats_to_f64(double * data, struct jls_statistics_s * stats)
     data[JLS_SUMMARY_FSR_STD] = sqrt(jls_statistics_var(stats));
 }
 
+static inline void entry_to_f64(double * data, struct jls_core_fsr_entry_s * e, uint32_t fields) {
+    if (e->stats.k) {
+        stats_to_f64(data, &e->stats);
+    } else {  // no finite samples
+        data[JLS_SUMMARY_FSR_MEAN] = NAN;
+        data[JLS_SUMMARY_FSR_MIN] = NAN;
+        data[JLS_SUMMARY_FSR_MAX] = NAN;
+        data[JLS_SUMMARY_FSR_STD] = NAN;
+    }
+    jls_core_fsr_entry_encode(e, fields, data + JLS_SUMMARY_FSR_COUNT);
+}
+
 static inline void f64_to_stats(struct jls_statistics_s * stats, const double * data, int64_t count) {
     stats->k = count;
     stats->mean = data[JLS_SUMMARY_FSR_MEAN];
@@ -244,6 +538,42 @@ static inline void f64_to_stats(struct jls_statistics_s * stats, const double *
     }
 }
 
+static inline void f64_to_entry(struct jls_core_fsr_entry_s * e, const double * data, uint32_t fields,
+                                int64_t count, int64_t nominal) {
+    f64_to_stats(&e->stats, data, count);
+    jls_core_fsr_entry_decode(e, fields, data + JLS_SUMMARY_FSR_COUNT, count / (double) nominal);
+}
+
+static inline void summary_to_entry(struct jls_core_fsr_entry_s * e, const void * summary, bool is_f32,
+                                    uint32_t stride, uint32_t fields, int64_t index, int64_t count, int64_t nominal) {
+    uint32_t fields_stride = jls_core_fsr_summary_stride(fields);
+    double v[JLS_SUMMARY_FSR_ENTRY_MAX];
+    if (is_f32) {
+        const float * src = ((const float *) summary) + index * stride;
+        for (uint32_t i = 0; i < fields_stride; ++i) {
+            v[i] = src[i];
+        }
+    } else {
+        const double * src = ((const double *) summary) + index * stride;
+        for (uint32_t i = 0; i < fields_stride; ++i) {
+            v[i] = src[i];
+        }
+    }
+    f64_to_entry(e, v, fields, count, nominal);
+}
+
+static int32_t summary_entry_type(struct jls_fsr_f32_summary_s * summary, uint32_t stride, bool * is_f32) {
+    if (summary->header.entry_size_bits == stride * sizeof(float) * 8) {
+        *is_f32 = true;  // 32-bit float summaries
+    } else if (summary->header.entry_size_bits == stride * sizeof(double) * 8) {
+        *is_f32 = false; // 64-bit float summaries
+    } else {
+        JLS_LOGE("invalid summary entry size: %d", (int) summary->header.entry_size_bits);
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    return 0;
+}
+
 static int32_t rd_stats_chunk(struct jls_core_s * self, uint16_t signal_id, uint8_t level) {
     ROE(jls_core_rd_chunk(self));
     if (JLS_TAG_TRACK_FSR_SUMMARY != self->chunk_cur.hdr.tag) {
@@ -272,19 +602,39 @@ static int32_t rd_stats_chunk(struct jls_core_s * self, uint16_t signal_id, uint
     return 0;
 }
 
+static int64_t level_step(const struct jls_signal_def_s * signal_def, uint8_t level) {
+    int64_t step_size = signal_def->sample_decimate_factor;
+    for (uint8_t lvl = 2; lvl <= level; ++lvl) {
+        step_size *= signal_def->summary_decimate_factor;
+    }
+    return step_size;
+}
+
+static uint8_t stats_level(const struct jls_signal_def_s * signal_def, int64_t increment, int64_t data_length) {
+    uint8_t level = 0;
+    int64_t sample_multiple_next = signal_def->sample_decimate_factor;
+    int64_t duration = increment * data_length;
+    while ((increment >= sample_multiple_next)
+            && (duration >= (DECIMATE_PER_DURATION * sample_multiple_next))) {
+        ++level;
+        sample_multiple_next *= signal_def->summary_decimate_factor;
+    }
+    return level;
+}
+
 static int32_t fsr_statistics(struct jls_core_s * self, uint16_t signal_id,
-                              int64_t start_sample_id, int64_t increment, uint8_t level,
-                              double * data, int64_t data_length) {
+                              int64_t start_sample_id, int64_t increment, uint8_t level, uint32_t fields,
+                              uint8_t flags, double * data, int64_t data_length) {
     // start_sample_id in JLS units with possible non-zero offset
     JLS_LOGD2("fsr_f32_statistics(signal_id=%d, start_id=%" PRIi64 ", incr=%" PRIi64 ", level=%d, len=%" PRIi64 ")",
               (int) signal_id, start_sample_id, increment, (int) level, data_length);
-    bool is_f32;
+    bool is_f32 = true;
     struct jls_signal_def_s * signal_def = &self->signal_info[signal_id].signal_def;
-    int64_t step_size = signal_def->sample_decimate_factor;
-    for (uint8_t lvl = 2; lvl <= level; ++lvl) {
-        step_size *= signal_def->summary_decimate_factor;
-    }
-    double f64_tmp4[JLS_SUMMARY_FSR_COUNT];
+    int64_t step_size = level_step(signal_def, level);
+    const uint32_t stored_fields = signal_def->summary_fields;
+    const uint32_t stride = jls_core_fsr_summary_level_stride(signal_def, level);
+    const uint32_t data_stride = jls_core_fsr_summary_stride(fields);
+    double f64_tmp[JLS_SUMMARY_FSR_ENTRY_MAX];
     const int64_t sample_id_offset = signal_def->sample_id_offset;
 
     ROE(jls_core_fsr_seek(self, signal_id, level, start_sample_id)); // returns the index
@@ -292,64 +642,56 @@ static int32_t fsr_statistics(struct jls_core_s * self, uint16_t signal_id,
     int64_t pos = jls_raw_chunk_tell(self->raw);
     ROE(rd_stats_chunk(self, signal_id, level));
 
-    struct jls_fsr_f32_summary_s * f32_summary = (struct jls_fsr_f32_summary_s *) self->buf->start;
-    struct jls_fsr_f64_summary_s * f64_summary = (struct jls_fsr_f64_summary_s *) self->buf->start;
-    int64_t chunk_sample_id = f32_summary->header.timestamp;
-    if (f32_summary->header.entry_size_bits == JLS_SUMMARY_FSR_COUNT * sizeof(float) * 8) {
-        is_f32 = true;  // 32-bit float summaries
-    } else if (f32_summary->header.entry_size_bits == JLS_SUMMARY_FSR_COUNT * sizeof(double) * 8) {
-        is_f32 = false; // 64-bit float summaries
-    } else {
-        JLS_LOGE("invalid summary entry size: %d", (int) f32_summary->header.entry_size_bits);
-        return JLS_ERROR_PARAMETER_INVALID;
-    }
+    struct jls_fsr_f32_summary_s * summary = (struct jls_fsr_f32_summary_s *) self->buf->start;
+    int64_t chunk_sample_id = summary->header.timestamp;
+    ROE(summary_entry_type(summary, stride, &is_f32));
     int64_t src_offset = 0;
-    int64_t src_end = f32_summary->header.entry_count;
+    int64_t src_end = summary->header.entry_count;
     int64_t entry_offset = ((start_sample_id - chunk_sample_id + step_size - 1) / step_size);
     int64_t entry_sample_id = entry_offset * step_size + chunk_sample_id;
 
-    struct jls_statistics_s stats_accum;
-    jls_statistics_reset(&stats_accum);
-    struct jls_statistics_s stats_next;
+    struct jls_core_fsr_entry_s stats_accum;
+    jls_core_fsr_entry_reset(&stats_accum);
+    struct jls_core_fsr_entry_s stats_next;
 
     int64_t incr_remaining = increment;
 
     if (entry_sample_id != start_sample_id) {
         int64_t incr = entry_sample_id - start_sample_id;
-        // invalidates stats, need to reload, providing API sample_id
-        ROE(jls_core_fsr_statistics(self, signal_id, start_sample_id - sample_id_offset,
-                                  incr, f64_tmp4, 1));
-        ROE(jls_raw_chunk_seek(self->raw, pos));
-        ROE(rd_stats_chunk(self, signal_id, level));
-        f64_to_stats(&stats_accum, f64_tmp4, incr);
+        if (flags & STATS_HEAD_SCALED) {
+            // match the preceding request part, which scales the straddling entry
+            summary_to_entry(&stats_accum, summary->data, is_f32, stride, stored_fields, entry_offset - 1,
+                             incr, step_size);
+        } else {
+            // invalidates stats, need to reload, providing API sample_id
+            ROE(jls_core_fsr_statistics_ext(self, signal_id, start_sample_id - sample_id_offset,
+                                            incr, stored_fields, f64_tmp, 1));
+            ROE(jls_raw_chunk_seek(self->raw, pos));
+            ROE(rd_stats_chunk(self, signal_id, level));
+            summary = (struct jls_fsr_f32_summary_s *) self->buf->start;
+            f64_to_entry(&stats_accum, f64_tmp, stored_fields, incr, incr);
+        }
         incr_remaining -= incr;
         start_sample_id += incr;
     }
     src_offset += entry_offset;
 
+    const bool tail_exact = !(flags & STATS_TAIL_SCALED);
     while (data_length) {
         if (src_offset >= src_end) {
             if (self->chunk_cur.hdr.item_next) {
                 ROE(jls_raw_chunk_seek(self->raw, self->chunk_cur.hdr.item_next));
                 ROE(rd_stats_chunk(self, signal_id, level));
-                f32_summary = (struct jls_fsr_f32_summary_s *) self->buf->start;
-                f64_summary = (struct jls_fsr_f64_summary_s *) self->buf->start;
-                if (f32_summary->header.entry_size_bits == JLS_SUMMARY_FSR_COUNT * sizeof(float) * 8) {
-                    is_f32 = true;  // 32-bit float summaries
-                } else if (f32_summary->header.entry_size_bits == JLS_SUMMARY_FSR_COUNT * sizeof(double) * 8) {
-                    is_f32 = false; // 64-bit float summaries
-                } else {
-                    JLS_LOGE("invalid summary entry size: %d", (int) f32_summary->header.entry_size_bits);
-                    return JLS_ERROR_PARAMETER_INVALID;
-                }
+                summary = (struct jls_fsr_f32_summary_s *) self->buf->start;
+                ROE(summary_entry_type(summary, stride, &is_f32));
                 src_offset = 0;
-                src_end = f32_summary->header.entry_count;
+                src_end = summary->header.entry_count;
             } else {
-                if ((incr_remaining <= step_size) && (data_length == 1)) {
+                if ((incr_remaining <= step_size) && (data_length == 1) && tail_exact) {
                     // not a problem, will fetch from lower statistics
                 } else {
                     JLS_LOGW("cannot get final %" PRIi64 " samples", data_length);
-                    for (int64_t idx = 0; idx < (JLS_SUMMARY_FSR_COUNT * data_length); ++idx) {
+                    for (int64_t idx = 0; idx < (data_stride * data_length); ++idx) {
                         data[idx] = NAN;
                     }
                     return JLS_ERROR_PARAMETER_INVALID;
@@ -358,39 +700,34 @@ static int32_t fsr_statistics(struct jls_core_s * self, uint16_t signal_id,
         }
 
         if (incr_remaining <= step_size) {
-            if (data_length == 1) {
-                ROE(jls_core_fsr_statistics(self, signal_id, start_sample_id - sample_id_offset,
-                                            incr_remaining, f64_tmp4, 1));
-                f64_to_stats(&stats_next, f64_tmp4, incr_remaining);
-            } else if (is_f32) {
-                f32_to_stats(&stats_next, f32_summary->data[src_offset], incr_remaining);
+            if ((data_length == 1) && tail_exact) {
+                ROE(jls_core_fsr_statistics_ext(self, signal_id, start_sample_id - sample_id_offset,
+                                                incr_remaining, stored_fields, f64_tmp, 1));
+                f64_to_entry(&stats_next, f64_tmp, stored_fields, incr_remaining, incr_remaining);
             } else {
-                f64_to_stats(&stats_next, f64_summary->data[src_offset], incr_remaining);
+                summary_to_entry(&stats_next, summary->data, is_f32, stride, stored_fields, src_offset,
+                                 incr_remaining, step_size);
             }
-            jls_statistics_combine(&stats_accum, &stats_accum, &stats_next);
-            stats_to_f64(data, &stats_accum);
-            data += JLS_SUMMARY_FSR_COUNT;
+            jls_core_fsr_entry_combine(&stats_accum, &stats_accum, &stats_next);
+            entry_to_f64(data, &stats_accum, fields);
+            data += data_stride;
             --data_length;
             int64_t incr = step_size - incr_remaining;
             if (incr < 0) {
                 JLS_LOGE("internal error");
                 incr = 0;
-                jls_statistics_reset(&stats_accum);
+                jls_core_fsr_entry_reset(&stats_accum);
             } else if (incr == 0) {
-                jls_statistics_reset(&stats_accum);
-            } else if (is_f32) {
-                f32_to_stats(&stats_accum, f32_summary->data[src_offset], incr);
+                jls_core_fsr_entry_reset(&stats_accum);
             } else {
-                f64_to_stats(&stats_accum, f64_summary->data[src_offset], incr);
+                summary_to_entry(&stats_accum, summary->data, is_f32, stride, stored_fields, src_offset,
+                                 incr, step_size);
             }
             incr_remaining = increment - incr;
         } else {
-            if (is_f32) {
-                f32_to_stats(&stats_next, f32_summary->data[src_offset], step_size);
-            } else {
-                f64_to_stats(&stats_next, f64_summary->data[src_offset], step_size);
-            }
-            jls_statistics_combine(&stats_accum, &stats_accum, &stats_next);
+            summary_to_entry(&stats_next, summary->data, is_f32, stride, stored_fields, src_offset,
+                             step_size, step_size);
+            jls_core_fsr_entry_combine(&stats_accum, &stats_accum, &stats_next);
             incr_remaining -= step_size;
         }
         start_sample_id += step_size;
@@ -399,12 +736,49 @@ static int32_t fsr_statistics(struct jls_core_s * self, uint16_t signal_id,
     return 0;
 }
 
+static int32_t fsr_statistics0(struct jls_core_s * self, uint16_t signal_id,
+                               int64_t start_sample_id, int64_t increment, uint32_t fields,
+                               double * data, int64_t data_length);
+
+static int32_t fsr_statistics_follow(struct jls_core_s * self, uint16_t signal_id,
+                                     int64_t start_sample_id, int64_t increment, uint8_t level, uint32_t fields,
+                                     double * data, int64_t data_length) {
+    // The summaries may not yet cover the request end, use lower levels for the remainder.
+    const int64_t * follow_end = self->signal_info[signal_id].tracks[JLS_TRACK_TYPE_FSR].follow_end;
+    const uint32_t data_stride = jls_core_fsr_summary_stride(fields);
+    for (; level > 0; --level) {
+        int64_t n = 0;
+        if (follow_end[level] > start_sample_id) {
+            n = (follow_end[level] - start_sample_id) / increment;
+        }
+        if (n >= data_length) {
+            return fsr_statistics(self, signal_id, start_sample_id, increment, level, fields, 0, data, data_length);
+        } else if (n > 0) {
+            ROE(fsr_statistics(self, signal_id, start_sample_id, increment, level, fields, 0, data, n));
+            start_sample_id += n * increment;
+            data += n * data_stride;
+            data_length -= n;
+        }
+    }
+    return fsr_statistics0(self, signal_id, start_sample_id, increment, fields, data, data_length);
+}
+
 int32_t jls_core_fsr_statistics(struct jls_core_s * self, uint16_t signal_id,
                               int64_t start_sample_id, int64_t increment,
                               double * data, int64_t data_length) {
+    return jls_core_fsr_statistics_ext(self, signal_id, start_sample_id, increment, 0, data, data_length);
+}
+
+int32_t jls_core_fsr_statistics_ext(struct jls_core_s * self, uint16_t signal_id,
+                                    int64_t start_sample_id, int64_t increment, uint32_t fields,
+                                    double * data, int64_t data_length) {
     // API zero-based start_sample_id
     ROE(jls_core_signal_validate_typed(self, signal_id, JLS_SIGNAL_TYPE_FSR));
-    if (increment <= 0) {
+    struct jls_signal_def_s * signal_def = &self->signal_info[signal_id].signal_def;
+    if (fields & ~signal_def->summary_fields) {
+        JLS_LOGW("summary fields 0x%08x not stored for signal %d", fields, (int) signal_id);
+        return JLS_ERROR_NOT_SUPPORTED;
+    } else if (increment <= 0) {
         JLS_LOGW("invalid increment: %" PRIi64, increment);
         return JLS_ERROR_PARAMETER_INVALID;
     } else if (data_length <= 0) {
@@ -422,22 +796,26 @@ int32_t jls_core_fsr_statistics(struct jls_core_s * self, uint16_t signal_id,
         JLS_LOGW("invalid length: %" PRIi64 " > %" PRIi64, end_sample_id, samples);
         return JLS_ERROR_PARAMETER_INVALID;
     }
-    struct jls_signal_def_s * signal_def = &self->signal_info[signal_id].signal_def;
     const int64_t sample_id_offset = signal_def->sample_id_offset;
-
-    uint8_t level = 0;
-    int64_t sample_multiple_next = signal_def->sample_decimate_factor;
-    int64_t duration = increment * data_length;
-    while ((increment >= sample_multiple_next)
-            && (duration >= (DECIMATE_PER_DURATION * sample_multiple_next))) {
-        ++level;
-        sample_multiple_next *= signal_def->summary_decimate_factor;
-    }
+    uint8_t level = stats_level(signal_def, increment, data_length);
     start_sample_id += sample_id_offset; // JLS file sample_id
 
-    if (level) {  // use summaries
-        return fsr_statistics(self, signal_id, start_sample_id, increment, level, data, data_length);
+    if (level && self->follow) {
+        return fsr_statistics_follow(self, signal_id, start_sample_id, increment, level, fields, data, data_length);
+    } else if (level) {  // use summaries
+        return fsr_statistics(self, signal_id, start_sample_id, increment, level, fields, 0, data, data_length);
     }  // else, use sample data
+    return fsr_statistics0(self, signal_id, start_sample_id, increment, fields, data, data_length);
+}
+
+static int32_t fsr_statistics0(struct jls_core_s * self, uint16_t signal_id,
+                               int64_t start_sample_id, int64_t increment, uint32_t fields,
+                               double * data, int64_t data_length) {
+    // start_sample_id in JLS units with possible non-zero offset
+    struct jls_signal_def_s * signal_def = &self->signal_info[signal_id].signal_def;
+    if (self->stats) {
+        ++self->stats->fsr_statistics_level0;
+    }
     JLS_LOGD2("f32(signal_id=%d, start_id=%" PRIi64 ", incr=%" PRIi64 ", level=0, len=%" PRIi64 ")",
               (int) signal_id, start_sample_id, increment, data_length);
 
@@ -445,10 +823,6 @@ int32_t jls_core_fsr_statistics(struct jls_core_s * self, uint16_t signal_id,
     ROE(jls_core_f64_buf_alloc((size_t) signal_def->samples_per_data, &self->f64_sample_buf));
     int64_t buf_offset = 0;
     uint8_t entry_size_bits = jls_datatype_parse_size(signal_def->data_type);
-    if (entry_size_bits > 32) {
-        JLS_LOGE("entry_size > 64 (float64 stats) not yet supported");
-        return JLS_ERROR_UNSUPPORTED_FILE;
-    }
 
     ROE(jls_core_rd_fsr_data0(self, signal_id, start_sample_id));
     struct jls_fsr_data_s * s = (struct jls_fsr_data_s *) self->buf->start;
@@ -467,6 +841,9 @@ int32_t jls_core_fsr_statistics(struct jls_core_s * self, uint16_t signal_id,
     double v_min = DBL_MAX;
     double v_max = -DBL_MAX;
     double v_var = 0.0;
+    struct jls_core_fsr_entry_s ext;
+    jls_core_fsr_entry_reset(&ext);
+    const uint32_t data_stride = jls_core_fsr_summary_stride(fields);
     double mean_scale = 1.0 / increment;
     double var_scale = 1.0;
     if (increment > 1) {
@@ -491,6 +868,9 @@ int32_t jls_core_fsr_statistics(struct jls_core_s * self, uint16_t signal_id,
         if (v > v_max) {
             v_max = v;
         }
+        if (fields) {
+            jls_core_fsr_entry_add(&ext, v);
+        }
         self->f64_stats_buf->start[buf_offset++] = v;
 
         if (buf_offset >= increment) {
@@ -506,9 +886,11 @@ int32_t jls_core_fsr_statistics(struct jls_core_s * self, uint16_t signal_id,
             data[JLS_SUMMARY_FSR_MIN] = v_min;
             data[JLS_SUMMARY_FSR_MAX] = v_max;
             data[JLS_SUMMARY_FSR_STD] = sqrt(v_var);
-            data += JLS_SUMMARY_FSR_COUNT;
+            jls_core_fsr_entry_encode(&ext, fields, data + JLS_SUMMARY_FSR_COUNT);
+            data += data_stride;
 
             buf_offset = 0;
+            jls_core_fsr_entry_reset(&ext);
             v_mean = 0.0;
             v_min = DBL_MAX;
             v_max = -DBL_MAX;
@@ -522,7 +904,571 @@ int32_t jls_core_fsr_statistics(struct jls_core_s * self, uint16_t signal_id,
 JLS_API int32_t jls_rd_fsr_statistics(struct jls_rd_s * self, uint16_t signal_id,
                                       int64_t start_sample_id, int64_t increment,
                                       double * data, int64_t data_length) {
-    return jls_core_fsr_statistics(&self->core, signal_id, start_sample_id, increment, data, data_length);
+    return jls_rd_fsr_statistics_ext(self, signal_id, start_sample_id, increment, 0, data, data_length);
+}
+
+static void stats_part_run(void * user_data) {
+    struct stats_part_s * part = (struct stats_part_s *) user_data;
+    struct jls_core_s * core = &part->rd->core;
+    if (part->level) {
+        int64_t sample_id = part->start_sample_id + core->signal_info[part->signal_id].signal_def.sample_id_offset;
+        part->rc = fsr_statistics(core, part->signal_id, sample_id, part->increment, part->level,
+                                  part->fields, part->flags, part->data, part->data_length);
+    } else {
+        part->rc = jls_core_fsr_statistics_ext(core, part->signal_id, part->start_sample_id, part->increment,
+                                               part->fields, part->data, part->data_length);
+    }
+}
+
+static int32_t rd_fsr_statistics(struct jls_rd_s * self, uint16_t signal_id,
+                                 int64_t start_sample_id, int64_t increment, uint32_t fields,
+                                 double * data, int64_t data_length) {
+    uint32_t count = jls_bkp_thread_count(self->pool);
+    struct jls_core_s * core = &self->core;
+    if ((count < 2) || core->follow || (data_length < count) || (increment <= 0) || (start_sample_id < 0)
+            || jls_core_signal_validate_typed(core, signal_id, JLS_SIGNAL_TYPE_FSR)) {
+        return jls_core_fsr_statistics_ext(core, signal_id, start_sample_id, increment, fields, data, data_length);
+    }
+    struct jls_signal_def_s * signal_def = &core->signal_info[signal_id].signal_def;
+    int64_t samples = 0;
+    ROE(jls_core_fsr_length(core, signal_id, &samples));
+    uint8_t level = stats_level(signal_def, increment, data_length);
+    int64_t step = level ? level_step(signal_def, level) : 1;
+    if ((fields & ~signal_def->summary_fields)
+            || ((start_sample_id + increment * data_length) > samples)
+            || (((increment * data_length) / step) < THREADS_ENTRIES_MIN)) {
+        return jls_core_fsr_statistics_ext(core, signal_id, start_sample_id, increment, fields, data, data_length);
+    }
+
+    // Split into contiguous parts.  Each part uses the level of the full
+    // request and scales the straddling summary entries at internal
+    // boundaries, so the result matches the single-threaded computation.
+    struct stats_part_s parts[THREADS_MAX];
+    void * user_data[THREADS_MAX];
+    const uint32_t data_stride = jls_core_fsr_summary_stride(fields);
+    int64_t idx_start = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        int64_t idx_end = (data_length * (i + 1)) / count;
+        struct stats_part_s * part = &parts[i];
+        part->rd = self->workers[i];
+        part->signal_id = signal_id;
+        part->level = level;
+        part->flags = ((i > 0) ? STATS_HEAD_SCALED : 0) | ((i + 1 < count) ? STATS_TAIL_SCALED : 0);
+        part->fields = fields;
+        part->start_sample_id = start_sample_id + idx_start * increment;
+        part->increment = increment;
+        part->data = data + idx_start * data_stride;
+        part->data_length = idx_end - idx_start;
+        part->rc = 0;
+        user_data[i] = part;
+        idx_start = idx_end;
+    }
+    ROE(jls_bkp_run(self->pool, stats_part_run, user_data, count));
+    for (uint32_t i = 0; i < count; ++i) {
+        ROE(parts[i].rc);
+    }
+    return 0;
+}
+
+JLS_API int32_t jls_rd_fsr_statistics_ext(struct jls_rd_s * self, uint16_t signal_id,
+                                          int64_t start_sample_id, int64_t increment, uint32_t fields,
+                                          double * data, int64_t data_length) {
+    struct jls_rd_virtual_s * v = rd_virtual(self, signal_id);
+    if (v) {
+        if (fields) {
+            return JLS_ERROR_NOT_SUPPORTED;
+        }
+        return jls_rd_virtual_statistics(v, self, start_sample_id, increment, data, data_length);
+    }
+    struct jls_stats_s * stats = self->core.stats;
+    if (!stats) {
+        return rd_fsr_statistics(self, signal_id, start_sample_id, increment, fields, data, data_length);
+    }
+    int64_t t_start = jls_time_rel();
+    int32_t rc = rd_fsr_statistics(self, signal_id, start_sample_id, increment, fields, data, data_length);
+    ++stats->fsr_statistics;
+    stats->fsr_statistics_time += jls_time_rel() - t_start;
+    return rc;
+}
+
+struct hist_accum_s {
+    const struct jls_signal_def_s * signal_def;
+    double counts[JLS_SUMMARY_HIST_BINS_MAX];
+    double min;
+    double max;
+};
+
+static int32_t hist_add_samples(struct jls_core_s * self, uint16_t signal_id,
+                                int64_t start_sample_id, int64_t end_sample_id, struct hist_accum_s * h) {
+    // API zero-based sample ids
+    const struct jls_signal_def_s * signal_def = h->signal_def;
+    ROE(jls_core_f64_buf_alloc((size_t) signal_def->samples_per_data, &self->f64_stats_buf));
+    double * buf = self->f64_stats_buf->start;
+    while (start_sample_id < end_sample_id) {
+        int64_t count = end_sample_id - start_sample_id;
+        if (count > signal_def->samples_per_data) {
+            count = signal_def->samples_per_data;
+        }
+        ROE(jls_core_fsr_to_f64(self, signal_id, start_sample_id, buf, count));  // unscaled, like the writer
+        for (int64_t i = 0; i < count; ++i) {
+            double v = buf[i];
+            if (isfinite(v)) {
+                h->counts[jls_core_fsr_hist_bin(signal_def, v)] += 1.0;
+                h->min = (v < h->min) ? v : h->min;
+                h->max = (v > h->max) ? v : h->max;
+            }
+        }
+        start_sample_id += count;
+    }
+    return 0;
+}
+
+static int32_t hist_add_entries(struct jls_core_s * self, uint16_t signal_id, uint8_t level,
+                                int64_t start_sample_id, int64_t end_sample_id, struct hist_accum_s * h) {
+    // API zero-based sample ids aligned to the level step, reads samples for missing entries
+    if (start_sample_id >= end_sample_id) {
+        return 0;
+    }
+    const struct jls_signal_def_s * signal_def = h->signal_def;
+    const int64_t sample_id_offset = signal_def->sample_id_offset;
+    const int64_t step_size = level_step(signal_def, level);
+    const uint32_t stride = jls_core_fsr_summary_level_stride(signal_def, level);
+    const uint32_t hist_offset = jls_core_fsr_summary_stride(signal_def->summary_fields);
+    bool is_f32 = true;
+
+    ROE(jls_core_fsr_seek(self, signal_id, level, start_sample_id + sample_id_offset));
+    ROE(jls_raw_chunk_next(self->raw));
+    ROE(rd_stats_chunk(self, signal_id, level));
+    while (1) {
+        struct jls_fsr_f32_summary_s * summary = (struct jls_fsr_f32_summary_s *) self->buf->start;
+        ROE(summary_entry_type(summary, stride, &is_f32));
+        int64_t idx = (start_sample_id + sample_id_offset - summary->header.timestamp) / step_size;
+        for (; (idx < summary->header.entry_count) && (start_sample_id < end_sample_id); ++idx) {
+            double v[JLS_SUMMARY_FSR_ENTRY_MAX + JLS_SUMMARY_HIST_BINS_MAX];
+            if (is_f32) {
+                const float * src = summary->data[0] + idx * stride;
+                for (uint32_t i = 0; i < stride; ++i) {
+                    v[i] = src[i];
+                }
+            } else {
+                const double * src = ((struct jls_fsr_f64_summary_s *) summary)->data[0] + idx * stride;
+                for (uint32_t i = 0; i < stride; ++i) {
+                    v[i] = src[i];
+                }
+            }
+            if (isfinite(v[JLS_SUMMARY_FSR_MIN])) {
+                h->min = (v[JLS_SUMMARY_FSR_MIN] < h->min) ? v[JLS_SUMMARY_FSR_MIN] : h->min;
+                h->max = (v[JLS_SUMMARY_FSR_MAX] > h->max) ? v[JLS_SUMMARY_FSR_MAX] : h->max;
+            }
+            for (uint32_t i = 0; i < signal_def->summary_hist_bins; ++i) {
+                h->counts[i] += v[hist_offset + i];
+            }
+            start_sample_id += step_size;
+        }
+        if ((start_sample_id >= end_sample_id) || !self->chunk_cur.hdr.item_next) {
+            break;
+        }
+        ROE(jls_raw_chunk_seek(self->raw, self->chunk_cur.hdr.item_next));
+        ROE(rd_stats_chunk(self, signal_id, level));
+    }
+    // incomplete entries at the end of the signal
+    return hist_add_samples(self, signal_id, start_sample_id, end_sample_id, h);
+}
+
+static int32_t hist_add_range(struct jls_core_s * self, uint16_t signal_id, uint8_t level,
+                              int64_t start_sample_id, int64_t end_sample_id, struct hist_accum_s * h) {
+    // API zero-based sample ids aligned to the level step
+    const int64_t * offsets = self->signal_info[signal_id].tracks[JLS_TRACK_TYPE_FSR].head_offsets;
+    uint8_t level_next = level + 1;
+    if ((level_next < JLS_SUMMARY_LEVEL_COUNT) && offsets[level_next]) {
+        int64_t step_size = level_step(h->signal_def, level_next);
+        int64_t k0 = ((start_sample_id + step_size - 1) / step_size) * step_size;
+        int64_t k1 = (end_sample_id / step_size) * step_size;
+        if (k0 < k1) {
+            ROE(hist_add_entries(self, signal_id, level, start_sample_id, k0, h));
+            ROE(hist_add_range(self, signal_id, level_next, k0, k1, h));
+            return hist_add_entries(self, signal_id, level, k1, end_sample_id, h);
+        }
+    }
+    return hist_add_entries(self, signal_id, level, start_sample_id, end_sample_id, h);
+}
+
+static double hist_quantile(const struct hist_accum_s * h, double total, double q) {
+    const struct jls_signal_def_s * signal_def = h->signal_def;
+    const uint32_t bins = signal_def->summary_hist_bins;
+    const double width = ((double) signal_def->summary_hist_max - signal_def->summary_hist_min) / bins;
+    double target = q * total;
+    double cumulative = 0.0;
+    uint32_t idx = 0;
+    for (; idx < bins; ++idx) {
+        double c = h->counts[idx];
+        if ((c > 0.0) && ((cumulative + c) >= target)) {
+            break;
+        }
+        cumulative += c;
+    }
+    if (idx >= bins) {  // rounding, use the last non-empty bin
+        return h->max;
+    }
+    double lo = signal_def->summary_hist_min + idx * width;
+    double hi = lo + width;
+    lo = ((0 == idx) || (h->min > lo)) ? h->min : lo;
+    hi = (((bins - 1) == idx) || (h->max < hi)) ? h->max : hi;
+    double f = (target - cumulative) / h->counts[idx];
+    f = (f < 0.0) ? 0.0 : ((f > 1.0) ? 1.0 : f);
+    return lo + f * (hi - lo);
+}
+
+static int32_t fsr_quantiles(struct jls_core_s * self, uint16_t signal_id,
+                             int64_t start_sample_id, int64_t length,
+                             const double * q, double * data, uint32_t q_count) {
+    // API zero-based start_sample_id
+    ROE(jls_core_signal_validate_typed(self, signal_id, JLS_SIGNAL_TYPE_FSR));
+    struct jls_signal_def_s * signal_def = &self->signal_info[signal_id].signal_def;
+    if (!signal_def->summary_hist_bins) {
+        JLS_LOGW("summary histograms not stored for signal %d", (int) signal_id);
+        return JLS_ERROR_NOT_SUPPORTED;
+    } else if ((length <= 0) || (start_sample_id < 0)) {
+        JLS_LOGW("invalid window: %" PRIi64 ", %" PRIi64, start_sample_id, length);
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    for (uint32_t i = 0; i < q_count; ++i) {
+        if (!(q[i] >= 0.0) || !(q[i] <= 1.0)) {
+            JLS_LOGW("invalid quantile: %f", q[i]);
+            return JLS_ERROR_PARAMETER_INVALID;
+        }
+    }
+    int64_t samples = 0;
+    ROE(jls_core_fsr_length(self, signal_id, &samples));
+    int64_t end_sample_id = start_sample_id + length;
+    if (end_sample_id > samples) {
+        JLS_LOGW("invalid length: %" PRIi64 " > %" PRIi64, end_sample_id, samples);
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+
+    struct hist_accum_s h;
+    memset(&h, 0, sizeof(h));
+    h.signal_def = signal_def;
+    h.min = DBL_MAX;
+    h.max = -DBL_MAX;
+    const uint8_t level = (uint8_t) signal_def->summary_hist_level;
+    const int64_t * offsets = self->signal_info[signal_id].tracks[JLS_TRACK_TYPE_FSR].head_offsets;
+    int64_t step_size = level_step(signal_def, level);
+    int64_t k0 = ((start_sample_id + step_size - 1) / step_size) * step_size;
+    int64_t k1 = (end_sample_id / step_size) * step_size;
+    if ((k0 < k1) && offsets[level]) {
+        ROE(hist_add_samples(self, signal_id, start_sample_id, k0, &h));
+        ROE(hist_add_range(self, signal_id, level, k0, k1, &h));
+        ROE(hist_add_samples(self, signal_id, k1, end_sample_id, &h));
+    } else {
+        ROE(hist_add_samples(self, signal_id, start_sample_id, end_sample_id, &h));
+    }
+
+    double total = 0.0;
+    for (uint32_t i = 0; i < signal_def->summary_hist_bins; ++i) {
+        total += h.counts[i];
+    }
+    for (uint32_t i = 0; i < q_count; ++i) {
+        data[i] = (total > 0.0) ? hist_quantile(&h, total, q[i]) : NAN;
+    }
+    return 0;
+}
+
+JLS_API int32_t jls_rd_fsr_quantiles(struct jls_rd_s * self, uint16_t signal_id,
+                                     int64_t start_sample_id, int64_t length,
+                                     const double * q, double * data, uint32_t q_count) {
+    if (rd_virtual(self, signal_id)) {
+        return JLS_ERROR_NOT_SUPPORTED;
+    }
+    return fsr_quantiles(&self->core, signal_id, start_sample_id, length, q, data, q_count);
+}
+
+static inline bool find_match(uint8_t op, double v, double threshold) {
+    switch (op) {
+        case FIND_OP_GT: return v > threshold;
+        case FIND_OP_GE: return v >= threshold;
+        case FIND_OP_LT: return v < threshold;
+        case FIND_OP_LE: return v <= threshold;
+        default: return false;
+    }
+}
+
+static inline uint8_t find_op_complement(uint8_t op) {
+    switch (op) {
+        case FIND_OP_GT: return FIND_OP_LE;
+        case FIND_OP_GE: return FIND_OP_LT;
+        case FIND_OP_LT: return FIND_OP_GE;
+        default: return FIND_OP_GT;
+    }
+}
+
+static inline double summary_value(struct jls_fsr_f32_summary_s * summary, bool is_f32, uint32_t stride,
+                                   int64_t index, uint32_t field) {
+    if (is_f32) {
+        const float * d = summary->data[0];
+        return d[index * stride + field];
+    }
+    const double * d = ((struct jls_fsr_f64_summary_s *) summary)->data[0];
+    return d[index * stride + field];
+}
+
+static int32_t find_samples(struct jls_core_s * self, uint16_t signal_id,
+                            int64_t start_sample_id, int64_t end_sample_id,
+                            uint8_t op, double threshold, int64_t * sample_id) {
+    // API zero-based sample ids
+    const struct jls_signal_def_s * signal_def = &self->signal_info[signal_id].signal_def;
+    ROE(jls_core_f64_buf_alloc((size_t) signal_def->samples_per_data, &self->f64_stats_buf));
+    double * buf = self->f64_stats_buf->start;
+    while (start_sample_id < end_sample_id) {
+        int64_t count = end_sample_id - start_sample_id;
+        if (count > signal_def->samples_per_data) {
+            count = signal_def->samples_per_data;
+        }
+        ROE(jls_core_fsr_to_f64(self, signal_id, start_sample_id, buf, count));
+        for (int64_t i = 0; i < count; ++i) {
+            if (isfinite(buf[i]) && find_match(op, buf[i], threshold)) {
+                *sample_id = start_sample_id + i;
+                return 0;
+            }
+        }
+        start_sample_id += count;
+    }
+    return JLS_ERROR_NOT_FOUND;
+}
+
+static int32_t find_entries(struct jls_core_s * self, uint16_t signal_id, uint8_t level,
+                            int64_t * pos, int64_t end_sample_id,
+                            uint8_t op, double threshold, int64_t * candidate) {
+    // API zero-based sample ids aligned to the level step.
+    // Advances pos past the candidate entry, or to the last available entry.
+    const struct jls_signal_def_s * signal_def = &self->signal_info[signal_id].signal_def;
+    const int64_t sample_id_offset = signal_def->sample_id_offset;
+    const int64_t step_size = level_step(signal_def, level);
+    const uint32_t stride = jls_core_fsr_summary_level_stride(signal_def, level);
+    const uint32_t field = ((FIND_OP_GT == op) || (FIND_OP_GE == op)) ? JLS_SUMMARY_FSR_MAX : JLS_SUMMARY_FSR_MIN;
+    bool is_f32 = true;
+    if (*pos >= end_sample_id) {
+        return JLS_ERROR_NOT_FOUND;
+    }
+
+    ROE(jls_core_fsr_seek(self, signal_id, level, *pos + sample_id_offset));
+    ROE(jls_raw_chunk_next(self->raw));
+    ROE(rd_stats_chunk(self, signal_id, level));
+    while (1) {
+        struct jls_fsr_f32_summary_s * summary = (struct jls_fsr_f32_summary_s *) self->buf->start;
+        ROE(summary_entry_type(summary, stride, &is_f32));
+        int64_t idx = (*pos + sample_id_offset - summary->header.timestamp) / step_size;
+        for (; (idx < summary->header.entry_count) && (*pos < end_sample_id); ++idx) {
+            double v = summary_value(summary, is_f32, stride, idx, field);
+            *pos += step_size;
+            if (find_match(op, v, threshold)) {  // min/max exclude non-finite samples
+                *candidate = *pos - step_size;
+                return 0;
+            }
+        }
+        if ((*pos >= end_sample_id) || !self->chunk_cur.hdr.item_next) {
+            return JLS_ERROR_NOT_FOUND;
+        }
+        ROE(jls_raw_chunk_seek(self->raw, self->chunk_cur.hdr.item_next));
+        ROE(rd_stats_chunk(self, signal_id, level));
+    }
+}
+
+static int32_t find_range(struct jls_core_s * self, uint16_t signal_id, uint8_t level,
+                          int64_t start_sample_id, int64_t end_sample_id,
+                          uint8_t op, double threshold, int64_t * sample_id) {
+    // API zero-based sample ids
+    int32_t rc;
+    if (start_sample_id >= end_sample_id) {
+        return JLS_ERROR_NOT_FOUND;
+    } else if (!level) {
+        return find_samples(self, signal_id, start_sample_id, end_sample_id, op, threshold, sample_id);
+    }
+    const struct jls_signal_def_s * signal_def = &self->signal_info[signal_id].signal_def;
+    int64_t step_size = level_step(signal_def, level);
+    int64_t k0 = ((start_sample_id + step_size - 1) / step_size) * step_size;
+    int64_t k1 = (end_sample_id / step_size) * step_size;
+    if (k0 >= k1) {
+        return find_range(self, signal_id, level - 1, start_sample_id, end_sample_id, op, threshold, sample_id);
+    }
+    rc = find_range(self, signal_id, level - 1, start_sample_id, k0, op, threshold, sample_id);
+    if (JLS_ERROR_NOT_FOUND != rc) {
+        return rc;
+    }
+    int64_t pos = k0;
+    int64_t candidate = 0;
+    while (1) {
+        rc = find_entries(self, signal_id, level, &pos, k1, op, threshold, &candidate);
+        if (JLS_ERROR_NOT_FOUND == rc) {
+            break;
+        } else if (rc) {
+            return rc;
+        }
+        rc = find_range(self, signal_id, level - 1, candidate, candidate + step_size, op, threshold, sample_id);
+        if (JLS_ERROR_NOT_FOUND != rc) {
+            return rc;
+        }
+    }
+    // pos < k1 when the trailing entries are not available
+    return find_range(self, signal_id, level - 1, pos, end_sample_id, op, threshold, sample_id);
+}
+
+static int32_t fsr_find(struct jls_core_s * self, uint16_t signal_id,
+                        int64_t start_sample_id, int64_t end_sample_id,
+                        uint8_t op, double threshold, int64_t * sample_id) {
+    // API zero-based sample ids, already validated
+    const struct jls_signal_def_s * signal_def = &self->signal_info[signal_id].signal_def;
+    const int64_t * offsets = self->signal_info[signal_id].tracks[JLS_TRACK_TYPE_FSR].head_offsets;
+    uint8_t level = 0;
+    while (((level + 1) < JLS_SUMMARY_LEVEL_COUNT) && offsets[level + 1]
+            && (level_step(signal_def, level + 1) <= (end_sample_id - start_sample_id))) {
+        ++level;
+    }
+    return find_range(self, signal_id, level, start_sample_id, end_sample_id, op, threshold, sample_id);
+}
+
+static int32_t find_validate(struct jls_rd_s * self, uint16_t signal_id,
+                             int64_t start_sample_id, int64_t end_sample_id, uint8_t predicate) {
+    if (!self) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    } else if (rd_virtual(self, signal_id)) {
+        return JLS_ERROR_NOT_SUPPORTED;
+    }
+    ROE(jls_core_signal_validate_typed(&self->core, signal_id, JLS_SIGNAL_TYPE_FSR));
+    if (predicate > JLS_RD_FIND_CROSS) {
+        JLS_LOGW("invalid find predicate: %d", (int) predicate);
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    int64_t samples = 0;
+    ROE(jls_core_fsr_length(&self->core, signal_id, &samples));
+    if ((start_sample_id < 0) || (start_sample_id >= end_sample_id) || (end_sample_id > samples)) {
+        JLS_LOGW("invalid find window: %" PRIi64 " to %" PRIi64, start_sample_id, end_sample_id);
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    return 0;
+}
+
+static int32_t find_cross_op(struct jls_rd_s * self, uint16_t signal_id, int64_t sample_id,
+                             double threshold, uint8_t * op) {
+    double v = NAN;
+    ROE(jls_core_fsr_to_f64(&self->core, signal_id, sample_id, &v, 1));
+    *op = (v > threshold) ? FIND_OP_LE : FIND_OP_GT;
+    return 0;
+}
+
+JLS_API int32_t jls_rd_fsr_find(struct jls_rd_s * self, uint16_t signal_id,
+                                int64_t start_sample_id, int64_t end_sample_id,
+                                uint8_t predicate, double threshold, int64_t * sample_id) {
+    ROE(find_validate(self, signal_id, start_sample_id, end_sample_id, predicate));
+    uint8_t op;
+    switch (predicate) {
+        case JLS_RD_FIND_GT: op = FIND_OP_GT; break;
+        case JLS_RD_FIND_LT: op = FIND_OP_LT; break;
+        default:
+            ROE(find_cross_op(self, signal_id, start_sample_id, threshold, &op));
+            ++start_sample_id;
+            break;
+    }
+    return fsr_find(&self->core, signal_id, start_sample_id, end_sample_id, op, threshold, sample_id);
+}
+
+JLS_API int32_t jls_rd_fsr_find_iter_open(struct jls_rd_s * self, uint16_t signal_id,
+                                          int64_t start_sample_id, int64_t end_sample_id,
+                                          uint8_t predicate, double threshold,
+                                          struct jls_rd_fsr_find_iter_s ** iter) {
+    if (!iter) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    *iter = NULL;
+    ROE(find_validate(self, signal_id, start_sample_id, end_sample_id, predicate));
+    struct jls_rd_fsr_find_iter_s * it = calloc(1, sizeof(struct jls_rd_fsr_find_iter_s));
+    if (!it) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    it->rd = self;
+    it->signal_id = signal_id;
+    it->threshold = threshold;
+    it->pos = start_sample_id;
+    it->end = end_sample_id;
+    switch (predicate) {
+        case JLS_RD_FIND_GT: it->op = FIND_OP_GT; break;
+        case JLS_RD_FIND_LT: it->op = FIND_OP_LT; break;
+        default: {
+            it->cross = true;
+            int32_t rc = find_cross_op(self, signal_id, start_sample_id, threshold, &it->op);
+            if (!rc) {
+                rc = fsr_find(&self->core, signal_id, start_sample_id + 1, end_sample_id,
+                              it->op, threshold, &it->pos);
+            }
+            if (JLS_ERROR_NOT_FOUND == rc) {
+                it->pos = end_sample_id;
+            } else if (rc) {
+                free(it);
+                return rc;
+            }
+            break;
+        }
+    }
+    *iter = it;
+    return 0;
+}
+
+JLS_API int32_t jls_rd_fsr_find_iter_next(struct jls_rd_fsr_find_iter_s * iter,
+                                          int64_t * interval_start, int64_t * interval_end) {
+    int32_t rc;
+    if (!iter || !interval_start || !interval_end) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    } else if (iter->pos >= iter->end) {
+        return JLS_ERROR_EMPTY;
+    }
+    struct jls_core_s * core = &iter->rd->core;
+    int64_t start = iter->pos;
+    if (!iter->cross) {
+        rc = fsr_find(core, iter->signal_id, iter->pos, iter->end, iter->op, iter->threshold, &start);
+        if (JLS_ERROR_NOT_FOUND == rc) {
+            iter->pos = iter->end;
+            return JLS_ERROR_EMPTY;
+        } else if (rc) {
+            return rc;
+        }
+    }
+    uint8_t op_end = find_op_complement(iter->op);
+    int64_t end = iter->end;
+    if ((start + 1) < iter->end) {
+        rc = fsr_find(core, iter->signal_id, start + 1, iter->end, op_end, iter->threshold, &end);
+        if (JLS_ERROR_NOT_FOUND == rc) {
+            end = iter->end;
+        } else if (rc) {
+            return rc;
+        }
+    }
+    if (iter->cross) {
+        iter->op = op_end;  // the next interval starts on the other side
+    }
+    iter->pos = end;
+    *interval_start = start;
+    *interval_end = end;
+    return 0;
+}
+
+JLS_API void jls_rd_fsr_find_iter_close(struct jls_rd_fsr_find_iter_s * iter) {
+    if (iter) {
+        free(iter);
+    }
+}
+
+int32_t jls_rd_stats_enable(struct jls_rd_s * self, int enable) {
+    if (!self) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    return jls_core_stats_enable(&self->core, enable);
+}
+
+int32_t jls_rd_stats(struct jls_rd_s * self, struct jls_stats_s * stats) {
+    if (!self) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    return jls_core_stats(&self->core, stats);
 }
 
 int32_t jls_core_annotations(struct jls_core_s * self, uint16_t signal_id, int64_t timestamp,
@@ -623,8 +1569,19 @@ int32_t jls_core_utc(struct jls_core_s * self, uint16_t signal_id, int64_t sampl
     // iterate
     struct jls_chunk_header_s hdr;
     hdr.item_next = jls_raw_chunk_tell(self->raw);
+    int64_t data_last = 0;  // follow mode: the last indexed data chunk
 
-    while (hdr.item_next) {
+    while (1) {
+        if (!hdr.item_next) {
+            if (!data_last) {
+                break;
+            }
+            // follow mode: the newest data chunks are not yet summarized
+            ROE(jls_raw_chunk_seek(self->raw, data_last));
+            ROE(jls_raw_rd_header(self->raw, &hdr));
+            data_last = 0;
+            continue;
+        }
         ROE(jls_raw_chunk_seek(self->raw, hdr.item_next));
         ROE(jls_raw_rd_header(self->raw, &hdr));
         if (hdr.tag == JLS_TAG_TRACK_UTC_DATA) {
@@ -634,12 +1591,20 @@ int32_t jls_core_utc(struct jls_core_s * self, uint16_t signal_id, int64_t sampl
                 .sample_id = utc_data->header.timestamp - sample_id_offset,
                 .timestamp = utc_data->timestamp,
             };
-            if (cbk_fn(cbk_user_data, &entry, 1)) {
+            if ((utc_data->header.timestamp >= sample_id) && cbk_fn(cbk_user_data, &entry, 1)) {
                 return 0;
             }
             continue;
         } else if (hdr.tag == JLS_TAG_TRACK_UTC_INDEX) {
-            ROE(jls_raw_chunk_next(self->raw));
+            if (self->follow) {
+                ROE(jls_core_rd_chunk(self));
+                struct jls_index_s * r = (struct jls_index_s *) self->buf->start;
+                if (r->header.entry_count) {
+                    data_last = r->entries[r->header.entry_count - 1].offset;
+                }
+            } else {
+                ROE(jls_raw_chunk_next(self->raw));
+            }
             ROE(jls_core_rd_chunk(self));
             if (self->chunk_cur.hdr.tag != JLS_TAG_TRACK_UTC_SUMMARY) {
                 return JLS_ERROR_NOT_FOUND;
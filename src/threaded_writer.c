@@ -15,6 +15,7 @@
  */
 
 #include "jls/threaded_writer.h"
+#include "jls/dataset.h"
 #include "jls/msg_ring_buffer.h"
 #include "jls/wr_prv.h"
 #include "jls/backend.h"
@@ -29,6 +30,16 @@
 
 
 #define MRB_BUFFER_SIZE (64 * 1024 * 1024)
+#define DS_SEGMENT_PATH_EXTRA (32)
+#define FLUSH_PENDING_MAX (16)
+#define FLUSH_GROUP_TIME (10 * JLS_TIME_MILLISECOND)  // maximum flush delay while busy
+
+
+struct flush_pending_s {
+    jls_twr_flush_cbk_fn cbk_fn;
+    void * cbk_user_data;
+    uint64_t flush_id;
+};
 
 
 struct jls_twr_s {
@@ -39,6 +50,23 @@ struct jls_twr_s {
     volatile uint64_t flush_send_id;
     volatile uint64_t flush_processed_id;
     uint8_t fsr_entry_size_bits[JLS_SIGNAL_COUNT];
+    struct jls_twr_stats_s * stats;  // instrumentation counters, NULL when disabled
+    char * ds_path;                 // dataset path, NULL when not a dataset
+    char * ds_segment_path;         // buffer for the next segment path
+    size_t ds_segment_path_size;
+    uint32_t ds_segment;            // the current segment index
+    int64_t ds_size;                // roll when the segment reaches this size, 0 to disable
+    int64_t ds_duration;            // roll after this duration, 0 to disable
+    int64_t ds_samples[JLS_SIGNAL_COUNT];       // ds_duration in samples, 0 to disable
+    int64_t ds_sample_start[JLS_SIGNAL_COUNT];  // first sample_id in this segment, -1 if none
+    int32_t durability;             // jls_twr_durability_e
+    int64_t sync_period;            // periodic sync duration, 0 to disable
+    int64_t sync_size;              // periodic sync size in bytes, 0 to disable
+    int64_t sync_pos;               // the file position at the last durable sync
+    int64_t sync_dirty_time;        // the time of the first write after the last sync, 0 if none
+    struct flush_pending_s flush_pending[FLUSH_PENDING_MAX];  // flushes waiting for a group sync
+    uint32_t flush_pending_count;
+    int64_t flush_pending_time;     // the time of the first pending flush
     struct jls_mrb_s mrb;
     uint8_t mrb_buffer[];
 };
@@ -74,6 +102,11 @@ struct msg_header_utc_s {
     int64_t utc;
 };
 
+struct msg_header_flush_s {
+    jls_twr_flush_cbk_fn cbk_fn;
+    void * cbk_user_data;
+};
+
 struct msg_header_s {
     uint8_t msg_type;
     union {
@@ -82,13 +115,15 @@ struct msg_header_s {
         struct msg_header_fsr_omit_s fsr_omit;
         struct msg_header_annotation_s annotation;
         struct msg_header_utc_s utc;
+        struct msg_header_flush_s flush;
     } h;
     uint64_t d;
+    int64_t t_enqueue;  // for instrumentation, 0 when disabled
 };
 
 enum message_e {
     MSG_CLOSE,          // no header data, no args
-    MSG_FLUSH,          // no header data, no args
+    MSG_FLUSH,          // hdr.flush, no args
     MSG_USER_DATA,      // hdr.user_data, user_data
     MSG_FSR,            // hdr.fsr_f32, data
     MSG_FSR_OMIT,       // hdr.fsr_omit, no args
@@ -97,6 +132,34 @@ enum message_e {
     MSG_ITEM_COUNT,
 };
 
+static void stats_latency(struct jls_twr_stats_s * stats, int64_t t_enqueue) {
+    if (!t_enqueue) {
+        return;  // enqueued before instrumentation was enabled
+    }
+    int64_t latency = jls_time_rel() - t_enqueue;
+    if (latency > stats->latency_max) {
+        stats->latency_max = latency;
+    }
+    int64_t us = latency / JLS_TIME_MICROSECOND;
+    uint32_t bin = 0;
+    while ((us > 0) && (bin < (JLS_STATS_LATENCY_BINS - 1))) {
+        us >>= 1;
+        ++bin;
+    }
+    ++stats->latency_histogram[bin];
+}
+
+static void stats_drop(struct jls_twr_s * self, const struct msg_header_s * hdr) {
+    jls_bkt_msg_lock(self->bk);
+    if (self->stats) {
+        ++self->stats->dropped_msgs;
+        if (hdr->msg_type == MSG_FSR) {
+            self->stats->dropped_samples += hdr->h.fsr.sample_count;
+        }
+    }
+    jls_bkt_msg_unlock(self->bk);
+}
+
 const char * message_str[] = {
         "close",
         "flush",
@@ -106,6 +169,116 @@ const char * message_str[] = {
         "utc",
 };
 
+static int32_t ds_roll_check(struct jls_twr_s * self, const struct msg_header_fsr_s * fsr) {
+    uint16_t signal_id = fsr->signal_id;
+    if (self->ds_sample_start[signal_id] < 0) {
+        self->ds_sample_start[signal_id] = fsr->sample_id;
+    }
+    int64_t samples = fsr->sample_id + fsr->sample_count - self->ds_sample_start[signal_id];
+    bool roll = (self->ds_size && (jls_wr_tell(self->wr) >= self->ds_size))
+            || (self->ds_samples[signal_id] && (samples >= self->ds_samples[signal_id]));
+    if (!roll) {
+        return 0;
+    }
+    ROE(jls_ds_segment_path(self->ds_path, self->ds_segment + 1, self->ds_segment_path, self->ds_segment_path_size));
+    JLS_LOGI("dataset roll to %s", self->ds_segment_path);
+    ROE(jls_wr_roll(&self->wr, self->ds_segment_path));
+    ++self->ds_segment;
+    for (uint32_t idx = 0; idx < JLS_SIGNAL_COUNT; ++idx) {
+        self->ds_sample_start[idx] = -1;
+    }
+    return 0;
+}
+
+static int32_t sync_durable(struct jls_twr_s * self) {
+    int64_t t_start = jls_time_rel();
+    int32_t rc;
+    if (self->durability == JLS_TWR_DURABILITY_FLUSH) {
+        rc = jls_wr_flush(self->wr);
+    } else {
+        rc = jls_wr_sync(self->wr, 1);
+    }
+    if (self->stats) {
+        ++self->stats->syncs;
+        self->stats->sync_time += jls_time_rel() - t_start;
+    }
+    self->sync_pos = jls_wr_tell(self->wr);
+    self->sync_dirty_time = 0;
+    return rc;
+}
+
+static int32_t sync_periodic(struct jls_twr_s * self) {
+    if (self->durability != JLS_TWR_DURABILITY_PERIODIC) {
+        return 0;
+    }
+    int64_t pos = jls_wr_tell(self->wr);
+    if (pos < self->sync_pos) {
+        self->sync_pos = 0;  // rolled to a new dataset segment
+    }
+    if (pos == self->sync_pos) {
+        return 0;
+    }
+    int64_t now = jls_time_rel();
+    if (!self->sync_dirty_time) {
+        self->sync_dirty_time = now;
+    }
+    if ((self->sync_period && ((now - self->sync_dirty_time) >= self->sync_period))
+            || (self->sync_size && ((pos - self->sync_pos) >= self->sync_size))) {
+        return sync_durable(self);
+    }
+    return 0;
+}
+
+static uint32_t sync_timeout_ms(struct jls_twr_s * self) {
+    // 0 waits for the next message, otherwise the time until the next periodic sync
+    if ((self->durability != JLS_TWR_DURABILITY_PERIODIC) || !self->sync_period || !self->sync_dirty_time) {
+        return 0;
+    }
+    int64_t remaining = self->sync_dirty_time + self->sync_period - jls_time_rel();
+    int64_t ms = remaining / JLS_TIME_MILLISECOND;
+    if (ms < 1) {
+        ms = 1;
+    } else if (ms > 1000) {
+        ms = 1000;
+    }
+    return (uint32_t) ms;
+}
+
+static void flush_complete(struct jls_twr_s * self) {
+    if (!self->flush_pending_count) {
+        return;
+    }
+    int32_t rc;
+    if (self->durability == JLS_TWR_DURABILITY_FLUSH) {
+        rc = sync_durable(self);
+    } else {
+        rc = jls_wr_sync(self->wr, 0);
+    }
+    for (uint32_t i = 0; i < self->flush_pending_count; ++i) {
+        struct flush_pending_s * p = &self->flush_pending[i];
+        if (p->flush_id > self->flush_processed_id) {
+            self->flush_processed_id = p->flush_id;
+        }
+        if (p->cbk_fn) {
+            p->cbk_fn(p->cbk_user_data, p->flush_id, rc);
+        }
+    }
+    self->flush_pending_count = 0;
+}
+
+static void flush_add(struct jls_twr_s * self, const struct msg_header_s * hdr) {
+    if (self->flush_pending_count >= FLUSH_PENDING_MAX) {
+        flush_complete(self);
+    }
+    if (!self->flush_pending_count) {
+        self->flush_pending_time = jls_time_rel();
+    }
+    struct flush_pending_s * p = &self->flush_pending[self->flush_pending_count++];
+    p->cbk_fn = hdr->h.flush.cbk_fn;
+    p->cbk_user_data = hdr->h.flush.cbk_user_data;
+    p->flush_id = hdr->d;
+}
+
 int32_t jls_twr_run(struct jls_twr_s * self) {
     uint32_t msg_size = 0;
     uint8_t * msg = NULL;
@@ -124,7 +297,12 @@ int32_t jls_twr_run(struct jls_twr_s * self) {
             self->quit = true;
             continue;
         }
-        jls_bkt_msg_wait(self->bk);
+        uint32_t timeout_ms = sync_timeout_ms(self);
+        if (timeout_ms) {
+            jls_bkt_msg_wait_ms(self->bk, timeout_ms);
+        } else {
+            jls_bkt_msg_wait(self->bk);
+        }
         while (1) {
             jls_bkt_msg_lock(self->bk);
             if (NULL != msg) {
@@ -148,13 +326,16 @@ int32_t jls_twr_run(struct jls_twr_s * self) {
             rc = 0;
 
             jls_bkt_process_lock(self->bk);
+            if (self->stats) {
+                ++self->stats->msg_count;
+                stats_latency(self->stats, hdr.t_enqueue);
+            }
             switch (hdr.msg_type) {
                 case MSG_CLOSE:
                     self->quit = 1;
                     break;
                 case MSG_FLUSH:
-                    jls_wr_flush(self->wr);
-                    self->flush_processed_id = hdr.d > self->flush_processed_id ? hdr.d : self->flush_processed_id;
+                    flush_add(self, &hdr);  // completed by flush_complete
                     break;
                 case MSG_USER_DATA:
                     rc = jls_wr_user_data(self->wr, hdr.h.user_data.chunk_meta, hdr.h.user_data.storage_type,
@@ -162,6 +343,9 @@ int32_t jls_twr_run(struct jls_twr_s * self) {
                     break;
                 case MSG_FSR:
                     rc = jls_wr_fsr(self->wr, hdr.h.fsr.signal_id, hdr.h.fsr.sample_id, payload, hdr.h.fsr.sample_count);
+                    if (!rc && self->ds_path) {
+                        rc = ds_roll_check(self, &hdr.h.fsr);
+                    }
                     break;
                 case MSG_FSR_OMIT:
                     rc = jls_wr_fsr_omit_data(self->wr, hdr.h.fsr_omit.signal_id, hdr.h.fsr_omit.enable);
@@ -179,6 +363,12 @@ int32_t jls_twr_run(struct jls_twr_s * self) {
                 default:
                     break;
             }
+            if (!rc) {
+                rc = sync_periodic(self);
+            }
+            if (self->flush_pending_count && ((jls_time_rel() - self->flush_pending_time) >= FLUSH_GROUP_TIME)) {
+                flush_complete(self);
+            }
             jls_bkt_process_unlock(self->bk);
             counter_end = jls_time_counter();
             duration_ms = (1000 * (counter_end.value - counter_start.value)) / counter_end.frequency;
@@ -196,17 +386,22 @@ int32_t jls_twr_run(struct jls_twr_s * self) {
                          (int) rc, jls_error_code_name(rc));
             }
         }
+
+        // queue empty: group sync for pending flushes
+        jls_bkt_process_lock(self->bk);
+        flush_complete(self);
+        rc = sync_periodic(self);
+        jls_bkt_process_unlock(self->bk);
+        if (rc) {
+            JLS_LOGW("periodic sync returned %d:%s", (int) rc, jls_error_code_name(rc));
+        }
     }
     JLS_LOGI("run done");
     return 0;
 }
 
-int32_t jls_twr_open(struct jls_twr_s ** instance, const char * path) {
-    struct jls_wr_s * wr;
-    struct jls_twr_s * self;
-    ROE(jls_wr_open(&wr, path));
-
-    self = malloc(sizeof(struct jls_twr_s) + MRB_BUFFER_SIZE);
+static int32_t twr_open(struct jls_twr_s ** instance, struct jls_wr_s * wr) {
+    struct jls_twr_s * self = malloc(sizeof(struct jls_twr_s) + MRB_BUFFER_SIZE);
     if (NULL == self) {
         JLS_LOGE("jls_twr_open malloc failed");
         jls_wr_close(wr);
@@ -217,6 +412,27 @@ int32_t jls_twr_open(struct jls_twr_s ** instance, const char * path) {
     self->wr = wr;
     self->flush_send_id = 0;
     self->flush_processed_id = 0;
+    self->stats = NULL;
+    self->ds_path = NULL;
+    self->ds_segment_path = NULL;
+    self->ds_segment_path_size = 0;
+    self->ds_segment = 0;
+    self->ds_size = 0;
+    self->ds_duration = 0;
+    self->durability = JLS_TWR_DURABILITY_FLUSH;
+    self->sync_period = 0;
+    self->sync_size = 0;
+    self->sync_pos = 0;
+    self->sync_dirty_time = 0;
+    self->flush_pending_count = 0;
+    self->flush_pending_time = 0;
+    for (uint32_t idx = 0; idx < JLS_SIGNAL_COUNT; ++idx) {
+        self->ds_samples[idx] = 0;
+        self->ds_sample_start[idx] = -1;
+        // signals restored on append are already defined
+        const struct jls_signal_def_s * signal = jls_wr_signal_def_get(wr, (uint16_t) idx);
+        self->fsr_entry_size_bits[idx] = signal ? jls_datatype_parse_size(signal->data_type) : 0;
+    }
 
     jls_mrb_init(&self->mrb, self->mrb_buffer, MRB_BUFFER_SIZE);
     self->bk = jls_bkt_initialize(self);
@@ -230,6 +446,53 @@ int32_t jls_twr_open(struct jls_twr_s ** instance, const char * path) {
     return 0;
 }
 
+int32_t jls_twr_open(struct jls_twr_s ** instance, const char * path) {
+    struct jls_wr_s * wr;
+    ROE(jls_wr_open(&wr, path));
+    return twr_open(instance, wr);
+}
+
+int32_t jls_twr_open_append(struct jls_twr_s ** instance, const char * path) {
+    struct jls_wr_s * wr;
+    ROE(jls_wr_open_append(&wr, path));
+    return twr_open(instance, wr);
+}
+
+int32_t jls_twr_open_dataset(struct jls_twr_s ** instance, const char * path,
+                             int64_t segment_size, int64_t segment_duration) {
+    struct jls_twr_s * self = NULL;
+    struct jls_wr_s * wr;
+    if ((segment_size < 0) || (segment_duration < 0)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    size_t path_len = strlen(path);
+    size_t segment_path_size = path_len + DS_SEGMENT_PATH_EXTRA;
+    char * ds_path = malloc(path_len + 1 + segment_path_size);
+    if (!ds_path) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    memcpy(ds_path, path, path_len + 1);
+    char * segment_path = ds_path + path_len + 1;
+    int32_t rc = jls_ds_segment_path(path, 0, segment_path, segment_path_size);
+    if (!rc) {
+        rc = jls_wr_open(&wr, segment_path);
+    }
+    if (!rc) {
+        rc = twr_open(&self, wr);
+    }
+    if (rc) {
+        free(ds_path);
+        return rc;
+    }
+    self->ds_path = ds_path;
+    self->ds_segment_path = segment_path;
+    self->ds_segment_path_size = segment_path_size;
+    self->ds_size = segment_size;
+    self->ds_duration = segment_duration;
+    *instance = self;
+    return 0;
+}
+
 uint32_t jls_twr_flags_get(struct jls_twr_s * self) {
     return self->flags;
 }
@@ -244,7 +507,17 @@ static int32_t msg_send_inner(struct jls_twr_s * self, const struct msg_header_s
     jls_bkt_msg_lock(self->bk);
     uint8_t *msg = jls_mrb_alloc(&self->mrb, sz);
     if (msg) {
-        memcpy(msg, hdr, sizeof(*hdr));
+        if (self->stats) {
+            struct msg_header_s h = *hdr;
+            h.t_enqueue = jls_time_rel();
+            memcpy(msg, &h, sizeof(h));
+            uint32_t used = jls_mrb_used_bytes(&self->mrb);
+            if (used > self->stats->ring_high_water) {
+                self->stats->ring_high_water = used;
+            }
+        } else {
+            memcpy(msg, hdr, sizeof(*hdr));
+        }
         if (payload_size) {
             memcpy(msg + sizeof(*hdr), payload, payload_size);
         }
@@ -266,18 +539,30 @@ static int32_t msg_send(struct jls_twr_s * self, const struct msg_header_s * hdr
         }
         jls_bkt_sleep_ms(5);
     }
+    stats_drop(self, hdr);
     return JLS_ERROR_BUSY;
 }
 
-int32_t jls_twr_flush(struct jls_twr_s * self) {
-    uint64_t flush_id;
+int32_t jls_twr_flush_async(struct jls_twr_s * self, jls_twr_flush_cbk_fn cbk_fn, void * cbk_user_data,
+                            uint64_t * flush_id) {
+    uint64_t id;
     struct msg_header_s hdr = { .msg_type = MSG_FLUSH };
+    hdr.h.flush.cbk_fn = cbk_fn;
+    hdr.h.flush.cbk_user_data = cbk_user_data;
     jls_bkt_msg_lock(self->bk);
-    flush_id = self->flush_send_id + 1;
-    self->flush_send_id = flush_id;
+    id = self->flush_send_id + 1;
+    self->flush_send_id = id;
     jls_bkt_msg_unlock(self->bk);
-    hdr.d = flush_id;
-    msg_send(self, &hdr, NULL, 0);
+    hdr.d = id;
+    if (flush_id) {
+        *flush_id = id;
+    }
+    return msg_send(self, &hdr, NULL, 0);
+}
+
+int32_t jls_twr_flush(struct jls_twr_s * self) {
+    uint64_t flush_id;
+    ROE(jls_twr_flush_async(self, NULL, NULL, &flush_id));
 
     int64_t t_start = jls_now();
     int64_t t_stop = t_start + JLS_TIME_MILLISECOND * (int64_t) JLS_BK_FLUSH_TIMEOUT_MS;
@@ -302,12 +587,49 @@ int32_t jls_twr_close(struct jls_twr_s * self) {
         // JLS_LOGI("jls_wr_flush done");
         jls_wr_close(self->wr);
         self->wr = NULL;
+        free(self->stats);
+        free(self->ds_path);
         free(self);
         JLS_LOGI("jls_wr_close done");
     }
     return 0;
 }
 
+int32_t jls_twr_durability(struct jls_twr_s * self, int32_t mode, int64_t period, int64_t size) {
+    if (!self || (period < 0) || (size < 0)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    switch (mode) {
+        case JLS_TWR_DURABILITY_FLUSH:      // intentional fall-through
+        case JLS_TWR_DURABILITY_NONE:       // intentional fall-through
+        case JLS_TWR_DURABILITY_PERIODIC:
+            break;
+        default:
+            return JLS_ERROR_PARAMETER_INVALID;
+    }
+    jls_bkt_process_lock(self->bk);
+    self->durability = mode;
+    self->sync_period = period;
+    self->sync_size = size;
+    jls_bkt_process_unlock(self->bk);
+    jls_bkt_msg_signal(self->bk);  // update the wait timeout
+    return 0;
+}
+
+int32_t jls_twr_checkpoint_interval(struct jls_twr_s * self, int64_t interval) {
+    jls_bkt_process_lock(self->bk);
+    int32_t rv = jls_wr_checkpoint_interval(self->wr, interval);
+    jls_bkt_process_unlock(self->bk);
+    return rv;
+}
+
+int32_t jls_twr_write_buffer(struct jls_twr_s * self, uint32_t size) {
+    jls_bkt_process_lock(self->bk);
+    int32_t rv = jls_wr_write_buffer(self->wr, size);
+    jls_bkt_process_unlock(self->bk);
+    return rv;
+}
+
 int32_t jls_twr_source_def(struct jls_twr_s * self, const struct jls_source_def_s * source) {
     jls_bkt_process_lock(self->bk);
     int32_t rv = jls_wr_source_def(self->wr, source);
@@ -318,11 +640,23 @@ int32_t jls_twr_source_def(struct jls_twr_s * self, const struct jls_source_def_
 int32_t jls_twr_signal_def(struct jls_twr_s * self, const struct jls_signal_def_s * signal) {
     jls_bkt_process_lock(self->bk);
     self->fsr_entry_size_bits[signal->signal_id] = jls_datatype_parse_size(signal->data_type);
+    if (self->ds_duration && (signal->signal_type == JLS_SIGNAL_TYPE_FSR)) {
+        self->ds_samples[signal->signal_id] = (int64_t) ((double) self->ds_duration * signal->sample_rate / JLS_TIME_SECOND);
+    }
     int32_t rv = jls_wr_signal_def(self->wr, signal);
     jls_bkt_process_unlock(self->bk);
     return rv;
 }
 
+int32_t jls_twr_signal_def_derived(struct jls_twr_s * self, const struct jls_signal_def_s * signal,
+                                   const struct jls_wr_derived_def_s * derived) {
+    jls_bkt_process_lock(self->bk);
+    self->fsr_entry_size_bits[signal->signal_id] = jls_datatype_parse_size(signal->data_type);
+    int32_t rv = jls_wr_signal_def_derived(self->wr, signal, derived);
+    jls_bkt_process_unlock(self->bk);
+    return rv;
+}
+
 int32_t jls_twr_user_data(struct jls_twr_s * self, uint16_t chunk_meta,
                           enum jls_storage_type_e storage_type, const uint8_t * data, uint32_t data_size) {
     struct msg_header_s hdr = {
@@ -351,10 +685,16 @@ int32_t jls_twr_fsr(struct jls_twr_s * self, uint16_t signal_id,
             },
             .d = 0
     };
+    if (signal_id >= JLS_SIGNAL_COUNT) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
     uint32_t length = (data_length * self->fsr_entry_size_bits[signal_id] + 7) / 8;
     int32_t rc;
     if (self->flags & JLS_TWR_FLAG_DROP_ON_OVERFLOW) {
         rc = msg_send_inner(self, &hdr, (const uint8_t *) data, length);
+        if (rc) {
+            stats_drop(self, &hdr);
+        }
     } else {
         rc = msg_send(self, &hdr, (const uint8_t *) data, length);
     }
@@ -421,3 +761,50 @@ JLS_API int32_t jls_twr_utc(struct jls_twr_s * self, uint16_t signal_id, int64_t
     };
     return msg_send(self, &hdr, NULL, 0);
 }
+
+int32_t jls_twr_stats_enable(struct jls_twr_s * self, int enable) {
+    struct jls_twr_stats_s * stats = NULL;
+    if (!self) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    if (enable) {
+        stats = calloc(1, sizeof(struct jls_twr_stats_s));
+        if (!stats) {
+            return JLS_ERROR_NOT_ENOUGH_MEMORY;
+        }
+        stats->ring_size = self->mrb.buf_size;
+    }
+    jls_bkt_process_lock(self->bk);
+    int32_t rv = jls_wr_stats_enable(self->wr, enable);
+    jls_bkt_msg_lock(self->bk);
+    struct jls_twr_stats_s * stats_prev = self->stats;
+    self->stats = rv ? NULL : stats;
+    jls_bkt_msg_unlock(self->bk);
+    jls_bkt_process_unlock(self->bk);
+    free(stats_prev);
+    if (rv) {
+        free(stats);
+    }
+    return rv;
+}
+
+int32_t jls_twr_stats(struct jls_twr_s * self, struct jls_twr_stats_s * stats) {
+    int32_t rv = 0;
+    if (!self || !stats) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    jls_bkt_process_lock(self->bk);
+    jls_bkt_msg_lock(self->bk);
+    if (self->stats) {
+        *stats = *self->stats;
+    } else {
+        memset(stats, 0, sizeof(*stats));
+        rv = JLS_ERROR_UNAVAILABLE;
+    }
+    jls_bkt_msg_unlock(self->bk);
+    if (!rv) {
+        rv = jls_wr_stats(self->wr, &stats->wr);
+    }
+    jls_bkt_process_unlock(self->bk);
+    return rv;
+}
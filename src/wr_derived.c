@@ -0,0 +1,264 @@
+/*
+ * Copyright 2026 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jls/wr_derived.h"
+#include "jls/datatype.h"
+#include "jls/cdef.h"
+#include "jls/ec.h"
+#include "jls/log.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+#define BLOCK_SIZE (4096)
+#define FIFO_SIZE_INIT (BLOCK_SIZE)
+
+
+struct fifo_s {
+    double * buf;
+    size_t capacity;        // in samples
+    size_t head;            // index of the first pending sample
+    size_t count;           // number of pending samples
+    int64_t sample_id;      // sample id for buf[head]
+    uint8_t started;
+};
+
+struct jls_wr_derived_s {
+    struct jls_wr_derived_def_s def;
+    uint32_t data_type;
+    double sample_period;
+    double integral;
+    struct fifo_s fifo[JLS_WR_DERIVED_SOURCE_MAX];
+    union {
+        double f64[BLOCK_SIZE];
+        float f32[BLOCK_SIZE];
+    } y;
+};
+
+int32_t jls_wr_derived_alloc(struct jls_wr_derived_s ** instance,
+                             const struct jls_signal_def_s * signal_def,
+                             const struct jls_wr_derived_def_s * def) {
+    if (!instance || !signal_def || !def) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    switch (def->op) {
+        case JLS_WR_DERIVED_OP_SUM:  // intentional fall-through
+        case JLS_WR_DERIVED_OP_PRODUCT:
+            if ((def->source_count < 2) || (def->source_count > JLS_WR_DERIVED_SOURCE_MAX)) {
+                JLS_LOGW("derived signal %d: invalid source_count %d",
+                         (int) signal_def->signal_id, (int) def->source_count);
+                return JLS_ERROR_PARAMETER_INVALID;
+            }
+            break;
+        case JLS_WR_DERIVED_OP_INTEGRAL:
+            if (def->source_count != 1) {
+                JLS_LOGW("derived signal %d: integral requires 1 source", (int) signal_def->signal_id);
+                return JLS_ERROR_PARAMETER_INVALID;
+            }
+            break;
+        default:
+            JLS_LOGW("derived signal %d: invalid op %d", (int) signal_def->signal_id, (int) def->op);
+            return JLS_ERROR_PARAMETER_INVALID;
+    }
+    if ((signal_def->data_type != JLS_DATATYPE_F32) && (signal_def->data_type != JLS_DATATYPE_F64)) {
+        JLS_LOGW("derived signal %d: data type must be f32 or f64", (int) signal_def->signal_id);
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    if (!signal_def->sample_rate) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+
+    struct jls_wr_derived_s * self = calloc(1, sizeof(struct jls_wr_derived_s));
+    if (!self) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    self->def = *def;
+    self->data_type = signal_def->data_type;
+    self->sample_period = 1.0 / signal_def->sample_rate;
+    *instance = self;
+    return 0;
+}
+
+void jls_wr_derived_free(struct jls_wr_derived_s * self) {
+    if (self) {
+        for (uint32_t i = 0; i < JLS_WR_DERIVED_SOURCE_MAX; ++i) {
+            free(self->fifo[i].buf);
+        }
+        free(self);
+    }
+}
+
+static int32_t fifo_reserve(struct fifo_s * f, size_t count) {
+    size_t sz = f->count + count;
+    if ((f->head + sz) <= f->capacity) {
+        return 0;
+    }
+    if (f->head && f->count) {
+        memmove(f->buf, f->buf + f->head, f->count * sizeof(double));
+    }
+    f->head = 0;
+    if (sz <= f->capacity) {
+        return 0;
+    }
+    size_t capacity = f->capacity ? f->capacity : FIFO_SIZE_INIT;
+    while (capacity < sz) {
+        capacity *= 2;
+    }
+    double * buf = realloc(f->buf, capacity * sizeof(double));
+    if (!buf) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    f->buf = buf;
+    f->capacity = capacity;
+    return 0;
+}
+
+static void fifo_discard(struct fifo_s * f, size_t count) {
+    f->head += count;
+    f->count -= count;
+    f->sample_id += (int64_t) count;
+    if (!f->count) {
+        f->head = 0;
+    }
+}
+
+static int32_t fifo_push(struct fifo_s * f, uint32_t data_type, int64_t sample_id,
+                         const void * data, uint32_t data_length) {
+    if (!f->started) {
+        f->started = 1;
+        f->sample_id = sample_id;
+    }
+    int64_t sample_id_end = f->sample_id + (int64_t) f->count;
+    if (sample_id > sample_id_end) {  // skip: fill with NaN
+        size_t skip = (size_t) (sample_id - sample_id_end);
+        ROE(fifo_reserve(f, skip));
+        double * dst = f->buf + f->head + f->count;
+        for (size_t i = 0; i < skip; ++i) {
+            dst[i] = NAN;
+        }
+        f->count += skip;
+        sample_id_end = sample_id;
+    }
+    int64_t dup = sample_id_end - sample_id;
+    if (dup >= (int64_t) data_length) {
+        return 0;  // duplicate, ignore
+    }
+    ROE(fifo_reserve(f, data_length));
+    double * dst = f->buf + f->head + f->count;
+    ROE(jls_dt_buffer_as_f64(data, data_type, dst, data_length));
+    size_t count = data_length - (size_t) dup;
+    if (dup) {
+        memmove(dst, dst + dup, count * sizeof(double));
+    }
+    f->count += count;
+    return 0;
+}
+
+int32_t jls_wr_derived_source(struct jls_wr_derived_s * self, uint16_t signal_id, uint32_t data_type,
+                              int64_t sample_id, const void * data, uint32_t data_length) {
+    for (uint32_t i = 0; i < self->def.source_count; ++i) {
+        if (self->def.source_ids[i] == signal_id) {
+            ROE(fifo_push(&self->fifo[i], data_type, sample_id, data, data_length));
+        }
+    }
+    return 0;
+}
+
+int32_t jls_wr_derived_next(struct jls_wr_derived_s * self,
+                            int64_t * sample_id, const void ** data, uint32_t * data_length) {
+    uint32_t source_count = self->def.source_count;
+    int64_t start = INT64_MIN;
+    for (uint32_t i = 0; i < source_count; ++i) {
+        struct fifo_s * f = &self->fifo[i];
+        if (!f->started) {
+            return JLS_ERROR_EMPTY;
+        }
+        if (f->sample_id > start) {
+            start = f->sample_id;
+        }
+    }
+
+    // align all sources to the same starting sample_id
+    size_t count = BLOCK_SIZE;
+    for (uint32_t i = 0; i < source_count; ++i) {
+        struct fifo_s * f = &self->fifo[i];
+        int64_t skip = start - f->sample_id;
+        if (skip > (int64_t) f->count) {
+            skip = (int64_t) f->count;
+        }
+        fifo_discard(f, (size_t) skip);
+        if (f->count < count) {
+            count = f->count;
+        }
+    }
+    if (!count) {
+        return JLS_ERROR_EMPTY;
+    }
+
+    double * y = self->y.f64;
+    const double * x0 = self->fifo[0].buf + self->fifo[0].head;
+    switch (self->def.op) {
+        case JLS_WR_DERIVED_OP_SUM:
+            memcpy(y, x0, count * sizeof(double));
+            for (uint32_t k = 1; k < source_count; ++k) {
+                const double * x = self->fifo[k].buf + self->fifo[k].head;
+                for (size_t i = 0; i < count; ++i) {
+                    y[i] += x[i];
+                }
+            }
+            break;
+        case JLS_WR_DERIVED_OP_PRODUCT:
+            memcpy(y, x0, count * sizeof(double));
+            for (uint32_t k = 1; k < source_count; ++k) {
+                const double * x = self->fifo[k].buf + self->fifo[k].head;
+                for (size_t i = 0; i < count; ++i) {
+                    y[i] *= x[i];
+                }
+            }
+            break;
+        case JLS_WR_DERIVED_OP_INTEGRAL:
+            for (size_t i = 0; i < count; ++i) {
+                if (!isnan(x0[i])) {
+                    self->integral += x0[i];
+                }
+                y[i] = self->integral * self->sample_period;
+            }
+            break;
+        default:
+            return JLS_ERROR_PARAMETER_INVALID;
+    }
+
+    double gain = self->def.gain;
+    double offset = self->def.offset;
+    if (self->data_type == JLS_DATATYPE_F32) {
+        for (size_t i = 0; i < count; ++i) {
+            self->y.f32[i] = (float) (gain * y[i] + offset);  // in place, f32[i] overlaps f64[i/2]
+        }
+    } else if ((gain != 1.0) || (offset != 0.0)) {
+        for (size_t i = 0; i < count; ++i) {
+            y[i] = gain * y[i] + offset;
+        }
+    }
+
+    for (uint32_t i = 0; i < source_count; ++i) {
+        fifo_discard(&self->fifo[i], count);
+    }
+    *sample_id = start;
+    *data = &self->y;
+    *data_length = (uint32_t) count;
+    return 0;
+}
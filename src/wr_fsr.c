@@ -15,12 +15,15 @@
  */
 
 #include "jls/wr_fsr.h"
+#include "jls/bit_shift.h"
 #include "jls/core.h"
 #include "jls/cdef.h"
 #include "jls/datatype.h"
 #include "jls/wr_prv.h"
 #include "jls/ec.h"
 #include "jls/log.h"
+#include "jls/statistics.h"
+#include "jls/time.h"
 #include <inttypes.h>
 #include <limits.h>
 #include <math.h>
@@ -34,6 +37,9 @@ static inline uint8_t sample_size_bits(struct jls_core_fsr_s * self) {
 }
 
 static inline uint8_t summary_entry_size(struct jls_core_fsr_s * self) {
+    if (self->parent->signal_def.summary_fields & JLS_SUMMARY_FIELD_F64) {
+        return 64;
+    }
     switch (self->parent->signal_def.data_type & 0xffff) {
         case JLS_DATATYPE_I32: // intentional fall-through
         case JLS_DATATYPE_I64: // intentional fall-through
@@ -46,6 +52,10 @@ static inline uint8_t summary_entry_size(struct jls_core_fsr_s * self) {
     }
 }
 
+static inline uint32_t summary_stride(struct jls_core_fsr_s * self, uint8_t level) {
+    return jls_core_fsr_summary_level_stride(&self->parent->signal_def, level);
+}
+
 int32_t jls_core_fsr_sample_buffer_alloc(struct jls_core_fsr_s * self) {
     size_t sample_buffer_sz = sizeof(struct jls_payload_header_s) + (sample_size_bits(self) * self->parent->signal_def.samples_per_data) / 8;
     self->data = malloc(sample_buffer_sz);
@@ -92,7 +102,7 @@ int32_t jls_core_fsr_summary_level_alloc(struct jls_core_fsr_s * self, uint8_t l
 
     size_t dt_sz_bits = summary_entry_size(self);
     size_t buffer_sz = sizeof(struct jls_fsr_f32_summary_s)
-            + (self->parent->signal_def.entries_per_summary * JLS_SUMMARY_FSR_COUNT * dt_sz_bits) / 8;
+            + (self->parent->signal_def.entries_per_summary * summary_stride(self, level) * dt_sz_bits) / 8;
     buffer_sz = ((buffer_sz + 15) / 16) * 16;
 
     size_t index_sz = sizeof(struct jls_fsr_index_s) + index_entries * sizeof(int64_t);
@@ -120,7 +130,7 @@ int32_t jls_core_fsr_summary_level_alloc(struct jls_core_fsr_s * self, uint8_t l
     b->summary = (struct jls_fsr_f32_summary_s *) buffer;  // actually jls_fsr_f32_summary_s or jls_fsr_f64_summary_s
     b->summary->header.timestamp = self->sample_id_offset;
     b->summary->header.entry_count = 0;
-    b->summary->header.entry_size_bits = (uint16_t) (JLS_SUMMARY_FSR_COUNT * dt_sz_bits);
+    b->summary->header.entry_size_bits = (uint16_t) (summary_stride(self, level) * dt_sz_bits);
     b->summary->header.rsv16 = 0;
 
     self->level[level] = b;
@@ -212,8 +222,8 @@ static int32_t wr_summary(struct jls_core_fsr_s * self, uint8_t level) {
     ROE(wr_index(self, level));
 
     uint8_t * p_start = (uint8_t *) dst->summary;
-    uint8_t * p_end = (uint8_t *) dst->summary->data[dst->summary->header.entry_count];
-    uint32_t payload_len = (uint32_t) (p_end - p_start);
+    uint32_t payload_len = (uint32_t) (sizeof(dst->summary->header)
+            + (dst->summary->header.entry_count * dst->summary->header.entry_size_bits) / 8);
     ROE(jls_core_wr_summary(self->parent->parent, self->parent->signal_def.signal_id, JLS_TRACK_TYPE_FSR, level,
                             p_start, payload_len));
     ROE(jls_core_fsr_summaryN(self, level + 1, pos_next));
@@ -269,78 +279,283 @@ int32_t jls_fsr_close(struct jls_core_fsr_s * self) {
     return 0;
 }
 
-static void summary_entry_add(struct jls_core_fsr_s * self, uint8_t level,
-        double v_mean, double v_min, double v_max, double v_var) {
+static void summary_entry_set(struct jls_core_fsr_s * self, uint8_t level, uint32_t entry,
+        const struct jls_core_fsr_entry_s * e, const double * hist) {
     struct jls_core_fsr_level_s * dst = self->level[level];
-    uint32_t dst_offset = dst->summary->header.entry_count * JLS_SUMMARY_FSR_COUNT;
+    uint32_t stride = summary_stride(self, level);
+    uint32_t fields_stride = jls_core_fsr_summary_stride(self->parent->signal_def.summary_fields);
+    uint32_t dst_offset = entry * stride;
+    const struct jls_statistics_s * stats = &e->stats;
+    double v[JLS_SUMMARY_FSR_ENTRY_MAX];
+    v[JLS_SUMMARY_FSR_MEAN] = NAN;
+    v[JLS_SUMMARY_FSR_STD] = NAN;
+    v[JLS_SUMMARY_FSR_MIN] = NAN;
+    v[JLS_SUMMARY_FSR_MAX] = NAN;
+    if (stats->k) {
+        v[JLS_SUMMARY_FSR_MEAN] = stats->mean;
+        v[JLS_SUMMARY_FSR_MIN] = stats->min;
+        v[JLS_SUMMARY_FSR_MAX] = stats->max;
+        v[JLS_SUMMARY_FSR_STD] = sqrt(stats->s / (double) stats->k);
+    }
+    jls_core_fsr_entry_encode(e, self->parent->signal_def.summary_fields, &v[JLS_SUMMARY_FSR_COUNT]);
     if (summary_entry_size(self) == 64) {
         double * data = (double *) dst->summary->data;
-        data[dst_offset + JLS_SUMMARY_FSR_MEAN] = v_mean;
-        data[dst_offset + JLS_SUMMARY_FSR_MIN] = v_min;
-        data[dst_offset + JLS_SUMMARY_FSR_MAX] = v_max;
-        data[dst_offset + JLS_SUMMARY_FSR_STD] = sqrt(v_var);
+        for (uint32_t i = 0; i < fields_stride; ++i) {
+            data[dst_offset + i] = v[i];
+        }
+        for (uint32_t i = fields_stride; i < stride; ++i) {
+            data[dst_offset + i] = hist[i - fields_stride];
+        }
     } else {
         float * data = (float *) dst->summary->data;
-        data[dst_offset + JLS_SUMMARY_FSR_MEAN] = (float) v_mean;
-        data[dst_offset + JLS_SUMMARY_FSR_MIN] = (float) v_min;
-        data[dst_offset + JLS_SUMMARY_FSR_MAX] = (float) v_max;
-        data[dst_offset + JLS_SUMMARY_FSR_STD] = (float) sqrt(v_var);
-    }
-    ++dst->summary->header.entry_count;
-}
-
-#define SUMMARYN_BODY_TEMPLATE()                                                            \
-    for (uint32_t idx = 0; idx < summaries_per; ++idx) {                                    \
-        uint32_t sample_idx = idx * self->parent->signal_def.summary_decimate_factor;                      \
-        uint32_t count = 0;                                                                 \
-        double v;                                                                           \
-        double v_mean = 0.0;                                                                \
-        double v_min = DBL_MAX;                                                             \
-        double v_max = -DBL_MAX;                                                            \
-        double v_var = 0.0;                                                                 \
-        for (uint32_t sample = 0; sample < self->parent->signal_def.summary_decimate_factor; ++sample) {   \
-            uint32_t offset = sample_idx * JLS_SUMMARY_FSR_COUNT;                           \
-            v = src_data[offset + JLS_SUMMARY_FSR_MEAN];                                    \
-            if (isfinite(v)) {                                                              \
-                ++count;                                                                    \
-                v_mean += v;                                                                \
-                if (src_data[offset + JLS_SUMMARY_FSR_MIN] < v_min) {                       \
-                    v_min = src_data[offset + JLS_SUMMARY_FSR_MIN];                         \
-                }                                                                           \
-                if (src_data[offset + JLS_SUMMARY_FSR_MAX] > v_max) {                       \
-                    v_max = src_data[offset + JLS_SUMMARY_FSR_MAX];                         \
-                }                                                                           \
-            }                                                                               \
-            ++sample_idx;                                                                   \
-        }                                                                                   \
-        if (count == 0) {                                                                   \
-            v_mean = NAN;                                                                   \
-            v_var = NAN;                                                                    \
-            v_min = NAN;                                                                    \
-            v_max = NAN;                                                                    \
-        } else {                                                                            \
-            v_mean /= count;                                                                    \
-            sample_idx = idx * self->parent->signal_def.summary_decimate_factor;                               \
-            for (uint32_t sample = 0; sample < self->parent->signal_def.summary_decimate_factor; ++sample) {   \
-                uint32_t offset = sample_idx * JLS_SUMMARY_FSR_COUNT;                           \
-                double v = src_data[offset + JLS_SUMMARY_FSR_MEAN] - v_mean;                    \
-                double std = src_data[offset + JLS_SUMMARY_FSR_STD];                            \
-                v_var += (std * std) + (v * v);                                                 \
-                ++sample_idx;                                                                   \
-            }                                                                                   \
-            v_var /= count;                                                                 \
-        }                                                                                    \
-        summary_entry_add(self, level, v_mean, v_min, v_max, v_var);                        \
+        for (uint32_t i = 0; i < fields_stride; ++i) {
+            data[dst_offset + i] = (float) v[i];
+        }
+        for (uint32_t i = fields_stride; i < stride; ++i) {
+            data[dst_offset + i] = (float) hist[i - fields_stride];
+        }
+    }
+}
+
+static void hist_add(struct jls_core_fsr_s * self, double * hist, const double * src) {
+    uint32_t bins = self->parent->signal_def.summary_hist_bins;
+    for (uint32_t i = 0; i < bins; ++i) {
+        hist[i] += src[i];
+    }
+}
+
+static void cascade_reset(struct jls_core_fsr_cascade_s * c) {
+    jls_core_fsr_entry_reset(&c->accum);
+    c->entries = 0;
+    memset(c->hist, 0, sizeof(c->hist));
+}
+
+static int32_t cascade_add(struct jls_core_fsr_s * self, uint8_t level, const struct jls_core_fsr_entry_s * e,
+                           const double * hist) {
+    if (level >= JLS_SUMMARY_LEVEL_COUNT) {
+        return 0;
+    }
+    struct jls_core_fsr_cascade_s * c = &self->cascade[level];
+    jls_core_fsr_entry_combine(&c->accum, &c->accum, e);
+    if (hist) {
+        hist_add(self, c->hist, hist);
+    }
+    ++c->fed;
+    if (++c->entries < self->parent->signal_def.summary_decimate_factor) {
+        return 0;
+    }
+
+    if (!self->level[level]) {
+        ROE(jls_core_fsr_summary_level_alloc(self, level));
+    }
+    struct jls_core_fsr_level_s * dst = self->level[level];
+    uint32_t entry = dst->summary->header.entry_count + c->pending;
+    if (entry >= dst->summary_entries) {
+        JLS_LOGE("summary cascade overflow: level %d", (int) level);
+        cascade_reset(c);
+        return JLS_ERROR_FULL;
+    }
+    summary_entry_set(self, level, entry, &c->accum, c->hist);
+    ++c->pending;
+    int32_t rc = cascade_add(self, level + 1, &c->accum, c->hist);
+    cascade_reset(c);
+    return rc;
+}
+
+static bool summary_entry_get(struct jls_core_fsr_s * self, uint8_t level, uint32_t entry, uint64_t k,
+        struct jls_core_fsr_entry_s * e, double * hist) {
+    // The inverse of summary_entry_set() for k nominal samples per entry, true if hist was filled.
+    struct jls_core_fsr_level_s * src = self->level[level];
+    bool is_f64 = (summary_entry_size(self) == 64);
+    uint32_t stride = summary_stride(self, level);
+    uint32_t fields_stride = jls_core_fsr_summary_stride(self->parent->signal_def.summary_fields);
+    uint32_t offset = entry * stride;
+    double * src_f64 = ((struct jls_fsr_f64_summary_s *) src->summary)->data[0];
+    float * src_f32 = src->summary->data[0];
+    double v[JLS_SUMMARY_FSR_ENTRY_MAX];
+    for (uint32_t i = 0; i < fields_stride; ++i) {
+        v[i] = is_f64 ? src_f64[offset + i] : (double) src_f32[offset + i];
+    }
+    for (uint32_t i = fields_stride; i < stride; ++i) {
+        hist[i - fields_stride] = is_f64 ? src_f64[offset + i] : (double) src_f32[offset + i];
+    }
+    jls_core_fsr_entry_reset(e);
+    if (isfinite(v[JLS_SUMMARY_FSR_MEAN])) {
+        e->stats.k = k;
+        e->stats.mean = v[JLS_SUMMARY_FSR_MEAN];
+        e->stats.s = v[JLS_SUMMARY_FSR_STD] * v[JLS_SUMMARY_FSR_STD] * (double) k;
+        e->stats.min = v[JLS_SUMMARY_FSR_MIN];
+        e->stats.max = v[JLS_SUMMARY_FSR_MAX];
+        jls_core_fsr_entry_decode(e, self->parent->signal_def.summary_fields, &v[JLS_SUMMARY_FSR_COUNT], 1.0);
+    }
+    return stride > fields_stride;
+}
+
+/// One cached chunk per level for recomputing histograms from the level 0 samples.
+struct hist_src_s {
+    int64_t offset[JLS_SUMMARY_LEVEL_COUNT];
+    uint8_t * index[JLS_SUMMARY_LEVEL_COUNT];      // level >= 1 index payload
+    uint8_t * summary[JLS_SUMMARY_LEVEL_COUNT];    // level >= 1 summary payload
+    double * data_f64;                             // level 0 samples
+    uint32_t data_count;
+};
+
+static void hist_src_free(struct hist_src_s * h) {
+    for (uint8_t level = 0; level < JLS_SUMMARY_LEVEL_COUNT; ++level) {
+        free(h->index[level]);
+        free(h->summary[level]);
+    }
+    free(h->data_f64);
+}
+
+static int32_t hist_src_copy(struct jls_core_s * core, uint8_t tag, uint8_t ** dst) {
+    ROE(jls_core_rd_chunk(core));
+    if (core->chunk_cur.hdr.tag != tag) {
+        JLS_LOGE("histogram rebuild: unexpected tag %d at %" PRIi64, (int) core->chunk_cur.hdr.tag,
+                 core->chunk_cur.offset);
+        return JLS_ERROR_UNSUPPORTED_FILE;
+    }
+    uint8_t * p = realloc(*dst, core->chunk_cur.hdr.payload_length);
+    if (!p) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    memcpy(p, core->buf->start, core->chunk_cur.hdr.payload_length);
+    *dst = p;
+    return 0;
+}
+
+static int32_t hist_src_load(struct jls_core_fsr_s * self, struct hist_src_s * h, uint8_t level, int64_t offset) {
+    // Load the index and summary chunks at offset, or the data chunk for level 0.
+    if (h->offset[level] == offset) {
+        return 0;
+    }
+    struct jls_core_s * core = self->parent->parent;
+    const struct jls_signal_def_s * def = &self->parent->signal_def;
+    h->offset[level] = 0;
+    ROE(jls_raw_chunk_seek(core->raw, offset));
+    if (level) {
+        ROE(hist_src_copy(core, JLS_TAG_TRACK_FSR_INDEX, &h->index[level]));
+        ROE(hist_src_copy(core, JLS_TAG_TRACK_FSR_SUMMARY, &h->summary[level]));  // follows index
+    } else {
+        ROE(jls_core_rd_chunk(core));
+        const struct jls_fsr_data_s * d = (const struct jls_fsr_data_s *) core->buf->start;
+        if ((core->chunk_cur.hdr.tag != JLS_TAG_TRACK_FSR_DATA) || (d->header.entry_count > def->samples_per_data)) {
+            JLS_LOGE("histogram rebuild: invalid data chunk at %" PRIi64, offset);
+            return JLS_ERROR_UNSUPPORTED_FILE;
+        }
+        if (!h->data_f64) {
+            h->data_f64 = malloc(def->samples_per_data * sizeof(double));
+            if (!h->data_f64) {
+                return JLS_ERROR_NOT_ENOUGH_MEMORY;
+            }
+        }
+        jls_dt_buffer_to_f64(&d->data[0], def->data_type, h->data_f64, d->header.entry_count);
+        h->data_count = d->header.entry_count;
+    }
+    h->offset[level] = offset;
+    return 0;
+}
+
+static double summary_mean(struct jls_core_fsr_s * self, const struct jls_fsr_f32_summary_s * s,
+                           uint8_t level, uint32_t entry) {
+    uint32_t offset = entry * summary_stride(self, level) + JLS_SUMMARY_FSR_MEAN;
+    if (summary_entry_size(self) == 64) {
+        return ((const struct jls_fsr_f64_summary_s *) s)->data[0][offset];
+    }
+    return s->data[0][offset];
+}
+
+static int32_t hist_entry(struct jls_core_fsr_s * self, struct hist_src_s * h, uint8_t level,
+                          const struct jls_fsr_index_s * index, const struct jls_fsr_f32_summary_s * summary,
+                          uint32_t entry, double * hist) {
+    // Add the level 0 samples of a summary entry to hist, descending through the stored indices.
+    const struct jls_signal_def_s * def = &self->parent->signal_def;
+    uint32_t decimate = (level == 1) ? def->sample_decimate_factor : def->summary_decimate_factor;
+    uint32_t per_chunk = ((level == 1) ? def->samples_per_data : def->entries_per_summary) / decimate;
+    uint32_t chunk = entry / per_chunk;
+    uint32_t start = (entry % per_chunk) * decimate;
+    uint32_t end = start + decimate;
+    if (chunk >= index->header.entry_count) {
+        JLS_LOGE("histogram rebuild: level %d entry %" PRIu32 " not indexed", (int) level, entry);
+        return JLS_ERROR_UNSUPPORTED_FILE;
+    }
+    int64_t offset = index->offsets[chunk];
+
+    if (level == 1) {
+        if (!offset) {
+            // omitted constant chunk, fully described by its mean
+            double v = summary_mean(self, summary, 1, entry);
+            if (isfinite(v)) {
+                hist[jls_core_fsr_hist_bin(def, v)] += (double) decimate;
+            }
+            return 0;
+        }
+        ROE(hist_src_load(self, h, 0, offset));
+        end = (end < h->data_count) ? end : h->data_count;
+        for (uint32_t i = start; i < end; ++i) {
+            double v = h->data_f64[i];
+            if (isfinite(v)) {
+                hist[jls_core_fsr_hist_bin(def, v)] += 1.0;
+            }
+        }
+        return 0;
     }
 
+    ROE(hist_src_load(self, h, level - 1, offset));
+    const struct jls_fsr_index_s * child_index = (const struct jls_fsr_index_s *) h->index[level - 1];
+    const struct jls_fsr_f32_summary_s * child_summary = (const struct jls_fsr_f32_summary_s *) h->summary[level - 1];
+    end = (end < child_summary->header.entry_count) ? end : child_summary->header.entry_count;
+    for (uint32_t i = start; i < end; ++i) {
+        ROE(hist_entry(self, h, level - 1, child_index, child_summary, i, hist));
+    }
+    return 0;
+}
+
+static int32_t cascade_replay(struct jls_core_fsr_s * self, uint8_t level) {
+    // Rebuild from the stored level - 1 summaries that bypassed the cascade, such as on repair and append.
+    struct jls_core_s * core = self->parent->parent;
+    struct jls_core_fsr_level_s * src = self->level[level - 1];
+    uint64_t k = self->parent->signal_def.sample_decimate_factor;  // nominal samples per src entry
+    for (uint8_t lvl = 2; lvl < level; ++lvl) {
+        k *= self->parent->signal_def.summary_decimate_factor;
+    }
+    // Levels below summary_hist_level store no histograms, so recompute them from the samples.
+    uint32_t fields_stride = jls_core_fsr_summary_stride(self->parent->signal_def.summary_fields);
+    bool rebuild = (summary_stride(self, level) > fields_stride) && (summary_stride(self, level - 1) == fields_stride);
+    struct hist_src_s h;
+    memset(&h, 0, sizeof(h));
+    int64_t pos = jls_raw_chunk_tell(core->raw);
+
+    int32_t rc = 0;
+    double hist[JLS_SUMMARY_HIST_BINS_MAX];
+    for (uint32_t idx = 0; !rc && (idx < src->summary->header.entry_count); ++idx) {
+        struct jls_core_fsr_entry_s e;
+        bool has_hist = summary_entry_get(self, level - 1, idx, k, &e, hist);
+        if (rebuild) {
+            memset(hist, 0, sizeof(hist));
+            rc = hist_entry(self, &h, level - 1, src->index, src->summary, idx, hist);
+            has_hist = true;
+        }
+        if (!rc) {
+            rc = cascade_add(self, level, &e, has_hist ? hist : NULL);
+        }
+    }
+    hist_src_free(&h);
+    if (rebuild) {
+        int32_t rc_seek = jls_raw_chunk_seek(core->raw, pos);  // restore the write position
+        rc = rc ? rc : rc_seek;
+    }
+    return rc;
+}
 
 int32_t jls_core_fsr_summaryN(struct jls_core_fsr_s * self, uint8_t level, int64_t pos) {
-    if (level < 2) {
+    if ((level < 2) || (level >= JLS_SUMMARY_LEVEL_COUNT)) {
         JLS_LOGE("invalid jls_core_fsr_summaryN level: %d", (int) level);
         return JLS_ERROR_PARAMETER_INVALID;
     }
     struct jls_core_fsr_level_s * src = self->level[level - 1];
     struct jls_core_fsr_level_s * dst = self->level[level];
+    struct jls_core_fsr_cascade_s * c = &self->cascade[level];
 
     if (!dst) {
         ROE(jls_core_fsr_summary_level_alloc(self, level));
@@ -355,13 +570,17 @@ int32_t jls_core_fsr_summaryN(struct jls_core_fsr_s * self, uint8_t level, int64
     }
     dst->index->offsets[dst->index->header.entry_count++] = pos;
 
-    uint32_t summaries_per = (uint32_t) (src->summary->header.entry_count / self->parent->signal_def.summary_decimate_factor);
-    if (summary_entry_size(self) == 64) {
-        double * src_data = ((struct jls_fsr_f64_summary_s *) src->summary)->data[0];
-        SUMMARYN_BODY_TEMPLATE();
-    } else {
-        float * src_data = src->summary->data[0];
-        SUMMARYN_BODY_TEMPLATE();
+    struct jls_stats_s * stats = self->parent->parent->stats;
+    int64_t t_start = stats ? jls_time_rel() : 0;
+    if (!c->fed) {
+        ROE(cascade_replay(self, level));
+    }
+    cascade_reset(c);  // discard incomplete entry, only possible on close
+    dst->summary->header.entry_count += c->pending;
+    c->pending = 0;
+    c->fed = 0;
+    if (stats) {
+        stats->summary_time += jls_time_rel() - t_start;
     }
 
     if (dst->summary->header.entry_count >= dst->summary_entries) {
@@ -370,6 +589,223 @@ int32_t jls_core_fsr_summaryN(struct jls_core_fsr_s * self, uint8_t level, int64
     return 0;
 }
 
+static int32_t append_copy(struct jls_core_s * core, void * dst, size_t dst_size) {
+    if (core->chunk_cur.hdr.payload_length > dst_size) {
+        JLS_LOGE("append: chunk at %" PRIi64 " too big", core->chunk_cur.offset);
+        return JLS_ERROR_NOT_SUPPORTED;
+    }
+    memcpy(dst, core->buf->start, core->chunk_cur.hdr.payload_length);
+    return 0;
+}
+
+static int32_t append_level(struct jls_core_fsr_s * self, uint8_t level, int64_t * offset,
+                            int64_t * truncate, bool * stale) {
+    // Load the tail index and summary.  Partial chunks were written on close.
+    struct jls_core_s * core = self->parent->parent;
+    struct jls_core_track_s * track = &self->parent->tracks[JLS_TRACK_TYPE_FSR];
+    if (!self->level[level]) {
+        ROE(jls_core_fsr_summary_level_alloc(self, level));
+    }
+    struct jls_core_fsr_level_s * dst = self->level[level];
+    size_t index_sz = sizeof(struct jls_fsr_index_s) + dst->index_entries * sizeof(int64_t);
+    size_t summary_sz = sizeof(struct jls_fsr_f32_summary_s)
+            + (dst->summary_entries * dst->summary->header.entry_size_bits) / 8;
+
+    ROE(jls_core_rd_chunk_tail(core, *offset, JLS_TAG_TRACK_FSR_INDEX));
+    ROE(append_copy(core, dst->index, index_sz));
+    struct jls_core_chunk_s index = core->chunk_cur;
+    ROE(jls_core_rd_chunk_tail(core, 0, JLS_TAG_TRACK_FSR_SUMMARY));  // follows index
+    ROE(append_copy(core, dst->summary, summary_sz));
+    struct jls_core_chunk_s summary = core->chunk_cur;
+    if (!dst->index->header.entry_count) {
+        JLS_LOGE("append: empty index at %" PRIi64, index.offset);
+        return JLS_ERROR_NOT_SUPPORTED;
+    }
+    *offset = dst->index->offsets[dst->index->header.entry_count - 1];
+
+    *stale = dst->summary->header.entry_count < dst->summary_entries;
+    if (*stale) {
+        *truncate = (index.offset < *truncate) ? index.offset : *truncate;
+        ROE(jls_core_rd_chunk_header(core, index.hdr.item_prev, &track->index_head[level]));
+        ROE(jls_core_rd_chunk_header(core, summary.hdr.item_prev, &track->summary_head[level]));
+    } else {
+        track->index_head[level] = index;
+        track->summary_head[level] = summary;
+    }
+    return 0;
+}
+
+static int32_t append_data(struct jls_core_fsr_s * self, int64_t offset, int64_t * truncate, bool * indexed) {
+    // Load the tail data chunk, which is partial when written on close.
+    struct jls_core_s * core = self->parent->parent;
+    const struct jls_signal_def_s * def = &self->parent->signal_def;
+    struct jls_core_track_s * track = &self->parent->tracks[JLS_TRACK_TYPE_FSR];
+    struct jls_fsr_index_s * idx1 = self->level[1]->index;
+    ROE(jls_core_fsr_sample_buffer_alloc(self));
+    self->data->header.timestamp = idx1->header.timestamp + idx1->header.entry_count * (int64_t) def->samples_per_data;
+
+    struct jls_core_chunk_s chunk;
+    chunk.offset = offset;
+    for (uint32_t i = idx1->header.entry_count; !chunk.offset && i; --i) {
+        chunk.offset = idx1->offsets[i - 1];  // skip omitted chunks
+    }
+    if (!chunk.offset) {
+        chunk.offset = track->head_offsets[0];
+    }
+    ROE(jls_core_list_tail(core, &chunk));
+    ROE(jls_core_rd_chunk_tail(core, chunk.offset, JLS_TAG_TRACK_FSR_DATA));
+    track->data_head = core->chunk_cur;
+    struct jls_fsr_data_s * r = (struct jls_fsr_data_s *) core->buf->start;
+    if (r->header.entry_count < def->samples_per_data) {
+        size_t data_sz = sizeof(struct jls_payload_header_s) + (sample_size_bits(self) * def->samples_per_data) / 8;
+        ROE(append_copy(core, self->data, data_sz));
+        *indexed = (chunk.offset == offset);  // else closed without a level 1 summary
+        *truncate = (chunk.offset < *truncate) ? chunk.offset : *truncate;
+        ROE(jls_core_rd_chunk_header(core, track->data_head.hdr.item_prev, &track->data_head));
+    }
+    return 0;
+}
+
+int32_t jls_fsr_append(struct jls_core_fsr_s * self, int64_t * truncate) {
+    struct jls_core_signal_s * info = self->parent;
+    struct jls_core_s * core = info->parent;
+    const struct jls_signal_def_s * def = &info->signal_def;
+    struct jls_core_track_s * track = &info->tracks[JLS_TRACK_TYPE_FSR];
+    bool stale[JLS_SUMMARY_LEVEL_COUNT];    // tail chunk is partial, written on close
+    bool indexed[JLS_SUMMARY_LEVEL_COUNT];  // partial tail chunk is in the level above index
+    memset(stale, 0, sizeof(stale));
+    memset(indexed, 0, sizeof(indexed));
+
+    if (!track->head_offsets[0]) {
+        return 0;  // no sample data, start on the first write
+    }
+    uint8_t level_top = JLS_SUMMARY_LEVEL_COUNT - 1;
+    while ((level_top > 0) && !track->head_offsets[level_top]) {
+        --level_top;
+    }
+    if (!level_top) {
+        JLS_LOGE("append: signal %d has data but no index", (int) def->signal_id);
+        return JLS_ERROR_NOT_SUPPORTED;
+    }
+    self->sample_id_offset = def->sample_id_offset;
+
+    // Each tail index references the lower level tail, unless close skipped an empty summary.
+    struct jls_core_chunk_s chunk;
+    chunk.offset = track->head_offsets[level_top];
+    for (uint8_t level = level_top; level > 0; --level) {
+        int64_t offset_ref = chunk.offset;
+        ROE(jls_core_list_tail(core, &chunk));
+        indexed[level] = (level < level_top) && (chunk.offset == offset_ref);
+        ROE(append_level(self, level, &chunk.offset, truncate, &stale[level]));
+        indexed[level] &= stale[level];
+    }
+    ROE(append_data(self, chunk.offset, truncate, &indexed[0]));
+
+    // Remove the contributions of the chunks written on close.
+    uint32_t entries_per_data = def->samples_per_data / def->sample_decimate_factor;
+    for (uint8_t level = 1; level <= level_top; ++level) {
+        struct jls_core_fsr_level_s * dst = self->level[level];
+        if (dst->summary->header.entry_count >= dst->summary_entries) {
+            if (indexed[level - 1]) {
+                JLS_LOGE("append: signal %d level %d not written on close", (int) def->signal_id, (int) level);
+                return JLS_ERROR_NOT_SUPPORTED;
+            }
+            dst->index->header.entry_count = 0;
+            dst->summary->header.entry_count = 0;
+            continue;
+        }
+        if (indexed[level - 1]) {
+            --dst->index->header.entry_count;  // references the lower level chunk written on close
+        }
+        uint32_t entries = (level == 1) ? entries_per_data : (def->entries_per_summary / def->summary_decimate_factor);
+        dst->summary->header.entry_count = dst->index->header.entry_count * entries;
+    }
+
+    // Rebuild the pending upper level entries from the stored summaries, oldest first.
+    for (uint8_t level = level_top; level >= 2; --level) {
+        if (self->level[level - 1]->summary->header.entry_count) {
+            ROE(cascade_replay(self, level));
+        }
+    }
+    return 0;
+}
+
+static inline uint32_t level_mask(struct jls_core_fsr_s * self) {
+    uint32_t mask = 0;
+    for (uint8_t level = 1; level < JLS_SUMMARY_LEVEL_COUNT; ++level) {
+        if (self->level[level]) {
+            mask |= 1U << level;
+        }
+    }
+    return mask;
+}
+
+int32_t jls_fsr_checkpoint(struct jls_core_fsr_s * self, struct jls_buf_s * buf) {
+    uint32_t levels = level_mask(self);
+    ROE(jls_buf_wr_i64(buf, self->sample_id_offset));
+    ROE(jls_buf_wr_i64(buf, self->data ? self->data->header.timestamp : self->sample_id_offset));
+    ROE(jls_buf_wr_u32(buf, levels));
+    ROE(jls_buf_wr_u32(buf, (uint32_t) sizeof(struct jls_core_fsr_cascade_s)));
+    for (uint8_t level = 1; level < JLS_SUMMARY_LEVEL_COUNT; ++level) {
+        struct jls_core_fsr_cascade_s * c = &self->cascade[level];
+        if (levels & (1U << (level - 1))) {
+            ROE(jls_buf_wr_bin(buf, c, (uint32_t) sizeof(*c)));  // fed by level - 1
+        }
+        struct jls_core_fsr_level_s * dst = self->level[level];
+        if (!dst) {
+            continue;
+        }
+        uint32_t index_sz = (uint32_t) (sizeof(dst->index->header) + dst->index->header.entry_count * sizeof(int64_t));
+        uint32_t entries = dst->summary->header.entry_count + c->pending;
+        uint32_t summary_sz = (uint32_t) (sizeof(dst->summary->header)
+                + ((uint64_t) entries * dst->summary->header.entry_size_bits) / 8);
+        ROE(jls_buf_wr_bin(buf, dst->index, index_sz));
+        ROE(jls_buf_wr_bin(buf, dst->summary, summary_sz));
+    }
+    return 0;
+}
+
+int32_t jls_fsr_restore(struct jls_core_fsr_s * self, struct jls_buf_s * buf) {
+    int64_t timestamp = 0;
+    uint32_t levels = 0;
+    uint32_t cascade_sz = 0;
+    ROE(jls_buf_rd_i64(buf, &self->sample_id_offset));
+    ROE(jls_buf_rd_i64(buf, &timestamp));
+    ROE(jls_buf_rd_u32(buf, &levels));
+    ROE(jls_buf_rd_u32(buf, &cascade_sz));
+    if ((cascade_sz != sizeof(struct jls_core_fsr_cascade_s)) || (levels & 1)) {
+        JLS_LOGW("checkpoint: signal %d state not supported", (int) self->parent->signal_def.signal_id);
+        return JLS_ERROR_UNSUPPORTED_FILE;
+    }
+    ROE(jls_core_fsr_sample_buffer_alloc(self));
+    self->data->header.timestamp = timestamp;
+
+    for (uint8_t level = 1; level < JLS_SUMMARY_LEVEL_COUNT; ++level) {
+        struct jls_core_fsr_cascade_s * c = &self->cascade[level];
+        if (levels & (1U << (level - 1))) {
+            ROE(jls_buf_rd_bin(buf, c, (uint32_t) sizeof(*c)));
+        }
+        if (!(levels & (1U << level))) {
+            continue;
+        }
+        ROE(jls_core_fsr_summary_level_alloc(self, level));
+        struct jls_core_fsr_level_s * dst = self->level[level];
+        uint16_t entry_size_bits = dst->summary->header.entry_size_bits;
+        ROE(jls_buf_rd_bin(buf, dst->index, (uint32_t) sizeof(dst->index->header)));
+        if (dst->index->header.entry_count > dst->index_entries) {
+            return JLS_ERROR_UNSUPPORTED_FILE;
+        }
+        ROE(jls_buf_rd_bin(buf, dst->index->offsets, dst->index->header.entry_count * (uint32_t) sizeof(int64_t)));
+        ROE(jls_buf_rd_bin(buf, dst->summary, (uint32_t) sizeof(dst->summary->header)));
+        uint32_t entries = dst->summary->header.entry_count + c->pending;
+        if ((dst->summary->header.entry_size_bits != entry_size_bits) || (entries > dst->summary_entries)) {
+            return JLS_ERROR_UNSUPPORTED_FILE;
+        }
+        ROE(jls_buf_rd_bin(buf, dst->summary->data, (uint32_t) (((uint64_t) entries * entry_size_bits) / 8)));
+    }
+    return 0;
+}
+
 static void data_to_f64(struct jls_core_fsr_s * self) {
     void * src = &self->data->data[0];
     double * dst = self->data_f64;
@@ -377,36 +813,49 @@ static void data_to_f64(struct jls_core_fsr_s * self) {
     jls_dt_buffer_to_f64(src, self->parent->signal_def.data_type, dst, count);
 }
 
-int32_t jls_core_fsr_summary1(struct jls_core_fsr_s * self, int64_t pos) {
+static int32_t summary1_index_add(struct jls_core_fsr_s * self, int64_t pos) {
     struct jls_core_fsr_level_s * dst = self->level[1];
-
     if (!dst) {
         ROE(jls_core_fsr_summary_level_alloc(self, 1));
         dst = self->level[1];
     }
-    data_to_f64(self);
-
-    double * data = self->data_f64;
     // JLS_LOGI("1 add %" PRIi64 " @ %" PRIi64 " %p", pos, dst->index->offset, &dst->index->data[dst->index->offset]);
     if (0 == dst->index->header.entry_count) {
         dst->index->header.timestamp = self->data->header.timestamp;
         dst->summary->header.timestamp = self->data->header.timestamp;
     }
     dst->index->offsets[dst->index->header.entry_count++] = pos;
+    return 0;
+}
+
+int32_t jls_core_fsr_summary1(struct jls_core_fsr_s * self, int64_t pos) {
+    ROE(summary1_index_add(self, pos));
+    struct jls_core_fsr_level_s * dst = self->level[1];
+    struct jls_stats_s * stats = self->parent->parent->stats;
+    int64_t t_start = stats ? jls_time_rel() : 0;
+    data_to_f64(self);
 
+    double * data = self->data_f64;
+
+    const struct jls_signal_def_s * signal_def = &self->parent->signal_def;
+    double * hist = signal_def->summary_hist_bins ? self->cascade[1].hist : NULL;
     uint32_t summaries_per = (uint32_t) (self->data->header.entry_count / self->parent->signal_def.sample_decimate_factor);
     for (uint32_t idx = 0; idx < summaries_per; ++idx) {
         uint32_t sample_idx = idx * self->parent->signal_def.sample_decimate_factor;
-        uint32_t count = 0;
-        double v_mean = 0.0;
+        struct jls_core_fsr_entry_s entry;
+        jls_core_fsr_entry_reset(&entry);
+        if (hist) {
+            memset(hist, 0, signal_def->summary_hist_bins * sizeof(double));
+        }
         double v_min = DBL_MAX;
         double v_max = -DBL_MAX;
-        double v_var = 0.0;
         for (uint32_t sample = 0; sample < self->parent->signal_def.sample_decimate_factor; ++sample) {
             double v = data[sample_idx];
             if (isfinite(v)) {
-                ++count;
-                v_mean += v;
+                jls_core_fsr_entry_add(&entry, v);
+                if (hist) {
+                    hist[jls_core_fsr_hist_bin(signal_def, v)] += 1.0;
+                }
                 if (v < v_min) {
                     v_min = v;
                 }
@@ -416,29 +865,28 @@ int32_t jls_core_fsr_summary1(struct jls_core_fsr_s * self, int64_t pos) {
             }
             ++sample_idx;
         }
-        if (count == 0) {
-            v_mean = NAN;
-            v_min = NAN;
-            v_max = NAN;
-            v_var = NAN;
-        } else {
-            v_mean /= count;
+        entry.stats.min = v_min;
+        entry.stats.max = v_max;
+        if (entry.stats.k) {
+            double v_mean = (entry.sum + entry.sum_c) / entry.stats.k;
+            double v_m2 = 0.0;
             sample_idx = idx * self->parent->signal_def.sample_decimate_factor;
             for (uint32_t sample = 0; sample < self->parent->signal_def.sample_decimate_factor; ++sample) {
                 double v = data[sample_idx];
                 if (isfinite(v)) {
                     v -= v_mean;
-                    v_var += v * v;
+                    v_m2 += v * v;
                 }
                 ++sample_idx;
             }
-            if (count == 1) {
-                v_var = 0.0;
-            } else {
-                v_var /= count;
-            }
+            entry.stats.mean = v_mean;
+            entry.stats.s = v_m2;
         }
-        summary_entry_add(self, 1, v_mean, v_min, v_max, v_var);
+        summary_entry_set(self, 1, dst->summary->header.entry_count++, &entry, hist);
+        ROE(cascade_add(self, 2, &entry, hist));
+    }
+    if (stats) {
+        stats->summary_time += jls_time_rel() - t_start;
     }
 
     if (dst->summary->header.entry_count >= dst->summary_entries) {
@@ -447,55 +895,104 @@ int32_t jls_core_fsr_summary1(struct jls_core_fsr_s * self, int64_t pos) {
     return 0;
 }
 
-static int32_t wr_data_inner(struct jls_core_fsr_s * self, const void * data, uint32_t data_length) {
+static void gap_entry(struct jls_core_fsr_s * self, struct jls_core_fsr_entry_s * entry, double * hist) {
+    // The level 1 entry for sample_decimate_factor skip fill samples, matching jls_core_fsr_summary1().
+    const struct jls_signal_def_s * signal_def = &self->parent->signal_def;
+    uint32_t data_type = signal_def->data_type;
+    jls_core_fsr_entry_reset(entry);
+    entry->stats.min = DBL_MAX;
+    entry->stats.max = -DBL_MAX;
+    if (hist) {
+        memset(hist, 0, signal_def->summary_hist_bins * sizeof(double));
+    }
+    if ((data_type == JLS_DATATYPE_F32) || (data_type == JLS_DATATYPE_F64)) {
+        return;  // NaN fill, no finite samples
+    }
+    for (uint32_t sample = 0; sample < signal_def->sample_decimate_factor; ++sample) {
+        jls_core_fsr_entry_add(entry, 0.0);
+    }
+    if (hist) {
+        hist[jls_core_fsr_hist_bin(signal_def, 0.0)] = (double) signal_def->sample_decimate_factor;
+    }
+    entry->stats.min = 0.0;
+    entry->stats.max = 0.0;
+    entry->stats.mean = 0.0;
+    entry->stats.s = 0.0;
+}
+
+static bool gap_supported(uint32_t data_type) {
+    // Readers before 0.16 only reconstruct omitted chunks for these types.
+    switch (data_type) {
+        case JLS_DATATYPE_F32:  // fall through
+        case JLS_DATATYPE_F64:  // fall through
+        case JLS_DATATYPE_U8:   // fall through
+        case JLS_DATATYPE_U4:   // fall through
+        case JLS_DATATYPE_U1:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static int32_t wr_gap(struct jls_core_fsr_s * self, int64_t chunks) {
+    // Skip whole data chunks as omitted chunks, reconstructed on read from the level 1 summary.
+    const struct jls_signal_def_s * signal_def = &self->parent->signal_def;
+    struct jls_stats_s * stats = self->parent->parent->stats;
+    int64_t t_start = stats ? jls_time_rel() : 0;
+    struct jls_core_fsr_entry_s entry;
+    double * hist = signal_def->summary_hist_bins ? self->cascade[1].hist : NULL;
+    uint32_t summaries_per = signal_def->samples_per_data / signal_def->sample_decimate_factor;
+    gap_entry(self, &entry, hist);
+
+    for (int64_t chunk = 0; chunk < chunks; ++chunk) {
+        ROE(summary1_index_add(self, 0));
+        struct jls_core_fsr_level_s * dst = self->level[1];
+        for (uint32_t idx = 0; idx < summaries_per; ++idx) {
+            summary_entry_set(self, 1, dst->summary->header.entry_count++, &entry, hist);
+            ROE(cascade_add(self, 2, &entry, hist));
+        }
+        if (dst->summary->header.entry_count >= dst->summary_entries) {
+            ROE(wr_summary(self, 1));
+        }
+        self->data->header.timestamp += signal_def->samples_per_data;
+    }
+    if (stats) {
+        stats->summary_time += jls_time_rel() - t_start;
+    }
+    return 0;
+}
+
+static int32_t wr_data_inner(struct jls_core_fsr_s * self, const void * data, size_t src_bit, uint32_t data_length) {
+    // Copy data_length samples starting at bit src_bit of data into the data chunks.
     struct jls_fsr_data_s * b = self->data;
     uint8_t sample_size_bits = jls_datatype_parse_size(self->parent->signal_def.data_type);
-    const uint8_t * src_u8 = (const uint8_t *) (data);
-    uint8_t * dst_u8;
-    uint8_t shift_this = (data_length * sample_size_bits) % 8;
-    uint8_t shift_amount_next = (shift_this + self->shift_amount) % 8;
 
     while (data_length) {
-        dst_u8 = (uint8_t *) &b->data[0];
-        dst_u8 += (b->header.entry_count * sample_size_bits) / 8;
         uint32_t length = (uint32_t) (self->data_length - b->header.entry_count);
         if (data_length < length) {
             length = data_length;
         }
-        if (self->shift_amount) {
-            uint8_t mask = (1 << self->shift_amount) - 1;
-            uint32_t bits = length * sample_size_bits + self->shift_amount;
-            while (bits) {
-                uint16_t v = (self->shift_buffer & mask) | (((uint16_t) (*src_u8++)) << self->shift_amount);
-                if (bits >= 8) {
-                    *dst_u8++ = (uint8_t) v;
-                    bits -= 8;
-                    self->shift_buffer = (uint8_t) (v >> 8);
-                } else {
-                    self->shift_buffer = (uint8_t) v;
-                    break;
-                }
-            }
+        size_t dst_bit = (size_t) b->header.entry_count * sample_size_bits;
+        size_t bits = (size_t) length * sample_size_bits;
+        if ((src_bit | dst_bit | bits) & 7) {
+            // sub-byte samples, the data buffer holds any trailing partial byte
+            jls_bit_copy_offset(&b->data[0], dst_bit, data, src_bit, bits);
         } else {
-            size_t byte_length = (length * sample_size_bits) / 8;
-            if (byte_length) {
-                memcpy(dst_u8, src_u8, byte_length);
-            }
-            self->shift_buffer = src_u8[byte_length];
-            src_u8 += byte_length;
+            memcpy((uint8_t *) &b->data[0] + dst_bit / 8, (const uint8_t *) data + src_bit / 8, bits / 8);
         }
+        src_bit += bits;
         b->header.entry_count += length;
         data_length -= length;
         if (b->header.entry_count >= self->data_length) {
             ROE(wr_data(self));
         }
     }
-    self->shift_amount = shift_amount_next;
     return 0;
 }
 
 int32_t jls_wr_fsr_data(struct jls_core_fsr_s * self, int64_t sample_id, const void * data, uint32_t data_length) {
     uint8_t sample_size_bits = jls_datatype_parse_size(self->parent->signal_def.data_type);
+    size_t src_bit = 0;
 
     if (0 == data_length) {
         return 0;
@@ -517,56 +1014,21 @@ int32_t jls_wr_fsr_data(struct jls_core_fsr_s * self, int64_t sample_id, const v
         if ((sample_id + data_length) <= sample_id_next) {
             return 0;
         }
-        const uint8_t * data_u8 = (const uint8_t *) data;
-        const uint8_t * data_end_u8 = data_u8 + (data_length * sample_size_bits + 7) / 8;
         uint32_t ffwd = (uint32_t) (sample_id_next - sample_id);
         data_length -= ffwd;
-        if (sample_size_bits >= 8) {
-            data = data_u8 + ffwd * (sample_size_bits / 8);
-        } else {
-            uint32_t shift = 0;
-            uint32_t shift_samples = 0;
-            if (sample_size_bits == 4) {
-                shift = (ffwd & 1) ? 4 : 0;
-                shift_samples = 1;
-            } else if (sample_size_bits == 1) {
-                shift = ffwd % sample_size_bits;
-                shift_samples = shift;
-            }
-            if (shift == 0) {
-                data = data_u8 + ffwd * (sample_size_bits / 8);
-            } else {
-                while (data_u8 < data_end_u8) {
-                    size_t sz = data_end_u8 - data_u8;
-                    if (sz > (sizeof(self->buffer_u64) - 8)) {
-                        sz = sizeof(self->buffer_u64) - 8;
-                    }
-                    memcpy(self->buffer_u64, data_u8, sz);
-                    self->buffer_u64[(sz / 8) + 1] = 0;
-                    size_t sz_words = (sz + 7) / 8;
-                    for (uint64_t idx = 0; idx < sz_words; ++idx) {
-                        self->buffer_u64[idx] = (self->buffer_u64[idx] >> shift)
-                                | (self->buffer_u64[idx + 1] << (64 - shift));
-                    }
-                    size_t entries = sz * (8 / sample_size_bits) - shift_samples;
-                    ROE(wr_data_inner(self, self->buffer_u64, (uint32_t) entries));
-                    data_u8 += sz - 1;
-                }
-                return 0;
-            }
-        }
+        src_bit = (size_t) ffwd * sample_size_bits;  // sub-byte samples copy directly from the bit offset
     } else {
         JLS_LOGW("fsr %d skip: in=%" PRIi64 " expect=%" PRIi64 ", skipped=%" PRIi64,
                  self->parent->signal_def.signal_id,
                  sample_id, sample_id_next,
                  sample_id - sample_id_next);
-        size_t skip = (size_t) (sample_id - sample_id_next);
-        size_t buf_sz = 0;
+        int64_t skip = sample_id - sample_id_next;
+        int64_t buf_sz = 0;
         if (self->parent->signal_def.data_type == JLS_DATATYPE_F32) {
             float * f32 = (float *) self->buffer_u64;
             buf_sz = sizeof(self->buffer_u64);
             buf_sz /= sizeof(float);
-            for (size_t idx = 0; idx < buf_sz; ++idx) {
+            for (int64_t idx = 0; idx < buf_sz; ++idx) {
                 f32[idx] = NAN;
             }
         } else if (self->parent->signal_def.data_type == JLS_DATATYPE_F64) {
@@ -576,17 +1038,84 @@ int32_t jls_wr_fsr_data(struct jls_core_fsr_s * self, int64_t sample_id, const v
                 f64[idx] = NAN;
             }
         } else {
-            buf_sz = (sizeof(self->buffer_u64) * sample_size_bits) / 8;
+            buf_sz = ((sizeof(self->buffer_u64) - 8) * 8) / sample_size_bits;
             memset(self->buffer_u64, 0, sizeof(self->buffer_u64));
         }
+        int64_t samples_per_data = self->data_length;
+        int64_t fill = (samples_per_data - b->header.entry_count) % samples_per_data;  // to chunk boundary
+        if (fill > skip) {
+            fill = skip;
+        }
+        skip -= fill;
+        while (fill) {
+            int64_t sz = (fill < buf_sz) ? fill : buf_sz;
+            ROE(wr_data_inner(self, self->buffer_u64, 0, (uint32_t) sz));
+            fill -= sz;
+        }
+        struct jls_core_track_s * track = &self->parent->tracks[JLS_TRACK_TYPE_FSR];
+        if ((skip >= samples_per_data) && (0 != track->data_head.offset)
+                && gap_supported(self->parent->signal_def.data_type)) {
+            ROE(wr_gap(self, skip / samples_per_data));
+            skip %= samples_per_data;
+        }
         while (skip) {
-            if (skip < buf_sz) {
-                buf_sz = skip;
-            }
-            ROE(wr_data_inner(self, self->buffer_u64, (uint32_t) buf_sz));
-            skip -= buf_sz;
+            int64_t sz = (skip < buf_sz) ? skip : buf_sz;
+            ROE(wr_data_inner(self, self->buffer_u64, 0, (uint32_t) sz));
+            skip -= sz;
         }
     }
 
-    return wr_data_inner(self, data, data_length);
+    return wr_data_inner(self, data, src_bit, data_length);
+}
+
+int32_t jls_wr_fsr_data_chunk(struct jls_core_fsr_s * self, int64_t sample_id,
+                              const struct jls_fsr_data_s * data, const void * summary) {
+    const struct jls_signal_def_s * signal_def = &self->parent->signal_def;
+    uint32_t samples_per_data = signal_def->samples_per_data;
+    if ((data->header.entry_count != samples_per_data) || (data->header.entry_size_bits != sample_size_bits(self))) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    if (!self->data) {
+        ROE(jls_core_fsr_sample_buffer_alloc(self));
+        self->sample_id_offset = sample_id;  // can be nonzero
+        self->data->header.timestamp = sample_id;
+    }
+    struct jls_fsr_data_s * b = self->data;
+    if (b->header.entry_count || (b->header.timestamp != sample_id)) {
+        return JLS_ERROR_NOT_SUPPORTED;  // must start on a chunk boundary with no pending samples
+    }
+    uint32_t data_length = (samples_per_data * sample_size_bits(self)) / 8;
+    memcpy(b->data, data->data, data_length);
+    b->header.entry_count = samples_per_data;
+    uint32_t fields_stride = jls_core_fsr_summary_stride(signal_def->summary_fields);
+    if (signal_def->summary_hist_bins && (summary_stride(self, 1) == fields_stride)) {
+        // level 1 omits the histogram needed by higher levels, recompute from the samples
+        return wr_data(self);
+    }
+
+    int64_t pos = jls_raw_chunk_tell(self->parent->parent->raw);
+    ROE(jls_core_wr_data(self->parent->parent, signal_def->signal_id, JLS_TRACK_TYPE_FSR,
+                         (const uint8_t *) b, (uint32_t) sizeof(struct jls_fsr_data_s) + data_length));
+    ROE(summary1_index_add(self, pos));
+
+    // copy the level 1 entries verbatim, then feed them to the higher levels
+    struct jls_core_fsr_level_s * dst = self->level[1];
+    uint32_t entries = samples_per_data / signal_def->sample_decimate_factor;
+    uint32_t entry_bytes = dst->summary->header.entry_size_bits / 8;
+    uint8_t * p = ((uint8_t *) dst->summary->data) + dst->summary->header.entry_count * entry_bytes;
+    memcpy(p, summary, entries * entry_bytes);
+    double hist[JLS_SUMMARY_HIST_BINS_MAX];
+    for (uint32_t idx = 0; idx < entries; ++idx) {
+        struct jls_core_fsr_entry_s e;
+        bool has_hist = summary_entry_get(self, 1, dst->summary->header.entry_count++,
+                                          signal_def->sample_decimate_factor, &e, hist);
+        ROE(cascade_add(self, 2, &e, has_hist ? hist : NULL));
+    }
+    if (dst->summary->header.entry_count >= dst->summary_entries) {
+        ROE(wr_summary(self, 1));
+    }
+    b->header.timestamp += samples_per_data;
+    b->header.entry_count = 0;
+    self->write_omit_data = (self->write_omit_data << 1) | (self->write_omit_data & 1);
+    return 0;
 }
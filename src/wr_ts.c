@@ -204,6 +204,114 @@ int32_t jls_wr_ts_close(struct jls_core_ts_s * self) {
     return 0;
 }
 
+int32_t jls_wr_ts_append(struct jls_core_ts_s * self, int64_t * truncate) {
+    struct jls_core_s * core = self->parent->parent;
+    struct jls_core_track_s * track = &self->parent->tracks[self->track_type];
+    if (!track->head_offsets[0]) {
+        return 0;  // no entries
+    }
+    uint8_t level_top = JLS_SUMMARY_LEVEL_COUNT - 1;
+    while ((level_top > 0) && !track->head_offsets[level_top]) {
+        --level_top;
+    }
+    if (!level_top) {
+        JLS_LOGE("append: track %d has data but no index", (int) self->track_type);
+        return JLS_ERROR_NOT_SUPPORTED;
+    }
+
+    struct jls_core_chunk_s chunk;
+    chunk.offset = track->head_offsets[level_top];
+    for (uint8_t level = level_top; level > 0; --level) {
+        ROE(jls_core_list_tail(core, &chunk));
+        ROE(jls_core_rd_chunk_tail(core, chunk.offset, JLS_TRACK_TAG_PACK(self->track_type, JLS_TRACK_CHUNK_INDEX)));
+        struct jls_core_chunk_s index_chunk = core->chunk_cur;
+        struct jls_index_s * index = (struct jls_index_s *) core->buf->start;
+        uint32_t index_count = index->header.entry_count;
+        if (!index_count || (index_count > self->decimate_factor)) {
+            JLS_LOGE("append: invalid index at %" PRIi64, index_chunk.offset);
+            return JLS_ERROR_NOT_SUPPORTED;
+        }
+        chunk.offset = (int64_t) index->entries[index_count - 1].offset;
+
+        // Chunks committed on close are partial, with an index entry but no summary for the lower level.
+        uint32_t index_sz = index_chunk.hdr.payload_length;
+        ROE(alloc(self, level));
+        memcpy(self->index[level], core->buf->start, index_sz);
+        ROE(jls_core_rd_chunk_tail(core, 0, JLS_TRACK_TAG_PACK(self->track_type, JLS_TRACK_CHUNK_SUMMARY)));
+        struct jls_core_chunk_s summary_chunk = core->chunk_cur;
+        struct jls_payload_header_s * summary = (struct jls_payload_header_s *) core->buf->start;
+        size_t summary_sz = sizeof(struct jls_payload_header_s)
+                + (self->decimate_factor * self->summary[level]->entry_size_bits) / 8;
+        if (summary_chunk.hdr.payload_length > summary_sz) {
+            JLS_LOGE("append: summary chunk at %" PRIi64 " too big", summary_chunk.offset);
+            return JLS_ERROR_NOT_SUPPORTED;
+        }
+        if (summary->entry_count >= self->decimate_factor) {
+            track->index_head[level] = index_chunk;
+            track->summary_head[level] = summary_chunk;
+            self->index[level]->header.entry_count = 0;
+            continue;
+        }
+        memcpy(self->summary[level], summary, summary_chunk.hdr.payload_length);
+        self->index[level]->header.entry_count = summary->entry_count;
+        *truncate = (index_chunk.offset < *truncate) ? index_chunk.offset : *truncate;
+        ROE(jls_core_rd_chunk_header(core, index_chunk.hdr.item_prev, &track->index_head[level]));
+        ROE(jls_core_rd_chunk_header(core, summary_chunk.hdr.item_prev, &track->summary_head[level]));
+    }
+    track->data_head.offset = chunk.offset;
+    return jls_core_list_tail(core, &track->data_head);
+}
+
+int32_t jls_wr_ts_checkpoint(struct jls_core_ts_s * self, struct jls_buf_s * buf) {
+    uint32_t levels = 0;
+    for (uint8_t level = 1; level < JLS_SUMMARY_LEVEL_COUNT; ++level) {
+        if (self->index[level] && self->summary[level]) {
+            levels |= 1U << level;
+        }
+    }
+    ROE(jls_buf_wr_u32(buf, levels));
+    for (uint8_t level = 1; level < JLS_SUMMARY_LEVEL_COUNT; ++level) {
+        if (!(levels & (1U << level))) {
+            continue;
+        }
+        struct jls_index_s * index = self->index[level];
+        struct jls_payload_header_s * summary = self->summary[level];
+        ROE(jls_buf_wr_bin(buf, index, (uint32_t) (sizeof(index->header)
+                + index->header.entry_count * sizeof(struct jls_index_entry_s))));
+        ROE(jls_buf_wr_bin(buf, summary, (uint32_t) (sizeof(*summary)
+                + (summary->entry_count * summary->entry_size_bits) / 8)));
+    }
+    return 0;
+}
+
+int32_t jls_wr_ts_restore(struct jls_core_ts_s * self, struct jls_buf_s * buf) {
+    uint32_t levels = 0;
+    ROE(jls_buf_rd_u32(buf, &levels));
+    if (levels & 1) {
+        return JLS_ERROR_UNSUPPORTED_FILE;
+    }
+    for (uint8_t level = 1; level < JLS_SUMMARY_LEVEL_COUNT; ++level) {
+        if (!(levels & (1U << level))) {
+            continue;
+        }
+        ROE(alloc(self, level));
+        struct jls_index_s * index = self->index[level];
+        struct jls_payload_header_s * summary = self->summary[level];
+        uint16_t entry_size_bits = summary->entry_size_bits;
+        ROE(jls_buf_rd_bin(buf, index, (uint32_t) sizeof(index->header)));
+        if (index->header.entry_count >= self->decimate_factor) {
+            return JLS_ERROR_UNSUPPORTED_FILE;
+        }
+        ROE(jls_buf_rd_bin(buf, index->entries, index->header.entry_count * (uint32_t) sizeof(struct jls_index_entry_s)));
+        ROE(jls_buf_rd_bin(buf, summary, (uint32_t) sizeof(*summary)));
+        if ((summary->entry_size_bits != entry_size_bits) || (summary->entry_count >= self->decimate_factor)) {
+            return JLS_ERROR_UNSUPPORTED_FILE;
+        }
+        ROE(jls_buf_rd_bin(buf, summary + 1, (summary->entry_count * entry_size_bits) / 8));
+    }
+    return 0;
+}
+
 int32_t jls_wr_ts_anno(struct jls_core_ts_s * self, int64_t timestamp, int64_t offset,
                        enum jls_annotation_type_e annotation_type, uint8_t group_id, float y) {
     if (self->track_type != JLS_TRACK_TYPE_ANNOTATION) {
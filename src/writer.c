@@ -16,11 +16,15 @@
 
 #include "jls/writer.h"
 #include "jls/raw.h"
+#include "jls/reader.h"
 #include "jls/format.h"
 #include "jls/buffer.h"
 #include "jls/core.h"
+#include "jls/checkpoint.h"
 #include "jls/track.h"
+#include "jls/wr_derived.h"
 #include "jls/wr_fsr.h"
+#include "jls/wr_prv.h"
 #include "jls/wr_ts.h"
 #include "jls/cdef.h"
 #include "jls/ec.h"
@@ -32,6 +36,12 @@
 
 struct jls_wr_s {
     struct jls_core_s core;
+    struct jls_wr_derived_s * derived[JLS_SIGNAL_COUNT];
+    uint16_t derived_ids[JLS_SIGNAL_COUNT];  // in definition order
+    uint16_t derived_count;
+    int64_t checkpoint_interval;  // in bytes, 0 to disable
+    int64_t checkpoint_pos;       // file position for the most recent checkpoint
+    uint32_t write_buffer;        // the write-behind buffer size in bytes, 0 to disable
 };
 
 const struct jls_source_def_s SOURCE_0 = {
@@ -59,21 +69,18 @@ const struct jls_signal_def_s SIGNAL_0 = {       // 0 reserved for VSR annotatio
         .units = "",
 };
 
-int32_t jls_wr_open(struct jls_wr_s ** instance, const char * path) {
-    if (!instance) {
-        return JLS_ERROR_PARAMETER_INVALID;
-    }
-
+static struct jls_wr_s * wr_alloc(void) {
     struct jls_wr_s * self = calloc(1, sizeof(struct jls_wr_s));
     if (!self) {
-        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+        return NULL;
     }
     struct jls_core_s * core = &self->core;
+    self->checkpoint_interval = JLS_WR_CHECKPOINT_INTERVAL_DEFAULT;
 
     core->buf = jls_buf_alloc();
     if (!core->buf) {
         free(self);
-        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+        return NULL;
     }
 
     for (uint16_t signal_id = 0; signal_id < JLS_SIGNAL_COUNT; ++signal_id) {
@@ -85,6 +92,19 @@ int32_t jls_wr_open(struct jls_wr_s ** instance, const char * path) {
             t->track_type = track_type;
         }
     }
+    return self;
+}
+
+int32_t jls_wr_open(struct jls_wr_s ** instance, const char * path) {
+    if (!instance) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+
+    struct jls_wr_s * self = wr_alloc();
+    if (!self) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    struct jls_core_s * core = &self->core;
 
     int32_t rc = jls_raw_open(&core->raw, path, "w");
     if (rc) {
@@ -95,7 +115,181 @@ int32_t jls_wr_open(struct jls_wr_s ** instance, const char * path) {
     ROE(jls_wr_user_data(self, 0, JLS_STORAGE_TYPE_INVALID, NULL, 0));
     ROE(jls_wr_source_def(self, &SOURCE_0));
     ROE(jls_wr_signal_def(self, &SIGNAL_0));
+    // after the chunks that jls_core_scan_initial() expects first
+    ROE(jls_core_checkpoint_head_wr(core));
+
+    *instance = self;
+    return 0;
+}
+
+static void wr_append_discard(struct jls_wr_s * self) {
+    // Free the restored state without writing, leaving the file contents unmodified.
+    struct jls_core_s * core = &self->core;
+    for (size_t i = 0; i < JLS_SIGNAL_COUNT; ++i) {
+        struct jls_core_signal_s * info = &core->signal_info[i];
+        struct jls_core_fsr_s * fsr = info->track_fsr;
+        if (fsr) {
+            jls_core_fsr_sample_buffer_free(fsr);
+            for (size_t level = 1; level < JLS_SUMMARY_LEVEL_COUNT; ++level) {
+                if (fsr->level[level]) {
+                    fsr->level[level]->summary->header.entry_count = 0;
+                }
+            }
+            jls_fsr_close(fsr);
+        }
+        struct jls_core_ts_s * ts_list[] = {info->track_anno, info->track_utc};
+        for (size_t k = 0; k < 2; ++k) {
+            struct jls_core_ts_s * ts = ts_list[k];
+            if (!ts) {
+                continue;
+            }
+            for (size_t level = 1; level < JLS_SUMMARY_LEVEL_COUNT; ++level) {
+                if (ts->index[level]) {
+                    ts->index[level]->header.entry_count = 0;
+                }
+            }
+            jls_wr_ts_close(ts);
+        }
+    }
+    jls_raw_close(core->raw);
+    jls_buf_free(core->buf);
+    free(self);
+}
+
+static int32_t head_check(const struct jls_core_chunk_s * head, int64_t truncate) {
+    if (head->offset >= truncate) {
+        JLS_LOGE("append: chunk at %" PRIi64 " follows the close summaries at %" PRIi64, head->offset, truncate);
+        return JLS_ERROR_NOT_SUPPORTED;
+    }
+    return 0;
+}
+
+static int32_t head_unlink(struct jls_core_s * core, struct jls_core_chunk_s * head) {
+    if (head->offset && head->hdr.item_next) {
+        head->hdr.item_next = 0;
+        ROE(jls_core_update_chunk_header(core, head));
+    }
+    return 0;
+}
+
+static int32_t track_append(struct jls_core_s * core, struct jls_core_track_s * track, int64_t truncate) {
+    if (!track->head.offset) {
+        return 0;
+    }
+    ROE(head_unlink(core, &track->data_head));
+    for (uint8_t level = 1; level < JLS_SUMMARY_LEVEL_COUNT; ++level) {
+        ROE(head_unlink(core, &track->index_head[level]));
+        ROE(head_unlink(core, &track->summary_head[level]));
+    }
+    bool modified = false;
+    for (uint8_t level = 0; level < JLS_SUMMARY_LEVEL_COUNT; ++level) {
+        if (track->head_offsets[level] >= truncate) {
+            track->head_offsets[level] = 0;
+            modified = true;
+        }
+    }
+    if (modified) {
+        ROE(jls_track_wr_head(track));
+    }
+    return 0;
+}
+
+static int32_t wr_append(struct jls_wr_s * self) {
+    struct jls_core_s * core = &self->core;
+    ROE(jls_core_scan_initial(core));
+    ROE(jls_core_scan_sources(core));
+    ROE(jls_core_scan_signals(core));
+    ROE(jls_core_scan_fsr_sample_id(core));
+    if (jls_core_rd_chunk_end(core) || (core->chunk_cur.hdr.tag != JLS_TAG_END)) {
+        JLS_LOGE("append: end chunk not found");
+        return JLS_ERROR_UNSUPPORTED_FILE;
+    }
+    int64_t truncate = core->chunk_cur.offset;
+    // The source and signal scans end at their list tails.  The user data
+    // list is not scanned on open, so follow its chunk headers.
+    ROE(jls_core_list_tail(core, &core->user_data_head));
+
+    // Restore the writer state and find the chunks written on close.
+    for (uint16_t signal_id = 0; signal_id < JLS_SIGNAL_COUNT; ++signal_id) {
+        struct jls_core_signal_s * info = &core->signal_info[signal_id];
+        if (!info->chunk_def.offset || (info->signal_def.signal_id != signal_id)) {
+            continue;
+        }
+        if (info->signal_def.signal_type == JLS_SIGNAL_TYPE_FSR) {
+            ROE(jls_fsr_open(&info->track_fsr, info));
+            ROE(jls_wr_ts_open(&info->track_utc, info, JLS_TRACK_TYPE_UTC,
+                               info->signal_def.utc_decimate_factor));
+            ROE(jls_fsr_append(info->track_fsr, &truncate));
+            ROE(jls_wr_ts_append(info->track_utc, &truncate));
+        }
+        ROE(jls_wr_ts_open(&info->track_anno, info, JLS_TRACK_TYPE_ANNOTATION,
+                           info->signal_def.annotation_decimate_factor));
+        ROE(jls_wr_ts_append(info->track_anno, &truncate));
+    }
 
+    // Only the chunks written on close may follow, which allows truncation.
+    ROE(head_check(&core->user_data_head, truncate));
+    ROE(head_check(&core->source_head, truncate));
+    ROE(head_check(&core->signal_head, truncate));
+    for (uint16_t signal_id = 0; signal_id < JLS_SIGNAL_COUNT; ++signal_id) {
+        struct jls_core_signal_s * info = &core->signal_info[signal_id];
+        for (uint8_t track_type = 0; track_type < JLS_TRACK_TYPE_COUNT; ++track_type) {
+            struct jls_core_track_s * track = &info->tracks[track_type];
+            ROE(head_check(&track->data_head, truncate));
+            for (uint8_t level = 1; level < JLS_SUMMARY_LEVEL_COUNT; ++level) {
+                ROE(head_check(&track->index_head[level], truncate));
+                ROE(head_check(&track->summary_head[level], truncate));
+            }
+        }
+    }
+
+    ROE(jls_raw_truncate(core->raw, truncate));
+    ROE(head_unlink(core, &core->user_data_head));
+    ROE(head_unlink(core, &core->source_head));
+    ROE(head_unlink(core, &core->signal_head));
+    for (uint16_t signal_id = 0; signal_id < JLS_SIGNAL_COUNT; ++signal_id) {
+        struct jls_core_signal_s * info = &core->signal_info[signal_id];
+        for (uint8_t track_type = 0; track_type < JLS_TRACK_TYPE_COUNT; ++track_type) {
+            ROE(track_append(core, &info->tracks[track_type], truncate));
+        }
+    }
+    return 0;
+}
+
+int32_t jls_wr_open_append(struct jls_wr_s ** instance, const char * path) {
+    if (!instance || !path) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+
+    // Repair files that were not closed, which completes their summaries.
+    struct jls_raw_s * raw = NULL;
+    int32_t rc = jls_raw_open(&raw, path, "r");
+    jls_raw_close(raw);
+    if (rc == JLS_ERROR_TRUNCATED) {
+        struct jls_rd_s * rd = NULL;
+        ROE(jls_rd_open(&rd, path));
+        jls_rd_close(rd);
+    } else if (rc) {
+        return rc;
+    }
+
+    struct jls_wr_s * self = wr_alloc();
+    if (!self) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    rc = jls_raw_open(&self->core.raw, path, "a");
+    if (rc) {
+        jls_raw_close(self->core.raw);
+        jls_buf_free(self->core.buf);
+        free(self);
+        return (rc == JLS_ERROR_TRUNCATED) ? JLS_ERROR_UNSUPPORTED_FILE : rc;
+    }
+    rc = wr_append(self);
+    if (rc) {
+        wr_append_discard(self);
+        return rc;
+    }
+    self->checkpoint_pos = jls_raw_chunk_tell(self->core.raw);
     *instance = self;
     return 0;
 }
@@ -103,6 +297,11 @@ int32_t jls_wr_open(struct jls_wr_s ** instance, const char * path) {
 int32_t jls_wr_close(struct jls_wr_s * self) {
     if (self) {
         struct jls_core_s * core = &self->core;
+        for (uint16_t i = 0; i < self->derived_count; ++i) {
+            uint16_t signal_id = self->derived_ids[i];
+            jls_wr_derived_free(self->derived[signal_id]);
+            self->derived[signal_id] = NULL;
+        }
         for (size_t i = 0; i < JLS_SIGNAL_COUNT; ++i) {
             struct jls_core_signal_s * signal_info = &core->signal_info[i];
             jls_fsr_close(signal_info->track_fsr);
@@ -110,6 +309,7 @@ int32_t jls_wr_close(struct jls_wr_s * self) {
             jls_wr_ts_close(signal_info->track_utc);
         }
         jls_core_wr_end(core);
+        jls_core_stats_free(core);
         int32_t rc = jls_raw_close(core->raw);
         if (core->buf) {
             jls_buf_free(core->buf);
@@ -125,6 +325,100 @@ int32_t jls_wr_flush(struct jls_wr_s * self) {
     return jls_raw_flush(self->core.raw);
 }
 
+int32_t jls_wr_sync(struct jls_wr_s * self, int32_t durable) {
+    if (!self) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    return jls_raw_sync(self->core.raw, durable);
+}
+
+int32_t jls_wr_checkpoint_interval(struct jls_wr_s * self, int64_t interval) {
+    if (!self || (interval < 0)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    self->checkpoint_interval = interval;
+    return 0;
+}
+
+int32_t jls_wr_write_buffer(struct jls_wr_s * self, uint32_t size) {
+    if (!self) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    ROE(jls_raw_write_buffer(self->core.raw, size));
+    self->write_buffer = size;
+    return 0;
+}
+
+static int32_t checkpoint_check(struct jls_wr_s * self) {
+    if (!self->checkpoint_interval) {
+        return 0;
+    }
+    int64_t pos = jls_raw_chunk_tell(self->core.raw);
+    if ((pos - self->checkpoint_pos) < self->checkpoint_interval) {
+        return 0;
+    }
+    ROE(jls_core_checkpoint_wr(&self->core));
+    self->checkpoint_pos = jls_raw_chunk_tell(self->core.raw);
+    return 0;
+}
+
+int64_t jls_wr_tell(struct jls_wr_s * self) {
+    return jls_raw_chunk_tell(self->core.raw);
+}
+
+const struct jls_signal_def_s * jls_wr_signal_def_get(struct jls_wr_s * self, uint16_t signal_id) {
+    if (signal_id >= JLS_SIGNAL_COUNT) {
+        return NULL;
+    }
+    struct jls_core_signal_s * info = &self->core.signal_info[signal_id];
+    if (!info->chunk_def.offset || (info->signal_def.signal_id != signal_id)) {
+        return NULL;
+    }
+    return &info->signal_def;
+}
+
+int32_t jls_wr_roll(struct jls_wr_s ** instance, const char * path) {
+    struct jls_wr_s * self = *instance;
+    struct jls_wr_s * wr = NULL;
+    if (self->derived_count) {
+        return JLS_ERROR_NOT_SUPPORTED;  // derived definitions are not retained
+    }
+    ROE(jls_wr_open(&wr, path));
+    int32_t rc = 0;
+    for (uint16_t source_id = 1; !rc && (source_id < JLS_SOURCE_COUNT); ++source_id) {
+        struct jls_core_source_s * info = &self->core.source_info[source_id];
+        if (info->chunk_def.offset) {
+            rc = jls_wr_source_def(wr, &info->source_def);
+        }
+    }
+    for (uint16_t signal_id = 1; !rc && (signal_id < JLS_SIGNAL_COUNT); ++signal_id) {
+        struct jls_core_signal_s * info = &self->core.signal_info[signal_id];
+        if (!info->chunk_def.offset) {
+            continue;
+        }
+        rc = jls_wr_signal_def(wr, &info->signal_def);
+        if (!rc && info->track_fsr && (info->track_fsr->write_omit_data & 1)) {
+            rc = jls_wr_fsr_omit_data(wr, signal_id, 1);
+        }
+    }
+    if (!rc && self->core.stats) {
+        rc = jls_wr_stats_enable(wr, 1);
+    }
+    if (!rc) {
+        rc = jls_wr_checkpoint_interval(wr, self->checkpoint_interval);
+    }
+    if (!rc) {
+        rc = jls_wr_write_buffer(wr, self->write_buffer);
+    }
+    if (rc) {
+        jls_wr_close(wr);
+        return rc;
+    }
+    jls_wr_close(self);
+    *instance = wr;
+    return 0;
+}
+
 static int32_t buf_wr_str(struct jls_buf_s * self, const char * src, char ** dst) {
     if (NULL == src) {
         if (NULL != dst) {
@@ -245,7 +539,12 @@ int32_t jls_wr_signal_def(struct jls_wr_s * self, const struct jls_signal_def_s
     ROE(jls_buf_wr_u32(buf, def->summary_decimate_factor));
     ROE(jls_buf_wr_u32(buf, def->annotation_decimate_factor));
     ROE(jls_buf_wr_u32(buf, def->utc_decimate_factor));
-    ROE(jls_buf_wr_zero(buf, 92));  // reserve space for future use.
+    ROE(jls_buf_wr_u32(buf, def->summary_fields));
+    ROE(jls_buf_wr_u32(buf, def->summary_hist_bins));
+    ROE(jls_buf_wr_u32(buf, def->summary_hist_level));
+    ROE(jls_buf_wr_f32(buf, def->summary_hist_min));
+    ROE(jls_buf_wr_f32(buf, def->summary_hist_max));
+    ROE(jls_buf_wr_zero(buf, 72));  // reserve space for future use.
     ROE(jls_buf_wr_str(buf, def->name));
     ROE(jls_buf_wr_str(buf, def->units));
     uint32_t payload_length = (uint32_t) jls_buf_length(buf);
@@ -288,6 +587,43 @@ int32_t jls_wr_signal_def(struct jls_wr_s * self, const struct jls_signal_def_s
     return 0;
 }
 
+int32_t jls_wr_signal_def_derived(struct jls_wr_s * self, const struct jls_signal_def_s * signal,
+                                  const struct jls_wr_derived_def_s * derived) {
+    if (!derived) {
+        return jls_wr_signal_def(self, signal);
+    }
+    if (!self || !signal) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    if (signal->signal_type != JLS_SIGNAL_TYPE_FSR) {
+        JLS_LOGE("derived signal %d must be FSR", (int) signal->signal_id);
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    for (uint32_t i = 0; (i < derived->source_count) && (i < JLS_WR_DERIVED_SOURCE_MAX); ++i) {
+        uint16_t source_id = derived->source_ids[i];
+        ROE(jls_core_signal_validate_typed(&self->core, source_id, JLS_SIGNAL_TYPE_FSR));
+        if (self->core.signal_info[source_id].signal_def.sample_rate != signal->sample_rate) {
+            JLS_LOGE("derived signal %d: source %d sample_rate mismatch",
+                     (int) signal->signal_id, (int) source_id);
+            return JLS_ERROR_PARAMETER_INVALID;
+        }
+    }
+    if ((signal->signal_id < JLS_SIGNAL_COUNT) && self->core.signal_info[signal->signal_id].chunk_def.offset) {
+        JLS_LOGE("Duplicate signal: %d", (int) signal->signal_id);
+        return JLS_ERROR_ALREADY_EXISTS;
+    }
+    struct jls_wr_derived_s * d = NULL;
+    ROE(jls_wr_derived_alloc(&d, signal, derived));
+    int32_t rc = jls_wr_signal_def(self, signal);
+    if (rc) {
+        jls_wr_derived_free(d);
+        return rc;
+    }
+    self->derived[signal->signal_id] = d;
+    self->derived_ids[self->derived_count++] = signal->signal_id;
+    return 0;
+}
+
 int32_t jls_wr_user_data(struct jls_wr_s * self, uint16_t chunk_meta,
                          enum jls_storage_type_e storage_type, const uint8_t * data, uint32_t data_size) {
     if (!self) {
@@ -328,14 +664,51 @@ int32_t jls_wr_user_data(struct jls_wr_s * self, uint16_t chunk_meta,
 
     // write
     ROE(jls_raw_wr(self->core.raw, &chunk.hdr, data));
-    return jls_core_update_item_head(&self->core, &self->core.user_data_head, &chunk);
+    ROE(jls_core_update_item_head(&self->core, &self->core.user_data_head, &chunk));
+    return checkpoint_check(self);
+}
+
+static int32_t fsr_wr(struct jls_wr_s * self, uint16_t signal_id,
+                      int64_t sample_id, const void * data, uint32_t data_length) {
+    struct jls_core_signal_s * info = &self->core.signal_info[signal_id];
+    ROE(jls_wr_fsr_data(info->track_fsr, sample_id, data, data_length));
+    for (uint16_t i = 0; i < self->derived_count; ++i) {
+        uint16_t derived_id = self->derived_ids[i];
+        struct jls_wr_derived_s * d = self->derived[derived_id];
+        ROE(jls_wr_derived_source(d, signal_id, info->signal_def.data_type, sample_id, data, data_length));
+        int64_t y_sample_id = 0;
+        const void * y = NULL;
+        uint32_t y_length = 0;
+        while (0 == jls_wr_derived_next(d, &y_sample_id, &y, &y_length)) {
+            ROE(fsr_wr(self, derived_id, y_sample_id, y, y_length));  // derived sources may also be derived
+        }
+    }
+    return 0;
 }
 
 int32_t jls_wr_fsr(struct jls_wr_s * self, uint16_t signal_id,
                            int64_t sample_id, const void * data, uint32_t data_length) {
     ROE(jls_core_signal_validate(&self->core, signal_id));
-    struct jls_core_signal_s * info = &self->core.signal_info[signal_id];
-    return jls_wr_fsr_data(info->track_fsr, sample_id, data, data_length);
+    if (self->derived[signal_id]) {
+        JLS_LOGW("signal %d is derived and cannot be written", (int) signal_id);
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    ROE(fsr_wr(self, signal_id, sample_id, data, data_length));
+    return checkpoint_check(self);
+}
+
+int32_t jls_wr_fsr_chunk(struct jls_wr_s * self, uint16_t signal_id, int64_t sample_id,
+                         const struct jls_fsr_data_s * data, const void * summary) {
+    ROE(jls_core_signal_validate_typed(&self->core, signal_id, JLS_SIGNAL_TYPE_FSR));
+    if (self->derived[signal_id]) {
+        JLS_LOGW("signal %d is derived and cannot be written", (int) signal_id);
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    if (self->derived_count) {
+        return JLS_ERROR_NOT_SUPPORTED;  // derived signals need the samples
+    }
+    ROE(jls_wr_fsr_data_chunk(self->core.signal_info[signal_id].track_fsr, sample_id, data, summary));
+    return checkpoint_check(self);
 }
 
 int32_t jls_wr_fsr_f32(struct jls_wr_s * self, uint16_t signal_id,
@@ -345,7 +718,7 @@ int32_t jls_wr_fsr_f32(struct jls_wr_s * self, uint16_t signal_id,
     if (info->signal_def.data_type != JLS_DATATYPE_F32) {
         return JLS_ERROR_PARAMETER_INVALID;
     }
-    return jls_wr_fsr_data(info->track_fsr, sample_id, data, data_length);
+    return jls_wr_fsr(self, signal_id, sample_id, data, data_length);
 }
 
 int32_t jls_wr_fsr_omit_data(struct jls_wr_s * self, uint16_t signal_id, uint32_t enable) {
@@ -422,7 +795,7 @@ int32_t jls_wr_annotation(struct jls_wr_s * self, uint16_t signal_id, int64_t ti
     ROE(jls_core_update_item_head(core, &signal_info->tracks[JLS_TRACK_TYPE_ANNOTATION].data_head, &chunk));
     ROE(jls_track_update(track, 0, offset));
     ROE(jls_wr_ts_anno(signal_info->track_anno, timestamp, offset, annotation_type, group_id, y));
-    return 0;
+    return checkpoint_check(self);
 }
 
 int32_t jls_wr_utc(struct jls_wr_s * self, uint16_t signal_id, int64_t sample_id, int64_t utc) {
@@ -459,5 +832,19 @@ int32_t jls_wr_utc(struct jls_wr_s * self, uint16_t signal_id, int64_t sample_id
     ROE(jls_track_update(track, 0, offset));
 
     ROE(jls_wr_ts_utc(signal_info->track_utc, sample_id, offset, utc));
-    return 0;
+    return checkpoint_check(self);
+}
+
+int32_t jls_wr_stats_enable(struct jls_wr_s * self, int enable) {
+    if (!self) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    return jls_core_stats_enable(&self->core, enable);
+}
+
+int32_t jls_wr_stats(struct jls_wr_s * self, struct jls_stats_s * stats) {
+    if (!self) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    return jls_core_stats(&self->core, stats);
 }
@@ -41,6 +41,7 @@ static void test_n(void **state) {
         uint32_t data_u32[] = U32_INIT_01;
         assert_int_equal(0, jls_bit_shift_array_right(i, data_u32, sizeof(data_u32)));
         assert_int_equal((U32_01[0] >> i) | (U32_01[1] << (32 - i)), data_u32[0]);
+        assert_int_equal(U32_01[5] >> i, data_u32[5]);
     }
 }
 
@@ -50,11 +51,117 @@ static void test_8(void **state) {
     assert_int_equal(JLS_ERROR_PARAMETER_INVALID, jls_bit_shift_array_right(8, data_u32, sizeof(data_u32)));
 }
 
+static uint8_t bit_get(const uint8_t * x, size_t idx) {
+    return (x[idx >> 3] >> (idx & 7)) & 1;
+}
+
+static void test_copy(void **state) {
+    (void) state;
+    const uint8_t src[] = {0xa5, 0x3c, 0xf0, 0x5a};
+    for (size_t dst_bit = 0; dst_bit < 8; ++dst_bit) {
+        for (size_t bits = 1; bits <= 24; ++bits) {
+            uint8_t dst[6];
+            memset(dst, 0xcc, sizeof(dst));
+            jls_bit_copy(dst, dst_bit, src, bits);
+            for (size_t i = 0; i < sizeof(dst) * 8; ++i) {
+                if ((i < dst_bit) || (i >= (dst_bit + bits))) {
+                    assert_int_equal(bit_get((const uint8_t[]) {0xcc}, i & 7), bit_get(dst, i));
+                } else {
+                    assert_int_equal(bit_get(src, i - dst_bit), bit_get(dst, i));
+                }
+            }
+        }
+    }
+}
+
+static void test_n_long(void **state) {
+    (void) state;
+    uint8_t src[37];
+    uint8_t data[37];
+    for (size_t i = 0; i < sizeof(src); ++i) {
+        src[i] = (uint8_t) (i * 37 + 11);
+    }
+    for (uint8_t shift = 1; shift < 8; ++shift) {
+        for (size_t size = 1; size <= sizeof(src); ++size) {
+            memcpy(data, src, size);
+            assert_int_equal(0, jls_bit_shift_array_right(shift, data, size));
+            for (size_t i = 0; i < (size * 8 - shift); ++i) {
+                assert_int_equal(bit_get(src, i + shift), bit_get(data, i));
+            }
+            for (size_t i = size * 8 - shift; i < size * 8; ++i) {
+                assert_int_equal(0, bit_get(data, i));
+            }
+        }
+    }
+}
+
+static void test_copy_offset(void **state) {
+    (void) state;
+    uint8_t src[40];
+    uint8_t dst[40];
+    for (size_t i = 0; i < sizeof(src); ++i) {
+        src[i] = (uint8_t) (i * 73 + 5);
+    }
+    for (size_t src_bit = 0; src_bit < 16; ++src_bit) {
+        for (size_t dst_bit = 0; dst_bit < 16; ++dst_bit) {
+            for (size_t bits = 0; bits <= 280; bits += (bits < 80) ? 1 : 13) {
+                memset(dst, 0xcc, sizeof(dst));
+                jls_bit_copy_offset(dst, dst_bit, src, src_bit, bits);
+                for (size_t i = 0; i < sizeof(dst) * 8; ++i) {
+                    if ((i < dst_bit) || (i >= (dst_bit + bits))) {
+                        assert_int_equal(bit_get((const uint8_t[]) {0xcc}, i & 7), bit_get(dst, i));
+                    } else {
+                        assert_int_equal(bit_get(src, i - dst_bit + src_bit), bit_get(dst, i));
+                    }
+                }
+            }
+        }
+    }
+}
+
+static void test_unpack_u8(void **state) {
+    (void) state;
+    uint8_t src[24];
+    uint8_t dst[200];
+    for (size_t i = 0; i < sizeof(src); ++i) {
+        src[i] = (uint8_t) (i * 151 + 3);
+    }
+    for (size_t src_bit = 0; src_bit < 16; ++src_bit) {
+        for (size_t count = 0; count <= 150; ++count) {
+            memset(dst, 0xcc, sizeof(dst));
+            assert_int_equal(0, jls_bit_unpack_u8(dst, src, src_bit, 1, count));
+            for (size_t i = 0; i < count; ++i) {
+                assert_int_equal(bit_get(src, src_bit + i), dst[i]);
+            }
+            assert_int_equal(0xcc, dst[count]);
+        }
+    }
+    for (size_t src_bit = 0; src_bit < 16; src_bit += 4) {
+        for (size_t count = 0; count <= 40; ++count) {
+            memset(dst, 0xcc, sizeof(dst));
+            assert_int_equal(0, jls_bit_unpack_u8(dst, src, src_bit, 4, count));
+            for (size_t i = 0; i < count; ++i) {
+                size_t k = src_bit / 4 + i;
+                assert_int_equal((src[k / 2] >> ((k & 1) * 4)) & 0x0f, dst[i]);
+            }
+            assert_int_equal(0xcc, dst[count]);
+        }
+    }
+    assert_int_equal(0, jls_bit_unpack_u8(dst, src, 8, 8, 4));
+    assert_memory_equal(src + 1, dst, 4);
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID, jls_bit_unpack_u8(dst, src, 2, 4, 4));
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID, jls_bit_unpack_u8(dst, src, 0, 2, 4));
+}
+
 int main(void) {
     const struct CMUnitTest tests[] = {
             cmocka_unit_test(test_0),
             cmocka_unit_test(test_n),
             cmocka_unit_test(test_8),
+            cmocka_unit_test(test_copy),
+            cmocka_unit_test(test_n_long),
+            cmocka_unit_test(test_copy_offset),
+            cmocka_unit_test(test_unpack_u8),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
@@ -78,8 +78,8 @@ static void test_wr_rd(void **state) {
     uint8_t u8b = 0;
     uint16_t u16b = 0;
     uint32_t u32b = 0;
-    //float f32b = 0.0f;
-    //int64_t i64b = 0;
+    float f32b = 0.0f;
+    int64_t i64b = 0;
 
     struct jls_buf_s * b = jls_buf_alloc();
     assert_int_equal(0, jls_buf_wr_zero(b, 32));
@@ -95,17 +95,20 @@ static void test_wr_rd(void **state) {
     b->cur = b->start;
     assert_int_equal(0, jls_buf_rd_skip(b, 32));
     assert_int_equal(0, jls_buf_rd_str(b, &strb));  assert_string_equal(strb, stra);
-    assert_int_equal(0, jls_buf_rd_skip(b, sizeof(u32a)));
+    assert_int_equal(0, jls_buf_rd_bin(b, &u32b, sizeof(u32b)));  assert_int_equal(u32b, u32a);
     assert_int_equal(0, jls_buf_rd_u8(b, &u8b));  assert_int_equal(u8b, u8a);
     assert_int_equal(0, jls_buf_rd_u16(b, &u16b));  assert_int_equal(u16b, u16a);
     assert_int_equal(0, jls_buf_rd_u32(b, &u32b));  assert_int_equal(u32b, u32a);
-    assert_int_equal(0, jls_buf_rd_skip(b, sizeof(float)));
-    assert_int_equal(0, jls_buf_rd_skip(b, sizeof(i64a)));
+    assert_int_equal(0, jls_buf_rd_f32(b, &f32b));  assert_float_equal(f32b, f32a, 0.0);
+    assert_int_equal(0, jls_buf_rd_i64(b, &i64b));  assert_true(i64b == i64a);
 
     assert_int_equal(JLS_ERROR_EMPTY, jls_buf_rd_skip(b, 1));
     assert_int_equal(JLS_ERROR_EMPTY, jls_buf_rd_u8(b, &u8b));
     assert_int_equal(JLS_ERROR_EMPTY, jls_buf_rd_u16(b, &u16b));
     assert_int_equal(JLS_ERROR_EMPTY, jls_buf_rd_u32(b, &u32b));
+    assert_int_equal(JLS_ERROR_EMPTY, jls_buf_rd_f32(b, &f32b));
+    assert_int_equal(JLS_ERROR_EMPTY, jls_buf_rd_i64(b, &i64b));
+    assert_int_equal(JLS_ERROR_EMPTY, jls_buf_rd_bin(b, &u32b, sizeof(u32b)));
     assert_int_equal(JLS_ERROR_EMPTY, jls_buf_rd_str(b, &strb));
 
     jls_buf_free(b);
@@ -144,6 +144,84 @@ static void test_i64(void **state) {
     VALIDATE(i64, JLS_DATATYPE_I64);
 }
 
+static void test_i24_u24(void **state) {
+    (void) state;
+    int32_t i24[] = {0, 1, -1, 0x7fffff, -0x800000, 1234567, -1234567};
+    uint32_t u24[] = {0, 1, 0xffffff, 0x800000, 1234567};
+    uint8_t src[3 * 8];
+    double dst[8];
+    for (size_t i = 0; i < ARRAY_SIZE(i24); ++i) {
+        uint32_t k = (uint32_t) i24[i];
+        src[3 * i + 0] = (uint8_t) (k & 0xff);
+        src[3 * i + 1] = (uint8_t) ((k >> 8) & 0xff);
+        src[3 * i + 2] = (uint8_t) ((k >> 16) & 0xff);
+    }
+    assert_int_equal(0, jls_dt_buffer_to_f64(src, JLS_DATATYPE_I24, dst, ARRAY_SIZE(i24)));
+    for (size_t i = 0; i < ARRAY_SIZE(i24); ++i) {
+        assert_float_equal((double) i24[i], dst[i], 1e-15);
+    }
+    for (size_t i = 0; i < ARRAY_SIZE(u24); ++i) {
+        src[3 * i + 0] = (uint8_t) (u24[i] & 0xff);
+        src[3 * i + 1] = (uint8_t) ((u24[i] >> 8) & 0xff);
+        src[3 * i + 2] = (uint8_t) ((u24[i] >> 16) & 0xff);
+    }
+    assert_int_equal(0, jls_dt_buffer_to_f64(src, JLS_DATATYPE_U24, dst, ARRAY_SIZE(u24)));
+    for (size_t i = 0; i < ARRAY_SIZE(u24); ++i) {
+        assert_float_equal((double) u24[i], dst[i], 1e-15);
+    }
+}
+
+static void test_packed_odd_length(void **state) {
+    (void) state;
+    uint8_t src[] = {0xa5, 0x3c};
+    double dst[16];
+    memset(dst, 0, sizeof(dst));
+    assert_int_equal(0, jls_dt_buffer_to_f64(src, JLS_DATATYPE_U1, dst, 11));
+    for (size_t i = 0; i < 11; ++i) {
+        assert_float_equal((double) ((src[i >> 3] >> (i & 7)) & 1), dst[i], 1e-15);
+    }
+    dst[3] = 100.0;
+    assert_int_equal(0, jls_dt_buffer_to_f64(src, JLS_DATATYPE_U4, dst, 3));
+    assert_float_equal(5.0, dst[0], 1e-15);
+    assert_float_equal(10.0, dst[1], 1e-15);
+    assert_float_equal(12.0, dst[2], 1e-15);
+    assert_float_equal(100.0, dst[3], 1e-15);  // not written
+}
+
+static void test_fixed_point(void **state) {
+    (void) state;
+    int16_t i16[] = {0, 16, -16, 1, -1, 32767};
+    double dst[ARRAY_SIZE(i16)];
+    float dst_f32[ARRAY_SIZE(i16)];
+    uint32_t dt = JLS_DATATYPE_DEF(INT, 16, 4);
+    assert_float_equal(1.0 / 16.0, jls_dt_scale(dt), 1e-15);
+    assert_int_equal(0, jls_dt_buffer_as_f64(i16, dt, dst, ARRAY_SIZE(i16)));
+    assert_int_equal(0, jls_dt_buffer_as_f32(i16, dt, dst_f32, ARRAY_SIZE(i16)));
+    for (size_t i = 0; i < ARRAY_SIZE(i16); ++i) {
+        assert_float_equal(i16[i] / 16.0, dst[i], 1e-15);
+        assert_float_equal(i16[i] / 16.0, dst_f32[i], 1e-6);
+    }
+    // summaries and sample statistics use the unscaled values
+    assert_int_equal(0, jls_dt_buffer_to_f64(i16, dt, dst, ARRAY_SIZE(i16)));
+    assert_int_equal(0, jls_dt_buffer_to_f32(i16, dt, dst_f32, ARRAY_SIZE(i16)));
+    for (size_t i = 0; i < ARRAY_SIZE(i16); ++i) {
+        assert_float_equal(i16[i], dst[i], 1e-15);
+        assert_float_equal(i16[i], dst_f32[i], 1e-6);
+    }
+    assert_float_equal(4.0, jls_dt_scale(JLS_DATATYPE_DEF(UINT, 8, -2)), 1e-15);
+    assert_float_equal(1.0, jls_dt_scale(JLS_DATATYPE_F32), 1e-15);
+}
+
+static void test_to_f32(void **state) {
+    (void) state;
+    int8_t i8[] = {0, 16, 32, 64, 127, -1, -16, -32, -64, -127, -128};
+    float dst[ARRAY_SIZE(i8)];
+    assert_int_equal(0, jls_dt_buffer_to_f32(i8, JLS_DATATYPE_I8, dst, ARRAY_SIZE(i8)));
+    for (size_t i = 0; i < ARRAY_SIZE(i8); ++i) {
+        assert_float_equal((float) i8[i], dst[i], 1e-7);
+    }
+}
+
 static void test_f32(void **state) {
     (void) state;
     float src[] = {0.0f, 1.0f, -1.0f, FLT_MAX, -FLT_MAX};
@@ -170,6 +248,10 @@ int main(void) {
             cmocka_unit_test(test_i16),
             cmocka_unit_test(test_i32),
             cmocka_unit_test(test_i64),
+            cmocka_unit_test(test_i24_u24),
+            cmocka_unit_test(test_packed_odd_length),
+            cmocka_unit_test(test_fixed_point),
+            cmocka_unit_test(test_to_f32),
 
             cmocka_unit_test(test_f32),
             cmocka_unit_test(test_f64),
@@ -163,6 +163,22 @@ static void test_samples(void **state) {
         assert_float_equal(signal[150000 + i], y[i], 10e-6);
     }
 
+    struct jls_rd_fsr_iter_s * iter = NULL;
+    const float * f32 = NULL;
+    int64_t sample_id = 0;
+    int64_t count = 0;
+    int64_t expect_sample_id = 0;
+    assert_int_equal(0, jls_rd_fsr_iter_open(rd, 1, 0, sample_count, &iter));
+    while (0 == jls_rd_fsr_iter_next(iter, (const void **) &f32, &sample_id, &count)) {
+        assert_int_equal(expect_sample_id, sample_id);
+        for (int64_t i = 0; i < count; ++i) {
+            assert_float_equal(signal[sample_id + i], f32[i], 10e-6);
+        }
+        expect_sample_id += count;
+    }
+    assert_int_equal(sample_count, expect_sample_id);
+    jls_rd_fsr_iter_close(iter);
+
     free(signal);
     free(y);
     remove(filename);
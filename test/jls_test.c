@@ -20,6 +20,8 @@
 #include <cmocka.h>
 #include "jls.h"
 #include "jls/writer.h"
+#include "jls/copy.h"
+#include "jls/log.h"
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -122,6 +124,30 @@ const struct jls_signal_def_s SIGNAL_9_U1 = {
 };
 
 #if !SKIP_BASIC
+static int log_count_ = 0;
+
+static void on_log_count(const char * msg) {
+    (void) msg;
+    ++log_count_;
+}
+
+static void test_open_empty_no_log(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    struct jls_rd_s * rd = NULL;
+    log_count_ = 0;
+    jls_log_register(on_log_count);
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_close(wr));
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    jls_rd_close(rd);
+    assert_int_equal(0, jls_wr_open_append(&wr, filename));
+    assert_int_equal(0, jls_wr_close(wr));
+    jls_log_unregister();
+    assert_int_equal(0, log_count_);
+    remove(filename);
+}
+
 static void test_source(void **state) {
     (void) state;
     struct jls_wr_s * wr = NULL;
@@ -870,6 +896,240 @@ static void test_fsr_samples_int_uint(void **state) {
     }
 }
 
+static void pack_bits(uint8_t * dst, int64_t idx, uint8_t bits, int64_t value) {
+    uint64_t v = (uint64_t) value;
+    for (uint8_t k = 0; k < bits; ++k) {
+        int64_t bit = idx * bits + k;
+        if ((v >> k) & 1) {
+            dst[bit >> 3] |= (uint8_t) (1 << (bit & 7));
+        }
+    }
+}
+
+static void test_fsr_as_float(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = 2500;
+    uint8_t * src = malloc(sample_count * 8);
+    float * dst_f32 = malloc(sample_count * sizeof(float));
+    double * dst_f64 = malloc(sample_count * sizeof(double));
+
+    uint32_t data_types[] = {
+            JLS_DATATYPE_U1, JLS_DATATYPE_U4, JLS_DATATYPE_U8, JLS_DATATYPE_U16,
+            JLS_DATATYPE_U24, JLS_DATATYPE_U32, JLS_DATATYPE_U64,
+            JLS_DATATYPE_I4, JLS_DATATYPE_I8, JLS_DATATYPE_I16,
+            JLS_DATATYPE_I24, JLS_DATATYPE_I32, JLS_DATATYPE_I64,
+            JLS_DATATYPE_F32, JLS_DATATYPE_F64,
+            JLS_DATATYPE_DEF(INT, 16, 4), JLS_DATATYPE_DEF(UINT, 8, 2),
+    };
+
+    struct jls_signal_def_s signal_7 = SIGNAL_5;
+    signal_7.signal_id = 7;
+
+    for (uint32_t idx = 0; idx < ARRAY_SIZE(data_types); ++idx) {
+        uint32_t data_type = data_types[idx];
+        uint8_t basetype = jls_datatype_parse_basetype(data_type);
+        uint8_t bits = jls_datatype_parse_size(data_type);
+        double scale = 1.0 / (double) (1 << jls_datatype_parse_q(data_type));
+        memset(src, 0, sample_count * 8);
+        for (int64_t i = 0; i < sample_count; ++i) {
+            if (basetype == JLS_DATATYPE_BASETYPE_FLOAT) {
+                if (bits == 32) {
+                    ((float *) src)[i] = (float) i * 0.25f;
+                } else {
+                    ((double *) src)[i] = (double) i * 0.25;
+                }
+            } else if (basetype == JLS_DATATYPE_BASETYPE_INT) {
+                pack_bits(src, i, bits, (i % 13) - 6);
+            } else {
+                pack_bits(src, i, bits, (i % 13) & ((bits == 1) ? 1 : 0xff));
+            }
+        }
+
+        signal_7.data_type = data_type;
+        assert_int_equal(0, jls_wr_open(&wr, filename));
+        assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+        assert_int_equal(0, jls_wr_signal_def(wr, &signal_7));
+        assert_int_equal(0, jls_wr_fsr(wr, signal_7.signal_id, 0, src, (uint32_t) sample_count));
+        assert_int_equal(0, jls_wr_close(wr));
+
+        struct jls_rd_s * rd = NULL;
+        assert_int_equal(0, jls_rd_open(&rd, filename));
+        int64_t start = 5;
+        int64_t length = sample_count - start;
+        assert_int_equal(0, jls_rd_fsr_as_f32(rd, signal_7.signal_id, start, dst_f32, length));
+        assert_int_equal(0, jls_rd_fsr_as_f64(rd, signal_7.signal_id, start, dst_f64, length));
+        for (int64_t i = 0; i < length; ++i) {
+            int64_t k = start + i;
+            double expect;
+            if (basetype == JLS_DATATYPE_BASETYPE_FLOAT) {
+                expect = (double) k * 0.25;
+            } else if (basetype == JLS_DATATYPE_BASETYPE_INT) {
+                expect = (double) ((k % 13) - 6);
+            } else {
+                expect = (double) ((k % 13) & ((bits == 1) ? 1 : 0xff));
+            }
+            expect *= scale;
+            assert_float_equal(expect, dst_f64[i], 1e-12);
+            assert_float_equal(expect, dst_f32[i], 1e-3);
+        }
+        jls_rd_close(rd);
+        remove(filename);
+    }
+    free(src);
+    free(dst_f32);
+    free(dst_f64);
+}
+
+static void test_fsr_fixed_point_statistics(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = 100000;
+    int16_t * src = malloc(sample_count * sizeof(int16_t));
+    for (int64_t i = 0; i < sample_count; ++i) {
+        src[i] = 16;
+    }
+    struct jls_signal_def_s signal_7 = SIGNAL_5;
+    signal_7.signal_id = 7;
+    signal_7.data_type = JLS_DATATYPE_DEF(INT, 16, 4);
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &signal_7));
+    assert_int_equal(0, jls_wr_fsr(wr, signal_7.signal_id, 0, src, (uint32_t) sample_count));
+    assert_int_equal(0, jls_wr_close(wr));
+
+    struct jls_rd_s * rd = NULL;
+    double stats[JLS_SUMMARY_FSR_COUNT];
+    double f64[4];
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    assert_int_equal(0, jls_rd_fsr_as_f64(rd, signal_7.signal_id, 0, f64, ARRAY_SIZE(f64)));
+    assert_float_equal(1.0, f64[0], 1e-15);
+    // sample and summary statistics share unscaled units at every zoom level
+    int64_t increments[] = {10, 1000, sample_count};
+    for (size_t i = 0; i < ARRAY_SIZE(increments); ++i) {
+        assert_int_equal(0, jls_rd_fsr_statistics(rd, signal_7.signal_id, 0, increments[i], stats, 1));
+        assert_float_equal(16.0, stats[JLS_SUMMARY_FSR_MEAN], 1e-9);
+        assert_float_equal(16.0, stats[JLS_SUMMARY_FSR_MAX], 1e-9);
+    }
+    jls_rd_close(rd);
+    remove(filename);
+    free(src);
+}
+
+static uint8_t unpack_sample(const uint8_t * src, int64_t idx, uint8_t bits) {
+    int64_t bit = idx * bits;
+    return (uint8_t) ((src[bit >> 3] >> (bit & 7)) & ((1 << bits) - 1));
+}
+
+static void test_fsr_u8(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = 5000;
+    uint8_t * src = malloc(sample_count);
+    uint8_t * dst = malloc(sample_count + 1);
+    uint32_t data_types[] = {JLS_DATATYPE_U1, JLS_DATATYPE_U4, JLS_DATATYPE_U8};
+    struct jls_signal_def_s signal_7 = SIGNAL_5;
+    signal_7.signal_id = 7;
+
+    for (uint32_t idx = 0; idx < ARRAY_SIZE(data_types); ++idx) {
+        uint8_t bits = jls_datatype_parse_size(data_types[idx]);
+        memset(src, 0, sample_count);
+        for (int64_t i = 0; i < sample_count; ++i) {
+            pack_bits(src, i, bits, (i * 7 + i / 3) & ((1 << bits) - 1));
+        }
+        signal_7.data_type = data_types[idx];
+        assert_int_equal(0, jls_wr_open(&wr, filename));
+        assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+        assert_int_equal(0, jls_wr_signal_def(wr, &signal_7));
+        assert_int_equal(0, jls_wr_fsr(wr, signal_7.signal_id, 0, src, (uint32_t) sample_count));
+        assert_int_equal(0, jls_wr_close(wr));
+
+        struct jls_rd_s * rd = NULL;
+        assert_int_equal(0, jls_rd_open(&rd, filename));
+        for (int64_t start = 0; start < 20; start += 3) {
+            int64_t length = sample_count - start - 7;
+            dst[length] = 0xcc;
+            assert_int_equal(0, jls_rd_fsr_u8(rd, signal_7.signal_id, start, dst, length));
+            for (int64_t i = 0; i < length; ++i) {
+                assert_int_equal(unpack_sample(src, start + i, bits), dst[i]);
+            }
+            assert_int_equal(0xcc, dst[length]);
+        }
+        jls_rd_close(rd);
+        remove(filename);
+    }
+
+    signal_7.data_type = JLS_DATATYPE_I4;
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &signal_7));
+    assert_int_equal(0, jls_wr_fsr(wr, signal_7.signal_id, 0, src, 100));
+    assert_int_equal(0, jls_wr_close(wr));
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID, jls_rd_fsr_u8(rd, signal_7.signal_id, 0, dst, 10));
+    jls_rd_close(rd);
+    remove(filename);
+    free(src);
+    free(dst);
+}
+
+static void test_fsr_sub_byte_dup(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = 3000;
+    uint8_t * src = malloc(sample_count);
+    uint8_t * dst = malloc(sample_count);
+    uint32_t data_types[] = {JLS_DATATYPE_U1, JLS_DATATYPE_U4};
+    struct jls_signal_def_s signal_7 = SIGNAL_5;
+    signal_7.signal_id = 7;
+
+    for (uint32_t idx = 0; idx < ARRAY_SIZE(data_types); ++idx) {
+        uint8_t bits = jls_datatype_parse_size(data_types[idx]);
+        memset(src, 0, sample_count);
+        for (int64_t i = 0; i < sample_count; ++i) {
+            pack_bits(src, i, bits, (i * 5 + i / 7) & ((1 << bits) - 1));
+        }
+        signal_7.data_type = data_types[idx];
+        assert_int_equal(0, jls_wr_open(&wr, filename));
+        assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+        assert_int_equal(0, jls_wr_signal_def(wr, &signal_7));
+        // each write overlaps the previous write by a sub-byte sample count
+        int64_t written = 0;
+        int64_t overlap = 0;
+        while (written < sample_count) {
+            int64_t start = written - overlap;
+            int64_t length = 101 + overlap;
+            if ((start + length) > sample_count) {
+                length = sample_count - start;
+            }
+            uint8_t * buf = calloc(1, (size_t) length);
+            for (int64_t i = 0; i < length; ++i) {
+                pack_bits(buf, i, bits, unpack_sample(src, start + i, bits));
+            }
+            assert_int_equal(0, jls_wr_fsr(wr, signal_7.signal_id, start, buf, (uint32_t) length));
+            free(buf);
+            written = start + length;
+            overlap = (overlap + 3) % 8;
+        }
+        assert_int_equal(0, jls_wr_close(wr));
+
+        struct jls_rd_s * rd = NULL;
+        assert_int_equal(0, jls_rd_open(&rd, filename));
+        int64_t samples = 0;
+        assert_int_equal(0, jls_rd_fsr_length(rd, signal_7.signal_id, &samples));
+        assert_int_equal(sample_count, samples);
+        assert_int_equal(0, jls_rd_fsr_u8(rd, signal_7.signal_id, 0, dst, sample_count));
+        for (int64_t i = 0; i < sample_count; ++i) {
+            assert_int_equal(unpack_sample(src, i, bits), dst[i]);
+        }
+        jls_rd_close(rd);
+        remove(filename);
+    }
+    free(src);
+    free(dst);
+}
+
 // todo static void test_fsr_uint_fp(void **state)
 // todo static void test_fsr_int_fp(void **state)
 
@@ -1106,6 +1366,1595 @@ static void test_fsr_u1_auto_def(void **state) {
     remove(filename);
 }
 
+static void test_fsr_iter_f32(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = WINDOW_SIZE * 1000;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    for (int sample_id = 0; sample_id < sample_count; sample_id += WINDOW_SIZE) {
+        assert_int_equal(0, jls_wr_fsr_f32(wr, 5, sample_id, signal + sample_id, WINDOW_SIZE));
+    }
+    assert_int_equal(0, jls_wr_close(wr));
+
+    struct jls_rd_s * rd = NULL;
+    struct jls_rd_fsr_iter_s * iter = NULL;
+    const void * data = NULL;
+    int64_t sample_id = 0;
+    int64_t count = 0;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+
+    // full file scan
+    int64_t expect_sample_id = 0;
+    assert_int_equal(0, jls_rd_fsr_iter_open(rd, 5, 0, sample_count, &iter));
+    while (0 == jls_rd_fsr_iter_next(iter, &data, &sample_id, &count)) {
+        assert_int_equal(expect_sample_id, sample_id);
+        assert_true(count > 0);
+        assert_memory_equal(signal + sample_id, data, count * sizeof(float));
+        expect_sample_id += count;
+    }
+    assert_int_equal(sample_count, expect_sample_id);
+    assert_int_equal(JLS_ERROR_EMPTY, jls_rd_fsr_iter_next(iter, &data, &sample_id, &count));
+    jls_rd_fsr_iter_close(iter);
+
+    // partial span with interleaved random access reads
+    float tmp[10];
+    expect_sample_id = 1999;
+    assert_int_equal(0, jls_rd_fsr_iter_open(rd, 5, 1999, 5002, &iter));
+    while (0 == jls_rd_fsr_iter_next(iter, &data, &sample_id, &count)) {
+        assert_int_equal(expect_sample_id, sample_id);
+        assert_memory_equal(signal + sample_id, data, count * sizeof(float));
+        expect_sample_id += count;
+        assert_int_equal(0, jls_rd_fsr_f32(rd, 5, sample_count - 10, tmp, 10));
+    }
+    assert_int_equal(1999 + 5002, expect_sample_id);
+    jls_rd_fsr_iter_close(iter);
+
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID, jls_rd_fsr_iter_open(rd, 5, sample_count - 5, 10, &iter));
+    assert_null(iter);
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID, jls_rd_fsr_iter_open(rd, 5, -1, 10, &iter));
+
+    jls_rd_close(rd);
+    free(signal);
+    remove(filename);
+}
+
+static void test_fsr_iter_u1(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = 8000;
+    uint8_t signal[8000 / 8];
+    for (size_t i = 0; i < sizeof(signal); ++i) {
+        signal[i] = (uint8_t) ((i * 37) ^ (i >> 3));
+    }
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_9_U1));
+    assert_int_equal(0, jls_wr_fsr(wr, 9, 0, signal, (uint32_t) sample_count));
+    assert_int_equal(0, jls_wr_close(wr));
+
+    struct jls_rd_s * rd = NULL;
+    struct jls_rd_fsr_iter_s * iter = NULL;
+    const void * data = NULL;
+    int64_t sample_id = 0;
+    int64_t count = 0;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+
+    int64_t start = 1003;
+    int64_t expect_sample_id = start;
+    assert_int_equal(0, jls_rd_fsr_iter_open(rd, 9, start, sample_count - start, &iter));
+    while (0 == jls_rd_fsr_iter_next(iter, &data, &sample_id, &count)) {
+        assert_int_equal(expect_sample_id, sample_id);
+        const uint8_t * u8 = (const uint8_t *) data;
+        for (int64_t i = 0; i < count; ++i) {
+            int64_t k = sample_id + i;
+            uint8_t expect = (signal[k >> 3] >> (k & 7)) & 1;
+            assert_int_equal(expect, (u8[i >> 3] >> (i & 7)) & 1);
+        }
+        expect_sample_id += count;
+    }
+    assert_int_equal(sample_count, expect_sample_id);
+    jls_rd_fsr_iter_close(iter);
+
+    jls_rd_close(rd);
+    remove(filename);
+}
+
+static void test_fsr_f64_statistics(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = 10000;
+    double * data = malloc(sample_count * sizeof(double));
+    for (int64_t i = 0; i < sample_count; ++i) {
+        data[i] = 1.0 + 0.25 * (double) (i % 13);
+    }
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_8));
+    assert_int_equal(0, jls_wr_fsr(wr, 8, 0, data, (uint32_t) sample_count));
+    assert_int_equal(0, jls_wr_close(wr));
+
+    struct jls_rd_s * rd = NULL;
+    double stats[5][JLS_SUMMARY_FSR_COUNT];
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 8, 33, 10, &stats[0][0], 5));
+    for (int64_t k = 0; k < 5; ++k) {
+        double mean = 0.0;
+        double v_min = data[33 + k * 10];
+        double v_max = v_min;
+        for (int64_t i = 0; i < 10; ++i) {
+            double v = data[33 + k * 10 + i];
+            mean += v;
+            v_min = (v < v_min) ? v : v_min;
+            v_max = (v > v_max) ? v : v_max;
+        }
+        mean /= 10.0;
+        assert_float_equal(mean, stats[k][JLS_SUMMARY_FSR_MEAN], 1e-12);
+        assert_float_equal(v_min, stats[k][JLS_SUMMARY_FSR_MIN], 1e-12);
+        assert_float_equal(v_max, stats[k][JLS_SUMMARY_FSR_MAX], 1e-12);
+    }
+    jls_rd_close(rd);
+    free(data);
+    remove(filename);
+}
+
+static void test_fsr_multi(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = WINDOW_SIZE * 20;
+    float * signal = gen_triangle(1000, sample_count);
+    double * signal_f64 = malloc(sample_count * sizeof(double));
+    uint8_t * signal_u1 = calloc(1, sample_count / 8 + 1);
+    for (int64_t i = 0; i < sample_count; ++i) {
+        signal_f64[i] = -signal[i];
+        if ((i % 11) < 5) {
+            signal_u1[i >> 3] |= (uint8_t) (1 << (i & 7));
+        }
+    }
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_8));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_9_U1));
+    for (int sample_id = 0; sample_id < sample_count; sample_id += 1000) {
+        assert_int_equal(0, jls_wr_fsr_f32(wr, 5, sample_id, signal + sample_id, 1000));
+        assert_int_equal(0, jls_wr_fsr(wr, 8, sample_id, signal_f64 + sample_id, 1000));
+        assert_int_equal(0, jls_wr_fsr(wr, 9, sample_id, signal_u1 + sample_id / 8, 1000));
+    }
+    assert_int_equal(0, jls_wr_close(wr));
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    const uint16_t signal_ids[] = {5, 8, 9};
+    int64_t start = 1237;
+    int64_t length = sample_count - start - 3;
+    float * y_f32 = malloc(length * sizeof(float));
+    double * y_f64 = malloc(length * sizeof(double));
+    uint8_t * y_u1 = calloc(1, length / 8 + 2);
+    uint8_t * expect_u1 = calloc(1, length / 8 + 2);
+    void * const data[] = {y_f32, y_f64, y_u1};
+    assert_int_equal(0, jls_rd_fsr_multi(rd, signal_ids, 3, start, length, data));
+    assert_memory_equal(signal + start, y_f32, length * sizeof(float));
+    assert_memory_equal(signal_f64 + start, y_f64, length * sizeof(double));
+    assert_int_equal(0, jls_rd_fsr(rd, 9, start, expect_u1, length));
+    assert_memory_equal(expect_u1, y_u1, length / 8);
+
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID, jls_rd_fsr_multi(rd, signal_ids, 3, start, sample_count, data));
+    jls_rd_close(rd);
+    free(y_f32);
+    free(y_f64);
+    free(y_u1);
+    free(expect_u1);
+    free(signal);
+    free(signal_f64);
+    free(signal_u1);
+    remove(filename);
+}
+
+static void test_virtual(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = 100000;
+    float * current = gen_triangle(1000, sample_count);
+    double * voltage = malloc(sample_count * sizeof(double));
+    for (int64_t i = 0; i < sample_count; ++i) {
+        voltage[i] = 2.0 + 0.001 * (double) (i % 17);
+    }
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_8));
+    assert_int_equal(0, jls_wr_fsr_f32(wr, 5, 0, current, (uint32_t) sample_count));
+    assert_int_equal(0, jls_wr_fsr(wr, 8, 0, voltage, (uint32_t) sample_count));
+    assert_int_equal(0, jls_wr_close(wr));
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    struct jls_rd_virtual_def_s power = {
+        .signal_id = 20, .op = JLS_RD_VIRTUAL_OP_PRODUCT, .source_ids = {5, 8},
+        .gain = 1.0, .offset = 0.0, .name = "power", .units = "W"};
+    struct jls_rd_virtual_def_s scaled = {
+        .signal_id = 21, .op = JLS_RD_VIRTUAL_OP_SCALE, .source_ids = {5, 0},
+        .gain = -1000.0, .offset = 1.0, .name = "current_mA", .units = "mA"};
+    struct jls_rd_virtual_def_s energy = {
+        .signal_id = 22, .op = JLS_RD_VIRTUAL_OP_INTEGRAL, .source_ids = {20, 0},
+        .gain = 1.0, .offset = 0.0, .name = "energy", .units = "J"};
+    assert_int_equal(0, jls_rd_virtual_def(rd, &power));
+    assert_int_equal(0, jls_rd_virtual_def(rd, &scaled));
+    assert_int_equal(0, jls_rd_virtual_def(rd, &energy));
+    assert_int_equal(JLS_ERROR_ALREADY_EXISTS, jls_rd_virtual_def(rd, &power));
+    power.signal_id = 5;
+    assert_int_equal(JLS_ERROR_ALREADY_EXISTS, jls_rd_virtual_def(rd, &power));
+
+    struct jls_signal_def_s * signals = NULL;
+    uint16_t count = 0;
+    assert_int_equal(0, jls_rd_signals(rd, &signals, &count));
+    assert_int_equal(6, count);
+    assert_int_equal(20, signals[3].signal_id);
+    assert_string_equal("power", signals[3].name);
+    assert_int_equal(JLS_DATATYPE_F64, signals[3].data_type);
+
+    int64_t samples = 0;
+    assert_int_equal(0, jls_rd_fsr_length(rd, 20, &samples));
+    assert_int_equal(sample_count, samples);
+
+    // sample data
+    double y[1000];
+    assert_int_equal(0, jls_rd_fsr(rd, 20, 5003, y, 1000));
+    for (int64_t i = 0; i < 1000; ++i) {
+        assert_float_equal(current[5003 + i] * voltage[5003 + i], y[i], 1e-9);
+    }
+    double accum = 0.0;
+    for (int64_t i = 0; i < 5003; ++i) {
+        accum += current[i] * voltage[i];
+    }
+    assert_int_equal(0, jls_rd_fsr_as_f64(rd, 22, 5003, y, 10));
+    for (int64_t i = 0; i < 10; ++i) {
+        accum += current[5003 + i] * voltage[5003 + i];
+        assert_float_equal(accum / SIGNAL_5.sample_rate, y[i], 1e-9);
+    }
+
+    // statistics: scale uses summaries, product uses samples
+    double stats[4][JLS_SUMMARY_FSR_COUNT];
+    double src_stats[4][JLS_SUMMARY_FSR_COUNT];
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, 0, 20000, &src_stats[0][0], 4));
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 21, 0, 20000, &stats[0][0], 4));
+    for (int i = 0; i < 4; ++i) {
+        assert_float_equal(-1000.0 * src_stats[i][JLS_SUMMARY_FSR_MEAN] + 1.0, stats[i][JLS_SUMMARY_FSR_MEAN], 1e-6);
+        assert_float_equal(1000.0 * src_stats[i][JLS_SUMMARY_FSR_STD], stats[i][JLS_SUMMARY_FSR_STD], 1e-6);
+        assert_float_equal(-1000.0 * src_stats[i][JLS_SUMMARY_FSR_MAX] + 1.0, stats[i][JLS_SUMMARY_FSR_MIN], 1e-6);
+        assert_float_equal(-1000.0 * src_stats[i][JLS_SUMMARY_FSR_MIN] + 1.0, stats[i][JLS_SUMMARY_FSR_MAX], 1e-6);
+    }
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 20, 100, 1000, &stats[0][0], 2));
+    double p_mean = 0.0;
+    double p_min = 1e9;
+    double p_max = -1e9;
+    for (int64_t i = 1100; i < 2100; ++i) {
+        double p = current[i] * voltage[i];
+        p_mean += p;
+        p_min = (p < p_min) ? p : p_min;
+        p_max = (p > p_max) ? p : p_max;
+    }
+    assert_float_equal(p_mean / 1000.0, stats[1][JLS_SUMMARY_FSR_MEAN], 1e-9);
+    assert_float_equal(p_min, stats[1][JLS_SUMMARY_FSR_MIN], 1e-9);
+    assert_float_equal(p_max, stats[1][JLS_SUMMARY_FSR_MAX], 1e-9);
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID, jls_rd_fsr_statistics(rd, 20, 0, sample_count, &stats[0][0], 2));
+
+    // sum and diff: exact at every increment
+    struct jls_rd_virtual_def_s diff = {
+        .signal_id = 23, .op = JLS_RD_VIRTUAL_OP_DIFF, .source_ids = {8, 5},
+        .gain = 2.0, .offset = 1.0, .name = "diff", .units = "V"};
+    diff.source_ids[1] = 99;  // undefined
+    assert_int_not_equal(0, jls_rd_virtual_def(rd, &diff));
+    diff.source_ids[1] = 0;   // not FSR
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID, jls_rd_virtual_def(rd, &diff));
+    diff.source_ids[1] = 5;
+    assert_int_equal(0, jls_rd_virtual_def(rd, &diff));
+    int64_t increments[] = {1000, 20000};
+    for (size_t k = 0; k < ARRAY_SIZE(increments); ++k) {
+        int64_t incr = increments[k];
+        for (int i = 0; i < 4; ++i) {
+            // data_length 1 is sample accurate
+            assert_int_equal(0, jls_rd_fsr_statistics(rd, 23, i * incr, incr, &stats[i][0], 1));
+            double d_mean = 0.0;
+            double d_min = 1e9;
+            double d_max = -1e9;
+            for (int64_t j = i * incr; j < (i + 1) * incr; ++j) {
+                double d = 2.0 * (voltage[j] - current[j]) + 1.0;
+                d_mean += d;
+                d_min = (d < d_min) ? d : d_min;
+                d_max = (d > d_max) ? d : d_max;
+            }
+            d_mean /= (double) incr;
+            double d_var = 0.0;
+            for (int64_t j = i * incr; j < (i + 1) * incr; ++j) {
+                double d = 2.0 * (voltage[j] - current[j]) + 1.0 - d_mean;
+                d_var += d * d;
+            }
+            double d_std = sqrt(d_var / (double) (incr - 1));
+            assert_float_equal(d_mean, stats[i][JLS_SUMMARY_FSR_MEAN], 1e-9);
+            assert_float_equal(d_std, stats[i][JLS_SUMMARY_FSR_STD], 1e-6);
+            assert_float_equal(d_min, stats[i][JLS_SUMMARY_FSR_MIN], 1e-9);
+            assert_float_equal(d_max, stats[i][JLS_SUMMARY_FSR_MAX], 1e-9);
+        }
+    }
+
+    jls_rd_close(rd);
+    free(current);
+    free(voltage);
+    remove(filename);
+}
+
+static void test_virtual_integral_nan(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = 100000;
+    float * current = gen_triangle(1000, sample_count);
+    for (int64_t i = 0; i < sample_count; i += 7) {
+        current[i] = NAN;
+    }
+    struct jls_signal_def_s signal_7 = SIGNAL_5;
+    signal_7.signal_id = 7;
+    signal_7.summary_fields = JLS_SUMMARY_FIELD_SUM | JLS_SUMMARY_FIELD_F64;
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    assert_int_equal(0, jls_wr_signal_def(wr, &signal_7));
+    assert_int_equal(0, jls_wr_fsr_f32(wr, 5, 0, current, (uint32_t) sample_count));
+    assert_int_equal(0, jls_wr_fsr_f32(wr, 7, 0, current, (uint32_t) sample_count));
+    assert_int_equal(0, jls_wr_close(wr));
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    // from samples and from the stored sum
+    struct jls_rd_virtual_def_s charge = {
+        .signal_id = 20, .op = JLS_RD_VIRTUAL_OP_INTEGRAL, .source_ids = {5, 0},
+        .gain = 1.0, .offset = 0.0, .name = "charge", .units = "C"};
+    assert_int_equal(0, jls_rd_virtual_def(rd, &charge));
+    charge.signal_id = 21;
+    charge.source_ids[0] = 7;
+    assert_int_equal(0, jls_rd_virtual_def(rd, &charge));
+
+    double y_full[200];
+    double y[100];
+    for (uint16_t signal_id = 20; signal_id <= 21; ++signal_id) {
+        assert_int_equal(0, jls_rd_fsr_as_f64(rd, signal_id, 54900, y_full, 200));
+        assert_int_equal(0, jls_rd_fsr_as_f64(rd, signal_id, 55000, y, 100));
+        double accum = 0.0;
+        for (int64_t i = 0; i < 55100; ++i) {
+            if (isfinite(current[i])) {
+                accum += current[i];
+            }
+            if (i >= 55000) {
+                assert_float_equal(y_full[i - 54900], y[i - 55000], 1e-9);
+            }
+        }
+        assert_float_equal(accum / SIGNAL_5.sample_rate, y[99], 1e-9);
+    }
+
+    jls_rd_close(rd);
+    free(current);
+    remove(filename);
+}
+
+static void test_wr_derived(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = 200000;
+    float * current = gen_triangle(1000, sample_count);
+    double * voltage = malloc(sample_count * sizeof(double));
+    for (int64_t i = 0; i < sample_count; ++i) {
+        voltage[i] = 2.0 + 0.001 * (double) (i % 17);
+    }
+    struct jls_signal_def_s power_def = SIGNAL_5;
+    power_def.signal_id = 20;
+    power_def.name = "power";
+    power_def.units = "W";
+    struct jls_wr_derived_def_s power = {
+        .op = JLS_WR_DERIVED_OP_PRODUCT, .source_count = 2, .source_ids = {5, 8},
+        .gain = 1.0, .offset = 0.0};
+    struct jls_signal_def_s energy_def = SIGNAL_8;
+    energy_def.signal_id = 21;
+    energy_def.name = "energy";
+    energy_def.units = "J";
+    struct jls_wr_derived_def_s energy = {
+        .op = JLS_WR_DERIVED_OP_INTEGRAL, .source_count = 1, .source_ids = {20},
+        .gain = 1.0, .offset = 0.0};
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_8));
+    assert_int_equal(JLS_ERROR_NOT_FOUND, jls_wr_signal_def_derived(wr, &energy_def, &energy));
+    assert_int_equal(0, jls_wr_signal_def_derived(wr, &power_def, &power));
+    assert_int_equal(0, jls_wr_signal_def_derived(wr, &energy_def, &energy));
+
+    // write sources with unaligned block sizes
+    int64_t i_idx = 0;
+    int64_t v_idx = 0;
+    while ((i_idx < sample_count) || (v_idx < sample_count)) {
+        if (i_idx < sample_count) {
+            uint32_t n = (uint32_t) (((sample_count - i_idx) < 1000) ? (sample_count - i_idx) : 1000);
+            assert_int_equal(0, jls_wr_fsr_f32(wr, 5, i_idx, current + i_idx, n));
+            i_idx += n;
+        }
+        if ((v_idx < sample_count) && (i_idx > 5000)) {
+            uint32_t n = (uint32_t) (((sample_count - v_idx) < 3333) ? (sample_count - v_idx) : 3333);
+            assert_int_equal(0, jls_wr_fsr(wr, 8, v_idx, voltage + v_idx, n));
+            v_idx += n;
+        }
+    }
+    float f = 0.0f;
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID, jls_wr_fsr_f32(wr, 20, sample_count, &f, 1));
+    assert_int_equal(0, jls_wr_close(wr));
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    int64_t samples = 0;
+    assert_int_equal(0, jls_rd_fsr_length(rd, 20, &samples));
+    assert_int_equal(sample_count, samples);
+    assert_int_equal(0, jls_rd_fsr_length(rd, 21, &samples));
+    assert_int_equal(sample_count, samples);
+
+    float p[1000];
+    assert_int_equal(0, jls_rd_fsr_f32(rd, 20, 123456, p, 1000));
+    for (int64_t i = 0; i < 1000; ++i) {
+        assert_float_equal((float) (current[123456 + i] * voltage[123456 + i]), p[i], 1e-6);
+    }
+
+    // summary statistics are exact for the product
+    double p_sum = 0.0;
+    for (int64_t i = 0; i < sample_count; ++i) {
+        p_sum += (double) (float) (current[i] * voltage[i]);
+    }
+    double stats[1][JLS_SUMMARY_FSR_COUNT];
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 20, 0, sample_count, &stats[0][0], 1));
+    assert_float_equal(p_sum / sample_count, stats[0][JLS_SUMMARY_FSR_MEAN], 1e-6);
+
+    double e = 0.0;
+    assert_int_equal(0, jls_rd_fsr(rd, 21, sample_count - 1, &e, 1));
+    assert_float_equal(p_sum / SIGNAL_5.sample_rate, e, 1e-9);
+
+    jls_rd_close(rd);
+    free(current);
+    free(voltage);
+    remove(filename);
+}
+
+static void test_fsr_summary_gap(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = 900000;
+    const int64_t gap_start = 52000;
+    const int64_t gap_end = 52500;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    assert_int_equal(0, jls_wr_fsr_f32(wr, 5, 0, signal, (uint32_t) gap_start));
+    assert_int_equal(0, jls_wr_fsr_f32(wr, 5, gap_end, signal + gap_end, (uint32_t) (sample_count - gap_end)));
+    assert_int_equal(0, jls_wr_close(wr));
+
+    // expected statistics for the level 2 entry containing the gap
+    double mean = 0.0;
+    double var = 0.0;
+    int64_t count = 0;
+    for (int64_t i = 50000; i < 60000; ++i) {
+        if ((i < gap_start) || (i >= gap_end)) {
+            mean += signal[i];
+            ++count;
+        }
+    }
+    mean /= count;
+    for (int64_t i = 50000; i < 60000; ++i) {
+        if ((i < gap_start) || (i >= gap_end)) {
+            var += (signal[i] - mean) * (signal[i] - mean);
+        }
+    }
+    var /= count;
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    double data[80][JLS_SUMMARY_FSR_COUNT];
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, 0, 10000, data[0], 80));
+    assert_float_equal(mean, data[5][JLS_SUMMARY_FSR_MEAN], 1e-6);
+    assert_float_equal(sqrt(var), data[5][JLS_SUMMARY_FSR_STD], 1e-6);
+    assert_float_equal(-1.0, data[5][JLS_SUMMARY_FSR_MIN], 1e-6);
+    assert_float_equal(1.0, data[5][JLS_SUMMARY_FSR_MAX], 1e-6);
+    compare_stats_f32(data[6], signal + 60000, 10000);
+    jls_rd_close(rd);
+    free(signal);
+    remove(filename);
+}
+
+static void check_summary_fields(const float * signal, int64_t start, int64_t end,
+                                 int64_t gap_start, int64_t gap_end, const double * data) {
+    double sum = 0.0;
+    double sum_sq = 0.0;
+    double first = NAN;
+    double last = NAN;
+    int64_t count = 0;
+    for (int64_t i = start; i < end; ++i) {
+        if ((i >= gap_start) && (i < gap_end)) {
+            continue;
+        }
+        if (!count) {
+            first = signal[i];
+        }
+        last = signal[i];
+        sum += signal[i];
+        sum_sq += signal[i] * (double) signal[i];
+        ++count;
+    }
+    const double * d = data + JLS_SUMMARY_FSR_COUNT;
+    assert_float_equal(sum, d[0], 1e-3);
+    assert_float_equal(sqrt(sum_sq / count), d[1], 1e-6);
+    assert_float_equal((double) count, d[2], 0.0);
+    assert_float_equal(first, d[3], 0.0);
+    assert_float_equal(last, d[4], 0.0);
+}
+
+static void test_fsr_summary_fields(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = 900000;
+    const int64_t gap_start = 52000;
+    const int64_t gap_end = 52500;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+    struct jls_signal_def_s signal_def = SIGNAL_5;
+    signal_def.summary_fields = JLS_SUMMARY_FIELD_ALL;
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &signal_def));
+    assert_int_equal(0, jls_wr_fsr_f32(wr, 5, 0, signal, (uint32_t) gap_start));
+    assert_int_equal(0, jls_wr_fsr_f32(wr, 5, gap_end, signal + gap_end, (uint32_t) (sample_count - gap_end)));
+    assert_int_equal(0, jls_wr_close(wr));
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    struct jls_signal_def_s s;
+    assert_int_equal(0, jls_rd_signal(rd, 5, &s));
+    assert_int_equal(JLS_SUMMARY_FIELD_ALL, s.summary_fields);
+    const int64_t incr = s.sample_decimate_factor * s.summary_decimate_factor;  // one level 2 entry
+
+    double base[80][JLS_SUMMARY_FSR_COUNT];
+    double data[80][JLS_SUMMARY_FSR_ENTRY_MAX];
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, 0, incr, base[0], 80));
+    assert_int_equal(0, jls_rd_fsr_statistics_ext(rd, 5, 0, incr, JLS_SUMMARY_FIELD_ALL, data[0], 80));
+    for (int i = 0; i < 80; ++i) {
+        for (int k = 0; k < JLS_SUMMARY_FSR_COUNT; ++k) {
+            assert_float_equal(base[i][k], data[i][k], 0.0);
+        }
+        check_summary_fields(signal, i * incr, (i + 1) * incr, gap_start, gap_end, data[i]);
+    }
+
+    // unaligned window spanning the gap
+    assert_int_equal(0, jls_rd_fsr_statistics_ext(rd, 5, 40123, 300000, JLS_SUMMARY_FIELD_ALL, data[0], 1));
+    check_summary_fields(signal, 40123, 340123, gap_start, gap_end, data[0]);
+
+    // subset of fields, packed in bit order
+    uint32_t fields = JLS_SUMMARY_FIELD_SUM | JLS_SUMMARY_FIELD_LAST;
+    double * d = data[0];
+    assert_int_equal(0, jls_rd_fsr_statistics_ext(rd, 5, 0, incr, fields, d, 2));
+    assert_float_equal(signal[incr - 1], d[JLS_SUMMARY_FSR_COUNT + 1], 0.0);
+    assert_float_equal(signal[2 * incr - 1], d[2 * JLS_SUMMARY_FSR_COUNT + 3], 0.0);
+    jls_rd_close(rd);
+
+    // fields not stored
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    assert_int_equal(0, jls_wr_fsr_f32(wr, 5, 0, signal, (uint32_t) sample_count));
+    assert_int_equal(0, jls_wr_close(wr));
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    assert_int_equal(JLS_ERROR_NOT_SUPPORTED,
+                     jls_rd_fsr_statistics_ext(rd, 5, 0, 10000, JLS_SUMMARY_FIELD_SUM, data[0], 1));
+    jls_rd_close(rd);
+    free(signal);
+    remove(filename);
+}
+
+static void test_fsr_summary_f64(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = 2000000;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+    for (int64_t i = 0; i < sample_count; ++i) {
+        signal[i] = 1000.0f + signal[i] * 0.001f;  // large DC offset
+    }
+    struct jls_signal_def_s signal_def = SIGNAL_5;
+    signal_def.summary_fields = JLS_SUMMARY_FIELD_F64 | JLS_SUMMARY_FIELD_SUM;
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &signal_def));
+    assert_int_equal(0, jls_wr_fsr_f32(wr, 5, 0, signal, (uint32_t) sample_count));
+    assert_int_equal(0, jls_wr_close(wr));
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    struct jls_signal_def_s s;
+    assert_int_equal(0, jls_rd_signal(rd, 5, &s));
+    assert_int_equal(signal_def.summary_fields, s.summary_fields);
+    const int64_t incr = s.sample_decimate_factor * s.summary_decimate_factor;
+    const int64_t length = (sample_count / incr) * incr;
+
+    double sum = 0.0;
+    double sum_c = 0.0;
+    for (int64_t i = 0; i < length; ++i) {  // Kahan reference
+        double y = signal[i] - sum_c;
+        double t = sum + y;
+        sum_c = (t - sum) - y;
+        sum = t;
+    }
+    double data[JLS_SUMMARY_FSR_ENTRY_MAX];
+    assert_int_equal(0, jls_rd_fsr_statistics_ext(rd, 5, 0, length, JLS_SUMMARY_FIELD_SUM, data, 1));
+    // assert_float_equal only has float precision
+    assert_true(fabs(sum - data[JLS_SUMMARY_FSR_COUNT]) < 1e-6);
+    jls_rd_close(rd);
+    free(signal);
+    remove(filename);
+}
+
+static int cmp_float(const void * a, const void * b) {
+    float fa = *((const float *) a);
+    float fb = *((const float *) b);
+    return (fa > fb) - (fa < fb);
+}
+
+static void check_quantiles(struct jls_rd_s * rd, const float * signal, int64_t start, int64_t length,
+                            double tolerance) {
+    const double q[] = {0.0, 0.01, 0.25, 0.5, 0.75, 0.99, 1.0};
+    double data[7];
+    assert_int_equal(0, jls_rd_fsr_quantiles(rd, 5, start, length, q, data, 7));
+    float * sorted = malloc(sizeof(float) * (size_t) length);
+    assert_non_null(sorted);
+    memcpy(sorted, signal + start, sizeof(float) * (size_t) length);
+    qsort(sorted, (size_t) length, sizeof(float), cmp_float);
+    for (int i = 0; i < 7; ++i) {
+        double expect = sorted[(int64_t) (q[i] * (length - 1))];
+        assert_true(fabs(expect - data[i]) <= tolerance);
+    }
+    assert_float_equal(sorted[0], data[0], 0.0);
+    assert_float_equal(sorted[length - 1], data[6], 0.0);
+    free(sorted);
+}
+
+static void test_fsr_quantiles(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = 4000000;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+    for (int64_t i = 0; i < sample_count; ++i) {
+        signal[i] = signal[i] * signal[i] * signal[i];  // non-uniform distribution
+    }
+    struct jls_signal_def_s signal_def = SIGNAL_5;
+    signal_def.summary_hist_bins = 100;
+    signal_def.summary_hist_min = -1.0f;
+    signal_def.summary_hist_max = 1.0f;
+    const double width = 2.0 / 100;
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &signal_def));
+    assert_int_equal(0, jls_wr_fsr_f32(wr, 5, 0, signal, (uint32_t) sample_count));
+    assert_int_equal(0, jls_wr_close(wr));
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    struct jls_signal_def_s s;
+    assert_int_equal(0, jls_rd_signal(rd, 5, &s));
+    assert_int_equal(100, s.summary_hist_bins);
+    assert_int_equal(2, s.summary_hist_level);
+    assert_float_equal(-1.0f, s.summary_hist_min, 0.0);
+    assert_float_equal(1.0f, s.summary_hist_max, 0.0);
+
+    // statistics unaffected by the histograms
+    double stats[JLS_SUMMARY_FSR_COUNT];
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, 12345, 2500000, stats, 1));
+    compare_stats_f32(stats, signal + 12345, 2500000);
+
+    check_quantiles(rd, signal, 12345, 3500000, width);  // multiple levels and edges
+    check_quantiles(rd, signal, 0, sample_count, width);
+    check_quantiles(rd, signal, 500, 5000, width);       // samples only
+
+    const double q_invalid = 1.5;
+    double v;
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID, jls_rd_fsr_quantiles(rd, 5, 0, 1000, &q_invalid, &v, 1));
+    jls_rd_close(rd);
+
+    // histograms not stored
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    assert_int_equal(0, jls_wr_fsr_f32(wr, 5, 0, signal, 100000));
+    assert_int_equal(0, jls_wr_close(wr));
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    const double q = 0.5;
+    assert_int_equal(JLS_ERROR_NOT_SUPPORTED, jls_rd_fsr_quantiles(rd, 5, 0, 1000, &q, &v, 1));
+    jls_rd_close(rd);
+    free(signal);
+    remove(filename);
+}
+
+static void test_fsr_quantiles_fixed_point(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = 300000;
+    int16_t * signal = malloc(sizeof(int16_t) * (size_t) sample_count);
+    assert_non_null(signal);
+    for (int64_t i = 0; i < sample_count; ++i) {
+        signal[i] = (i < 150000) ? 12800 : 25600;  // 50.0 and 100.0 with q = 8
+    }
+    struct jls_signal_def_s signal_def = SIGNAL_5;
+    signal_def.data_type = JLS_DATATYPE_DEF(INT, 16, 8);
+    signal_def.summary_hist_bins = 16;
+    signal_def.summary_hist_min = 0.0f;     // unscaled integer units
+    signal_def.summary_hist_max = 32768.0f;
+    const double width = 32768.0 / 16;
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &signal_def));
+    assert_int_equal(0, jls_wr_fsr(wr, 5, 0, signal, (uint32_t) sample_count));
+    assert_int_equal(0, jls_wr_close(wr));
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    const double q[] = {0.0, 0.25, 0.75, 1.0};
+    double v[4];
+    assert_int_equal(0, jls_rd_fsr_quantiles(rd, 5, 12345, 250000, q, v, 4));  // summaries and edge samples
+    assert_float_equal(12800.0, v[0], 0.0);
+    assert_float_equal(12800.0, v[1], width);
+    assert_float_equal(25600.0, v[2], width);
+    assert_float_equal(25600.0, v[3], 0.0);
+    assert_int_equal(0, jls_rd_fsr_quantiles(rd, 5, 149500, 1000, q, v, 4));  // samples only
+    assert_float_equal(12800.0, v[0], 0.0);
+    assert_float_equal(12800.0, v[1], width);
+    assert_float_equal(25600.0, v[2], width);
+    assert_float_equal(25600.0, v[3], 0.0);
+    jls_rd_close(rd);
+    free(signal);
+    remove(filename);
+}
+
+static void test_fsr_find_fixed_point(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = 300000;
+    int16_t * signal = malloc(sizeof(int16_t) * (size_t) sample_count);
+    assert_non_null(signal);
+    for (int64_t i = 0; i < sample_count; ++i) {
+        signal[i] = 25600;  // 100.0 with q = 8
+    }
+    signal[150000] = 12800;  // 50.0
+    struct jls_signal_def_s signal_def = SIGNAL_5;
+    signal_def.data_type = JLS_DATATYPE_DEF(INT, 16, 8);
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &signal_def));
+    assert_int_equal(0, jls_wr_fsr(wr, 5, 0, signal, (uint32_t) sample_count));
+    assert_int_equal(0, jls_wr_close(wr));
+
+    // thresholds in unscaled integer units, like the statistics
+    struct jls_rd_s * rd = NULL;
+    int64_t sample_id = -1;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    assert_int_equal(0, jls_rd_fsr_find(rd, 5, 0, sample_count, JLS_RD_FIND_LT, 19200.0, &sample_id));
+    assert_int_equal(150000, sample_id);
+    assert_int_equal(0, jls_rd_fsr_find(rd, 5, 149990, 150010, JLS_RD_FIND_LT, 19200.0, &sample_id));
+    assert_int_equal(150000, sample_id);
+    assert_int_equal(0, jls_rd_fsr_find(rd, 5, 150000, sample_count, JLS_RD_FIND_GT, 19200.0, &sample_id));
+    assert_int_equal(150001, sample_id);
+    assert_int_equal(0, jls_rd_fsr_find(rd, 5, 0, sample_count, JLS_RD_FIND_CROSS, 19200.0, &sample_id));
+    assert_int_equal(150000, sample_id);
+    assert_int_equal(JLS_ERROR_NOT_FOUND, jls_rd_fsr_find(rd, 5, 0, sample_count, JLS_RD_FIND_LT, 75.0, &sample_id));
+
+    struct jls_rd_fsr_find_iter_s * iter = NULL;
+    int64_t i0 = 0;
+    int64_t i1 = 0;
+    assert_int_equal(0, jls_rd_fsr_find_iter_open(rd, 5, 0, sample_count, JLS_RD_FIND_LT, 19200.0, &iter));
+    assert_int_equal(0, jls_rd_fsr_find_iter_next(iter, &i0, &i1));
+    assert_int_equal(150000, i0);
+    assert_int_equal(150001, i1);
+    assert_int_equal(JLS_ERROR_EMPTY, jls_rd_fsr_find_iter_next(iter, &i0, &i1));
+    jls_rd_fsr_find_iter_close(iter);
+    jls_rd_close(rd);
+    free(signal);
+    remove(filename);
+}
+
+static void test_fsr_find(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = 4000000;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+    for (int64_t i = 0; i < sample_count; ++i) {
+        signal[i] *= 0.5f;
+    }
+    for (int64_t i = 1234567; i < 1234617; ++i) {
+        signal[i] = 2.0f;
+    }
+    for (int64_t i = 3000000; i < 3000010; ++i) {
+        signal[i] = 2.0f;
+    }
+    signal[2500000] = -3.0f;
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    assert_int_equal(0, jls_wr_fsr_f32(wr, 5, 0, signal, (uint32_t) sample_count));
+    assert_int_equal(0, jls_wr_close(wr));
+
+    struct jls_rd_s * rd = NULL;
+    struct jls_stats_s stats;
+    int64_t sample_id = -1;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    assert_int_equal(0, jls_rd_stats_enable(rd, 1));
+    assert_int_equal(0, jls_rd_fsr_find(rd, 5, 0, sample_count, JLS_RD_FIND_GT, 1.0, &sample_id));
+    assert_int_equal(1234567, sample_id);
+    assert_int_equal(0, jls_rd_stats(rd, &stats));
+    assert_true(stats.chunk_rd[JLS_TAG_TRACK_FSR_DATA] <= 4);  // pruned by the summaries
+    assert_int_equal(0, jls_rd_fsr_find(rd, 5, 1234600, sample_count, JLS_RD_FIND_GT, 1.0, &sample_id));
+    assert_int_equal(1234600, sample_id);
+    assert_int_equal(0, jls_rd_fsr_find(rd, 5, 1234617, sample_count, JLS_RD_FIND_GT, 1.0, &sample_id));
+    assert_int_equal(3000000, sample_id);
+    assert_int_equal(JLS_ERROR_NOT_FOUND, jls_rd_fsr_find(rd, 5, 1234617, 3000000, JLS_RD_FIND_GT, 1.0, &sample_id));
+    assert_int_equal(0, jls_rd_fsr_find(rd, 5, 0, sample_count, JLS_RD_FIND_LT, -1.0, &sample_id));
+    assert_int_equal(2500000, sample_id);
+    assert_int_equal(0, jls_rd_fsr_find(rd, 5, 1234570, sample_count, JLS_RD_FIND_CROSS, 1.0, &sample_id));
+    assert_int_equal(1234617, sample_id);
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID,
+                     jls_rd_fsr_find(rd, 5, 0, sample_count + 1, JLS_RD_FIND_GT, 1.0, &sample_id));
+
+    // compare with a linear search
+    for (int64_t start = 777; start < sample_count; start += 390001) {
+        int64_t expect = start;
+        while (!(signal[expect] > 0.49)) {
+            ++expect;
+        }
+        assert_int_equal(0, jls_rd_fsr_find(rd, 5, start, sample_count, JLS_RD_FIND_GT, 0.49, &sample_id));
+        assert_int_equal(expect, sample_id);
+    }
+
+    struct jls_rd_fsr_find_iter_s * iter = NULL;
+    int64_t i0 = 0;
+    int64_t i1 = 0;
+    assert_int_equal(0, jls_rd_fsr_find_iter_open(rd, 5, 0, sample_count, JLS_RD_FIND_GT, 1.0, &iter));
+    assert_int_equal(0, jls_rd_fsr_find_iter_next(iter, &i0, &i1));
+    assert_int_equal(1234567, i0);
+    assert_int_equal(1234617, i1);
+    assert_int_equal(0, jls_rd_fsr_find_iter_next(iter, &i0, &i1));
+    assert_int_equal(3000000, i0);
+    assert_int_equal(3000010, i1);
+    assert_int_equal(JLS_ERROR_EMPTY, jls_rd_fsr_find_iter_next(iter, &i0, &i1));
+    jls_rd_fsr_find_iter_close(iter);
+
+    const int64_t cross[] = {1234567, 1234617, 3000000, 3000010, sample_count};
+    assert_int_equal(0, jls_rd_fsr_find_iter_open(rd, 5, 0, sample_count, JLS_RD_FIND_CROSS, 1.0, &iter));
+    for (int i = 0; i < 4; ++i) {
+        assert_int_equal(0, jls_rd_fsr_find_iter_next(iter, &i0, &i1));
+        assert_int_equal(cross[i], i0);
+        assert_int_equal(cross[i + 1], i1);
+    }
+    assert_int_equal(JLS_ERROR_EMPTY, jls_rd_fsr_find_iter_next(iter, &i0, &i1));
+    jls_rd_fsr_find_iter_close(iter);
+
+    jls_rd_close(rd);
+    free(signal);
+    remove(filename);
+}
+
+static void test_fsr_threads(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = 4000000;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+    for (int64_t i = 0; i < sample_count; ++i) {
+        signal[i] += 0.001f * (float) ((i * 7919) % 257);
+    }
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    assert_int_equal(0, jls_wr_fsr_f32(wr, 5, 0, signal, (uint32_t) sample_count));
+    assert_int_equal(0, jls_wr_close(wr));
+    free(signal);
+
+    struct {
+        int64_t start;
+        int64_t increment;
+        int64_t length;
+    } cases[] = {
+        {777, 1000, 3000},      // level 1, unaligned
+        {0, 1040, 3800},        // level 1, aligned
+        {12345, 10, 100000},    // level 0
+    };
+    struct jls_rd_s * rd = NULL;
+    struct jls_stats_s stats;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID, jls_rd_threads_set(rd, 65));
+    for (size_t k = 0; k < sizeof(cases) / sizeof(cases[0]); ++k) {
+        size_t sz = (size_t) cases[k].length * JLS_SUMMARY_FSR_COUNT * sizeof(double);
+        double * expect = malloc(sz);
+        double * actual = malloc(sz);
+        assert_non_null(expect);
+        assert_non_null(actual);
+        assert_int_equal(0, jls_rd_threads_set(rd, 0));
+        assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, cases[k].start, cases[k].increment,
+                                                  expect, cases[k].length));
+        assert_int_equal(0, jls_rd_threads_set(rd, 3));
+        assert_int_equal(0, jls_rd_stats_enable(rd, 1));
+        assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, cases[k].start, cases[k].increment,
+                                                  actual, cases[k].length));
+        assert_int_equal(0, jls_rd_stats(rd, &stats));
+        assert_int_equal(0, stats.header_rd);  // computed by the workers
+        assert_int_equal(0, jls_rd_stats_enable(rd, 0));
+        assert_memory_equal(expect, actual, sz);
+        free(expect);
+        free(actual);
+    }
+    jls_rd_close(rd);
+    remove(filename);
+}
+
+static void follow_check(struct jls_rd_s * rd, const float * signal, int64_t length, int closed) {
+    int64_t samples = 0;
+    struct jls_signal_def_s signal_def;
+    assert_int_equal(0, jls_rd_follow_update(rd));
+    assert_int_equal(0, jls_rd_signal(rd, 5, &signal_def));
+    if (!closed) {  // only complete data chunks are written
+        length -= length % signal_def.samples_per_data;
+    }
+    assert_int_equal(0, jls_rd_fsr_length(rd, 5, &samples));
+    assert_int_equal(length, samples);
+
+    // samples across the unindexed tail
+    int64_t start = length - 30000;
+    float * data = malloc(30000 * sizeof(float));
+    assert_non_null(data);
+    assert_int_equal(0, jls_rd_fsr_f32(rd, 5, start, data, 30000));
+    assert_memory_equal(signal + start, data, 30000 * sizeof(float));
+    free(data);
+
+    // aligned statistics spanning levels 2, 1 and 0
+    const int64_t increment = 10400;
+    const int64_t count = length / increment;
+    double * stats = malloc(count * JLS_SUMMARY_FSR_COUNT * sizeof(double));
+    assert_non_null(stats);
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, 0, increment, stats, count));
+    for (int64_t k = 0; k < count; ++k) {
+        double v_mean = 0.0;
+        for (int64_t i = k * increment; i < (k + 1) * increment; ++i) {
+            v_mean += signal[i];
+        }
+        v_mean /= increment;
+        assert_true(fabs(v_mean - stats[k * JLS_SUMMARY_FSR_COUNT + JLS_SUMMARY_FSR_MEAN]) < 1e-5);
+    }
+    free(stats);
+
+    // sample-accurate window across the summary coverage
+    double v_mean = 0.0;
+    for (int64_t i = 123; i < length - 77; ++i) {
+        v_mean += signal[i];
+    }
+    v_mean /= (length - 200);
+    double window[JLS_SUMMARY_FSR_COUNT];
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, 123, length - 200, window, 1));
+    assert_true(fabs(v_mean - window[JLS_SUMMARY_FSR_MEAN]) < 1e-5);
+}
+
+static void test_rd_follow(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    struct jls_rd_s * rd = NULL;
+    int64_t samples = -1;
+    const int64_t sample_count = 2507000;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    assert_int_equal(0, jls_wr_flush(wr));
+
+    assert_int_equal(0, jls_rd_open_follow(&rd, filename));
+    assert_int_equal(0, jls_rd_fsr_length(rd, 5, &samples));
+    assert_int_equal(0, samples);
+
+    // complete level 2 summary followed by a partial level 1
+    assert_int_equal(0, jls_wr_fsr_f32(wr, 5, 0, signal, 2500000));
+    follow_check(rd, signal, 2500000, 0);
+
+    // unindexed data chunks
+    assert_int_equal(0, jls_wr_fsr_f32(wr, 5, 2500000, signal + 2500000, 7000));
+    follow_check(rd, signal, sample_count, 0);
+
+    assert_int_equal(0, jls_wr_close(wr));
+    follow_check(rd, signal, sample_count, 1);
+    jls_rd_close(rd);
+
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    assert_int_equal(JLS_ERROR_NOT_SUPPORTED, jls_rd_follow_update(rd));
+    jls_rd_close(rd);
+    free(signal);
+    remove(filename);
+}
+
+static void sparse_gap_check(uint32_t data_type) {
+    struct jls_wr_s * wr = NULL;
+    struct jls_rd_s * rd = NULL;
+    struct jls_stats_s stats;
+    const int64_t length = 5000;
+    const int64_t gap_end = 3005123;
+    const int is_f32 = (data_type == JLS_DATATYPE_F32);
+    float * signal = gen_triangle(1000, length);
+    assert_non_null(signal);
+    int16_t signal_i16[5000];
+    for (int64_t i = 0; i < length; ++i) {
+        signal_i16[i] = (int16_t) (signal[i] * 1000.0f);
+    }
+    const void * src = is_f32 ? (const void *) signal : (const void *) signal_i16;
+    struct jls_signal_def_s signal_def = SIGNAL_5;
+    signal_def.data_type = data_type;
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_stats_enable(wr, 1));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &signal_def));
+    assert_int_equal(0, jls_wr_fsr(wr, 5, 0, src, (uint32_t) length));
+    assert_int_equal(0, jls_wr_fsr(wr, 5, gap_end, src, (uint32_t) length));
+    assert_int_equal(0, jls_wr_stats(wr, &stats));
+    assert_int_equal(0, jls_wr_close(wr));
+    if (is_f32) {
+        assert_true(stats.chunk_wr[JLS_TAG_TRACK_FSR_DATA] < 20);  // gap chunks omitted
+    } else {
+        assert_true(stats.chunk_wr[JLS_TAG_TRACK_FSR_DATA] > 3000);  // zero fill written for older readers
+    }
+
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    int64_t samples = 0;
+    assert_int_equal(0, jls_rd_fsr_length(rd, 5, &samples));
+    assert_int_equal(gap_end + length, samples);
+
+    float f32[5000];
+    int16_t i16[5000];
+    void * dst = is_f32 ? (void *) f32 : (void *) i16;
+    int64_t sample_ids[] = {0, gap_end, 1000000, length - 100, gap_end - 4900};
+    for (size_t k = 0; k < sizeof(sample_ids) / sizeof(sample_ids[0]); ++k) {
+        int64_t sample_id = sample_ids[k];
+        assert_int_equal(0, jls_rd_fsr(rd, 5, sample_id, dst, length));
+        for (int64_t i = 0; i < length; ++i) {
+            int64_t idx = sample_id + i;
+            int64_t src_idx = (idx < length) ? idx : ((idx >= gap_end) ? (idx - gap_end) : -1);
+            if (src_idx < 0) {
+                assert_true(is_f32 ? isnan(f32[i]) : (0 == i16[i]));
+            } else if (is_f32) {
+                assert_true(signal[src_idx] == f32[i]);
+            } else {
+                assert_int_equal(signal_i16[src_idx], i16[i]);
+            }
+        }
+    }
+
+    double mean = 0.0;
+    for (int64_t i = 0; i < length; ++i) {
+        mean += is_f32 ? signal[i] : signal_i16[i];
+    }
+    mean /= length;
+    double data[JLS_SUMMARY_FSR_COUNT];
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, gap_end, length, data, 1));
+    assert_true(fabs(mean - data[JLS_SUMMARY_FSR_MEAN]) < 1e-3);
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, 100000, 2000000, data, 1));
+    if (is_f32) {
+        assert_true(isnan(data[JLS_SUMMARY_FSR_MEAN]));
+    } else {
+        assert_true(fabs(data[JLS_SUMMARY_FSR_MEAN]) < 1e-9);
+        assert_true(fabs(data[JLS_SUMMARY_FSR_MAX]) < 1e-9);
+    }
+    jls_rd_close(rd);
+    free(signal);
+    remove(filename);
+}
+
+static void test_fsr_sparse_gap(void **state) {
+    (void) state;
+    sparse_gap_check(JLS_DATATYPE_F32);
+    sparse_gap_check(JLS_DATATYPE_I16);
+}
+
+static int32_t on_append_annotation(void * user_data, const struct jls_annotation_s * annotation) {
+    int64_t * count = (int64_t *) user_data;
+    assert_int_equal(*count * 1000, annotation->timestamp);
+    ++*count;
+    return 0;
+}
+
+static int32_t on_append_user_data(void * user_data, uint16_t chunk_meta, enum jls_storage_type_e storage_type,
+                                   uint8_t * data, uint32_t data_size) {
+    (void) storage_type;
+    (void) data;
+    (void) data_size;
+    int64_t * count = (int64_t *) user_data;
+    assert_int_equal(*count, chunk_meta);
+    ++*count;
+    return 0;
+}
+
+static int32_t on_append_utc(void * user_data, const struct jls_utc_summary_entry_s * utc, uint32_t size) {
+    int64_t * count = (int64_t *) user_data;
+    for (uint32_t i = 0; i < size; ++i) {
+        assert_int_equal(*count * 10000, utc[i].sample_id);
+        ++*count;
+    }
+    return 0;
+}
+
+static void append_write(struct jls_wr_s * wr, const float * signal, int64_t start, int64_t end) {
+    for (int64_t k = (start + 999) / 1000; k * 1000 < end; ++k) {
+        assert_int_equal(0, jls_wr_annotation(wr, 5, k * 1000, 1.0f, JLS_ANNOTATION_TYPE_TEXT, 0,
+                                              JLS_STORAGE_TYPE_STRING, (const uint8_t *) "hello", 0));
+    }
+    for (int64_t k = (start + 9999) / 10000; k * 10000 < end; ++k) {
+        assert_int_equal(0, jls_wr_utc(wr, 5, k * 10000, k * JLS_TIME_MILLISECOND));
+    }
+    assert_int_equal(0, jls_wr_user_data(wr, start ? 2 : 1, JLS_STORAGE_TYPE_STRING, (const uint8_t *) "hi", 0));
+    assert_int_equal(0, jls_wr_fsr_f32(wr, 5, start, signal + start, (uint32_t) (end - start)));
+}
+
+static void test_append(void **state) {
+    (void) state;
+    const char * filename_ref = "jls_test_tmp_ref.jls";
+    const int64_t split[] = {1234567, 2000000, 2400000};
+    const int64_t length = 2468013;
+    float * signal = gen_triangle(1000, length);
+    assert_non_null(signal);
+    struct jls_wr_s * wr = NULL;
+    struct jls_rd_s * rd = NULL;
+    struct jls_rd_s * rd_ref = NULL;
+
+    for (size_t s = 0; s < sizeof(split) / sizeof(split[0]); ++s) {
+        assert_int_equal(0, jls_wr_open(&wr, filename_ref));
+        assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+        assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+        append_write(wr, signal, 0, split[s]);
+        append_write(wr, signal, split[s], length);
+        assert_int_equal(0, jls_wr_close(wr));
+
+        assert_int_equal(0, jls_wr_open(&wr, filename));
+        assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+        assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+        append_write(wr, signal, 0, split[s]);
+        assert_int_equal(0, jls_wr_close(wr));
+        assert_int_equal(0, jls_wr_open_append(&wr, filename));
+        assert_int_equal(JLS_ERROR_ALREADY_EXISTS, jls_wr_signal_def(wr, &SIGNAL_5));
+        append_write(wr, signal, split[s], length);
+        assert_int_equal(0, jls_wr_close(wr));
+
+        assert_int_equal(0, jls_rd_open(&rd, filename));
+        assert_int_equal(0, jls_rd_open(&rd_ref, filename_ref));
+        int64_t samples = 0;
+        assert_int_equal(0, jls_rd_fsr_length(rd, 5, &samples));
+        assert_int_equal(length, samples);
+        float * data = malloc(length * sizeof(float));
+        assert_int_equal(0, jls_rd_fsr_f32(rd, 5, 0, data, length));
+        assert_memory_equal(signal, data, length * sizeof(float));
+        free(data);
+
+        double stats[128][JLS_SUMMARY_FSR_COUNT];
+        double stats_ref[128][JLS_SUMMARY_FSR_COUNT];
+        const int64_t increments[] = {20000, 200000, 2000000};
+        for (size_t k = 0; k < sizeof(increments) / sizeof(increments[0]); ++k) {
+            int64_t count = length / increments[k];
+            assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, 0, increments[k], stats[0], count));
+            assert_int_equal(0, jls_rd_fsr_statistics(rd_ref, 5, 0, increments[k], stats_ref[0], count));
+            for (int64_t i = 0; i < count; ++i) {
+                for (int j = 0; j < JLS_SUMMARY_FSR_COUNT; ++j) {
+                    assert_true(fabs(stats_ref[i][j] - stats[i][j]) < 1e-4);
+                }
+            }
+        }
+
+        int64_t count = 0;
+        assert_int_equal(0, jls_rd_annotations(rd, 5, 0, on_append_annotation, &count));
+        assert_int_equal((length + 999) / 1000, count);
+        count = 0;
+        assert_int_equal(0, jls_rd_utc(rd, 5, 0, on_append_utc, &count));
+        assert_int_equal((length + 9999) / 10000, count);
+        count = 1;
+        assert_int_equal(0, jls_rd_user_data(rd, on_append_user_data, &count));
+        assert_int_equal(3, count);
+        jls_rd_close(rd);
+        jls_rd_close(rd_ref);
+    }
+    free(signal);
+    remove(filename);
+    remove(filename_ref);
+}
+
+static void test_append_definitions(void **state) {
+    (void) state;
+    float data[1000];
+    for (int i = 0; i < 1000; ++i) {
+        data[i] = (float) i;
+    }
+    struct jls_signal_def_s signal_def = SIGNAL_8;
+    signal_def.source_id = 1;
+    signal_def.data_type = JLS_DATATYPE_F32;
+    struct jls_wr_s * wr = NULL;
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    assert_int_equal(0, jls_wr_fsr_f32(wr, 5, 0, data, 1000));
+    assert_int_equal(0, jls_wr_close(wr));
+
+    // link new definitions after the list tails found on open
+    assert_int_equal(0, jls_wr_open_append(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_1));
+    assert_int_equal(0, jls_wr_signal_def(wr, &signal_def));
+    assert_int_equal(0, jls_wr_fsr_f32(wr, 8, 0, data, 1000));
+    assert_int_equal(0, jls_wr_fsr_f32(wr, 5, 1000, data, 1000));
+    assert_int_equal(0, jls_wr_close(wr));
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    struct jls_source_def_s * sources = NULL;
+    uint16_t count = 0;
+    assert_int_equal(0, jls_rd_sources(rd, &sources, &count));
+    assert_int_equal(3, count);
+    assert_string_equal(SOURCE_1.name, sources[1].name);
+    assert_string_equal(SOURCE_3.name, sources[2].name);
+    struct jls_signal_def_s * signals = NULL;
+    assert_int_equal(0, jls_rd_signals(rd, &signals, &count));
+    assert_int_equal(3, count);
+    assert_int_equal(5, signals[1].signal_id);
+    assert_int_equal(8, signals[2].signal_id);
+    int64_t samples = 0;
+    assert_int_equal(0, jls_rd_fsr_length(rd, 5, &samples));
+    assert_int_equal(2000, samples);
+    assert_int_equal(0, jls_rd_fsr_length(rd, 8, &samples));
+    assert_int_equal(1000, samples);
+    float rd_data[1000];
+    assert_int_equal(0, jls_rd_fsr_f32(rd, 8, 0, rd_data, 1000));
+    assert_memory_equal(data, rd_data, sizeof(data));
+    jls_rd_close(rd);
+    remove(filename);
+}
+
+static void test_append_quantiles(void **state) {
+    (void) state;
+    const char * filename_ref = "jls_test_tmp_ref.jls";
+    const int64_t split = 1234567;
+    const int64_t length = 2468013;
+    float * signal = malloc(sizeof(float) * (size_t) length);
+    assert_non_null(signal);
+    for (int64_t i = 0; i < length; ++i) {
+        signal[i] = (i < split) ? 0.25f : 0.75f;
+    }
+    struct jls_signal_def_s signal_def = SIGNAL_5;
+    signal_def.summary_hist_bins = 10;
+    signal_def.summary_hist_min = 0.0f;
+    signal_def.summary_hist_max = 1.0f;
+    struct jls_wr_s * wr = NULL;
+    struct jls_rd_s * rd = NULL;
+    struct jls_rd_s * rd_ref = NULL;
+
+    assert_int_equal(0, jls_wr_open(&wr, filename_ref));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &signal_def));
+    assert_int_equal(0, jls_wr_fsr_f32(wr, 5, 0, signal, (uint32_t) length));
+    assert_int_equal(0, jls_wr_close(wr));
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &signal_def));
+    assert_int_equal(0, jls_wr_fsr_f32(wr, 5, 0, signal, (uint32_t) split));
+    assert_int_equal(0, jls_wr_close(wr));
+    assert_int_equal(0, jls_wr_open_append(&wr, filename));
+    assert_int_equal(0, jls_wr_fsr_f32(wr, 5, split, signal + split, (uint32_t) (length - split)));
+    assert_int_equal(0, jls_wr_close(wr));
+
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    assert_int_equal(0, jls_rd_open(&rd_ref, filename_ref));
+    const double q[] = {0.0, 0.1, 0.3, 0.5, 0.9, 1.0};
+    double v[6];
+    double v_ref[6];
+    const int64_t windows[][2] = {
+        {1200000, 100000},
+        {1000000, 1000000},
+        {0, length},
+        {12345, 2400000},
+    };
+    for (size_t w = 0; w < sizeof(windows) / sizeof(windows[0]); ++w) {
+        assert_int_equal(0, jls_rd_fsr_quantiles(rd, 5, windows[w][0], windows[w][1], q, v, 6));
+        assert_int_equal(0, jls_rd_fsr_quantiles(rd_ref, 5, windows[w][0], windows[w][1], q, v_ref, 6));
+        for (int i = 0; i < 6; ++i) {
+            assert_float_equal(v_ref[i], v[i], 1e-9);
+        }
+    }
+    assert_int_equal(0, jls_rd_fsr_quantiles(rd, 5, 1200000, 100000, q, v, 6));
+    assert_true(v[2] < 0.5);   // 34567 of 100000 samples at 0.25
+    jls_rd_close(rd);
+    jls_rd_close(rd_ref);
+    free(signal);
+    remove(filename);
+    remove(filename_ref);
+}
+
+static int32_t on_slice_annotation(void * user_data, const struct jls_annotation_s * annotation) {
+    (void) annotation;
+    int64_t * count = (int64_t *) user_data;
+    ++*count;
+    return 0;
+}
+
+static int32_t on_slice_utc(void * user_data, const struct jls_utc_summary_entry_s * utc, uint32_t size) {
+    (void) utc;
+    int64_t * count = (int64_t *) user_data;
+    *count += size;
+    return 0;
+}
+
+static void test_slice(void **state) {
+    (void) state;
+    const char * filename_slice = "jls_test_tmp_slice.jls";
+    const char * filename_ref = "jls_test_tmp_ref.jls";
+    const int64_t length = 2468013;
+    // samples_per_data rounds up to 1040, so only the first two ranges copy chunks verbatim
+    const int64_t ranges[][2] = {{0, -1}, {3120, 1999017}, {12345, 1234567}, {2400000, 2400500}};
+    float * signal = gen_triangle(1000, length);
+    assert_non_null(signal);
+    struct jls_wr_s * wr = NULL;
+    struct jls_rd_s * rd = NULL;
+    struct jls_rd_s * rd_src = NULL;
+    struct jls_rd_s * rd_ref = NULL;
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    append_write(wr, signal, 0, length);
+    assert_int_equal(0, jls_wr_close(wr));
+    uint16_t signal_ids[] = {1};
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID, jls_slice(filename, filename_slice, signal_ids, 1, 0, -1));
+    assert_int_equal(0, jls_rd_open(&rd_src, filename));
+
+    for (size_t r = 0; r < sizeof(ranges) / sizeof(ranges[0]); ++r) {
+        int64_t start = ranges[r][0];
+        int64_t end = (ranges[r][1] < 0) ? length : ranges[r][1];
+        signal_ids[0] = 5;
+        assert_int_equal(0, jls_slice(filename, filename_slice, signal_ids, 1, start, ranges[r][1]));
+        assert_int_equal(0, jls_wr_open(&wr, filename_ref));
+        assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+        assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+        assert_int_equal(0, jls_wr_fsr_f32(wr, 5, 0, signal + start, (uint32_t) (end - start)));
+        assert_int_equal(0, jls_wr_close(wr));
+        assert_int_equal(0, jls_rd_open(&rd_ref, filename_ref));
+        assert_int_equal(0, jls_rd_open(&rd, filename_slice));
+        int64_t samples = 0;
+        assert_int_equal(0, jls_rd_fsr_length(rd, 5, &samples));
+        assert_int_equal(end - start, samples);
+        float * data = malloc(samples * sizeof(float));
+        assert_int_equal(0, jls_rd_fsr_f32(rd, 5, 0, data, samples));
+        assert_memory_equal(signal + start, data, samples * sizeof(float));
+        free(data);
+
+        double stats[128][JLS_SUMMARY_FSR_COUNT];
+        double stats_ref[128][JLS_SUMMARY_FSR_COUNT];
+        const int64_t increments[] = {100, 20000, 200000};
+        for (size_t k = 0; k < sizeof(increments) / sizeof(increments[0]); ++k) {
+            int64_t count = samples / increments[k];
+            if (count > 128) {
+                count = 128;
+            }
+            if (!count) {
+                continue;
+            }
+            assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, 0, increments[k], stats[0], count));
+            assert_int_equal(0, jls_rd_fsr_statistics(rd_ref, 5, 0, increments[k], stats_ref[0], count));
+            for (int64_t i = 0; i < count; ++i) {
+                for (int j = 0; j < JLS_SUMMARY_FSR_COUNT; ++j) {
+                    assert_true(fabs(stats_ref[i][j] - stats[i][j]) < 1e-4);
+                }
+            }
+        }
+
+        int64_t count = 0;
+        assert_int_equal(0, jls_rd_annotations(rd, 5, 0, on_slice_annotation, &count));
+        assert_int_equal((end + 999) / 1000 - (start + 999) / 1000, count);
+        count = 0;
+        assert_int_equal(0, jls_rd_utc(rd, 5, 0, on_slice_utc, &count));
+        assert_int_equal((end - 2) / 10000 - start / 10000 + 2, count);
+        int64_t t_src = 0;
+        int64_t t = 0;
+        assert_int_equal(0, jls_rd_sample_id_to_timestamp(rd_src, 5, start + 100, &t_src));
+        assert_int_equal(0, jls_rd_sample_id_to_timestamp(rd, 5, 100, &t));
+        assert_true(llabs(t_src - t) <= 1);
+        count = 1;
+        assert_int_equal(0, jls_rd_user_data(rd, on_append_user_data, &count));
+        assert_int_equal(2, count);
+        jls_rd_close(rd);
+        jls_rd_close(rd_ref);
+    }
+    jls_rd_close(rd_src);
+    free(signal);
+    remove(filename);
+    remove(filename_slice);
+    remove(filename_ref);
+}
+
+static int32_t on_concat_user_data(void * user_data, uint16_t chunk_meta, enum jls_storage_type_e storage_type,
+                                   uint8_t * data, uint32_t data_size) {
+    (void) chunk_meta;
+    (void) storage_type;
+    (void) data;
+    (void) data_size;
+    int64_t * count = (int64_t *) user_data;
+    ++*count;
+    return 0;
+}
+
+static void test_concat(void **state) {
+    (void) state;
+    const char * filenames[] = {"jls_test_tmp_c0.jls", "jls_test_tmp_c1.jls", "jls_test_tmp_c2.jls"};
+    const char * filename_ref = "jls_test_tmp_ref.jls";
+    // samples_per_data rounds up to 1040: copy chunks for file 1, decode file 2
+    const int64_t split[] = {0, 520000, 643457, 1043457};
+    const int64_t length = split[3];
+    float * signal = gen_triangle(1000, length);
+    assert_non_null(signal);
+    struct jls_wr_s * wr = NULL;
+    struct jls_rd_s * rd = NULL;
+    struct jls_rd_s * rd_ref = NULL;
+
+    for (int i = 0; i < 3; ++i) {
+        assert_int_equal(0, jls_wr_open(&wr, filenames[i]));
+        assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+        assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+        append_write(wr, signal, split[i], split[i + 1]);
+        assert_int_equal(0, jls_wr_close(wr));
+    }
+    assert_int_equal(0, jls_wr_open(&wr, filename_ref));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    append_write(wr, signal, 0, length);
+    assert_int_equal(0, jls_wr_close(wr));
+
+    assert_int_equal(0, jls_concat(filenames, 3, filename));
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    assert_int_equal(0, jls_rd_open(&rd_ref, filename_ref));
+    int64_t samples = 0;
+    assert_int_equal(0, jls_rd_fsr_length(rd, 5, &samples));
+    assert_int_equal(length, samples);
+    float * data = malloc(length * sizeof(float));
+    assert_int_equal(0, jls_rd_fsr_f32(rd, 5, 0, data, length));
+    assert_memory_equal(signal, data, length * sizeof(float));
+    free(data);
+
+    double stats[128][JLS_SUMMARY_FSR_COUNT];
+    double stats_ref[128][JLS_SUMMARY_FSR_COUNT];
+    const int64_t increments[] = {100, 10000, 200000};
+    for (size_t k = 0; k < sizeof(increments) / sizeof(increments[0]); ++k) {
+        int64_t count = length / increments[k];
+        count = (count > 128) ? 128 : count;
+        for (int64_t start = 0; start < length - count * increments[k]; start += 400000) {
+            assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, start, increments[k], stats[0], count));
+            assert_int_equal(0, jls_rd_fsr_statistics(rd_ref, 5, start, increments[k], stats_ref[0], count));
+            for (int64_t i = 0; i < count; ++i) {
+                for (int j = 0; j < JLS_SUMMARY_FSR_COUNT; ++j) {
+                    assert_true(fabs(stats_ref[i][j] - stats[i][j]) < 1e-4);
+                }
+            }
+        }
+    }
+
+    int64_t count = 0;
+    assert_int_equal(0, jls_rd_annotations(rd, 5, 0, on_append_annotation, &count));
+    assert_int_equal((length + 999) / 1000, count);
+    count = 0;
+    assert_int_equal(0, jls_rd_utc(rd, 5, 0, on_append_utc, &count));
+    assert_int_equal((length + 9999) / 10000, count);
+    count = 0;
+    assert_int_equal(0, jls_rd_user_data(rd, on_concat_user_data, &count));
+    assert_int_equal(3, count);
+    jls_rd_close(rd);
+    jls_rd_close(rd_ref);
+
+    struct jls_signal_def_s signal_def = SIGNAL_5;
+    signal_def.sample_rate = 200000;
+    assert_int_equal(0, jls_wr_open(&wr, filenames[2]));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &signal_def));
+    assert_int_equal(0, jls_wr_close(wr));
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID, jls_concat(filenames, 3, filename));
+
+    for (int i = 0; i < 3; ++i) {
+        remove(filenames[i]);
+    }
+    free(signal);
+    remove(filename);
+    remove(filename_ref);
+}
+
+static uint8_t * write_buffer_gen(const float * signal, int64_t sample_count, uint32_t write_buffer,
+                                  long * size, uint64_t * writes) {
+    struct jls_wr_s * wr = NULL;
+    struct jls_stats_s stats;
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_write_buffer(wr, write_buffer));
+    assert_int_equal(0, jls_wr_checkpoint_interval(wr, 1000000));
+    assert_int_equal(0, jls_wr_stats_enable(wr, 1));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    for (int64_t sample_id = 0; sample_id < sample_count; sample_id += WINDOW_SIZE) {
+        assert_int_equal(0, jls_wr_fsr_f32(wr, 5, sample_id, signal + sample_id, WINDOW_SIZE));
+        if (0 == (sample_id % (WINDOW_SIZE * 100))) {
+            assert_int_equal(0, jls_wr_annotation(wr, 5, sample_id, 1.0f, JLS_ANNOTATION_TYPE_TEXT, 0,
+                                                  JLS_STORAGE_TYPE_STRING, (const uint8_t *) "hi", 0));
+            assert_int_equal(0, jls_wr_utc(wr, 5, sample_id, sample_id * 1000));
+        }
+    }
+    assert_int_equal(0, jls_wr_stats(wr, &stats));
+    *writes = stats.writes;
+    assert_int_equal(0, jls_wr_close(wr));
+
+    FILE * f = fopen(filename, "rb");
+    assert_non_null(f);
+    fseek(f, 0L, SEEK_END);
+    *size = ftell(f);
+    fseek(f, 0L, SEEK_SET);
+    uint8_t * data = malloc(*size);
+    assert_non_null(data);
+    assert_int_equal(*size, fread(data, 1, *size, f));
+    fclose(f);
+    return data;
+}
+
+static void test_write_buffer(void **state) {
+    (void) state;
+    const int64_t sample_count = WINDOW_SIZE * 1000;
+    long expect_size = 0;
+    long size = 0;
+    uint64_t expect_writes = 0;
+    uint64_t writes = 0;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+
+    uint8_t * expect = write_buffer_gen(signal, sample_count, 0, &expect_size, &expect_writes);
+    uint8_t * data = write_buffer_gen(signal, sample_count, 1 << 20, &size, &writes);
+    assert_int_equal(expect_size, size);
+    assert_memory_equal(expect, data, size);
+    assert_true((writes * 20) < expect_writes);
+
+    struct jls_rd_s * rd = NULL;
+    int64_t samples = 0;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    assert_int_equal(0, jls_rd_fsr_length(rd, 5, &samples));
+    assert_int_equal(sample_count, samples);
+    jls_rd_close(rd);
+
+    free(data);
+    free(expect);
+    free(signal);
+    remove(filename);
+}
+
 #if !SKIP_REALWORLD
 static void test_fsr_f32_statistics_real(void **state) {
     (void) state;
@@ -1138,6 +2987,7 @@ static void test_fsr_annotation_real(void **state) {
 int main(void) {
     const struct CMUnitTest tests[] = {
 #if !SKIP_BASIC
+            cmocka_unit_test(test_open_empty_no_log),
             cmocka_unit_test(test_source),
             cmocka_unit_test(test_source_with_null_and_empty_str),
             cmocka_unit_test(test_wr_source_duplicate),
@@ -1163,6 +3013,10 @@ int main(void) {
             cmocka_unit_test(test_fsr_f64),
 
             cmocka_unit_test(test_fsr_samples_int_uint),
+            cmocka_unit_test(test_fsr_as_float),
+            cmocka_unit_test(test_fsr_fixed_point_statistics),
+            cmocka_unit_test(test_fsr_u8),
+            cmocka_unit_test(test_fsr_sub_byte_dup),
             cmocka_unit_test(test_fsr_statistics_u1),
 
             cmocka_unit_test(test_fsr_f32_sample_skip),
@@ -1170,6 +3024,29 @@ int main(void) {
             cmocka_unit_test(test_fsr_u1_len_1),
             cmocka_unit_test(test_fsr_u1_ones),
             cmocka_unit_test(test_fsr_u1_auto_def),
+            cmocka_unit_test(test_fsr_iter_f32),
+            cmocka_unit_test(test_fsr_iter_u1),
+            cmocka_unit_test(test_fsr_f64_statistics),
+            cmocka_unit_test(test_fsr_multi),
+            cmocka_unit_test(test_virtual),
+            cmocka_unit_test(test_virtual_integral_nan),
+            cmocka_unit_test(test_wr_derived),
+            cmocka_unit_test(test_fsr_summary_gap),
+            cmocka_unit_test(test_fsr_summary_fields),
+            cmocka_unit_test(test_fsr_summary_f64),
+            cmocka_unit_test(test_fsr_quantiles),
+            cmocka_unit_test(test_fsr_quantiles_fixed_point),
+            cmocka_unit_test(test_fsr_find),
+            cmocka_unit_test(test_fsr_find_fixed_point),
+            cmocka_unit_test(test_fsr_threads),
+            cmocka_unit_test(test_rd_follow),
+            cmocka_unit_test(test_fsr_sparse_gap),
+            cmocka_unit_test(test_append),
+            cmocka_unit_test(test_append_definitions),
+            cmocka_unit_test(test_append_quantiles),
+            cmocka_unit_test(test_slice),
+            cmocka_unit_test(test_concat),
+            cmocka_unit_test(test_write_buffer),
 
 #if !SKIP_REALWORLD
             cmocka_unit_test(test_fsr_f32_statistics_real),
@@ -23,6 +23,7 @@
 #include "jls/format.h"
 #include "jls/ec.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 
@@ -247,6 +248,93 @@ static void test_chunks_scan(void **state) {
     remove(filename);
 }
 
+static uint8_t * file_load(long * size) {
+    FILE * f = fopen(filename, "rb");
+    assert_non_null(f);
+    fseek(f, 0L, SEEK_END);
+    *size = ftell(f);
+    fseek(f, 0L, SEEK_SET);
+    uint8_t * data = malloc(*size);
+    assert_non_null(data);
+    assert_int_equal(*size, fread(data, 1, *size, f));
+    fclose(f);
+    remove(filename);
+    return data;
+}
+
+static uint8_t * construct_linked_chunks(uint32_t write_buffer, long * size) {
+    struct jls_raw_s * j = NULL;
+    struct jls_chunk_header_s hdr[2];
+    int64_t offset[2] = {0, 0};
+    uint8_t payload[3000];
+    for (size_t i = 0; i < sizeof(payload); ++i) {
+        payload[i] = (uint8_t) i;
+    }
+    assert_int_equal(0, jls_raw_open(&j, filename, "w"));
+    assert_int_equal(0, jls_raw_write_buffer(j, write_buffer));
+    for (uint32_t i = 0; i < 200; ++i) {
+        struct jls_chunk_header_s * prev = &hdr[i & 1];
+        int64_t pos_cur = jls_raw_chunk_tell(j);
+        struct jls_chunk_header_s h;
+        hdr_set(&h, JLS_TAG_USER_DATA, (uint16_t) i, 1 + ((i * 997) % sizeof(payload)));
+        h.item_prev = offset[i & 1];
+        assert_int_equal(0, jls_raw_wr(j, &h, payload));
+        int64_t pos_next = jls_raw_chunk_tell(j);
+        if (offset[i & 1]) {
+            // back-patch the previous item, like the linked list updates
+            prev->item_next = pos_cur;
+            assert_int_equal(0, jls_raw_chunk_seek(j, offset[i & 1]));
+            assert_int_equal(0, jls_raw_wr_header(j, prev));
+            assert_int_equal(0, jls_raw_chunk_seek(j, pos_next));
+        }
+        *prev = h;
+        offset[i & 1] = pos_cur;
+    }
+    assert_int_equal(0, jls_raw_close(j));
+    return file_load(size);
+}
+
+static void test_write_buffer(void **state) {
+    (void) state;
+    long expect_size = 0;
+    long size = 0;
+    uint8_t * expect = construct_linked_chunks(0, &expect_size);
+    uint32_t write_buffer[] = {4096, 10000, 1 << 20};
+    for (size_t i = 0; i < sizeof(write_buffer) / sizeof(write_buffer[0]); ++i) {
+        uint8_t * data = construct_linked_chunks(write_buffer[i], &size);
+        assert_int_equal(expect_size, size);
+        assert_memory_equal(expect, data, size);
+        free(data);
+    }
+    free(expect);
+}
+
+static void test_write_buffer_read(void **state) {
+    (void) state;
+    struct jls_raw_s * j = NULL;
+    struct jls_chunk_header_s hdr;
+    uint8_t data[sizeof(PAYLOAD1) + 16];
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID, jls_raw_write_buffer(NULL, 4096));
+    assert_int_equal(0, jls_raw_open(&j, filename, "w"));
+    assert_int_equal(0, jls_raw_write_buffer(j, 1 << 16));
+    int64_t pos1 = jls_raw_chunk_tell(j);
+    assert_int_equal(0, jls_raw_wr(j, hdr_set(&hdr, JLS_TAG_USER_DATA, 1, sizeof(PAYLOAD1)), PAYLOAD1));
+    assert_int_equal(0, jls_raw_wr(j, hdr_set(&hdr, JLS_TAG_USER_DATA, 2, 4), PAYLOAD1 + 4));
+    assert_int_equal(0, jls_raw_chunk_seek(j, pos1));
+    assert_int_equal(0, jls_raw_rd(j, &hdr, sizeof(data), data));
+    assert_int_equal(1, hdr.chunk_meta);
+    assert_memory_equal(PAYLOAD1, data, sizeof(PAYLOAD1));
+    assert_int_equal(0, jls_raw_rd(j, &hdr, sizeof(data), data));
+    assert_int_equal(2, hdr.chunk_meta);
+    assert_memory_equal(PAYLOAD1 + 4, data, 4);
+    assert_int_equal(0, jls_raw_close(j));
+
+    assert_int_equal(0, jls_raw_open(&j, filename, "r"));
+    assert_int_equal(JLS_ERROR_NOT_SUPPORTED, jls_raw_write_buffer(j, 4096));
+    assert_int_equal(0, jls_raw_close(j));
+    remove(filename);
+}
+
 int main(void) {
     const struct CMUnitTest tests[] = {
             cmocka_unit_test(test_invalid_open),
@@ -258,6 +346,8 @@ int main(void) {
             cmocka_unit_test(test_items_nav),
             cmocka_unit_test(test_tag_to_name),
             cmocka_unit_test(test_chunks_scan),
+            cmocka_unit_test(test_write_buffer),
+            cmocka_unit_test(test_write_buffer_read),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
@@ -27,6 +27,7 @@
 #include "jls/reader.h"
 #include "jls/writer.h"
 #include <math.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -261,6 +262,224 @@ static void test_truncate_samples_unclosed(void **state) {
     remove(filename);
 }
 
+static void gen_checkpoint(const char * path, float * signal, int64_t sample_count, int64_t checkpoint_interval,
+                           int64_t skip_sample_id) {
+    struct jls_wr_s * wr = NULL;
+    int64_t utc = JLS_TIME_YEAR;
+    assert_int_equal(0, jls_wr_open(&wr, path));
+    assert_int_equal(0, jls_wr_checkpoint_interval(wr, checkpoint_interval));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    for (int64_t sample_id = 0; sample_id < sample_count; sample_id += WINDOW_SIZE) {
+        bool skip = (skip_sample_id >= 0) && (sample_id >= skip_sample_id)
+                && (sample_id < (skip_sample_id + 5 * WINDOW_SIZE));
+        if (!skip) {
+            assert_int_equal(0, jls_wr_fsr_f32(wr, 5, sample_id, signal + sample_id, WINDOW_SIZE));
+        }
+        assert_int_equal(0, jls_wr_utc(wr, 5, sample_id, utc + JLS_COUNTER_TO_TIME(sample_id, SIGNAL_5.sample_rate)));
+        if (0 == (sample_id % (WINDOW_SIZE * 10))) {
+            assert_int_equal(0, jls_wr_annotation(wr, 5, sample_id, NAN, JLS_ANNOTATION_TYPE_TEXT,
+                                                  0, JLS_STORAGE_TYPE_STRING, (const uint8_t *) STRING_1, 0));
+        }
+    }
+    struct jls_core_s * core = (struct jls_core_s *) wr;
+    jls_bk_fclose(jls_raw_backend(core->raw));  // skip close
+}
+
+static int32_t on_checkpoint_annotation(void * user_data, const struct jls_annotation_s * annotation) {
+    int64_t * count = (int64_t *) user_data;
+    assert_int_equal(*count * WINDOW_SIZE * 10, annotation->timestamp);
+    ++*count;
+    return 0;
+}
+
+static int32_t on_checkpoint_utc(void * user_data, const struct jls_utc_summary_entry_s * utc, uint32_t size) {
+    int64_t * count = (int64_t *) user_data;
+    for (uint32_t i = 0; i < size; ++i) {
+        assert_int_equal(*count * WINDOW_SIZE, utc[i].sample_id);
+        ++*count;
+    }
+    return 0;
+}
+
+static void checkpoint_check(int64_t skip_sample_id) {
+    const char * filename_ref = "jls_test_tmp_ref.jls";
+    int64_t sample_count = WINDOW_SIZE * 1000;
+    int64_t sample_count_truncated = 0xe4840;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+    gen_checkpoint(filename_ref, signal, sample_count, 0, skip_sample_id);
+    gen_checkpoint(filename, signal, sample_count, 256 * 1024, skip_sample_id);
+
+    struct jls_rd_s * rd = NULL;
+    struct jls_rd_s * rd_ref = NULL;
+    assert_int_equal(0, jls_rd_open(&rd_ref, filename_ref));  // full repair
+    assert_int_equal(0, jls_rd_open(&rd, filename));  // recover from checkpoint
+    int64_t samples = 0;
+    assert_int_equal(0, jls_rd_fsr_length(rd, 5, &samples));
+    assert_int_equal(sample_count_truncated, samples);
+
+    double stats[128][JLS_SUMMARY_FSR_COUNT];
+    double stats_ref[128][JLS_SUMMARY_FSR_COUNT];
+    const int64_t increments[] = {8000, 100000, 900000};
+    for (size_t k = 0; k < ARRAY_SIZE(increments); ++k) {
+        int64_t count = samples / increments[k];
+        assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, 0, increments[k], stats[0], count));
+        assert_int_equal(0, jls_rd_fsr_statistics(rd_ref, 5, 0, increments[k], stats_ref[0], count));
+        for (int64_t i = 0; i < count; ++i) {
+            for (int j = 0; j < JLS_SUMMARY_FSR_COUNT; ++j) {
+                assert_float_equal(stats_ref[i][j], stats[i][j], 1e-9);
+            }
+        }
+    }
+
+    int64_t count = 0;
+    assert_int_equal(0, jls_rd_annotations(rd, 5, 0, on_checkpoint_annotation, &count));
+    assert_int_equal(100, count);
+    count = 0;
+    assert_int_equal(0, jls_rd_utc(rd, 5, 0, on_checkpoint_utc, &count));
+    assert_int_equal(1000, count);
+
+    jls_rd_close(rd);
+    jls_rd_close(rd_ref);
+    free(signal);
+    remove(filename);
+    remove(filename_ref);
+}
+
+static void test_checkpoint_unclosed(void **state) {
+    (void) state;
+    checkpoint_check(-1);
+}
+
+static void test_checkpoint_fallback(void **state) {
+    (void) state;
+    checkpoint_check(WINDOW_SIZE * 990);  // gap after the last checkpoint, full repair
+}
+
+static uint8_t * file_load(int64_t * size) {
+    FILE * f = fopen(filename, "rb");
+    assert_non_null(f);
+    assert_int_equal(0, fseek(f, 0, SEEK_END));
+    *size = ftell(f);
+    assert_int_equal(0, fseek(f, 0, SEEK_SET));
+    uint8_t * data = malloc((size_t) *size);
+    assert_non_null(data);
+    assert_int_equal(*size, (int64_t) fread(data, 1, (size_t) *size, f));
+    fclose(f);
+    return data;
+}
+
+static void test_readonly_unclosed(void **state) {
+    (void) state;
+    int64_t sample_count = WINDOW_SIZE * 3000;  // complete level 2 summary
+    int64_t sample_count_truncated = 2810080;
+    float * signal = gen_truncate(sample_count, 0, GEN_SKIP_CLOSE);
+    int64_t file_size = 0;
+    uint8_t * file_data = file_load(&file_size);
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open_readonly(&rd, filename));
+    int64_t samples = 0;
+    assert_int_equal(0, jls_rd_fsr_length(rd, 5, &samples));
+    assert_int_equal(sample_count_truncated, samples);
+    float * data = malloc(10000 * sizeof(float));
+    assert_int_equal(0, jls_rd_fsr_f32(rd, 5, samples - 10000, data, 10000));
+    assert_memory_equal(signal + samples - 10000, data, 10000 * sizeof(float));
+    free(data);
+
+    double stats[2][JLS_SUMMARY_FSR_COUNT];
+    double stats_ref[2][JLS_SUMMARY_FSR_COUNT];
+    int64_t increment = samples / 2;
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, 0, increment, stats[0], 2));
+    int64_t count = 0;
+    assert_int_equal(0, jls_rd_utc(rd, 5, 0, on_checkpoint_utc, &count));
+    assert_int_equal(3000, count);
+    jls_rd_close(rd);
+
+    int64_t file_size_after = 0;
+    uint8_t * file_data_after = file_load(&file_size_after);
+    assert_int_equal(file_size, file_size_after);
+    assert_memory_equal(file_data, file_data_after, (size_t) file_size);
+    free(file_data);
+    free(file_data_after);
+
+    assert_int_equal(0, jls_rd_open(&rd, filename));  // repair in place
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, 0, increment, stats_ref[0], 2));
+    for (int i = 0; i < 2; ++i) {
+        for (int j = 0; j < JLS_SUMMARY_FSR_COUNT; ++j) {
+            assert_float_equal(stats_ref[i][j], stats[i][j], 1e-4);
+        }
+    }
+    jls_rd_close(rd);
+    free(signal);
+    remove(filename);
+}
+
+static void gen_quantiles(const char * path, const struct jls_signal_def_s * signal_def, float * signal,
+                          int64_t sample_count, enum gen_close_e gen_close) {
+    struct jls_wr_s * wr = NULL;
+    assert_int_equal(0, jls_wr_open(&wr, path));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, signal_def));
+    for (int64_t sample_id = 0; sample_id < sample_count; sample_id += WINDOW_SIZE) {
+        int64_t length = sample_count - sample_id;
+        length = (length < WINDOW_SIZE) ? length : WINDOW_SIZE;
+        assert_int_equal(0, jls_wr_fsr_f32(wr, 5, sample_id, signal + sample_id, (uint32_t) length));
+    }
+    if (gen_close == GEN_CLOSE) {
+        assert_int_equal(0, jls_wr_close(wr));
+    } else {
+        struct jls_core_s * core = (struct jls_core_s *) wr;
+        jls_bk_fclose(jls_raw_backend(core->raw));
+    }
+}
+
+static void test_quantiles_unclosed(void **state) {
+    (void) state;
+    const char * filename_ref = "jls_test_tmp_ref.jls";
+    int64_t sample_count = WINDOW_SIZE * 3000;
+    float * signal = malloc(sizeof(float) * (size_t) sample_count);
+    assert_non_null(signal);
+    for (int64_t i = 0; i < sample_count; ++i) {
+        signal[i] = (i < 1234567) ? 0.25f : 0.75f;
+    }
+    struct jls_signal_def_s signal_def = SIGNAL_5;
+    signal_def.summary_hist_bins = 10;
+    signal_def.summary_hist_min = 0.0f;
+    signal_def.summary_hist_max = 1.0f;
+
+    gen_quantiles(filename, &signal_def, signal, sample_count, GEN_SKIP_CLOSE);
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));  // automatically repaired
+    int64_t samples = 0;
+    assert_int_equal(0, jls_rd_fsr_length(rd, 5, &samples));
+    gen_quantiles(filename_ref, &signal_def, signal, samples, GEN_CLOSE);
+    struct jls_rd_s * rd_ref = NULL;
+    assert_int_equal(0, jls_rd_open(&rd_ref, filename_ref));
+
+    const double q[] = {0.0, 0.1, 0.3, 0.5, 0.9, 1.0};
+    double v[ARRAY_SIZE(q)];
+    double v_ref[ARRAY_SIZE(q)];
+    const int64_t windows[][2] = {
+        {1200000, 100000},
+        {1000000, 1000000},
+        {0, samples},
+    };
+    for (size_t w = 0; w < ARRAY_SIZE(windows); ++w) {
+        assert_int_equal(0, jls_rd_fsr_quantiles(rd, 5, windows[w][0], windows[w][1], q, v, ARRAY_SIZE(q)));
+        assert_int_equal(0, jls_rd_fsr_quantiles(rd_ref, 5, windows[w][0], windows[w][1], q, v_ref, ARRAY_SIZE(q)));
+        for (size_t i = 0; i < ARRAY_SIZE(q); ++i) {
+            assert_float_equal(v_ref[i], v[i], 1e-9);
+        }
+    }
+    jls_rd_close(rd);
+    jls_rd_close(rd_ref);
+    free(signal);
+    remove(filename);
+    remove(filename_ref);
+}
+
 
 static void on_log_recv(const char * msg) {
     printf("%s", msg);
@@ -272,6 +491,10 @@ int main(void) {
             cmocka_unit_test(test_truncate_summary),
             cmocka_unit_test(test_truncate_samples),
             cmocka_unit_test(test_truncate_samples_unclosed),
+            cmocka_unit_test(test_checkpoint_unclosed),
+            cmocka_unit_test(test_checkpoint_fallback),
+            cmocka_unit_test(test_readonly_unclosed),
+            cmocka_unit_test(test_quantiles_unclosed),
     };
 
     jls_log_register(on_log_recv);
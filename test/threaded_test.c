@@ -18,6 +18,8 @@
 #include <stddef.h>
 #include <setjmp.h>
 #include <cmocka.h>
+#include "jls/backend.h"
+#include "jls/dataset.h"
 #include "jls/reader.h"
 #include "jls/threaded_writer.h"
 #include "jls/format.h"
@@ -127,9 +129,353 @@ static void test_data(void **state) {
     remove(filename);
 }
 
+static void test_stats(void **state) {
+    (void) state;
+    struct jls_twr_s * wr = NULL;
+    struct jls_twr_stats_s twr_stats;
+    struct jls_stats_s rd_stats;
+    const int64_t sample_count = WINDOW_SIZE * 1000;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+
+    assert_int_equal(0, jls_twr_open(&wr, filename));
+    assert_int_equal(JLS_ERROR_UNAVAILABLE, jls_twr_stats(wr, &twr_stats));
+    assert_int_equal(0, jls_twr_stats_enable(wr, 1));
+    assert_int_equal(0, jls_twr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_twr_signal_def(wr, &SIGNAL_5));
+    for (int sample_id = 0; sample_id < sample_count; sample_id += WINDOW_SIZE) {
+        assert_int_equal(0, jls_twr_fsr_f32(wr, 5, sample_id, signal + sample_id, WINDOW_SIZE));
+    }
+    assert_int_equal(0, jls_twr_flush(wr));
+    assert_int_equal(0, jls_twr_stats(wr, &twr_stats));
+    assert_int_equal(1001, twr_stats.msg_count);  // 1000 fsr + flush
+    assert_int_equal(0, twr_stats.dropped_msgs);
+    assert_int_equal(0, twr_stats.dropped_samples);
+    assert_true(twr_stats.ring_high_water > 0);
+    assert_true(twr_stats.ring_high_water <= twr_stats.ring_size);
+    uint64_t latency_count = 0;
+    for (int i = 0; i < JLS_STATS_LATENCY_BINS; ++i) {
+        latency_count += twr_stats.latency_histogram[i];
+    }
+    assert_int_equal(twr_stats.msg_count, latency_count);
+    assert_int_equal(1, twr_stats.wr.chunk_wr[JLS_TAG_SOURCE_DEF]);
+    assert_int_equal(1, twr_stats.wr.chunk_wr[JLS_TAG_SIGNAL_DEF]);
+    assert_true(twr_stats.wr.chunk_wr[JLS_TAG_TRACK_FSR_DATA] >= 900);
+    assert_true(twr_stats.wr.chunk_wr[JLS_TAG_TRACK_FSR_SUMMARY] > 0);
+    assert_true(twr_stats.wr.bytes_wr > sample_count * sizeof(float));
+    assert_true(twr_stats.wr.summary_time > 0);
+    assert_int_equal(0, twr_stats.wr.chunk_rd[JLS_TAG_TRACK_FSR_DATA]);
+    assert_int_equal(0, jls_twr_close(wr));
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    assert_int_equal(JLS_ERROR_UNAVAILABLE, jls_rd_stats(rd, &rd_stats));
+    assert_int_equal(0, jls_rd_stats_enable(rd, 1));
+    float data[1000];
+    assert_int_equal(0, jls_rd_fsr_f32(rd, 5, 1999, data, 1000));
+    assert_int_equal(0, jls_rd_stats(rd, &rd_stats));
+    assert_true(rd_stats.chunk_rd[JLS_TAG_TRACK_FSR_DATA] >= 2);
+    assert_true(rd_stats.bytes_rd > 2 * 1000 * sizeof(float));
+    assert_true(rd_stats.seeks > 0);
+    assert_int_equal(0, rd_stats.fsr_statistics);
+
+    double stats[2][JLS_SUMMARY_FSR_COUNT];
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, 0, 10, &stats[0][0], 2));
+    assert_int_equal(0, jls_rd_stats(rd, &rd_stats));
+    assert_int_equal(1, rd_stats.fsr_statistics);
+    assert_int_equal(1, rd_stats.fsr_statistics_level0);
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, 0, 400000, &stats[0][0], 2));
+    assert_int_equal(0, jls_rd_stats(rd, &rd_stats));
+    assert_int_equal(2, rd_stats.fsr_statistics);
+    assert_true(rd_stats.fsr_statistics_time > 0);
+    assert_true(rd_stats.chunk_rd[JLS_TAG_TRACK_FSR_SUMMARY] > 0);
+
+    assert_int_equal(0, jls_rd_stats_enable(rd, 1));  // reset
+    assert_int_equal(0, jls_rd_stats(rd, &rd_stats));
+    assert_int_equal(0, rd_stats.fsr_statistics);
+    assert_int_equal(0, jls_rd_stats_enable(rd, 0));
+    assert_int_equal(JLS_ERROR_UNAVAILABLE, jls_rd_stats(rd, &rd_stats));
+
+    jls_rd_close(rd);
+    free(signal);
+    remove(filename);
+}
+
+static int32_t on_dataset_annotation(void * user_data, const struct jls_annotation_s * annotation) {
+    int64_t * count = (int64_t *) user_data;
+    assert_int_equal(*count * 10000, annotation->timestamp);
+    ++*count;
+    return 0;
+}
+
+static int32_t on_dataset_utc(void * user_data, const struct jls_utc_summary_entry_s * utc, uint32_t size) {
+    int64_t * count = (int64_t *) user_data;
+    for (uint32_t i = 0; i < size; ++i) {
+        assert_int_equal(*count * 50000, utc[i].sample_id);
+        assert_int_equal(*count * JLS_TIME_SECOND / 2, utc[i].timestamp);
+        ++*count;
+    }
+    return 0;
+}
+
+static void dataset_write(struct jls_twr_s * wr, const float * signal, int64_t sample_count) {
+    assert_int_equal(0, jls_twr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_twr_signal_def(wr, &SIGNAL_5));
+    for (int64_t sample_id = 0; sample_id < sample_count; sample_id += WINDOW_SIZE) {
+        int64_t end = sample_id + WINDOW_SIZE;
+        for (int64_t k = (sample_id + 9999) / 10000; k * 10000 < end; ++k) {
+            assert_int_equal(0, jls_twr_annotation(wr, 5, k * 10000, 1.0f, JLS_ANNOTATION_TYPE_TEXT, 0,
+                                                   JLS_STORAGE_TYPE_STRING, (const uint8_t *) "hello", 0));
+        }
+        for (int64_t k = (sample_id + 49999) / 50000; k * 50000 < end; ++k) {
+            assert_int_equal(0, jls_twr_utc(wr, 5, k * 50000, k * JLS_TIME_SECOND / 2));
+        }
+        assert_int_equal(0, jls_twr_fsr_f32(wr, 5, sample_id, signal + sample_id, WINDOW_SIZE));
+    }
+    assert_int_equal(0, jls_twr_close(wr));
+}
+
+static void test_dataset(void **state) {
+    (void) state;
+    const char * filename_ref = "threaded_test_tmp_ref.jls";
+    struct jls_twr_s * wr = NULL;
+    const int64_t sample_count = WINDOW_SIZE * 1000;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+
+    assert_int_equal(0, jls_twr_open(&wr, filename_ref));
+    dataset_write(wr, signal, sample_count);
+    assert_int_equal(0, jls_twr_open_dataset(&wr, filename, 0, 2 * JLS_TIME_SECOND));
+    dataset_write(wr, signal, sample_count);
+
+    char segment_path[64];
+    assert_int_equal(0, jls_ds_segment_path(filename, 3, segment_path, sizeof(segment_path)));
+    assert_string_equal("threaded_test_tmp_00003.jls", segment_path);
+    assert_int_equal(JLS_ERROR_TOO_BIG, jls_ds_segment_path(filename, 3, segment_path, 8));
+
+    struct jls_ds_s * ds = NULL;
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(JLS_ERROR_NOT_FOUND, jls_ds_open(&ds, "threaded_test_missing.jls"));
+    assert_int_equal(0, jls_ds_open(&ds, filename));
+    assert_int_equal(0, jls_rd_open(&rd, filename_ref));
+    assert_int_equal(5, jls_ds_segment_count(ds));  // 200000 samples per segment
+    struct jls_signal_def_s * signals = NULL;
+    uint16_t count = 0;
+    assert_int_equal(0, jls_ds_signals(ds, &signals, &count));
+    assert_int_equal(2, count);
+    assert_int_equal(5, signals[1].signal_id);
+    int64_t samples = 0;
+    assert_int_equal(0, jls_ds_fsr_length(ds, 5, &samples));
+    assert_int_equal(sample_count, samples);
+
+    float * data = malloc(sample_count * sizeof(float));
+    assert_non_null(data);
+    assert_int_equal(0, jls_ds_fsr(ds, 5, 0, data, sample_count));
+    assert_memory_equal(signal, data, sample_count * sizeof(float));
+    assert_int_equal(0, jls_ds_fsr(ds, 5, 199000, data, 2000));  // across a segment boundary
+    assert_memory_equal(signal + 199000, data, 2000 * sizeof(float));
+    assert_int_equal(JLS_ERROR_NOT_FOUND, jls_ds_fsr(ds, 5, sample_count - 5, data, 10));
+    free(data);
+
+    double stats[64][JLS_SUMMARY_FSR_COUNT];
+    double stats_ref[64][JLS_SUMMARY_FSR_COUNT];
+    // the reader approximates the last entry of each request from summaries,
+    // and the dataset splits requests at segment boundaries.
+    const int64_t increments[] = {100, 10000, 230000};
+    for (size_t k = 0; k < sizeof(increments) / sizeof(increments[0]); ++k) {
+        int64_t n = sample_count / increments[k];
+        n = (n > 64) ? 64 : n;
+        for (int64_t start = 0; start < sample_count - n * increments[k]; start += 150000) {
+            assert_int_equal(0, jls_ds_fsr_statistics(ds, 5, start, increments[k], stats[0], n));
+            assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, start, increments[k], stats_ref[0], n));
+            for (int64_t i = 0; i < n; ++i) {
+                for (int j = 0; j < JLS_SUMMARY_FSR_COUNT; ++j) {
+                    assert_true(fabs(stats_ref[i][j] - stats[i][j]) < 1e-3);
+                }
+            }
+        }
+    }
+    assert_int_equal(0, jls_ds_fsr_statistics(ds, 5, 0, sample_count, stats[0], 1));
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, 0, sample_count, stats_ref[0], 1));
+    for (int j = 0; j < JLS_SUMMARY_FSR_COUNT; ++j) {
+        assert_true(fabs(stats_ref[0][j] - stats[0][j]) < 1e-4);
+    }
+
+    int64_t n = 0;
+    assert_int_equal(0, jls_ds_annotations(ds, 5, 0, on_dataset_annotation, &n));
+    assert_int_equal((sample_count + 9999) / 10000, n);
+    n = 40;
+    assert_int_equal(0, jls_ds_annotations(ds, 5, 400000, on_dataset_annotation, &n));
+    assert_int_equal((sample_count + 9999) / 10000, n);
+    n = 0;
+    assert_int_equal(0, jls_ds_utc(ds, 5, 0, on_dataset_utc, &n));
+    assert_int_equal((sample_count + 49999) / 50000, n);
+
+    jls_ds_close(ds);
+    jls_rd_close(rd);
+    for (uint32_t i = 0; 0 == jls_ds_segment_path(filename, i, segment_path, sizeof(segment_path)); ++i) {
+        if (remove(segment_path)) {
+            break;
+        }
+    }
+    remove(filename_ref);
+    free(signal);
+}
+
+struct flush_cbk_s {
+    uint64_t count;
+    uint64_t flush_id;
+    int32_t rc;
+    int out_of_order;
+};
+
+static void on_flush(void * user_data, uint64_t flush_id, int32_t rc) {
+    // called from the writer thread, so record rather than assert
+    struct flush_cbk_s * cbk = (struct flush_cbk_s *) user_data;
+    if (flush_id <= cbk->flush_id) {
+        cbk->out_of_order = 1;
+    }
+    cbk->flush_id = flush_id;
+    cbk->rc = rc ? rc : cbk->rc;
+    ++cbk->count;
+}
+
+static void test_flush_async(void **state) {
+    (void) state;
+    struct jls_twr_s * wr = NULL;
+    struct jls_twr_stats_s stats;
+    struct flush_cbk_s cbk = {0, 0, 0, 0};
+    uint64_t flush_id = 0;
+    const int64_t sample_count = WINDOW_SIZE * 100;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+
+    assert_int_equal(0, jls_twr_open(&wr, filename));
+    assert_int_equal(0, jls_twr_stats_enable(wr, 1));
+    assert_int_equal(0, jls_twr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_twr_signal_def(wr, &SIGNAL_5));
+    for (int sample_id = 0; sample_id < sample_count; sample_id += WINDOW_SIZE) {
+        assert_int_equal(0, jls_twr_fsr_f32(wr, 5, sample_id, signal + sample_id, WINDOW_SIZE));
+        if (0 == (sample_id % (WINDOW_SIZE * 25))) {
+            assert_int_equal(0, jls_twr_flush_async(wr, on_flush, &cbk, &flush_id));
+        }
+    }
+    assert_int_equal(4, flush_id);
+    assert_int_equal(0, jls_twr_flush(wr));  // completes after all prior flushes
+    assert_int_equal(4, cbk.count);
+    assert_int_equal(4, cbk.flush_id);
+    assert_int_equal(0, cbk.rc);
+    assert_int_equal(0, cbk.out_of_order);
+    assert_int_equal(0, jls_twr_stats(wr, &stats));
+    assert_true(stats.syncs >= 1);
+    assert_true(stats.syncs <= 5);
+    assert_int_equal(0, jls_twr_close(wr));
+    free(signal);
+    remove(filename);
+}
+
+static uint64_t durability_syncs(struct jls_twr_s * wr) {
+    struct jls_twr_stats_s stats;
+    assert_int_equal(0, jls_twr_stats(wr, &stats));
+    return stats.syncs;
+}
+
+static void test_durability(void **state) {
+    (void) state;
+    struct jls_twr_s * wr = NULL;
+    const int64_t sample_count = WINDOW_SIZE * 1000;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+
+    assert_int_equal(0, jls_twr_open(&wr, filename));
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID, jls_twr_durability(wr, 99, 0, 0));
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID, jls_twr_durability(wr, JLS_TWR_DURABILITY_PERIODIC, -1, 0));
+    assert_int_equal(0, jls_twr_durability(wr, JLS_TWR_DURABILITY_NONE, 0, 0));
+    assert_int_equal(0, jls_twr_stats_enable(wr, 1));
+    assert_int_equal(0, jls_twr_write_buffer(wr, 1 << 20));
+    assert_int_equal(0, jls_twr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_twr_signal_def(wr, &SIGNAL_5));
+    int64_t half = sample_count / 2;
+    for (int64_t sample_id = 0; sample_id < half; sample_id += WINDOW_SIZE) {
+        assert_int_equal(0, jls_twr_fsr_f32(wr, 5, sample_id, signal + sample_id, WINDOW_SIZE));
+    }
+    assert_int_equal(0, jls_twr_flush(wr));
+    assert_int_equal(0, durability_syncs(wr));
+
+    // size triggers syncs while busy
+    assert_int_equal(0, jls_twr_durability(wr, JLS_TWR_DURABILITY_PERIODIC, 0, 256 * 1024));
+    for (int64_t sample_id = half; sample_id < sample_count; sample_id += WINDOW_SIZE) {
+        assert_int_equal(0, jls_twr_fsr_f32(wr, 5, sample_id, signal + sample_id, WINDOW_SIZE));
+    }
+    assert_int_equal(0, jls_twr_flush(wr));
+    uint64_t syncs = durability_syncs(wr);
+    assert_true(syncs >= 4);
+
+    // period triggers a sync while idle
+    assert_int_equal(0, jls_twr_durability(wr, JLS_TWR_DURABILITY_PERIODIC, 20 * JLS_TIME_MILLISECOND, 0));
+    assert_int_equal(0, jls_twr_utc(wr, 5, 0, 0));
+    for (int i = 0; (i < 200) && (durability_syncs(wr) == syncs); ++i) {
+        jls_bkt_sleep_ms(10);
+    }
+    assert_true(durability_syncs(wr) > syncs);
+    assert_int_equal(0, jls_twr_close(wr));
+
+    struct jls_rd_s * rd = NULL;
+    int64_t samples = 0;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    assert_int_equal(0, jls_rd_fsr_length(rd, 5, &samples));
+    assert_int_equal(sample_count, samples);
+    jls_rd_close(rd);
+    free(signal);
+    remove(filename);
+}
+
+static void test_append(void **state) {
+    (void) state;
+    struct jls_twr_s * wr = NULL;
+    const int64_t sample_count = WINDOW_SIZE * 1000;
+    const int64_t split = WINDOW_SIZE * 400;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+
+    assert_int_equal(0, jls_twr_open(&wr, filename));
+    assert_int_equal(0, jls_twr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_twr_signal_def(wr, &SIGNAL_5));
+    for (int64_t sample_id = 0; sample_id < split; sample_id += WINDOW_SIZE) {
+        assert_int_equal(0, jls_twr_fsr_f32(wr, 5, sample_id, signal + sample_id, WINDOW_SIZE));
+    }
+    assert_int_equal(0, jls_twr_close(wr));
+
+    // signal 5 is restored from the file, not defined again
+    assert_int_equal(0, jls_twr_open_append(&wr, filename));
+    for (int64_t sample_id = split; sample_id < sample_count; sample_id += WINDOW_SIZE) {
+        assert_int_equal(0, jls_twr_fsr_f32(wr, 5, sample_id, signal + sample_id, WINDOW_SIZE));
+    }
+    assert_int_equal(0, jls_twr_close(wr));
+
+    struct jls_rd_s * rd = NULL;
+    int64_t samples = 0;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    assert_int_equal(0, jls_rd_fsr_length(rd, 5, &samples));
+    assert_int_equal(sample_count, samples);
+    float * data = malloc(sizeof(float) * (size_t) sample_count);
+    assert_non_null(data);
+    assert_int_equal(0, jls_rd_fsr_f32(rd, 5, 0, data, sample_count));
+    assert_memory_equal(signal, data, sizeof(float) * (size_t) sample_count);
+    jls_rd_close(rd);
+    free(data);
+    free(signal);
+    remove(filename);
+}
+
 int main(void) {
     const struct CMUnitTest tests[] = {
             cmocka_unit_test(test_data),
+            cmocka_unit_test(test_stats),
+            cmocka_unit_test(test_dataset),
+            cmocka_unit_test(test_flush_async),
+            cmocka_unit_test(test_durability),
+            cmocka_unit_test(test_append),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);